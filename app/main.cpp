@@ -21,15 +21,23 @@
 
 #include "gpio_tester.h"
 #include "cpu_tester.h"
+#include "stress_generator.h"
 #include <iostream>
 #include <vector>
 #include <memory>
 #include <string>
 #include <chrono>
 #include <thread>
+#include <sstream>
 
 using namespace cm5_peripheral_test;
 
+/** Set by --isolate: run CPU tests in isolated-core measurement mode. */
+static bool isolate_cores = false;
+
+/** Set by --record: series file monitor tests append every sample to. */
+static std::string record_path;
+
 /**
  * @brief Prints usage information for the application.
  * @param program_name The name of the executable.
@@ -42,13 +50,37 @@ void print_usage(const char* program_name) {
               << "  --all-monitor <sec>  Run monitoring tests for all peripherals\n"
               << "  --cpu-short          Run short CPU test\n"
               << "  --cpu-monitor <sec>  Run CPU monitoring test\n"
+              << "  --cpu-freq-sweep     Sweep cpufreq steps and measure throughput per step\n"
+              << "  --cpu-dvfs-latency   Measure governor ramp-up/ramp-down latency\n"
+              << "  --cpu-idle-latency   Measure wakeup latency cost of each idle state\n"
+              << "  --cpu-contention     Benchmark lock/atomic contention and false sharing\n"
+              << "  --cpu-crypto         Benchmark AES/PMULL/SHA2/CRC32 extensions against portable C\n"
+              << "  --cpu-gemm           Measure SGEMM/DGEMM GFLOP/s against theoretical peak\n"
+              << "  --cpu-clocks         Characterize clock source cost, resolution and monotonicity\n"
+              << "  --cpu-threads        Measure thread create/join, condvar, futex, barrier and eventfd costs\n"
+              << "  --cpu-tlb            Compare page-stride latency and TLB misses with and without huge pages\n"
+              << "  --cpu-mapping        Measure page-fault, mmap/munmap, madvise and mprotect costs\n"
+              << "  --cpu-frontend       Measure branch misprediction, indirect call and I-cache footprint costs\n"
+              << "  --cpu-handoff        Compare mutex and lock-free SPSC producer/consumer handoff throughput\n"
+              << "  --cpu-litmus         Run memory-ordering litmus tests across core pairs\n"
+              << "  --cpu-sdc-screen     Screen all cores for silent data corruption\n"
+              << "  --cpu-stress <sec> [--mix int,fp,cache,mem] [--duty <pct>[,<pct>...]]\n"
+              << "               [--period <ms>] [--stagger]\n"
+              << "                       Load cores with a square-wave pattern while monitoring temperature\n"
               << "  --gpio-short         Run short GPIO test\n"
               << "  --gpio-monitor <sec> Run GPIO monitoring test\n"
+              << "  --isolate            With any CPU option: keep the tool's own threads on housekeeping\n"
+              << "                       cores and run benchmarks only on measurement cores\n"
+              << "  --record <file>      With a monitor or stress option: append every sample to a\n"
+              << "                       compressed series file\n"
               << "  --list               List all available peripherals\n"
               << "  --help               Show this help message\n\n"
               << "Examples:\n"
               << "  " << program_name << " --all-short\n"
               << "  " << program_name << " --cpu-monitor 60\n"
+              << "  " << program_name << " --cpu-stress 300 --mix int,fp --duty 50 --period 20\n"
+              << "  " << program_name << " --cpu-gemm --isolate\n"
+              << "  " << program_name << " --all-monitor 604800 --record soak.cm5ts\n"
               << "  " << program_name << " --list\n";
 }
 
@@ -72,6 +104,74 @@ void list_peripherals() {
     std::cout << "More peripherals will be added in future versions.\n";
 }
 
+/**
+ * @brief Applies global options to a CPU tester before it runs.
+ * @param tester Tester to configure.
+ */
+void configure_cpu_tester(CPUTester& tester) {
+    if (isolate_cores && !tester.enable_core_isolation()) {
+        std::cerr << "Warning: Core isolation unavailable (" << tester.core_partition().describe() << ").\n";
+    }
+    tester.set_recording_path(record_path);
+}
+
+/**
+ * @brief Applies global options to a GPIO tester before it runs.
+ * @param tester Tester to configure.
+ */
+void configure_gpio_tester(GPIOTester& tester) {
+    tester.set_recording_path(record_path);
+}
+
+/**
+ * @brief Prints the core partition a report ran under, if any.
+ * @param report Report to describe.
+ */
+void print_placement(const TestReport& report) {
+    if (!report.placement.empty()) {
+        std::cout << "Placement: " << report.placement << "\n";
+    }
+}
+
+/**
+ * @brief Prints the resources a report's test consumed.
+ * @param report Report to describe.
+ */
+void print_resources(const TestReport& report) {
+    if (report.resources.valid) {
+        std::cout << "Resources: " << format_resource_usage(report.resources, report.duration) << "\n";
+    }
+}
+
+/**
+ * @brief Prints the statistics, retained window and latency histograms of a report.
+ * @param report Report to describe.
+ */
+void print_series(const TestReport& report) {
+    for (const StreamingSummary& statistics : report.statistics) {
+        std::cout << "Statistics " << statistics.describe() << "\n";
+    }
+    for (const LatencyHistogram& histogram : report.histograms) {
+        std::cout << "Histogram " << histogram.name() << ": " << histogram.summary(1000.0, "us") << "\n  "
+                  << histogram.serialize() << "\n";
+    }
+    for (const TimeSeries& series : report.series) {
+        std::cout << "Series " << series.describe() << "\n";
+    }
+}
+
+/**
+ * @brief Prints the outcome of a test with everything its report carries.
+ * @param report Report to print.
+ */
+void print_report(const TestReport& report) {
+    std::cout << "Result: " << (report.result == TestResult::SUCCESS ? "PASS" : "FAIL") << "\n";
+    print_placement(report);
+    std::cout << "Details:\n" << report.details << "\n";
+    print_resources(report);
+    print_series(report);
+}
+
 /**
  * @brief Runs short tests for all available peripherals.
  * @return 0 on success, non-zero on failure.
@@ -83,11 +183,11 @@ int run_all_short_tests() {
 
     // CPU test
     CPUTester cpu_tester;
+    configure_cpu_tester(cpu_tester);
     if (cpu_tester.is_available()) {
         std::cout << "Testing CPU...\n";
         TestReport report = cpu_tester.short_test();
-        std::cout << "Result: " << (report.result == TestResult::SUCCESS ? "PASS" : "FAIL") << "\n";
-        std::cout << "Details: " << report.details << "\n";
+        print_report(report);
         std::cout << "Duration: " << report.duration.count() << " ms\n\n";
 
         if (report.result != TestResult::SUCCESS) {
@@ -99,11 +199,11 @@ int run_all_short_tests() {
 
     // GPIO test
     GPIOTester gpio_tester;
+    configure_gpio_tester(gpio_tester);
     if (gpio_tester.is_available()) {
         std::cout << "Testing GPIO...\n";
         TestReport report = gpio_tester.short_test();
-        std::cout << "Result: " << (report.result == TestResult::SUCCESS ? "PASS" : "FAIL") << "\n";
-        std::cout << "Details: " << report.details << "\n";
+        print_report(report);
         std::cout << "Duration: " << report.duration.count() << " ms\n\n";
 
         if (report.result != TestResult::SUCCESS) {
@@ -136,11 +236,11 @@ int run_all_monitor_tests(int duration_seconds) {
 
     // CPU test
     CPUTester cpu_tester;
+    configure_cpu_tester(cpu_tester);
     if (cpu_tester.is_available()) {
         std::cout << "Monitoring CPU...\n";
         TestReport report = cpu_tester.monitor_test(std::chrono::seconds(duration_seconds));
-        std::cout << "Result: " << (report.result == TestResult::SUCCESS ? "PASS" : "FAIL") << "\n";
-        std::cout << "Details: " << report.details << "\n";
+        print_report(report);
         std::cout << "Duration: " << report.duration.count() << " ms\n\n";
 
         if (report.result != TestResult::SUCCESS) {
@@ -152,11 +252,11 @@ int run_all_monitor_tests(int duration_seconds) {
 
     // GPIO test
     GPIOTester gpio_tester;
+    configure_gpio_tester(gpio_tester);
     if (gpio_tester.is_available()) {
         std::cout << "Monitoring GPIO...\n";
         TestReport report = gpio_tester.monitor_test(std::chrono::seconds(duration_seconds));
-        std::cout << "Result: " << (report.result == TestResult::SUCCESS ? "PASS" : "FAIL") << "\n";
-        std::cout << "Details: " << report.details << "\n";
+        print_report(report);
         std::cout << "Duration: " << report.duration.count() << " ms\n\n";
 
         if (report.result != TestResult::SUCCESS) {
@@ -177,6 +277,105 @@ int run_all_monitor_tests(int duration_seconds) {
     }
 }
 
+/**
+ * @brief Runs one extended CPU test and prints its report.
+ * @param title Human-readable test name.
+ * @param test CPUTester member function implementing the test.
+ * @return 0 on success, non-zero on failure.
+ */
+int run_cpu_test(const std::string& title, TestReport (CPUTester::*test)()) {
+    CPUTester tester;
+    configure_cpu_tester(tester);
+    if (!tester.is_available()) {
+        std::cerr << "CPU peripheral is not available on this system.\n";
+        return 1;
+    }
+
+    std::cout << "Running CPU " << title << "...\n";
+    TestReport report = (tester.*test)();
+    print_report(report);
+    return report.result == TestResult::SUCCESS ? 0 : 1;
+}
+
+/**
+ * @brief Splits a comma-separated option value.
+ * @param value Option value such as "int,fp".
+ * @return Non-empty fields in order.
+ */
+std::vector<std::string> split_list(const std::string& value) {
+    std::vector<std::string> fields;
+    std::stringstream stream(value);
+    std::string field;
+    while (std::getline(stream, field, ',')) {
+        if (!field.empty()) {
+            fields.push_back(field);
+        }
+    }
+    return fields;
+}
+
+/**
+ * @brief Parses the --cpu-stress options and runs the stress test.
+ * @param argc Number of command-line arguments.
+ * @param argv Arguments; argv[2] is the duration, options follow.
+ * @return 0 on success, non-zero on failure or invalid options.
+ */
+int run_cpu_stress(int argc, char* argv[]) {
+    StressConfig config;
+    int seconds = 0;
+
+    try {
+        seconds = std::stoi(argv[2]);
+        for (int i = 3; i < argc; ++i) {
+            std::string option = argv[i];
+            if (option == "--stagger") {
+                config.staggered = true;
+            } else if (option == "--mix" && i + 1 < argc) {
+                config.mix.clear();
+                for (const auto& name : split_list(argv[++i])) {
+                    StressWorkload workload;
+                    if (!parse_stress_workload(name, workload)) {
+                        std::cerr << "Error: Unknown workload '" << name << "'.\n";
+                        return 1;
+                    }
+                    config.mix.push_back(workload);
+                }
+            } else if (option == "--duty" && i + 1 < argc) {
+                config.duty_cycles.clear();
+                for (const auto& pct : split_list(argv[++i])) {
+                    config.duty_cycles.push_back(std::stod(pct) / 100.0);
+                }
+            } else if (option == "--period" && i + 1 < argc) {
+                config.period = std::chrono::milliseconds(std::stoi(argv[++i]));
+            } else {
+                std::cerr << "Error: Unknown stress option '" << option << "'.\n";
+                return 1;
+            }
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "Error: Invalid stress option value.\n";
+        return 1;
+    }
+
+    if (seconds <= 0 || config.period.count() <= 0) {
+        std::cerr << "Error: Duration and period must be positive.\n";
+        return 1;
+    }
+
+    CPUTester tester;
+
+    configure_cpu_tester(tester);
+    if (!tester.is_available()) {
+        std::cerr << "CPU peripheral is not available on this system.\n";
+        return 1;
+    }
+
+    std::cout << "Running CPU stress test for " << seconds << " seconds...\n";
+    TestReport report = tester.stress_test(config, std::chrono::seconds(seconds));
+    print_report(report);
+    return report.result == TestResult::SUCCESS ? 0 : 1;
+}
+
 /**
  * @brief Main entry point of the application.
  *
@@ -187,6 +386,20 @@ int run_all_monitor_tests(int duration_seconds) {
  * @return 0 on successful execution, non-zero on error.
  */
 int main(int argc, char* argv[]) {
+    // --isolate and --record may appear anywhere; strip them so positional
+    // options keep their places
+    int kept = 1;
+    for (int i = 1; i < argc; ++i) {
+        if (std::string(argv[i]) == "--isolate") {
+            isolate_cores = true;
+        } else if (std::string(argv[i]) == "--record" && i + 1 < argc) {
+            record_path = argv[++i];
+        } else {
+            argv[kept++] = argv[i];
+        }
+    }
+    argc = kept;
+
     if (argc < 2) {
         print_usage(argv[0]);
         return 1;
@@ -212,6 +425,7 @@ int main(int argc, char* argv[]) {
 
     } else if (command == "--cpu-short") {
         CPUTester tester;
+        configure_cpu_tester(tester);
         if (!tester.is_available()) {
             std::cerr << "CPU peripheral is not available on this system.\n";
             return 1;
@@ -219,10 +433,52 @@ int main(int argc, char* argv[]) {
 
         std::cout << "Running CPU short test...\n";
         TestReport report = tester.short_test();
-        std::cout << "Result: " << (report.result == TestResult::SUCCESS ? "PASS" : "FAIL") << "\n";
-        std::cout << "Details:\n" << report.details << "\n";
+        print_report(report);
         return report.result == TestResult::SUCCESS ? 0 : 1;
 
+    } else if (command == "--cpu-freq-sweep") {
+        return run_cpu_test("frequency sweep", &CPUTester::frequency_sweep_test);
+
+    } else if (command == "--cpu-dvfs-latency") {
+        return run_cpu_test("DVFS latency test", &CPUTester::dvfs_latency_test);
+
+    } else if (command == "--cpu-idle-latency") {
+        return run_cpu_test("idle-state latency test", &CPUTester::idle_latency_test);
+
+    } else if (command == "--cpu-contention") {
+        return run_cpu_test("contention benchmark", &CPUTester::lock_contention_test);
+
+    } else if (command == "--cpu-crypto") {
+        return run_cpu_test("crypto extension benchmark", &CPUTester::crypto_test);
+
+    } else if (command == "--cpu-gemm") {
+        return run_cpu_test("GEMM benchmark", &CPUTester::gemm_test);
+
+    } else if (command == "--cpu-clocks") {
+        return run_cpu_test("clock characterization", &CPUTester::clock_test);
+
+    } else if (command == "--cpu-threads") {
+        return run_cpu_test("thread and synchronization cost benchmark", &CPUTester::thread_cost_test);
+
+    } else if (command == "--cpu-tlb") {
+        return run_cpu_test("TLB and huge-page benchmark", &CPUTester::tlb_test);
+
+    } else if (command == "--cpu-mapping") {
+        return run_cpu_test("page-fault and memory-mapping benchmark", &CPUTester::mapping_test);
+
+    } else if (command == "--cpu-frontend") {
+        return run_cpu_test("branch-predictor and front-end benchmark", &CPUTester::frontend_test);
+    } else if (command == "--cpu-handoff") {
+        return run_cpu_test("producer/consumer handoff benchmark", &CPUTester::handoff_test);
+    } else if (command == "--cpu-litmus") {
+        return run_cpu_test("memory-ordering litmus tests", &CPUTester::litmus_test);
+
+    } else if (command == "--cpu-sdc-screen") {
+        return run_cpu_test("silent data corruption screen", &CPUTester::sdc_screen_test);
+
+    } else if (command == "--cpu-stress" && argc >= 3) {
+        return run_cpu_stress(argc, argv);
+
     } else if (command == "--cpu-monitor" && argc >= 3) {
         try {
             int seconds = std::stoi(argv[2]);
@@ -232,6 +488,8 @@ int main(int argc, char* argv[]) {
             }
 
             CPUTester tester;
+
+            configure_cpu_tester(tester);
             if (!tester.is_available()) {
                 std::cerr << "CPU peripheral is not available on this system.\n";
                 return 1;
@@ -239,14 +497,14 @@ int main(int argc, char* argv[]) {
 
             std::cout << "Running CPU monitoring test for " << seconds << " seconds...\n";
             TestReport report = tester.monitor_test(std::chrono::seconds(seconds));
-            std::cout << "Result: " << (report.result == TestResult::SUCCESS ? "PASS" : "FAIL") << "\n";
-            std::cout << "Details:\n" << report.details << "\n";
+            print_report(report);
             return report.result == TestResult::SUCCESS ? 0 : 1;
         } catch (const std::exception& e) {
             std::cerr << "Error: Invalid duration value.\n";
             return 1;
         }
         GPIOTester tester;
+        configure_gpio_tester(tester);
         if (!tester.is_available()) {
             std::cerr << "GPIO peripheral is not available on this system.\n";
             return 1;
@@ -254,8 +512,7 @@ int main(int argc, char* argv[]) {
 
         std::cout << "Running GPIO short test...\n";
         TestReport report = tester.short_test();
-        std::cout << "Result: " << (report.result == TestResult::SUCCESS ? "PASS" : "FAIL") << "\n";
-        std::cout << "Details:\n" << report.details << "\n";
+        print_report(report);
         return report.result == TestResult::SUCCESS ? 0 : 1;
 
     } else if (command == "--gpio-monitor" && argc >= 3) {
@@ -267,6 +524,7 @@ int main(int argc, char* argv[]) {
             }
 
             GPIOTester tester;
+            configure_gpio_tester(tester);
             if (!tester.is_available()) {
                 std::cerr << "GPIO peripheral is not available on this system.\n";
                 return 1;
@@ -274,8 +532,7 @@ int main(int argc, char* argv[]) {
 
             std::cout << "Running GPIO monitoring test for " << seconds << " seconds...\n";
             TestReport report = tester.monitor_test(std::chrono::seconds(seconds));
-            std::cout << "Result: " << (report.result == TestResult::SUCCESS ? "PASS" : "FAIL") << "\n";
-            std::cout << "Details:\n" << report.details << "\n";
+            print_report(report);
             return report.result == TestResult::SUCCESS ? 0 : 1;
         } catch (const std::exception& e) {
             std::cerr << "Error: Invalid duration value.\n";
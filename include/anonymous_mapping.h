@@ -0,0 +1,88 @@
+/**
+ * @file anonymous_mapping.h
+ * @brief Anonymous memory mapping released on scope exit.
+ * @author Sandesh Ghimire | sandesh@soccentric
+ * @copyright (C) Soccentric LLC. All rights reserved.
+ */
+
+#ifndef ANONYMOUS_MAPPING_H
+#define ANONYMOUS_MAPPING_H
+
+#include <cstddef>
+#include <sys/mman.h>
+
+namespace cm5_peripheral_test {
+
+/**
+ * @class AnonymousMapping
+ * @brief Private read-write anonymous mapping, unmapped by the destructor.
+ *
+ * Used by the benchmarks that need a region outside the heap so they
+ * control its page size and can fault, advise or protect it directly.
+ */
+class AnonymousMapping {
+public:
+    AnonymousMapping() = default;
+
+    ~AnonymousMapping() { unmap(); }
+
+    AnonymousMapping(const AnonymousMapping&) = delete;
+    AnonymousMapping& operator=(const AnonymousMapping&) = delete;
+
+    /**
+     * @brief Maps a new region, releasing any previous one.
+     * @param length Bytes to map.
+     * @param extra_flags Flags added to MAP_PRIVATE | MAP_ANONYMOUS.
+     * @return false if mmap failed; the object is then empty.
+     */
+    bool map(size_t length, int extra_flags = 0) {
+        unmap();
+        void* base = mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | extra_flags, -1, 0);
+        if (base == MAP_FAILED) {
+            return false;
+        }
+        base_ = static_cast<char*>(base);
+        length_ = length;
+        return true;
+    }
+
+    /**
+     * @brief Maps a region and asks the kernel to back it with base pages
+     *        only, so every page costs its own fault and TLB entry.
+     * @param length Bytes to map.
+     * @return false if mmap failed.
+     */
+    bool map_base_pages(size_t length) {
+        if (!map(length)) {
+            return false;
+        }
+        madvise(base_, length_, MADV_NOHUGEPAGE);
+        return true;
+    }
+
+    /**
+     * @brief Returns the start of the region, or nullptr when empty.
+     */
+    char* data() const { return base_; }
+
+    /**
+     * @brief Returns the mapped length in bytes.
+     */
+    size_t size() const { return length_; }
+
+private:
+    void unmap() {
+        if (base_ != nullptr) {
+            munmap(base_, length_);
+            base_ = nullptr;
+            length_ = 0;
+        }
+    }
+
+    char* base_ = nullptr; /**< Start of the region */
+    size_t length_ = 0;    /**< Mapped bytes */
+};
+
+} // namespace cm5_peripheral_test
+
+#endif // ANONYMOUS_MAPPING_H
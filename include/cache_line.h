@@ -0,0 +1,33 @@
+/**
+ * @file cache_line.h
+ * @brief Cache line size and spin-wait hint shared by lock-free code.
+ * @author Sandesh Ghimire | sandesh@soccentric
+ * @copyright (C) Soccentric LLC. All rights reserved.
+ */
+
+#ifndef CACHE_LINE_H
+#define CACHE_LINE_H
+
+#include <cstddef>
+
+namespace cm5_peripheral_test {
+
+/**
+ * @brief Cache line size assumed for padding (Cortex-A76 and x86 hosts).
+ */
+constexpr size_t CACHE_LINE_SIZE = 64;
+
+/**
+ * @brief Spin-wait hint for the current architecture.
+ */
+inline void cpu_relax() {
+#if defined(__aarch64__) || defined(__arm__)
+    asm volatile("yield" ::: "memory");
+#elif defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#endif
+}
+
+} // namespace cm5_peripheral_test
+
+#endif // CACHE_LINE_H
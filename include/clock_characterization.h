@@ -0,0 +1,60 @@
+/**
+ * @file clock_characterization.h
+ * @brief Cost, resolution and monotonicity of the available clocks.
+ * @author Sandesh Ghimire | sandesh@soccentric
+ * @copyright (C) Soccentric LLC. All rights reserved.
+ *
+ * Reads each ClockSource back-to-back on a pinned core to find its cost
+ * per call, the smallest step it can report and whether it ever runs
+ * backwards, then hands timestamps between two cores to check that a
+ * value taken on one core is never ahead of a later read on another.
+ */
+
+#ifndef CLOCK_CHARACTERIZATION_H
+#define CLOCK_CHARACTERIZATION_H
+
+#include "fast_clock.h"
+#include <cstdint>
+
+namespace cm5_peripheral_test {
+
+/**
+ * @struct ClockCharacteristics
+ * @brief Behaviour of one clock source on one core.
+ */
+struct ClockCharacteristics {
+    ClockSource source;                   /**< Source measured */
+    int cpu = -1;                         /**< Core the reads ran on */
+    double cost_ns = 0.0;                 /**< Mean cost of one read */
+    double resolution_ns = 0.0;           /**< Smallest non-zero step observed, 0 if none */
+    double nominal_resolution_ns = 0.0;   /**< clock_getres() or one counter tick */
+    uint64_t backward_steps = 0;          /**< Reads that returned less than the previous read */
+};
+
+/**
+ * @brief Reads @p source @p reads times back-to-back on @p cpu.
+ * @param source Source to characterize.
+ * @param cpu Logical CPU to pin the calling thread to for the run.
+ * @param reads Number of consecutive reads.
+ * @return ClockCharacteristics.
+ */
+ClockCharacteristics characterize_clock(ClockSource source, int cpu, uint64_t reads);
+
+/**
+ * @brief Counts cross-core ordering violations of @p source.
+ *
+ * A writer on @p cpu_a publishes a timestamp; a reader on @p cpu_b reads
+ * its own clock after observing it. Each handoff runs in both
+ * directions, so the result covers skew either way between the cores.
+ *
+ * @param source Source to check.
+ * @param cpu_a First core.
+ * @param cpu_b Second core.
+ * @param handoffs Timestamps passed in each direction.
+ * @return Handoffs where the later read was behind the published value.
+ */
+uint64_t cross_core_clock_inversions(ClockSource source, int cpu_a, int cpu_b, uint64_t handoffs);
+
+} // namespace cm5_peripheral_test
+
+#endif // CLOCK_CHARACTERIZATION_H
@@ -0,0 +1,79 @@
+/**
+ * @file core_partition.h
+ * @brief Housekeeping / measurement core partitioning for benchmarks.
+ * @author Sandesh Ghimire | sandesh@soccentric
+ * @copyright (C) Soccentric LLC. All rights reserved.
+ *
+ * Splits the online CPUs into a housekeeping set, which runs the tool's
+ * own threads (main, samplers, reporting), and a measurement set that
+ * only benchmark workers are pinned to. CPUs the kernel already isolates
+ * (isolcpus= or nohz_full=) become the measurement set; otherwise the
+ * first CPU, which also takes most device interrupts by default, is
+ * reserved for housekeeping and the partition is enforced with thread
+ * affinity.
+ */
+
+#ifndef CORE_PARTITION_H
+#define CORE_PARTITION_H
+
+#include <string>
+#include <vector>
+
+namespace cm5_peripheral_test {
+
+/**
+ * @enum PartitionMode
+ * @brief How the measurement cores were chosen.
+ */
+enum class PartitionMode {
+    SHARED,    /**< Too few CPUs to split; both sets are all CPUs */
+    KERNEL,    /**< Measurement cores isolated by isolcpus= / nohz_full= */
+    AFFINITY   /**< Measurement cores reserved by the tool's own affinity */
+};
+
+/**
+ * @struct CorePartition
+ * @brief Result of partitioning the online CPUs.
+ */
+struct CorePartition {
+    PartitionMode mode = PartitionMode::SHARED;  /**< How the split was made */
+    std::vector<int> housekeeping;               /**< CPUs for the tool's infrastructure threads */
+    std::vector<int> measurement;                /**< CPUs for benchmark workers */
+    std::vector<int> isolated;                   /**< Kernel isolcpus= list */
+    std::vector<int> nohz_full;                  /**< Kernel nohz_full= list */
+
+    /**
+     * @brief Formats the partition for a report.
+     * @return One line naming the mode and both CPU sets.
+     */
+    std::string describe() const;
+};
+
+/**
+ * @brief Partitions @p online given the kernel's isolation lists.
+ * @param online Online CPUs.
+ * @param isolated CPUs from isolcpus=.
+ * @param nohz_full CPUs from nohz_full=.
+ * @return CorePartition; housekeeping and measurement are never empty
+ *         when @p online is not.
+ */
+CorePartition plan_core_partition(const std::vector<int>& online, const std::vector<int>& isolated,
+                                  const std::vector<int>& nohz_full);
+
+/**
+ * @brief Reads the online, isolated and nohz_full lists and partitions them.
+ * @param sysfs_root Root of the CPU sysfs tree (overridable for tests).
+ * @return CorePartition.
+ */
+CorePartition detect_core_partition(const std::string& sysfs_root = "/sys/devices/system/cpu");
+
+/**
+ * @brief Formats a CPU list in kernel notation ("0-3,6").
+ * @param cpus Sorted CPU indices.
+ * @return CPU list string, "none" if empty.
+ */
+std::string format_cpu_list(const std::vector<int>& cpus);
+
+} // namespace cm5_peripheral_test
+
+#endif // CORE_PARTITION_H
@@ -0,0 +1,76 @@
+/**
+ * @file cpu_affinity.h
+ * @brief Thread-to-core pinning helpers for CPU benchmarks.
+ * @author Sandesh Ghimire | sandesh@soccentric
+ * @copyright (C) Soccentric LLC. All rights reserved.
+ *
+ * Benchmarks that read per-core counters or drive a specific cpufreq
+ * policy must run on a known core. These helpers wrap the Linux
+ * scheduler affinity calls for the calling thread.
+ */
+
+#ifndef CPU_AFFINITY_H
+#define CPU_AFFINITY_H
+
+#include <vector>
+
+namespace cm5_peripheral_test {
+
+/**
+ * @brief Pins the calling thread to a single CPU.
+ * @param cpu Logical CPU index.
+ * @return true if the affinity was applied.
+ */
+bool pin_current_thread(int cpu);
+
+/**
+ * @brief Restricts the calling thread to a set of CPUs.
+ * @param cpus Logical CPU indices; threads created afterwards inherit the set.
+ * @return true if the affinity was applied.
+ */
+bool set_current_thread_cpus(const std::vector<int>& cpus);
+
+/**
+ * @brief Returns the logical CPUs the calling thread may run on.
+ * @return Sorted list of CPU indices, empty on error.
+ */
+std::vector<int> current_thread_cpus();
+
+/**
+ * @class ScopedAffinity
+ * @brief Pins the calling thread for the lifetime of the object.
+ *
+ * The previous affinity mask is captured on construction and restored
+ * on destruction, so a benchmark can pin itself without leaking the
+ * restriction into the rest of the tool.
+ */
+class ScopedAffinity {
+public:
+    /**
+     * @brief Pins the calling thread to @p cpu.
+     * @param cpu Logical CPU index.
+     */
+    explicit ScopedAffinity(int cpu);
+
+    /**
+     * @brief Restores the affinity captured on construction.
+     */
+    ~ScopedAffinity();
+
+    ScopedAffinity(const ScopedAffinity&) = delete;
+    ScopedAffinity& operator=(const ScopedAffinity&) = delete;
+
+    /**
+     * @brief Checks whether the pin was applied.
+     * @return true if the thread now runs only on the requested CPU.
+     */
+    bool is_pinned() const { return pinned_; }
+
+private:
+    std::vector<int> previous_cpus_; /**< Affinity before pinning */
+    bool pinned_;                    /**< Pin success flag */
+};
+
+} // namespace cm5_peripheral_test
+
+#endif // CPU_AFFINITY_H
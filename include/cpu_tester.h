@@ -12,6 +12,9 @@
 #define CPU_TESTER_H
 
 #include "peripheral_tester.h"
+#include "core_partition.h"
+#include "cpu_topology.h"
+#include <cstdint>
 #include <vector>
 #include <string>
 
@@ -23,12 +26,52 @@ namespace cm5_peripheral_test {
  */
 struct CPUInfo {
     std::string model_name;
-    int cores;
+    int cores = 0;
     std::string architecture;
-    double frequency_mhz;
-    double temperature_c;
+    double frequency_mhz = 0.0;
+    double temperature_c = -1.0;
+    CpuTopology topology;    /**< Packages, clusters, cores and cache hierarchy */
 };
 
+/**
+ * @struct FrequencyStep
+ * @brief Result of running the sweep kernel at one cpufreq step.
+ */
+struct FrequencyStep {
+    long requested_khz;         /**< Frequency requested from cpufreq */
+    double measured_mhz;        /**< Frequency derived from the cycle counter, 0 if unavailable */
+    double throughput;          /**< Median kernel iterations per second */
+    double throughput_ci;       /**< 95% confidence half-width of the mean, relative */
+    size_t samples;             /**< Samples kept after warm-up */
+    double throughput_per_mhz;  /**< Throughput normalised by requested MHz */
+};
+
+/**
+ * @struct DvfsTransition
+ * @brief Frequency ramp behaviour of one governor on an idle-to-load step.
+ */
+struct DvfsTransition {
+    std::string governor;     /**< Governor under test */
+    double idle_mhz;          /**< Clock after the idle phase */
+    double peak_mhz;          /**< Plateau clock reached under load */
+    double time_to_max_ms;    /**< Load start until 95% of the plateau, -1 if never */
+    double time_to_idle_ms;   /**< Load end until back near the idle clock, -1 if never */
+    bool cycle_counter;       /**< true if ramp-up was sampled from the cycle counter */
+};
+
+/**
+ * @struct WakeupLatency
+ * @brief Timer wakeup latency distribution for one idle configuration.
+ */
+struct WakeupLatency {
+    double median_us;  /**< Median lateness of the wakeup */
+    double p99_us;     /**< 99th percentile lateness */
+    double max_us;     /**< Worst observed lateness */
+};
+
+class CpufreqPolicy;
+struct StressConfig;
+
 /**
  * @class CPUTester
  * @brief Tester implementation for CPU peripherals.
@@ -44,6 +87,24 @@ public:
      */
     CPUTester();
 
+    /**
+     * @brief Switches the tester to isolated-core measurement mode.
+     *
+     * Partitions the online CPUs with detect_core_partition() and
+     * restricts the calling thread (and every infrastructure thread it
+     * starts later, such as samplers) to the housekeeping set. Benchmark
+     * workers are then placed only on measurement cores, and the
+     * partition is recorded in each TestReport's placement field.
+     *
+     * @return true if housekeeping and measurement cores are disjoint.
+     */
+    bool enable_core_isolation();
+
+    /**
+     * @brief Returns the partition applied by enable_core_isolation().
+     */
+    const CorePartition& core_partition() const { return partition_; }
+
     /**
      * @brief Performs short verification test of CPU functionality.
      *
@@ -63,6 +124,7 @@ public:
      * - Temperature stability
      * - Performance consistency
      * - Load distribution across cores
+     * - Per-core interrupt and softirq rates, sampled every 100 ms
      *
      * @param duration Monitoring duration in seconds.
      * @return TestReport with monitoring results.
@@ -81,6 +143,226 @@ public:
      */
     bool is_available() const override;
 
+    /**
+     * @brief Sweeps the cpufreq steps of CPU 0 and measures each one.
+     *
+     * Pins the clock to every entry of scaling_available_frequencies in
+     * turn (userspace governor or min/max clamp), runs a fixed integer
+     * kernel and records throughput, throughput per MHz and the frequency
+     * seen by the cycle counter. The original governor and limits are
+     * restored afterwards. Steps whose measured clock deviates from the
+     * request, or whose throughput does not scale linearly with frequency,
+     * fail the test.
+     *
+     * @return TestReport with one line per step; SKIPPED if the policy
+     *         is not writable by the current user.
+     */
+    TestReport frequency_sweep_test();
+
+    /**
+     * @brief Measures DVFS ramp-up and ramp-down latency per governor.
+     *
+     * For each available governor CPU 0 is left idle, then driven to full
+     * load while its effective clock is sampled from the cycle counter
+     * over short busy windows, then released while scaling_cur_freq is
+     * polled. Reports time-to-max and time-to-idle for each governor and
+     * restores the original policy afterwards.
+     *
+     * @return TestReport with one line per governor; SKIPPED if the policy
+     *         is not writable by the current user.
+     */
+    TestReport dvfs_latency_test();
+
+    /**
+     * @brief Measures the wakeup latency cost of each cpuidle state.
+     *
+     * For each idle state in turn, the states deeper than it are disabled
+     * on the measured core and timer wakeup latency is sampled with
+     * absolute clock_nanosleep deadlines. Reports median/p99/max latency,
+     * the extra median latency compared with the shallowest configuration
+     * and the residency achieved in the deepest allowed state. Original
+     * disable flags are restored afterwards.
+     *
+     * @return TestReport with one line per idle configuration; SKIPPED
+     *         (with only the current configuration) if states cannot be
+     *         disabled by the current user.
+     */
+    TestReport idle_latency_test();
+
+    /**
+     * @brief Measures contention scaling of locks and atomics.
+     *
+     * Sweeps thread counts (powers of two up to one thread per physical
+     * core, each pinned) over std::mutex, a ticket spinlock, an MCS queue
+     * lock, relaxed and seq_cst atomic increments, and per-thread counters
+     * packed into one cache line versus padded onto separate lines.
+     * Reports aggregate throughput and Jain fairness per configuration.
+     *
+     * @return TestReport; FAILURE if any lock or atomic loses updates.
+     */
+    TestReport lock_contention_test();
+
+    /**
+     * @brief Runs the stress generator while monitoring temperature.
+     *
+     * Starts a StressGenerator with @p config (cores default to one per
+     * physical core, the cache-thrash buffer is sized from the discovered
+     * cache hierarchy) and runs monitor_temperature() for @p duration.
+     * Reports the load pattern, work completed per core and the
+     * temperature at start and end.
+     *
+     * @param config Load pattern.
+     * @param duration Stress duration in seconds.
+     * @return TestReport; FAILURE if a loaded core made no progress or the
+     *         temperature varied beyond the monitor limit.
+     */
+    TestReport stress_test(const StressConfig& config, std::chrono::seconds duration);
+
+    /**
+     * @brief Screens every core for silent data corruption.
+     *
+     * Pins each policy to its highest frequency where writable, then runs
+     * the known-answer kernels of run_sdc_screen() on one thread per
+     * physical core. The screen keeps every core at full load, so the
+     * later rounds run hot. Digests are checked against the golden table
+     * and across cores; the original policies are restored afterwards.
+     *
+     * @return TestReport with throughput, per-core rounds and every
+     *         mismatch by core and kernel; FAILURE on any mismatch.
+     */
+    TestReport sdc_screen_test();
+
+    /**
+     * @brief Runs memory-ordering litmus tests across core pairs.
+     *
+     * Runs MP, SB and LB on every pair of physical cores and IRIW on four
+     * cores (wrapping when fewer exist), each with relaxed, acquire/release
+     * and seq_cst accesses. Reports the outcome histogram per shape and
+     * ordering.
+     *
+     * @return TestReport; FAILURE if any forbidden outcome is observed,
+     *         SKIPPED with fewer than two cores.
+     */
+    TestReport litmus_test();
+
+    /**
+     * @brief Benchmarks the AES, PMULL, SHA2 and CRC32 extensions.
+     *
+     * Detects the extensions from the auxiliary vector (or cpuinfo), then
+     * measures AES-128-GCM, SHA-256 and CRC-32C with the portable and the
+     * accelerated implementation on a pinned thread, checking that both
+     * produce identical output. Reports cycles per byte (from the cycle
+     * counter, else estimated from the nominal clock) and the speedup.
+     *
+     * @return TestReport; FAILURE if an aarch64 board lacks an extension,
+     *         an accelerated path disagrees with the portable one, or its
+     *         speedup is below the expected minimum.
+     */
+    TestReport crypto_test();
+
+    /**
+     * @brief Measures SGEMM and DGEMM throughput against theoretical peak.
+     *
+     * Runs the blocked, register-tiled multiply on one core and then on
+     * one thread per physical core. Peak is cores x clock x FLOP/cycle,
+     * using cpuinfo_max_freq or, if unavailable, the clock measured by the
+     * cycle counters during the run.
+     *
+     * @return TestReport with GFLOP/s and percentage of peak per
+     *         configuration; FAILURE if a result fails verification.
+     */
+    TestReport gemm_test();
+
+    /**
+     * @brief Characterizes the clock sources benchmarks can time with.
+     *
+     * Reports the fast counter in use and its frequency, then for each
+     * source and physical core the cost per read, the smallest step it
+     * reports and any backward steps. Timestamps are handed between the
+     * first core and every other core to catch cross-core skew, and the
+     * fast counter's elapsed time is compared with CLOCK_MONOTONIC over
+     * the whole run.
+     *
+     * @return TestReport; FAILURE if a monotonic source steps backwards
+     *         on a core or across cores, or the fast counter drifts from
+     *         CLOCK_MONOTONIC by more than the calibration tolerance.
+     */
+    TestReport clock_test();
+
+    /**
+     * @brief Measures thread creation and blocking synchronization costs.
+     *
+     * Times create/join per thread and, as a token passed around a ring
+     * of pinned threads, the per-hop cost of a condition variable, a raw
+     * futex and an eventfd, plus the cost of a barrier crossing. Each is
+     * run at 2, 4, ... up to one thread per measurement core, and the
+     * spawn cost is expressed in futex handoffs to show where a thread
+     * pool pays off.
+     *
+     * @return TestReport with median, p99 and worst cost per operation;
+     *         FAILURE if a thread missed a round.
+     */
+    TestReport thread_cost_test();
+
+    /**
+     * @brief Measures the effect of huge pages on page-stride access latency.
+     *
+     * Chases one line per base page over working sets from within to
+     * well beyond the TLB reach, backed by base pages, transparent huge
+     * pages and hugetlbfs pages, on the first measurement core. DTLB
+     * misses are counted when perf counters are available. Backings that
+     * cannot be mapped (no reserved hugetlbfs pages, THP disabled) are
+     * reported as such.
+     *
+     * @return TestReport with latency, TLB misses per access and huge
+     *         page coverage per backing and working set.
+     */
+    TestReport tlb_test();
+
+    /**
+     * @brief Measures page-fault and memory-mapping system call costs.
+     *
+     * On the first measurement core: minor faults on anonymous memory,
+     * major faults on an evicted file in /var/tmp, mmap/munmap pairs,
+     * and madvise(MADV_DONTNEED) and mprotect on populated chunks. First
+     * touch of one shared buffer is then repeated with 1, 2, ... up to
+     * one thread per measurement core.
+     *
+     * @return TestReport with latency, rate and faults per operation;
+     *         FAILURE if an anonymous-memory operation cannot be run.
+     */
+    TestReport mapping_test();
+
+    /**
+     * @brief Measures branch prediction, indirect dispatch and
+     *        instruction-footprint costs.
+     *
+     * On the first measurement core: a branch on a periodic versus a
+     * random pattern, the same operations dispatched through a switch,
+     * a function pointer table and a virtual call in a fixed and in a
+     * random target order, and a chain of code
+     * blocks that fits in L1I versus one that does not. Branch misses,
+     * front-end stall cycles and L1I misses come from perf counters
+     * where available.
+     *
+     * @return TestReport with per-iteration time and counters.
+     */
+    TestReport frontend_test();
+
+    /**
+     * @brief Measures sampler-to-consumer handoff throughput.
+     *
+     * Streams items from a producer on the first measurement core to a
+     * consumer on the second (or the same core if there is only one)
+     * through a mutex-guarded queue and through SpscRing, each with
+     * single and batched operations, at the capacity SeriesRecorder
+     * uses, and compares the two queues at the same batch size.
+     *
+     * @return TestReport with items per second and full-queue retries;
+     *         FAILURE if an item was lost, duplicated or reordered.
+     */
+    TestReport handoff_test();
+
 private:
     /**
      * @brief Retrieves CPU information from system files.
@@ -102,10 +384,19 @@ private:
 
     /**
      * @brief Monitors CPU temperature over time.
+     *
+     * Fits a first-order thermal model to the readings and the system
+     * load between them, and predicts the time to the thermal zone's
+     * trip point.
+     *
      * @param duration Monitoring duration.
+     * @param summary Receives the temperature range, fitted model and prediction.
+     * @param series Receives the most recent temperature and load readings.
+     * @param statistics Receives whole-run temperature and load statistics.
      * @return TestResult indicating success or failure.
      */
-    TestResult monitor_temperature(std::chrono::seconds duration);
+    TestResult monitor_temperature(std::chrono::seconds duration, std::string& summary,
+                                   std::vector<TimeSeries>& series, std::vector<StreamingSummary>& statistics);
 
     /**
      * @brief Tests multi-core functionality.
@@ -113,14 +404,44 @@ private:
      */
     TestResult test_multi_core();
 
+    /**
+     * @brief Runs the sweep kernel at the current clock and measures it.
+     * @param requested_khz Frequency the policy was pinned to.
+     * @return FrequencyStep with throughput and measured frequency.
+     */
+    FrequencyStep measure_frequency_step(long requested_khz);
+
+    /**
+     * @brief Runs one idle-load-idle cycle under the active governor.
+     * @param policy Policy of the CPU the calling thread is pinned to.
+     * @return DvfsTransition with ramp timings.
+     */
+    DvfsTransition measure_dvfs_transition(const CpufreqPolicy& policy);
+
+    /**
+     * @brief Samples timer wakeup lateness on the calling thread.
+     * @param histogram Receives the lateness of each wakeup in ns.
+     * @return WakeupLatency distribution summary.
+     */
+    WakeupLatency measure_wakeup_latency(LatencyHistogram& histogram);
+
     /**
      * @brief Gets the current CPU temperature.
      * @return Temperature in Celsius, or -1.0 if not available.
      */
     double get_cpu_temperature();
 
+    /**
+     * @brief CPUs benchmark workers may be placed on.
+     * @return One CPU per physical core, restricted to the measurement
+     *         set in isolated mode.
+     */
+    std::vector<int> measurement_cpus() const;
+
     CPUInfo cpu_info_;
     bool cpu_available_;
+    bool isolated_ = false;      /**< enable_core_isolation() succeeded */
+    CorePartition partition_;    /**< Housekeeping / measurement split */
 };
 
 } // namespace cm5_peripheral_test
@@ -0,0 +1,161 @@
+/**
+ * @file cpu_topology.h
+ * @brief CPU topology and cache hierarchy discovery.
+ * @author Sandesh Ghimire | sandesh@soccentric
+ * @copyright (C) Soccentric LLC. All rights reserved.
+ *
+ * Builds a compact model of the processor from /sys/devices/system/cpu:
+ * one CoreDescriptor per logical CPU (package, cluster, core, SMT
+ * siblings, online state, capacity) and one CacheDescriptor per distinct
+ * cache instance (level, type, geometry and the CPUs sharing it).
+ * Benchmarks use it to size working sets and place threads.
+ */
+
+#ifndef CPU_TOPOLOGY_H
+#define CPU_TOPOLOGY_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace cm5_peripheral_test {
+
+/**
+ * @brief Parses a kernel CPU list such as "0-3,6,8-9".
+ * @param list CPU list string.
+ * @return Sorted CPU indices; empty for an empty or malformed list.
+ */
+std::vector<int> parse_cpu_list(const std::string& list);
+
+/**
+ * @enum CacheType
+ * @brief Kind of data a cache holds.
+ */
+enum class CacheType : uint8_t {
+    DATA,
+    INSTRUCTION,
+    UNIFIED
+};
+
+/**
+ * @struct CoreDescriptor
+ * @brief Placement of one logical CPU. Fields are -1 when not exposed.
+ */
+struct CoreDescriptor {
+    int16_t cpu;             /**< Logical CPU index */
+    int16_t package_id;      /**< physical_package_id */
+    int16_t cluster_id;      /**< cluster_id */
+    int16_t core_id;         /**< core_id within the package */
+    int16_t capacity;        /**< cpu_capacity (1024 = biggest core) */
+    bool online;             /**< CPU is online */
+    uint64_t smt_siblings;   /**< Bit mask of hardware threads on the same core */
+};
+
+/**
+ * @struct CacheDescriptor
+ * @brief Geometry of one cache instance.
+ */
+struct CacheDescriptor {
+    uint8_t level;           /**< 1 = L1, 2 = L2, ... */
+    CacheType type;          /**< Data, instruction or unified */
+    uint16_t line_size;      /**< coherency_line_size in bytes */
+    uint16_t ways;           /**< ways_of_associativity (0 = fully associative/unknown) */
+    uint32_t sets;           /**< number_of_sets */
+    uint64_t size_bytes;     /**< Total capacity */
+    uint64_t shared_cpus;    /**< Bit mask of CPUs sharing this instance */
+};
+
+/**
+ * @class CpuTopology
+ * @brief Discovered topology and cache hierarchy.
+ *
+ * CPU masks are 64 bits wide, which covers every Raspberry Pi and the
+ * development hosts the tool is built on; CPUs beyond 63 are ignored.
+ */
+class CpuTopology {
+public:
+    /**
+     * @brief Creates an empty topology (nothing discovered).
+     */
+    CpuTopology() = default;
+
+    /**
+     * @brief Discovers the topology from sysfs.
+     * @param sysfs_root Root of the CPU sysfs tree, normally /sys/devices/system/cpu.
+     */
+    explicit CpuTopology(const std::string& sysfs_root);
+
+    /**
+     * @brief Returns one descriptor per possible logical CPU.
+     * @return Descriptors ordered by CPU index.
+     */
+    const std::vector<CoreDescriptor>& cores() const { return cores_; }
+
+    /**
+     * @brief Returns one descriptor per distinct cache instance.
+     * @return Descriptors ordered by level, then by first sharing CPU.
+     */
+    const std::vector<CacheDescriptor>& caches() const { return caches_; }
+
+    /**
+     * @brief Counts distinct packages.
+     * @return Number of packages among online CPUs.
+     */
+    int package_count() const;
+
+    /**
+     * @brief Counts distinct clusters.
+     * @return Number of (package, cluster) pairs among online CPUs.
+     */
+    int cluster_count() const;
+
+    /**
+     * @brief Counts physical cores, folding SMT siblings together.
+     * @return Number of online physical cores.
+     */
+    int physical_core_count() const;
+
+    /**
+     * @brief Counts online logical CPUs.
+     * @return Number of online CPUs.
+     */
+    int online_count() const;
+
+    /**
+     * @brief Returns one online CPU per physical core.
+     *
+     * Lets benchmarks place one thread per core without SMT siblings
+     * competing for the same pipeline.
+     *
+     * @return CPU indices, lowest sibling of each core.
+     */
+    std::vector<int> one_cpu_per_core() const;
+
+    /**
+     * @brief Returns the data (or unified) cache seen by a CPU at a level.
+     * @param level Cache level.
+     * @param cpu Logical CPU index.
+     * @return Pointer into caches(), or nullptr if unknown.
+     */
+    const CacheDescriptor* data_cache(int level, int cpu = 0) const;
+
+    /**
+     * @brief Returns the coherency line size of the L1 data cache.
+     * @return Line size in bytes, 64 if unknown.
+     */
+    int line_size() const;
+
+    /**
+     * @brief Formats a human-readable summary.
+     * @return Multi-line description of topology and caches.
+     */
+    std::string describe() const;
+
+private:
+    std::vector<CoreDescriptor> cores_;   /**< Per-CPU placement */
+    std::vector<CacheDescriptor> caches_; /**< Distinct cache instances */
+};
+
+} // namespace cm5_peripheral_test
+
+#endif // CPU_TOPOLOGY_H
@@ -0,0 +1,158 @@
+/**
+ * @file cpufreq_policy.h
+ * @brief Access to the Linux cpufreq policy of a CPU.
+ * @author Sandesh Ghimire | sandesh@soccentric
+ * @copyright (C) Soccentric LLC. All rights reserved.
+ *
+ * Reads and, when permitted, modifies the cpufreq sysfs attributes of a
+ * single CPU (governor, scaling limits and userspace set-speed). Settings
+ * can be captured and restored so that benchmarks which pin the clock
+ * leave the policy exactly as they found it.
+ */
+
+#ifndef CPUFREQ_POLICY_H
+#define CPUFREQ_POLICY_H
+
+#include <string>
+#include <vector>
+
+namespace cm5_peripheral_test {
+
+/**
+ * @struct CpufreqSettings
+ * @brief Snapshot of the writable parts of a cpufreq policy.
+ */
+struct CpufreqSettings {
+    std::string governor;  /**< scaling_governor */
+    long min_khz = 0;      /**< scaling_min_freq */
+    long max_khz = 0;      /**< scaling_max_freq */
+    long setspeed_khz = 0; /**< scaling_setspeed under the userspace governor, else 0 */
+};
+
+/**
+ * @class CpufreqPolicy
+ * @brief Reader/writer for /sys/devices/system/cpu/cpuN/cpufreq.
+ */
+class CpufreqPolicy {
+public:
+    /**
+     * @brief Creates a policy accessor for one CPU.
+     * @param cpu Logical CPU index.
+     * @param sysfs_root Root of the CPU sysfs tree (overridable for tests).
+     */
+    explicit CpufreqPolicy(int cpu, std::string sysfs_root = "/sys/devices/system/cpu");
+
+    /**
+     * @brief Checks whether the CPU exposes a cpufreq policy.
+     * @return true if the cpufreq directory exists.
+     */
+    bool is_available() const;
+
+    /**
+     * @brief Checks whether the policy limits can be written.
+     * @return true if scaling_min_freq and scaling_max_freq are writable.
+     */
+    bool is_writable() const;
+
+    /**
+     * @brief Returns the CPU this policy belongs to.
+     * @return Logical CPU index.
+     */
+    int cpu() const { return cpu_; }
+
+    /**
+     * @brief Lists the discrete frequencies the driver supports.
+     *
+     * Falls back to {cpuinfo_min_freq, cpuinfo_max_freq} when the driver
+     * does not publish scaling_available_frequencies.
+     *
+     * @return Frequencies in kHz, sorted ascending.
+     */
+    std::vector<long> available_frequencies_khz() const;
+
+    /**
+     * @brief Lists the governors the kernel offers for this policy.
+     * @return Governor names.
+     */
+    std::vector<std::string> available_governors() const;
+
+    /**
+     * @brief Returns the active governor.
+     * @return Governor name, empty if unavailable.
+     */
+    std::string governor() const;
+
+    /**
+     * @brief Returns the frequency the kernel last requested.
+     * @return scaling_cur_freq in kHz, or 0 if unavailable.
+     */
+    long current_khz() const;
+
+    /**
+     * @brief Returns the hardware maximum frequency.
+     * @return cpuinfo_max_freq in kHz, or 0 if unavailable.
+     */
+    long hardware_max_khz() const;
+
+    /**
+     * @brief Returns the hardware minimum frequency.
+     * @return cpuinfo_min_freq in kHz, or 0 if unavailable.
+     */
+    long hardware_min_khz() const;
+
+    /**
+     * @brief Captures the current writable settings, including the fixed
+     *        frequency when the userspace governor is active.
+     * @return Snapshot suitable for restore().
+     */
+    CpufreqSettings snapshot() const;
+
+    /**
+     * @brief Restores settings captured by snapshot().
+     * @param settings Previously captured settings.
+     * @return true if every attribute was written back.
+     */
+    bool restore(const CpufreqSettings& settings);
+
+    /**
+     * @brief Switches the scaling governor.
+     * @param governor Governor name.
+     * @return true if the write succeeded.
+     */
+    bool set_governor(const std::string& governor);
+
+    /**
+     * @brief Clamps the policy to a [min, max] range.
+     *
+     * Writes are ordered so the range never becomes empty in between.
+     *
+     * @param min_khz Lower bound in kHz.
+     * @param max_khz Upper bound in kHz.
+     * @return true if both limits were written.
+     */
+    bool set_limits(long min_khz, long max_khz);
+
+    /**
+     * @brief Forces the CPU to run at a fixed frequency.
+     *
+     * Uses the userspace governor's scaling_setspeed when available and
+     * otherwise clamps scaling_min_freq = scaling_max_freq.
+     *
+     * @param khz Target frequency in kHz.
+     * @return true if the frequency was requested successfully.
+     */
+    bool pin_frequency(long khz);
+
+private:
+    std::string attribute_path(const std::string& name) const;
+    std::string read_attribute(const std::string& name) const;
+    long read_khz(const std::string& name) const;
+    bool write_attribute(const std::string& name, const std::string& value);
+
+    int cpu_;                /**< Logical CPU index */
+    std::string policy_dir_; /**< .../cpuN/cpufreq */
+};
+
+} // namespace cm5_peripheral_test
+
+#endif // CPUFREQ_POLICY_H
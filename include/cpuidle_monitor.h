@@ -0,0 +1,138 @@
+/**
+ * @file cpuidle_monitor.h
+ * @brief Per-core idle-state residency sampling via Linux cpuidle sysfs.
+ * @author Sandesh Ghimire | sandesh@soccentric
+ * @copyright (C) Soccentric LLC. All rights reserved.
+ *
+ * Reads /sys/devices/system/cpu/cpuN/cpuidle/stateM/{usage,time} for
+ * every core and computes deltas between samples, giving the share of
+ * wall time each core spent in each idle state. Individual states can
+ * be disabled (root only) to measure their wakeup latency cost.
+ */
+
+#ifndef CPUIDLE_MONITOR_H
+#define CPUIDLE_MONITOR_H
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace cm5_peripheral_test {
+
+/**
+ * @struct IdleStateInfo
+ * @brief Static description of one cpuidle state.
+ */
+struct IdleStateInfo {
+    int index;                  /**< State number (stateN) */
+    std::string name;           /**< Driver-provided name, e.g. "WFI" */
+    long exit_latency_us;       /**< Advertised worst-case exit latency */
+    long target_residency_us;   /**< Minimum residency for the state to pay off */
+};
+
+/**
+ * @struct IdleStateDelta
+ * @brief Activity of one idle state on one core between two samples.
+ */
+struct IdleStateDelta {
+    uint64_t entries = 0;   /**< Number of times the state was entered */
+    uint64_t time_us = 0;   /**< Time spent in the state */
+    double residency = 0.0; /**< time_us as a fraction of the sample interval */
+    bool valid = false;     /**< Counters were readable at both samples and did not go
+                                 backwards (e.g. the core went offline); otherwise all zero */
+};
+
+/**
+ * @class CpuidleMonitor
+ * @brief Samples cpuidle counters for all cores.
+ *
+ * Call start() to capture a baseline, then sample() any number of times;
+ * each sample() returns the deltas since the previous call.
+ */
+class CpuidleMonitor {
+public:
+    /**
+     * @brief Discovers cores and idle states.
+     * @param sysfs_root Root of the CPU sysfs tree (overridable for tests).
+     */
+    explicit CpuidleMonitor(std::string sysfs_root = "/sys/devices/system/cpu");
+
+    /**
+     * @brief Checks whether any core exposes cpuidle states.
+     * @return true if at least one state was discovered.
+     */
+    bool is_available() const { return !cpus_.empty() && !states_.empty(); }
+
+    /**
+     * @brief Returns the cores that expose cpuidle states.
+     * @return Logical CPU indices.
+     */
+    const std::vector<int>& cpus() const { return cpus_; }
+
+    /**
+     * @brief Returns the idle states (taken from the first core).
+     * @return State descriptors ordered shallow to deep.
+     */
+    const std::vector<IdleStateInfo>& states() const { return states_; }
+
+    /**
+     * @brief Captures the baseline counters.
+     */
+    void start();
+
+    /**
+     * @brief Reads counters and returns deltas since the previous sample.
+     *
+     * A state whose counters could not be read at either sample, or went
+     * backwards in between, is returned with valid = false and zeros.
+     *
+     * @return deltas[core_position][state_index], core order as cpus().
+     */
+    std::vector<std::vector<IdleStateDelta>> sample();
+
+    /**
+     * @brief Formats a residency table for a set of deltas.
+     * @param deltas Result of sample().
+     * @return One line per core with residency percentage per state, "-"
+     *         where the delta is not valid.
+     */
+    std::string format_residency(const std::vector<std::vector<IdleStateDelta>>& deltas) const;
+
+    /**
+     * @brief Reads whether a state is disabled on a core.
+     * @param cpu Logical CPU index.
+     * @param state State index.
+     * @return true if the state is disabled.
+     */
+    bool is_state_disabled(int cpu, int state) const;
+
+    /**
+     * @brief Enables or disables a state on a core (requires root).
+     * @param cpu Logical CPU index.
+     * @param state State index.
+     * @param disabled true to forbid the state.
+     * @return true if the write succeeded.
+     */
+    bool set_state_disabled(int cpu, int state, bool disabled);
+
+private:
+    struct Counters {
+        uint64_t usage = 0;
+        uint64_t time_us = 0;
+        bool readable = false;
+    };
+
+    std::string state_path(int cpu, int state, const std::string& attribute) const;
+    std::vector<std::vector<Counters>> read_counters() const;
+
+    std::string sysfs_root_;                          /**< CPU sysfs root */
+    std::vector<int> cpus_;                           /**< Cores with cpuidle */
+    std::vector<IdleStateInfo> states_;               /**< States of the first core */
+    std::vector<std::vector<Counters>> previous_;     /**< Counters at the last sample */
+    std::chrono::steady_clock::time_point previous_time_; /**< Time of the last sample */
+};
+
+} // namespace cm5_peripheral_test
+
+#endif // CPUIDLE_MONITOR_H
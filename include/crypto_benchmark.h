@@ -0,0 +1,196 @@
+/**
+ * @file crypto_benchmark.h
+ * @brief Crypto extension detection and throughput benchmarks.
+ * @author Sandesh Ghimire | sandesh@soccentric
+ * @copyright (C) Soccentric LLC. All rights reserved.
+ *
+ * Provides AES-128-GCM encryption, SHA-256 and CRC-32C in two forms: a
+ * portable C implementation and one built on the CPU's crypto
+ * instructions (ARMv8 AES/PMULL/SHA2/CRC32, or AES-NI/PCLMULQDQ/SSE4.2
+ * on x86 development hosts). The accelerated form is only used when the
+ * running CPU reports the extension, so both can be benchmarked and
+ * cross-checked on any machine.
+ */
+
+#ifndef CRYPTO_BENCHMARK_H
+#define CRYPTO_BENCHMARK_H
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace cm5_peripheral_test {
+
+/**
+ * @struct CryptoFeatures
+ * @brief Crypto-related CPU extensions reported by the kernel.
+ */
+struct CryptoFeatures {
+    bool aes = false;    /**< AES rounds (aes / aes) */
+    bool pmull = false;  /**< 64-bit carry-less multiply (pmull / pclmulqdq) */
+    bool sha2 = false;   /**< SHA-256 rounds (sha2 / sha_ni) */
+    bool crc32 = false;  /**< CRC-32/CRC-32C instructions (crc32 / sse4_2) */
+};
+
+/**
+ * @enum CryptoAlgorithm
+ * @brief Benchmarked algorithms.
+ */
+enum class CryptoAlgorithm {
+    AES_GCM,  /**< AES-128 in GCM mode (CTR encryption + GHASH) */
+    SHA256,   /**< SHA-256 */
+    CRC32C    /**< CRC-32C, as used by ext4/btrfs metadata checksums */
+};
+
+/**
+ * @enum CryptoImpl
+ * @brief Implementation to run.
+ */
+enum class CryptoImpl {
+    PORTABLE,     /**< Plain C++ */
+    ACCELERATED   /**< CPU instructions; falls back to PORTABLE if unavailable */
+};
+
+/**
+ * @brief Parses a cpuinfo "Features" (ARM) or "flags" (x86) value.
+ * @param flags Space-separated feature names.
+ * @return Detected extensions.
+ */
+CryptoFeatures parse_crypto_features(const std::string& flags);
+
+/**
+ * @brief Detects the extensions of the running CPU.
+ *
+ * Uses getauxval(AT_HWCAP) on aarch64 Linux and the first Features/flags
+ * line of @p cpuinfo_path elsewhere.
+ *
+ * @param cpuinfo_path Path of cpuinfo, normally /proc/cpuinfo.
+ * @return Detected extensions.
+ */
+CryptoFeatures detect_crypto_features(const std::string& cpuinfo_path = "/proc/cpuinfo");
+
+/**
+ * @brief Checks whether ACCELERATED really uses CPU instructions.
+ * @param algorithm Algorithm.
+ * @param features Extensions of the running CPU.
+ * @return true if this build has an accelerated path and the CPU supports it.
+ */
+bool crypto_accelerated(CryptoAlgorithm algorithm, const CryptoFeatures& features);
+
+/**
+ * @brief Returns a display name for an algorithm.
+ * @param algorithm Algorithm to name.
+ * @return Static string.
+ */
+const char* crypto_algorithm_name(CryptoAlgorithm algorithm);
+
+/** AES-128 expanded key: 11 round keys of 16 bytes. */
+constexpr size_t AES128_SCHEDULE_BYTES = 176;
+
+/**
+ * @brief Expands an AES-128 key into its round keys.
+ * @param key 16-byte key.
+ * @param round_keys Receives AES128_SCHEDULE_BYTES bytes.
+ */
+void aes128_expand_key(const uint8_t* key, uint8_t* round_keys);
+
+/**
+ * @brief Encrypts one 16-byte block with an expanded AES-128 key.
+ *
+ * ACCELERATED uses the AES round instructions when the AES-GCM path is
+ * accelerated (see crypto_accelerated()).
+ *
+ * @param impl Implementation to use.
+ * @param round_keys Output of aes128_expand_key().
+ * @param in Plaintext block.
+ * @param out Receives the ciphertext block; may equal @p in.
+ */
+void aes128_encrypt_block(CryptoImpl impl, const uint8_t* round_keys, const uint8_t* in, uint8_t* out);
+
+/**
+ * @brief Multiplies two 64-bit polynomials over GF(2).
+ *
+ * ACCELERATED uses PMULL/PCLMULQDQ under the same condition as
+ * aes128_encrypt_block().
+ *
+ * @param impl Implementation to use.
+ * @param a First factor.
+ * @param b Second factor.
+ * @param lo Receives bits 0..63 of the product.
+ * @param hi Receives bits 64..127 of the product.
+ */
+void clmul64(CryptoImpl impl, uint64_t a, uint64_t b, uint64_t& lo, uint64_t& hi);
+
+/**
+ * @brief Encrypts with AES-128-GCM (96-bit IV, no additional data).
+ * @param impl Implementation to use.
+ * @param key 16-byte key.
+ * @param iv 12-byte IV.
+ * @param in Plaintext.
+ * @param length Plaintext length in bytes.
+ * @param out Receives @p length bytes of ciphertext.
+ * @param tag Receives the 16-byte authentication tag.
+ */
+void aes128_gcm_encrypt(CryptoImpl impl, const uint8_t* key, const uint8_t* iv, const uint8_t* in, size_t length,
+                        uint8_t* out, uint8_t* tag);
+
+/**
+ * @brief Computes a SHA-256 digest.
+ * @param impl Implementation to use.
+ * @param data Input.
+ * @param length Input length in bytes.
+ * @param digest Receives 32 bytes.
+ */
+void sha256_digest(CryptoImpl impl, const uint8_t* data, size_t length, uint8_t* digest);
+
+/**
+ * @brief Computes CRC-32C (Castagnoli, reflected, init/xorout 0xFFFFFFFF).
+ * @param impl Implementation to use.
+ * @param data Input.
+ * @param length Input length in bytes.
+ * @return Checksum.
+ */
+uint32_t crc32c(CryptoImpl impl, const uint8_t* data, size_t length);
+
+/**
+ * @brief Continues a raw CRC-32C over more data, without the initial
+ *        value or final xor, so a checksum can be built up in pieces.
+ * @param impl Implementation to use.
+ * @param crc Running CRC register.
+ * @param data Input.
+ * @param length Input length in bytes.
+ * @return Updated CRC register.
+ */
+uint32_t crc32c_update(CryptoImpl impl, uint32_t crc, const uint8_t* data, size_t length);
+
+/**
+ * @brief Checks that both implementations agree on a pseudo-random buffer.
+ * @param algorithm Algorithm to check.
+ * @return true if outputs are identical.
+ */
+bool crypto_implementations_agree(CryptoAlgorithm algorithm);
+
+/**
+ * @struct CryptoThroughput
+ * @brief Throughput of one algorithm and implementation.
+ */
+struct CryptoThroughput {
+    CryptoAlgorithm algorithm;        /**< Algorithm measured */
+    CryptoImpl impl;                  /**< Implementation measured */
+    double bytes_per_second = 0.0;    /**< Sustained throughput */
+    double cycles_per_byte = -1.0;    /**< From the cycle counter, -1 if unavailable */
+};
+
+/**
+ * @brief Repeatedly processes a 16 KiB buffer on the calling thread.
+ * @param algorithm Algorithm to run.
+ * @param impl Implementation to run.
+ * @param duration Minimum measurement time.
+ * @return CryptoThroughput.
+ */
+CryptoThroughput benchmark_crypto(CryptoAlgorithm algorithm, CryptoImpl impl, std::chrono::milliseconds duration);
+
+} // namespace cm5_peripheral_test
+
+#endif // CRYPTO_BENCHMARK_H
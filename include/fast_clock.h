@@ -0,0 +1,159 @@
+/**
+ * @file fast_clock.h
+ * @brief Low-overhead calibrated timestamp source.
+ * @author Sandesh Ghimire | sandesh@soccentric
+ * @copyright (C) Soccentric LLC. All rights reserved.
+ *
+ * Reads the ARM generic timer's virtual counter (CNTVCT_EL0) on aarch64,
+ * or the invariant TSC on x86 development hosts, without entering the
+ * kernel or the vDSO. Counter ticks are converted to nanoseconds on the
+ * CLOCK_MONOTONIC timeline using a frequency taken from CNTFRQ_EL0 or
+ * calibrated against CLOCK_MONOTONIC at first use. Hosts without a
+ * usable counter fall back to clock_gettime(CLOCK_MONOTONIC).
+ */
+
+#ifndef FAST_CLOCK_H
+#define FAST_CLOCK_H
+
+#include <cstdint>
+#include <time.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+namespace cm5_peripheral_test {
+
+/**
+ * @enum ClockSource
+ * @brief Timestamp sources the tool can read.
+ */
+enum class ClockSource {
+    FAST_COUNTER,      /**< FastClock (CNTVCT_EL0 / TSC) */
+    STEADY_CLOCK,      /**< std::chrono::steady_clock */
+    SYSTEM_CLOCK,      /**< std::chrono::system_clock (may step) */
+    MONOTONIC_RAW,     /**< CLOCK_MONOTONIC_RAW, not NTP-slewed */
+    MONOTONIC_COARSE   /**< CLOCK_MONOTONIC_COARSE, tick-granular */
+};
+
+/** Number of ClockSource values. */
+constexpr int CLOCK_SOURCE_COUNT = 5;
+
+/**
+ * @brief Returns a display name for a clock source.
+ * @param source Source to name.
+ * @return Static string.
+ */
+const char* clock_source_name(ClockSource source);
+
+/**
+ * @brief Reads @p source once.
+ * @param source Source to read.
+ * @return Nanoseconds since the source's epoch.
+ */
+uint64_t read_clock_ns(ClockSource source);
+
+/**
+ * @brief Reads CLOCK_MONOTONIC in nanoseconds.
+ */
+inline uint64_t monotonic_ns() {
+    timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return static_cast<uint64_t>(ts.tv_sec) * 1000000000ULL + static_cast<uint64_t>(ts.tv_nsec);
+}
+
+/**
+ * @class FastClock
+ * @brief Process-wide calibrated counter, created on first use.
+ *
+ * ticks() is the raw counter and costs a handful of cycles; convert
+ * differences with ticks_to_ns() or absolute values with to_ns(). The
+ * counter reads are ordered (ISB / LFENCE) so they do not drift into
+ * the code being timed.
+ */
+class FastClock {
+public:
+    /**
+     * @brief Returns the calibrated clock, calibrating on first call.
+     */
+    static const FastClock& instance();
+
+    /**
+     * @brief Reads the raw counter.
+     * @return Counter ticks, or CLOCK_MONOTONIC ns on the fallback path.
+     */
+    uint64_t ticks() const {
+        if (!hardware_) {
+            return monotonic_ns();
+        }
+        return read_counter();
+    }
+
+    /**
+     * @brief Converts a tick interval to nanoseconds.
+     */
+    double ticks_to_ns(uint64_t ticks) const { return static_cast<double>(ticks) * ns_per_tick_; }
+
+    /**
+     * @brief Converts a nanosecond interval to ticks.
+     */
+    uint64_t ns_to_ticks(double ns) const { return static_cast<uint64_t>(ns / ns_per_tick_); }
+
+    /**
+     * @brief Converts an absolute tick value to CLOCK_MONOTONIC nanoseconds.
+     */
+    uint64_t to_ns(uint64_t ticks) const {
+        return base_ns_ + static_cast<uint64_t>(static_cast<double>(static_cast<int64_t>(ticks - base_ticks_)) *
+                                                ns_per_tick_);
+    }
+
+    /**
+     * @brief Reads the clock in CLOCK_MONOTONIC nanoseconds.
+     */
+    uint64_t now_ns() const { return to_ns(ticks()); }
+
+    /**
+     * @brief Checks whether a hardware counter is in use.
+     * @return false on the clock_gettime fallback.
+     */
+    bool is_hardware() const { return hardware_; }
+
+    /**
+     * @brief Returns the counter frequency in Hz.
+     */
+    double frequency_hz() const { return 1e9 / ns_per_tick_; }
+
+    /**
+     * @brief Returns the name of the counter in use.
+     * @return "CNTVCT_EL0", "TSC" or "CLOCK_MONOTONIC".
+     */
+    const char* counter_name() const;
+
+    /**
+     * @brief Reads the hardware counter directly.
+     */
+    static uint64_t read_counter() {
+#if defined(__aarch64__)
+        uint64_t value;
+        asm volatile("isb\n\tmrs %0, cntvct_el0" : "=r"(value) : : "memory");
+        return value;
+#elif defined(__x86_64__) || defined(__i386__)
+        _mm_lfence();
+        return __rdtsc();
+#else
+        return monotonic_ns();
+#endif
+    }
+
+private:
+    FastClock();
+
+    bool hardware_ = false;      /**< Counter usable (arch timer, or invariant TSC) */
+    double ns_per_tick_ = 1.0;   /**< Conversion factor */
+    uint64_t base_ticks_ = 0;    /**< Counter value at the reference point */
+    uint64_t base_ns_ = 0;       /**< CLOCK_MONOTONIC at the reference point */
+};
+
+} // namespace cm5_peripheral_test
+
+#endif // FAST_CLOCK_H
@@ -0,0 +1,88 @@
+/**
+ * @file frontend_benchmark.h
+ * @brief Branch predictor, indirect dispatch and instruction footprint microbenchmarks.
+ * @author Sandesh Ghimire | sandesh@soccentric
+ * @copyright (C) Soccentric LLC. All rights reserved.
+ *
+ * Small kernels that isolate the front end of the core:
+ *
+ * - a conditional branch on a periodic pattern versus on random data,
+ * - the same eight operations dispatched through a switch, a function
+ *   pointer table and a virtual call on an interface (the shape of the
+ *   PeripheralTester hierarchy), once cycling through the targets in a
+ *   fixed order the indirect predictor learns and once in a random
+ *   order it cannot,
+ * - a chain of template-generated code blocks that fits in the L1
+ *   instruction cache versus one several times larger.
+ *
+ * Each kernel reports time and, where perf counters are available,
+ * cycles, branch misses, front-end stall cycles and L1I misses per
+ * iteration.
+ */
+
+#ifndef FRONTEND_BENCHMARK_H
+#define FRONTEND_BENCHMARK_H
+
+#include <cstddef>
+#include <cstdint>
+
+namespace cm5_peripheral_test {
+
+/**
+ * @enum FrontendKernel
+ * @brief Kernels covered by the front-end benchmark.
+ */
+enum class FrontendKernel {
+    PREDICTABLE_BRANCH,       /**< Branch taken on a period-4 pattern */
+    RANDOM_BRANCH,            /**< Branch taken on random data */
+    SWITCH_DISPATCH,          /**< switch over eight inlined operations */
+    FUNCTION_POINTER,         /**< Call through a table of eight function pointers */
+    VIRTUAL_CALL,             /**< Virtual call through eight implementations of an interface */
+    RANDOM_SWITCH,            /**< SWITCH_DISPATCH with targets in random order */
+    RANDOM_FUNCTION_POINTER,  /**< FUNCTION_POINTER with targets in random order */
+    RANDOM_VIRTUAL_CALL,      /**< VIRTUAL_CALL with targets in random order */
+    SMALL_FOOTPRINT,          /**< Code blocks that fit in the L1 instruction cache */
+    LARGE_FOOTPRINT           /**< Code blocks several times the L1 instruction cache */
+};
+
+/** Number of FrontendKernel values. */
+constexpr int FRONTEND_KERNEL_COUNT = 10;
+
+/**
+ * @brief Returns a short display name for a kernel.
+ * @param kernel Kernel to name.
+ * @return Static string.
+ */
+const char* frontend_kernel_name(FrontendKernel kernel);
+
+/**
+ * @struct FrontendResult
+ * @brief Outcome of one kernel.
+ *
+ * An iteration is one branch, one dispatched call or one code block.
+ * Counter-derived fields are -1 when the counter is unavailable.
+ */
+struct FrontendResult {
+    FrontendKernel kernel;              /**< Kernel measured */
+    uint64_t iterations = 0;            /**< Iterations timed */
+    size_t code_bytes = 0;              /**< Span of the generated blocks (footprint kernels) */
+    double ns_per_iteration = 0.0;      /**< Wall time per iteration */
+    double cycles_per_iteration = -1.0; /**< Core cycles per iteration */
+    double branch_misses = -1.0;        /**< Mispredicted branches per iteration */
+    double frontend_stalls = -1.0;      /**< Front-end stall cycles per iteration */
+    double icache_misses = -1.0;        /**< L1I misses per iteration */
+    uint64_t checksum = 0;              /**< Kernel result, keeps the work observable */
+};
+
+/**
+ * @brief Runs one kernel on the calling thread.
+ * @param kernel Kernel to run.
+ * @param iterations Approximate iterations; footprint kernels round to
+ *        whole passes over their blocks.
+ * @return FrontendResult.
+ */
+FrontendResult run_frontend_benchmark(FrontendKernel kernel, uint64_t iterations);
+
+} // namespace cm5_peripheral_test
+
+#endif // FRONTEND_BENCHMARK_H
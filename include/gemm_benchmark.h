@@ -0,0 +1,197 @@
+/**
+ * @file gemm_benchmark.h
+ * @brief Cache-blocked, register-tiled matrix multiply benchmark.
+ * @author Sandesh Ghimire | sandesh@soccentric
+ * @copyright (C) Soccentric LLC. All rights reserved.
+ *
+ * Follows the usual GotoBLAS/BLIS structure: B is packed into KC x NC
+ * blocks that stay in the last-level cache, A into MC x KC blocks that
+ * stay in L2, and an MR x NR micro-kernel keeps its accumulators in
+ * registers while streaming both packed panels from L1. Tile and block
+ * sizes are template parameters; GemmTile selects defaults for the
+ * target at compile time.
+ */
+
+#ifndef GEMM_BENCHMARK_H
+#define GEMM_BENCHMARK_H
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <vector>
+
+namespace cm5_peripheral_test {
+
+/**
+ * @struct GemmTile
+ * @brief Default register tile and cache blocking for element type @p T.
+ *
+ * Sized so the MR x NR accumulators use about three quarters of the
+ * vector register file: 32 x 128-bit on AArch64, 16 x 128-bit for the
+ * baseline x86-64 ISA the tool is built with.
+ */
+template <typename T>
+struct GemmTile {
+#if defined(__aarch64__)
+    static constexpr int MR = 8;
+    static constexpr int NR = 48 / sizeof(T);  /**< 12 floats / 6 doubles */
+#elif defined(__x86_64__)
+    static constexpr int MR = 4;
+    static constexpr int NR = 32 / sizeof(T);  /**< 8 floats / 4 doubles */
+#else
+    static constexpr int MR = 4;
+    static constexpr int NR = 4;
+#endif
+    static constexpr int MC = 128;   /**< Rows of A per L2 block */
+    static constexpr int KC = 256;   /**< Depth of each packed panel */
+    static constexpr int NC = 1024;  /**< Columns of B per LLC block */
+};
+
+/**
+ * @brief Computes an MR x NR tile of C += A * B from packed panels.
+ *
+ * @param kc Panel depth.
+ * @param a Packed A panel, MR values per step.
+ * @param b Packed B panel, NR values per step.
+ * @param c Top-left element of the C tile.
+ * @param ldc Row stride of C.
+ * @param mr Valid rows (<= MR) at the matrix edge.
+ * @param nr Valid columns (<= NR) at the matrix edge.
+ */
+template <typename T, int MR, int NR>
+inline void gemm_micro_kernel(int kc, const T* a, const T* b, T* c, int ldc, int mr, int nr) {
+    T acc[MR][NR] = {};
+    for (int p = 0; p < kc; ++p) {
+        for (int i = 0; i < MR; ++i) {
+            T ai = a[p * MR + i];
+            for (int j = 0; j < NR; ++j) {
+                acc[i][j] += ai * b[p * NR + j];
+            }
+        }
+    }
+    for (int i = 0; i < mr; ++i) {
+        for (int j = 0; j < nr; ++j) {
+            c[i * ldc + j] += acc[i][j];
+        }
+    }
+}
+
+/**
+ * @class BlockedGemm
+ * @brief Row-major C += A * B over a band of rows, with reusable packing buffers.
+ */
+template <typename T, int MR = GemmTile<T>::MR, int NR = GemmTile<T>::NR, int MC = GemmTile<T>::MC,
+          int KC = GemmTile<T>::KC, int NC = GemmTile<T>::NC>
+class BlockedGemm {
+    static_assert(MC % MR == 0 && NC % NR == 0, "cache blocks must be whole register tiles");
+
+public:
+    BlockedGemm() : packed_a_(MC * KC), packed_b_(KC * NC) {}
+
+    /**
+     * @brief Multiplies rows [row_begin, row_end) of C.
+     * @param n Columns of B and C.
+     * @param k Columns of A / rows of B.
+     * @param a A (rows x k), row stride k.
+     * @param b B (k x n), row stride n.
+     * @param c C (rows x n), row stride n.
+     */
+    void multiply(int row_begin, int row_end, int n, int k, const T* a, const T* b, T* c) {
+        for (int jc = 0; jc < n; jc += NC) {
+            int nc = std::min(NC, n - jc);
+            for (int pc = 0; pc < k; pc += KC) {
+                int kc = std::min(KC, k - pc);
+                pack_b(kc, nc, b + pc * n + jc, n);
+                for (int ic = row_begin; ic < row_end; ic += MC) {
+                    int mc = std::min(MC, row_end - ic);
+                    pack_a(mc, kc, a + ic * k + pc, k);
+                    for (int jr = 0; jr < nc; jr += NR) {
+                        for (int ir = 0; ir < mc; ir += MR) {
+                            gemm_micro_kernel<T, MR, NR>(kc, &packed_a_[ir * kc], &packed_b_[jr * kc],
+                                                         c + (ic + ir) * n + jc + jr, n, std::min(MR, mc - ir),
+                                                         std::min(NR, nc - jr));
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+private:
+    /** Packs A into MR-row panels, each stored step-major and zero-padded. */
+    void pack_a(int mc, int kc, const T* a, int lda) {
+        for (int ir = 0; ir < mc; ir += MR) {
+            T* panel = &packed_a_[ir * kc];
+            for (int p = 0; p < kc; ++p) {
+                for (int i = 0; i < MR; ++i) {
+                    panel[p * MR + i] = ir + i < mc ? a[(ir + i) * lda + p] : T(0);
+                }
+            }
+        }
+    }
+
+    /** Packs B into NR-column panels, each stored step-major and zero-padded. */
+    void pack_b(int kc, int nc, const T* b, int ldb) {
+        for (int jr = 0; jr < nc; jr += NR) {
+            T* panel = &packed_b_[jr * kc];
+            for (int p = 0; p < kc; ++p) {
+                for (int j = 0; j < NR; ++j) {
+                    panel[p * NR + j] = jr + j < nc ? b[p * ldb + jr + j] : T(0);
+                }
+            }
+        }
+    }
+
+    std::vector<T> packed_a_;  /**< MC x KC block of A */
+    std::vector<T> packed_b_;  /**< KC x NC block of B */
+};
+
+/**
+ * @enum GemmPrecision
+ * @brief Element type of a benchmark run.
+ */
+enum class GemmPrecision {
+    SINGLE,  /**< float (SGEMM) */
+    DOUBLE   /**< double (DGEMM) */
+};
+
+/**
+ * @brief Peak floating-point operations per cycle per core for the
+ *        instruction set this binary was compiled for.
+ * @param precision Element type.
+ * @return FLOP/cycle (two FMA pipes on Cortex-A76; separate add and
+ *         multiply pipes for baseline x86-64 SSE2).
+ */
+double gemm_peak_flops_per_cycle(GemmPrecision precision);
+
+/**
+ * @struct GemmResult
+ * @brief Outcome of one GEMM benchmark configuration.
+ */
+struct GemmResult {
+    GemmPrecision precision;     /**< Element type */
+    int threads = 0;             /**< Worker threads (one per listed CPU) */
+    int size = 0;                /**< Square matrix dimension */
+    double gflops = 0.0;         /**< Achieved GFLOP/s across all threads */
+    double effective_mhz = 0.0;  /**< Mean clock from the cycle counters, 0 if unavailable */
+    bool verified = false;       /**< Sampled entries match a reference dot product */
+};
+
+/**
+ * @brief Multiplies two size x size matrices repeatedly for @p duration.
+ *
+ * Each pinned worker owns a band of rows of C and repeats its band until
+ * the window closes; throughput counts every completed band.
+ *
+ * @param precision Element type.
+ * @param size Matrix dimension.
+ * @param cpus CPUs to run on; one worker per entry.
+ * @param duration Measurement window.
+ * @return GemmResult.
+ */
+GemmResult run_gemm_benchmark(GemmPrecision precision, int size, const std::vector<int>& cpus,
+                              std::chrono::milliseconds duration);
+
+} // namespace cm5_peripheral_test
+
+#endif // GEMM_BENCHMARK_H
@@ -31,6 +31,8 @@
 
 namespace cm5_peripheral_test {
 
+class SeriesRecorder;
+
 /**
  * @enum GPIOMode
  * @brief GPIO pin modes for testing.
@@ -153,9 +155,15 @@ private:
     /**
      * @brief Monitors GPIO pins for stability over time.
      * @param duration Monitoring duration.
+     * @param levels Receives the most recent pin readings (-1 for a failed read).
+     * @param level_stats Receives statistics of the successful readings.
+     * @param read_latency Receives the time of each sysfs read in ns.
+     * @param recorder Series file recorder for every reading, or nullptr.
      * @return TestResult indicating success or failure.
      */
-    TestResult monitor_gpio_stability(std::chrono::seconds duration);
+    TestResult monitor_gpio_stability(std::chrono::seconds duration, TimeSeries& levels,
+                                      StreamingSummary& level_stats, LatencyHistogram& read_latency,
+                                      SeriesRecorder* recorder);
 
     /**
      * @brief Exports a GPIO pin for use.
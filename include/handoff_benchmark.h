@@ -0,0 +1,71 @@
+/**
+ * @file handoff_benchmark.h
+ * @brief Producer-to-consumer handoff throughput benchmark.
+ * @author Sandesh Ghimire | sandesh@soccentric
+ * @copyright (C) Soccentric LLC. All rights reserved.
+ *
+ * Streams a sequence of items from a pinned producer thread to a pinned
+ * consumer thread through a bounded queue, the way a sampler hands
+ * readings to its consumers, and compares a mutex-guarded queue with
+ * the lock-free SpscRing, each pushing and popping single items or
+ * batches.
+ */
+
+#ifndef HANDOFF_BENCHMARK_H
+#define HANDOFF_BENCHMARK_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace cm5_peripheral_test {
+
+/**
+ * @enum HandoffQueue
+ * @brief Queues covered by the handoff benchmark.
+ */
+enum class HandoffQueue {
+    MUTEX_QUEUE,   /**< std::mutex around a bounded std::deque, one item per lock */
+    MUTEX_BATCH,   /**< The same queue, a batch of items per lock */
+    SPSC_SINGLE,   /**< SpscRing, one item per push and pop */
+    SPSC_BATCH     /**< SpscRing, batched push and pop */
+};
+
+/**
+ * @brief Returns a short display name for a queue.
+ * @param queue Queue to name.
+ * @return Static string.
+ */
+const char* handoff_queue_name(HandoffQueue queue);
+
+/**
+ * @struct HandoffResult
+ * @brief Outcome of streaming items through one queue.
+ */
+struct HandoffResult {
+    HandoffQueue queue;             /**< Queue measured */
+    uint64_t items = 0;             /**< Items streamed */
+    double items_per_second = 0.0;  /**< Throughput from first push to last pop */
+    uint64_t full_rejections = 0;   /**< Items the producer had to retry because the queue was full */
+    bool in_order = false;          /**< Consumer saw every item exactly once, in order */
+};
+
+/**
+ * @brief Streams @p items items from a producer to a consumer.
+ *
+ * The producer is pinned to the first CPU in @p cpus and the consumer
+ * to the second, or to the same one when only one is listed. Neither
+ * side blocks: on a full or empty queue it spins briefly, then yields.
+ *
+ * @param queue Queue to measure.
+ * @param cpus CPUs to run on (at least one).
+ * @param items Items to stream.
+ * @param capacity Queue capacity in items.
+ * @return HandoffResult.
+ */
+HandoffResult run_handoff_benchmark(HandoffQueue queue, const std::vector<int>& cpus, uint64_t items,
+                                    size_t capacity);
+
+} // namespace cm5_peripheral_test
+
+#endif // HANDOFF_BENCHMARK_H
@@ -0,0 +1,142 @@
+/**
+ * @file interrupt_monitor.h
+ * @brief Per-core hardirq and softirq rate sampling from procfs.
+ * @author Sandesh Ghimire | sandesh@soccentric
+ * @copyright (C) Soccentric LLC. All rights reserved.
+ *
+ * Reads /proc/interrupts and /proc/softirqs into per-source, per-CPU
+ * counter arrays and turns the deltas between samples into rates. The
+ * layout (sources, CPU columns, device names) is discovered once on
+ * construction; after that a sample reads both files into a reused
+ * buffer and parses them in place without allocating, so it can run at
+ * a 100 ms cadence alongside latency-sensitive work.
+ */
+
+#ifndef INTERRUPT_MONITOR_H
+#define INTERRUPT_MONITOR_H
+
+#include <cstddef>
+#include <cstdint>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace cm5_peripheral_test {
+
+/**
+ * @struct InterruptSource
+ * @brief One row of /proc/interrupts or /proc/softirqs.
+ */
+struct InterruptSource {
+    std::string id;       /**< IRQ number, IPI mnemonic ("LOC", "IPI0") or softirq name */
+    std::string device;   /**< Controller, trigger and device text, empty for softirqs */
+    bool softirq = false; /**< true for rows of /proc/softirqs */
+};
+
+/**
+ * @class InterruptMonitor
+ * @brief Samples interrupt and softirq counters for every online CPU.
+ *
+ * Call start() to capture a baseline, then sample() at a fixed cadence.
+ * Each sample updates the per-interval rate, the running total and the
+ * peak interval rate of every (source, CPU) cell.
+ */
+class InterruptMonitor {
+public:
+    /**
+     * @brief Discovers the sources and CPU columns and preallocates storage.
+     * @param proc_root Root of procfs (overridable for tests).
+     */
+    explicit InterruptMonitor(const std::string& proc_root = "/proc");
+
+    /**
+     * @brief Checks whether /proc/interrupts could be parsed.
+     * @return true if at least one source and one CPU were found.
+     */
+    bool is_available() const { return !sources_.empty() && !cpus_.empty(); }
+
+    /**
+     * @brief Returns the CPU of each counter column.
+     * @return Logical CPU indices from the file header.
+     */
+    const std::vector<int>& cpus() const { return cpus_; }
+
+    /**
+     * @brief Returns the discovered sources, hardirqs first.
+     */
+    const std::vector<InterruptSource>& sources() const { return sources_; }
+
+    /**
+     * @brief Captures the baseline counters and resets totals and peaks.
+     */
+    void start();
+
+    /**
+     * @brief Reads the counters and updates rates, totals and peaks.
+     * @return false if a file could not be read.
+     */
+    bool sample();
+
+    /**
+     * @brief Interrupts per second in the last interval.
+     * @param source Index into sources().
+     * @param column Index into cpus().
+     */
+    double rate(size_t source, size_t column) const { return rates_[source * cpus_.size() + column]; }
+
+    /**
+     * @brief Highest per-interval rate since start().
+     */
+    double peak_rate(size_t source, size_t column) const { return peaks_[source * cpus_.size() + column]; }
+
+    /**
+     * @brief Interrupts counted since start().
+     */
+    uint64_t total(size_t source, size_t column) const { return totals_[source * cpus_.size() + column]; }
+
+    /**
+     * @brief Seconds covered by the samples since start().
+     */
+    double elapsed_seconds() const { return elapsed_ns_ / 1e9; }
+
+    /**
+     * @brief Distinct rows seen since start() that were not present at
+     *        discovery (hot-plugged devices); their counts are ignored.
+     */
+    uint64_t unknown_rows() const { return unknown_ids_[0].size() + unknown_ids_[1].size(); }
+
+    /**
+     * @brief Formats the busiest sources by total count.
+     * @param limit Maximum number of sources listed.
+     * @param storm_rate Per-CPU peak rate (per second) flagged as a storm.
+     * @return Table with mean and peak rate per source and the busiest CPU.
+     */
+    std::string format_summary(size_t limit, double storm_rate) const;
+
+private:
+    bool discover(const std::string& path, bool softirq);
+    bool read_file(const std::string& path);
+    void parse_counters(bool softirq);
+    size_t find_source(const char* id, size_t length, bool softirq, size_t hint) const;
+
+    std::string interrupts_path_;            /**< /proc/interrupts */
+    std::string softirqs_path_;              /**< /proc/softirqs */
+    std::vector<int> cpus_;                  /**< CPU of each column */
+    std::vector<InterruptSource> sources_;   /**< Discovered rows */
+    std::vector<int> hardirq_columns_;       /**< interrupts file column -> cpus_ index */
+    std::vector<int> softirq_columns_;       /**< softirqs file column -> cpus_ index */
+    std::vector<char> buffer_;               /**< Reused file contents */
+    size_t buffer_length_ = 0;               /**< Valid bytes in buffer_ */
+    std::vector<uint64_t> previous_;         /**< Counters at the last sample */
+    std::vector<uint64_t> current_;          /**< Counters being read */
+    std::vector<uint64_t> totals_;           /**< Counts since start() */
+    std::vector<double> rates_;              /**< Rates over the last interval */
+    std::vector<double> peaks_;              /**< Highest interval rate since start() */
+    uint64_t previous_ns_ = 0;               /**< Time of the last sample */
+    uint64_t elapsed_ns_ = 0;                /**< Time covered since start() */
+    std::set<std::string, std::less<>> unknown_ids_[2]; /**< Unmatched hardirq [0] and softirq [1] row IDs */
+};
+
+} // namespace cm5_peripheral_test
+
+#endif // INTERRUPT_MONITOR_H
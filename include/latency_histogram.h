@@ -0,0 +1,151 @@
+/**
+ * @file latency_histogram.h
+ * @brief Fixed-memory log-linear latency histogram.
+ * @author Sandesh Ghimire | sandesh@soccentric
+ * @copyright (C) Soccentric LLC. All rights reserved.
+ *
+ * HDR-style bucketing: values below 2^bits get one bucket each, and
+ * every power of two above that is split into 2^(bits-1) equal buckets,
+ * so the relative error of any reported value is at most 2^-(bits-1)
+ * (0.8% at the default 8 bits) from one nanosecond up to the highest
+ * trackable value. The bucket array is allocated once; recording is a
+ * shift, a count-leading-zeros and an increment.
+ *
+ * Each histogram has a single writer. Counters are relaxed atomics, so
+ * another thread may read or merge a histogram while its owner is still
+ * recording without taking a lock; threads that share a measurement
+ * record into their own histogram and the results are merged with add().
+ * serialize() gives a compact text form (non-empty buckets only) for
+ * reports, and deserialize() restores it.
+ */
+
+#ifndef LATENCY_HISTOGRAM_H
+#define LATENCY_HISTOGRAM_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+namespace cm5_peripheral_test {
+
+/**
+ * @class LatencyHistogram
+ * @brief Named log-linear histogram of non-negative integer values (typically ns).
+ */
+class LatencyHistogram {
+public:
+    /** Default highest trackable value: about 18 minutes in nanoseconds. */
+    static constexpr uint64_t DEFAULT_HIGHEST_VALUE = uint64_t(1) << 40;
+
+    /** Default sub-bucket resolution (0.8% relative error). */
+    static constexpr int DEFAULT_PRECISION_BITS = 8;
+
+    /**
+     * @brief Allocates the buckets.
+     * @param name Quantity name, including the unit (e.g. "wakeup_ns").
+     * @param highest_value Largest value tracked exactly; larger values
+     *        land in the last bucket, max() still reports them.
+     * @param precision_bits Sub-bucket resolution, clamped to 2..16.
+     */
+    explicit LatencyHistogram(std::string name, uint64_t highest_value = DEFAULT_HIGHEST_VALUE,
+                              int precision_bits = DEFAULT_PRECISION_BITS);
+
+    LatencyHistogram(const LatencyHistogram& other);
+    LatencyHistogram& operator=(const LatencyHistogram& other);
+    LatencyHistogram(LatencyHistogram&& other) noexcept;
+    LatencyHistogram& operator=(LatencyHistogram&& other) noexcept;
+
+    /**
+     * @brief Records @p count occurrences of @p value. Owner thread only.
+     */
+    void record(uint64_t value, uint64_t count = 1);
+
+    /**
+     * @brief Adds every bucket of @p other into this histogram. Owner thread only.
+     * @return false (and nothing added) if the bucket layouts differ.
+     */
+    bool add(const LatencyHistogram& other);
+
+    /**
+     * @brief Clears all counts, keeping the allocation. Owner thread only.
+     */
+    void reset();
+
+    /**
+     * @brief Returns the value at or below which @p percentile percent of samples fall.
+     * @param percentile 0..100.
+     * @return Highest value of the matching bucket, clamped to [min(), max()];
+     *         0 if empty.
+     */
+    uint64_t percentile(double percentile) const;
+
+    /**
+     * @brief Returns the name, the number of values and the smallest and
+     *        largest value recorded (0 if empty).
+     */
+    const std::string& name() const { return name_; }
+    uint64_t count() const { return count_.load(std::memory_order_relaxed); }
+    uint64_t min() const;
+    uint64_t max() const { return max_.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Returns the exact mean of the recorded values, 0 if empty.
+     */
+    double mean() const;
+
+    /**
+     * @brief Returns the number of buckets.
+     */
+    size_t bucket_count() const { return bucket_count_; }
+
+    /**
+     * @brief Returns the bytes held by the bucket array.
+     */
+    size_t memory_bytes() const { return bucket_count_ * sizeof(std::atomic<uint64_t>); }
+
+    /**
+     * @brief Summarises the distribution in one line.
+     * @param divisor Value per displayed unit (1000 to show ns as us).
+     * @param unit Displayed unit.
+     * @return e.g. "n 200, p50 56.2 us, p90 61.0 us, p99 88.1 us, p99.9 90.3 us, max 90.3 us".
+     */
+    std::string summary(double divisor = 1.0, const char* unit = "") const;
+
+    /**
+     * @brief Encodes the histogram compactly.
+     * @return "hdr1/<bits>/<highest>/<min>/<max>/<sum>/<buckets>", where
+     *         buckets lists non-empty buckets as "<index gap>" or
+     *         "<index gap>x<count>" separated by commas.
+     */
+    std::string serialize() const;
+
+    /**
+     * @brief Restores a histogram written by serialize().
+     * @param name Name for the restored histogram.
+     * @param text Encoded form.
+     * @param out Receives the histogram.
+     * @return false if @p text is malformed.
+     */
+    static bool deserialize(const std::string& name, const std::string& text, LatencyHistogram& out);
+
+private:
+    void copy_from(const LatencyHistogram& other);
+    size_t index_of(uint64_t value) const;
+    uint64_t highest_in_bucket(size_t index) const;
+
+    std::string name_;                                /**< Quantity name and unit */
+    uint64_t highest_value_;                          /**< Largest value tracked exactly */
+    int precision_bits_;                              /**< Sub-bucket resolution */
+    size_t bucket_count_;                             /**< Buckets allocated */
+    std::unique_ptr<std::atomic<uint64_t>[]> counts_; /**< Per-bucket counts */
+    std::atomic<uint64_t> count_{0};                  /**< Values recorded */
+    std::atomic<uint64_t> min_{UINT64_MAX};           /**< Smallest value recorded */
+    std::atomic<uint64_t> max_{0};                    /**< Largest value recorded */
+    std::atomic<uint64_t> sum_{0};                    /**< Sum of values recorded (wraps after 2^64) */
+};
+
+} // namespace cm5_peripheral_test
+
+#endif // LATENCY_HISTOGRAM_H
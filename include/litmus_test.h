@@ -0,0 +1,123 @@
+/**
+ * @file litmus_test.h
+ * @brief Memory-ordering litmus test runner.
+ * @author Sandesh Ghimire | sandesh@soccentric
+ * @copyright (C) Soccentric LLC. All rights reserved.
+ *
+ * Runs the classic two- and four-thread litmus shapes many times on
+ * pinned cores and histograms the values each thread observed. Outcomes
+ * the C++ memory model forbids for the chosen ordering indicate a
+ * hardware or compiler bug; allowed-but-weak outcomes show how relaxed
+ * the core really is.
+ */
+
+#ifndef LITMUS_TEST_H
+#define LITMUS_TEST_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace cm5_peripheral_test {
+
+/**
+ * @enum LitmusTest
+ * @brief Litmus shapes. x and y start at 0; stores write 1.
+ */
+enum class LitmusTest {
+    MESSAGE_PASSING,   /**< MP:   T0: x=1; y=1          T1: r0=y; r1=x */
+    STORE_BUFFERING,   /**< SB:   T0: x=1; r0=y         T1: y=1; r1=x */
+    LOAD_BUFFERING,    /**< LB:   T0: r0=x; y=1         T1: r1=y; x=1 */
+    IRIW               /**< IRIW: T0: x=1  T1: y=1  T2: r0=x; r1=y  T3: r2=y; r3=x */
+};
+
+/**
+ * @enum LitmusOrdering
+ * @brief Memory order applied to every access of a run.
+ */
+enum class LitmusOrdering {
+    RELAXED,          /**< memory_order_relaxed everywhere */
+    ACQUIRE_RELEASE,  /**< Release stores, acquire loads */
+    SEQ_CST           /**< memory_order_seq_cst everywhere */
+};
+
+/**
+ * @brief Returns the short name of a test ("MP", "SB", "LB", "IRIW").
+ * @param test Test to name.
+ * @return Static string.
+ */
+const char* litmus_test_name(LitmusTest test);
+
+/**
+ * @brief Returns the short name of an ordering.
+ * @param ordering Ordering to name.
+ * @return Static string.
+ */
+const char* litmus_ordering_name(LitmusOrdering ordering);
+
+/**
+ * @brief Returns the number of threads a test uses.
+ * @param test Test.
+ * @return 2, or 4 for IRIW.
+ */
+size_t litmus_thread_count(LitmusTest test);
+
+/**
+ * @brief Returns the number of distinct outcomes of a test.
+ * @param test Test.
+ * @return 2^(registers); outcome bit k holds register rk.
+ */
+size_t litmus_outcome_count(LitmusTest test);
+
+/**
+ * @brief Checks whether the memory model forbids an outcome.
+ * @param test Test.
+ * @param ordering Ordering used.
+ * @param outcome Outcome index (bit k = rk).
+ * @return true if the outcome must never be observed.
+ */
+bool litmus_forbidden(LitmusTest test, LitmusOrdering ordering, size_t outcome);
+
+/**
+ * @brief Formats an outcome as register assignments.
+ * @param test Test.
+ * @param outcome Outcome index.
+ * @return String such as "r0=1 r1=0".
+ */
+std::string format_litmus_outcome(LitmusTest test, size_t outcome);
+
+/**
+ * @struct LitmusResult
+ * @brief Outcome histogram of one run.
+ */
+struct LitmusResult {
+    LitmusTest test;                 /**< Shape run */
+    LitmusOrdering ordering;         /**< Ordering used */
+    std::vector<int> cpus;           /**< CPU of each thread */
+    uint64_t iterations = 0;         /**< Instances executed */
+    std::vector<uint64_t> outcomes;  /**< Count per outcome index */
+    uint64_t forbidden = 0;          /**< Instances with a forbidden outcome */
+    double iterations_per_second = 0.0;
+};
+
+/**
+ * @brief Runs a litmus test.
+ *
+ * Threads execute batches of independent instances, each on its own
+ * cache lines, with a random spin before every instance to vary the
+ * interleaving. A barrier separates batches; thread 0 tallies outcomes
+ * and resets the locations in between.
+ *
+ * @param test Shape to run.
+ * @param ordering Ordering for every access.
+ * @param cpus CPUs to pin threads to; thread t uses cpus[t % size].
+ * @param iterations Minimum number of instances (rounded up to a batch).
+ * @return LitmusResult; empty if @p cpus is empty.
+ */
+LitmusResult run_litmus_test(LitmusTest test, LitmusOrdering ordering, const std::vector<int>& cpus,
+                             uint64_t iterations);
+
+} // namespace cm5_peripheral_test
+
+#endif // LITMUS_TEST_H
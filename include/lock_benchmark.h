@@ -0,0 +1,148 @@
+/**
+ * @file lock_benchmark.h
+ * @brief Synchronization primitive contention benchmarks.
+ * @author Sandesh Ghimire | sandesh@soccentric
+ * @copyright (C) Soccentric LLC. All rights reserved.
+ *
+ * Measures throughput and fairness of locks and atomic counters under
+ * contention from pinned threads, and the cost of false sharing between
+ * per-thread counters that live on the same cache line.
+ */
+
+#ifndef LOCK_BENCHMARK_H
+#define LOCK_BENCHMARK_H
+
+#include "cache_line.h"
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace cm5_peripheral_test {
+
+/**
+ * @class TicketSpinlock
+ * @brief FIFO spinlock: threads take a ticket and wait for their turn.
+ */
+class TicketSpinlock {
+public:
+    void lock() {
+        uint32_t ticket = next_.fetch_add(1, std::memory_order_relaxed);
+        while (serving_.load(std::memory_order_acquire) != ticket) {
+            cpu_relax();
+        }
+    }
+
+    void unlock() {
+        serving_.store(serving_.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    }
+
+private:
+    std::atomic<uint32_t> next_{0};    /**< Next ticket to hand out */
+    std::atomic<uint32_t> serving_{0}; /**< Ticket currently allowed in */
+};
+
+/**
+ * @class McsLock
+ * @brief MCS queue lock: each waiter spins on its own node.
+ *
+ * Waiters form a linked queue and spin only on a flag in their own
+ * cache line, so a handoff touches one remote line instead of every
+ * waiter's copy of a shared word.
+ */
+class McsLock {
+public:
+    /**
+     * @struct Node
+     * @brief Per-acquisition queue node, owned by the locking thread.
+     */
+    struct alignas(CACHE_LINE_SIZE) Node {
+        std::atomic<Node*> next{nullptr};
+        std::atomic<bool> locked{false};
+    };
+
+    void lock(Node& node) {
+        node.next.store(nullptr, std::memory_order_relaxed);
+        node.locked.store(true, std::memory_order_relaxed);
+        Node* previous = tail_.exchange(&node, std::memory_order_acq_rel);
+        if (previous != nullptr) {
+            previous->next.store(&node, std::memory_order_release);
+            while (node.locked.load(std::memory_order_acquire)) {
+                cpu_relax();
+            }
+        }
+    }
+
+    void unlock(Node& node) {
+        Node* successor = node.next.load(std::memory_order_acquire);
+        if (successor == nullptr) {
+            Node* expected = &node;
+            if (tail_.compare_exchange_strong(expected, nullptr, std::memory_order_acq_rel)) {
+                return;
+            }
+            // A new waiter swapped the tail but has not linked itself yet
+            while ((successor = node.next.load(std::memory_order_acquire)) == nullptr) {
+                cpu_relax();
+            }
+        }
+        successor->locked.store(false, std::memory_order_release);
+    }
+
+private:
+    std::atomic<Node*> tail_{nullptr}; /**< Last node in the queue */
+};
+
+/**
+ * @enum SyncPrimitive
+ * @brief Primitives covered by the contention benchmark.
+ */
+enum class SyncPrimitive {
+    STD_MUTEX,        /**< std::mutex around a shared counter */
+    TICKET_SPINLOCK,  /**< TicketSpinlock around a shared counter */
+    MCS_LOCK,         /**< McsLock around a shared counter */
+    ATOMIC_RELAXED,   /**< fetch_add(relaxed) on one shared atomic */
+    ATOMIC_SEQ_CST,   /**< fetch_add(seq_cst) on one shared atomic */
+    SHARED_COUNTERS,  /**< Per-thread counters packed into one cache line */
+    PADDED_COUNTERS   /**< Per-thread counters on separate cache lines */
+};
+
+/**
+ * @brief Returns a short display name for a primitive.
+ * @param primitive Primitive to name.
+ * @return Static string.
+ */
+const char* sync_primitive_name(SyncPrimitive primitive);
+
+/**
+ * @struct ContentionResult
+ * @brief Outcome of one primitive at one thread count.
+ */
+struct ContentionResult {
+    SyncPrimitive primitive;   /**< Primitive measured */
+    int threads;               /**< Number of contending threads */
+    double ops_per_second;     /**< Aggregate operations per second */
+    double fairness;           /**< Jain's index of per-thread op counts (1.0 = perfectly fair) */
+    bool consistent;           /**< Protected/atomic total matched the sum of per-thread counts */
+};
+
+/**
+ * @brief Runs one primitive with one pinned thread per listed CPU.
+ * @param primitive Primitive to measure.
+ * @param cpus CPUs to pin threads to; one thread per entry.
+ * @param duration Measurement window.
+ * @return ContentionResult for the run.
+ */
+ContentionResult run_contention_benchmark(SyncPrimitive primitive, const std::vector<int>& cpus,
+                                          std::chrono::milliseconds duration);
+
+/**
+ * @brief Computes Jain's fairness index.
+ * @param counts Per-thread operation counts.
+ * @return (sum x)^2 / (n * sum x^2), 1.0 for an empty or single-entry set.
+ */
+double jain_fairness(const std::vector<uint64_t>& counts);
+
+} // namespace cm5_peripheral_test
+
+#endif // LOCK_BENCHMARK_H
@@ -0,0 +1,83 @@
+/**
+ * @file mapping_benchmark.h
+ * @brief Page-fault and memory-mapping system call cost benchmarks.
+ * @author Sandesh Ghimire | sandesh@soccentric
+ * @copyright (C) Soccentric LLC. All rights reserved.
+ *
+ * Times the kernel work behind setting up a large buffer: the minor
+ * fault taken on first write to an anonymous page, the major fault
+ * taken when a file page has to be read back from storage, mmap/munmap
+ * of an untouched region, madvise(MADV_DONTNEED) and mprotect on a
+ * populated range, and concurrent first touch by several threads that
+ * share one address space. Fault counts from getrusage(2) are reported
+ * alongside so a run where the kernel did not fault as expected (THP,
+ * a file that stayed cached) is visible.
+ */
+
+#ifndef MAPPING_BENCHMARK_H
+#define MAPPING_BENCHMARK_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace cm5_peripheral_test {
+
+/**
+ * @enum MappingOperation
+ * @brief Operations covered by the mapping benchmark.
+ */
+enum class MappingOperation {
+    MINOR_FAULT,       /**< First write to an anonymous page, per page */
+    MAJOR_FAULT,       /**< First read of an uncached file page, per page */
+    MMAP_MUNMAP,       /**< mmap + munmap of an untouched chunk, per pair */
+    MADVISE_DONTNEED,  /**< madvise(MADV_DONTNEED) on a populated chunk, per call */
+    MPROTECT,          /**< mprotect toggling a populated chunk, per call */
+    FIRST_TOUCH        /**< Concurrent first write by one thread per CPU, per page */
+};
+
+/**
+ * @brief Returns a short display name for an operation.
+ * @param operation Operation to name.
+ * @return Static string.
+ */
+const char* mapping_operation_name(MappingOperation operation);
+
+/**
+ * @struct MappingCostResult
+ * @brief Outcome of one operation.
+ */
+struct MappingCostResult {
+    MappingOperation operation;  /**< Operation measured */
+    int threads = 1;             /**< Threads that ran it */
+    uint64_t operations = 0;     /**< Operations timed */
+    size_t chunk_bytes = 0;      /**< Bytes per call for the chunked system calls */
+    double ns_per_op = 0.0;      /**< Mean latency per operation */
+    double ops_per_second = 0.0; /**< Aggregate rate across threads */
+    double faults_per_op = -1.0; /**< getrusage faults per operation, -1 when not a fault test */
+    bool available = false;      /**< Operation could be set up */
+    std::string note;            /**< Reason when unavailable */
+};
+
+/**
+ * @brief Runs one operation over a region of @p bytes.
+ *
+ * Single-threaded operations run on the calling thread; FIRST_TOUCH
+ * starts one pinned thread per entry of @p cpus, each touching its own
+ * slice of one shared mapping. Anonymous mappings are marked
+ * MADV_NOHUGEPAGE so every base page takes its own fault.
+ *
+ * @param operation Operation to measure.
+ * @param cpus CPUs for FIRST_TOUCH; ignored otherwise.
+ * @param bytes Region size; rounded up to whole base pages.
+ * @param scratch_dir Directory for the MAJOR_FAULT backing file; it
+ *        must be on a block device, not tmpfs, for faults to be major.
+ * @return MappingCostResult.
+ */
+MappingCostResult run_mapping_benchmark(MappingOperation operation, const std::vector<int>& cpus, size_t bytes,
+                                        const std::string& scratch_dir = "/var/tmp");
+
+} // namespace cm5_peripheral_test
+
+#endif // MAPPING_BENCHMARK_H
@@ -0,0 +1,83 @@
+/**
+ * @file measurement_harness.h
+ * @brief Adaptive repetition of benchmark samples until convergence.
+ * @author Sandesh Ghimire | sandesh@soccentric
+ * @copyright (C) Soccentric LLC. All rights reserved.
+ *
+ * A benchmark supplies a callable that runs one short sample and returns
+ * a figure (throughput, latency, ...). The harness discards samples
+ * until the last few agree (warm-up: caches, page faults, governor
+ * ramp), then keeps sampling until the 95% confidence interval of the
+ * mean is narrower than a target fraction of the mean, a sample limit
+ * is reached or a time cap expires. Quiet systems converge after a few
+ * samples; noisy ones get as many as the cap allows.
+ */
+
+#ifndef MEASUREMENT_HARNESS_H
+#define MEASUREMENT_HARNESS_H
+
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace cm5_peripheral_test {
+
+/**
+ * @struct ConvergenceCriteria
+ * @brief When to stop warming up and when to stop sampling.
+ */
+struct ConvergenceCriteria {
+    double target_relative_ci = 0.02;        /**< Stop when CI half-width / mean is at most this */
+    size_t min_samples = 5;                  /**< Samples kept before convergence is checked */
+    size_t max_samples = 200;                /**< Hard limit on kept samples */
+    size_t warmup_window = 3;                /**< Consecutive samples that must agree to end warm-up */
+    double warmup_tolerance = 0.05;          /**< Allowed (max - min) / median within the window */
+    size_t max_warmup = 20;                  /**< Warm-up samples taken before giving up on stability */
+    std::chrono::milliseconds time_cap{5000}; /**< Wall-clock limit including warm-up */
+};
+
+/**
+ * @struct MeasurementSummary
+ * @brief Robust and parametric summary of the kept samples.
+ */
+struct MeasurementSummary {
+    size_t iterations = 0;        /**< Samples kept after warm-up */
+    size_t warmup = 0;            /**< Samples discarded as warm-up */
+    double median = 0.0;          /**< Median of kept samples */
+    double mad = 0.0;             /**< Median absolute deviation from the median */
+    double mean = 0.0;            /**< Mean of kept samples */
+    double ci_half_width = 0.0;   /**< 95% confidence half-width of the mean */
+    double relative_ci = 0.0;     /**< ci_half_width / |mean| */
+    bool converged = false;       /**< relative_ci reached the target */
+};
+
+/**
+ * @brief Summarises a set of samples.
+ * @param samples Kept samples.
+ * @return MeasurementSummary with iterations = samples.size() and warmup = 0.
+ */
+MeasurementSummary summarize_samples(std::vector<double> samples);
+
+/**
+ * @brief Runs @p sample repeatedly until @p criteria are met.
+ * @param sample Runs one sample and returns its figure.
+ * @param criteria Warm-up and convergence rules.
+ * @return MeasurementSummary of the samples kept after warm-up.
+ */
+MeasurementSummary measure_until_converged(const std::function<double()>& sample,
+                                           const ConvergenceCriteria& criteria = ConvergenceCriteria());
+
+/**
+ * @brief Formats a summary for a report line.
+ * @param summary Summary to format.
+ * @param scale Multiplier applied to median, MAD and mean (e.g. 1e-6 for M/s).
+ * @param precision Decimal places of the scaled values.
+ * @return "median (MAD m, ±c% CI95, n=i)", with " [NOT CONVERGED]" when applicable.
+ */
+std::string format_measurement(const MeasurementSummary& summary, double scale = 1.0, int precision = 2);
+
+} // namespace cm5_peripheral_test
+
+#endif // MEASUREMENT_HARNESS_H
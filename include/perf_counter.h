@@ -0,0 +1,86 @@
+/**
+ * @file perf_counter.h
+ * @brief Hardware performance counter access for CPU benchmarks.
+ * @author Sandesh Ghimire | sandesh@soccentric
+ * @copyright (C) Soccentric LLC. All rights reserved.
+ *
+ * Thin RAII wrapper around Linux perf_event_open(2) for counting a single
+ * hardware event on the calling thread. Counters are optional: kernels
+ * built without perf support, containers and a restrictive
+ * perf_event_paranoid setting all leave the counter unavailable, and
+ * callers are expected to fall back to wall-clock figures.
+ */
+
+#ifndef PERF_COUNTER_H
+#define PERF_COUNTER_H
+
+#include <cstdint>
+
+namespace cm5_peripheral_test {
+
+/**
+ * @enum PerfEvent
+ * @brief Hardware events that benchmarks may count.
+ */
+enum class PerfEvent {
+    CPU_CYCLES,      /**< Core clock cycles */
+    INSTRUCTIONS,    /**< Retired instructions */
+    DTLB_MISSES,     /**< Data TLB read misses (L1D_TLB_REFILL on Arm) */
+    BRANCH_MISSES,   /**< Mispredicted branches */
+    FRONTEND_STALLS, /**< Cycles the front end delivered no instructions (STALL_FRONTEND on Arm) */
+    ICACHE_MISSES    /**< L1 instruction cache read misses */
+};
+
+/**
+ * @class PerfCounter
+ * @brief Counts one hardware event for the calling thread.
+ *
+ * The counter is opened disabled; start() resets and enables it and
+ * stop() disables it and returns the accumulated count.
+ */
+class PerfCounter {
+public:
+    /**
+     * @brief Opens a counter for @p event on the calling thread.
+     * @param event Hardware event to count.
+     */
+    explicit PerfCounter(PerfEvent event);
+
+    /**
+     * @brief Closes the counter file descriptor.
+     */
+    ~PerfCounter();
+
+    PerfCounter(const PerfCounter&) = delete;
+    PerfCounter& operator=(const PerfCounter&) = delete;
+
+    /**
+     * @brief Checks whether the counter could be opened.
+     * @return true if start()/stop() return meaningful counts.
+     */
+    bool is_available() const { return fd_ >= 0; }
+
+    /**
+     * @brief Resets and enables the counter.
+     */
+    void start();
+
+    /**
+     * @brief Disables the counter.
+     * @return Events counted since start(), or 0 if unavailable.
+     */
+    uint64_t stop();
+
+    /**
+     * @brief Reads the counter without disabling it.
+     * @return Events counted since start(), or 0 if unavailable.
+     */
+    uint64_t read() const;
+
+private:
+    int fd_; /**< perf_event file descriptor, -1 if unavailable */
+};
+
+} // namespace cm5_peripheral_test
+
+#endif // PERF_COUNTER_H
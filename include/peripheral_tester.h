@@ -28,9 +28,14 @@
 #ifndef PERIPHERAL_TESTER_H
 #define PERIPHERAL_TESTER_H
 
+#include "latency_histogram.h"
+#include "resource_usage.h"
+#include "streaming_stats.h"
+#include "time_series.h"
 #include <string>
 #include <chrono>
 #include <memory>
+#include <vector>
 
 /**
  * @namespace cm5_peripheral_test
@@ -69,6 +74,11 @@ struct TestReport {
     std::chrono::milliseconds duration;          /**< Time taken to complete the test */
     std::string details;                         /**< Detailed test output or error messages */
     std::chrono::system_clock::time_point timestamp; /**< When the test was executed */
+    std::string placement;                       /**< Core partition the test ran under, empty if none */
+    ResourceUsage resources;                     /**< CPU time, switches, faults and peak RSS growth during the test */
+    std::vector<TimeSeries> series;              /**< Most recent window of each monitored quantity */
+    std::vector<StreamingSummary> statistics;    /**< Whole-run summary of each monitored quantity */
+    std::vector<LatencyHistogram> histograms;    /**< Latency distributions measured by the test */
 
     /**
      * @brief Default constructor initializing all fields.
@@ -169,6 +179,16 @@ public:
      */
     virtual bool is_available() const = 0;
 
+    /**
+     * @brief Makes monitor tests append every sample to a series file.
+     *
+     * Samples are written by a background thread in compressed chunks
+     * (see SeriesRecorder); the report notes what was recorded.
+     *
+     * @param path Series file to append to; empty disables recording.
+     */
+    void set_recording_path(const std::string& path) { recording_path_ = path; }
+
 protected:
     /**
      * @brief Protected constructor to prevent direct instantiation.
@@ -179,6 +199,19 @@ protected:
      */
     PeripheralTester() = default;
 
+    /**
+     * @brief Marks the start of a test.
+     *
+     * Records the resource usage baseline that create_report() subtracts.
+     * Every test entry point calls this first.
+     *
+     * @return Start time for the test's wall-clock duration.
+     */
+    std::chrono::steady_clock::time_point begin_test() {
+        usage_start_ = capture_resource_usage();
+        return std::chrono::steady_clock::now();
+    }
+
     /**
      * @brief Creates a standardized test report.
      *
@@ -199,8 +232,14 @@ protected:
         report.duration = test_duration;
         report.details = details;
         report.timestamp = std::chrono::system_clock::now();
+        report.placement = placement_;
+        report.resources = resource_usage_delta(usage_start_, capture_resource_usage());
         return report;
     }
+
+    std::string placement_;      /**< Core partition recorded in every report, empty if none */
+    ResourceUsage usage_start_;  /**< Usage when the current test began */
+    std::string recording_path_; /**< Series file monitor samples are appended to, empty if none */
 };
 
 } // namespace cm5_peripheral_test
@@ -0,0 +1,65 @@
+/**
+ * @file resource_usage.h
+ * @brief Process resource usage snapshots and per-test deltas.
+ * @author Sandesh Ghimire | sandesh@soccentric
+ * @copyright (C) Soccentric LLC. All rights reserved.
+ *
+ * A test records a snapshot when it starts and the difference when it
+ * reports: CPU time in user and kernel mode, context switches, page
+ * faults and growth of the peak resident set. Snapshots cover the whole
+ * process (getrusage(RUSAGE_SELF)), so worker threads a test spawns and
+ * joins are included; the tool runs one test at a time, so the delta
+ * belongs to that test. CPU time well above the wall time, or a flood
+ * of involuntary switches, shows a passing test that is burning cores
+ * or competing with other work.
+ */
+
+#ifndef RESOURCE_USAGE_H
+#define RESOURCE_USAGE_H
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+namespace cm5_peripheral_test {
+
+/**
+ * @struct ResourceUsage
+ * @brief Cumulative counters (snapshot) or their difference (delta).
+ */
+struct ResourceUsage {
+    bool valid = false;                /**< Counters were read */
+    double user_ms = 0.0;              /**< CPU time in user mode */
+    double system_ms = 0.0;            /**< CPU time in kernel mode */
+    int64_t voluntary_switches = 0;    /**< Context switches while waiting (sleep, I/O, lock) */
+    int64_t involuntary_switches = 0;  /**< Context switches forced by preemption */
+    int64_t minor_faults = 0;          /**< Page faults served without I/O */
+    int64_t major_faults = 0;          /**< Page faults that needed I/O */
+    int64_t peak_rss_kib = 0;          /**< Peak resident set (snapshot) or its growth (delta) */
+};
+
+/**
+ * @brief Reads the resource usage of the calling process.
+ * @return ResourceUsage; valid is false if getrusage failed.
+ */
+ResourceUsage capture_resource_usage();
+
+/**
+ * @brief Returns the usage between two snapshots.
+ * @param start Snapshot taken first.
+ * @param end Snapshot taken later.
+ * @return Difference of every counter; valid only if both snapshots are.
+ */
+ResourceUsage resource_usage_delta(const ResourceUsage& start, const ResourceUsage& end);
+
+/**
+ * @brief Formats a delta for a report.
+ * @param usage Delta from resource_usage_delta().
+ * @param wall Wall time the delta covers, for the CPU utilisation.
+ * @return One line, or "n/a" if @p usage is not valid.
+ */
+std::string format_resource_usage(const ResourceUsage& usage, std::chrono::milliseconds wall);
+
+} // namespace cm5_peripheral_test
+
+#endif // RESOURCE_USAGE_H
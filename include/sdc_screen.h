@@ -0,0 +1,118 @@
+/**
+ * @file sdc_screen.h
+ * @brief Silent data corruption screening with known-answer kernels.
+ * @author Sandesh Ghimire | sandesh@soccentric
+ * @copyright (C) Soccentric LLC. All rights reserved.
+ *
+ * A marginal core can return wrong results without faulting. The screen
+ * runs deterministic kernels on every core in parallel, folds each run
+ * into a 64-bit digest and checks it two ways: against a golden digest
+ * for a fixed seed (baked in at build time) and against the digests the
+ * other cores produced for the same seeds. All kernels use only
+ * operations that are bit-exact under IEEE-754 and two's complement, so
+ * the golden values hold on every conforming core. The CRC and crypto
+ * kernels pick the CRC32, AES and PMULL instructions at run time when
+ * the CPU reports them, so the screen exercises those units too.
+ */
+
+#ifndef SDC_SCREEN_H
+#define SDC_SCREEN_H
+
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
+namespace cm5_peripheral_test {
+
+/**
+ * @enum SdcKernel
+ * @brief Known-answer kernels run by the screen.
+ */
+enum class SdcKernel {
+    INTEGER,  /**< Multiply, divide, rotate and popcount chains */
+    FLOAT,    /**< Double-precision multiply-add, divide and sqrt */
+    SIMD,     /**< 128-bit integer and float vector lanes */
+    CRC32C,   /**< CRC-32C over a generated buffer (CRC32 instructions where reported) */
+    CRYPTO    /**< AES-128 blocks chained through carry-less multiplies (AES/PMULL where reported) */
+};
+
+/** Number of SdcKernel values. */
+constexpr size_t SDC_KERNEL_COUNT = 5;
+
+/** Seed whose digests are checked against the golden table. */
+constexpr uint64_t SDC_GOLDEN_SEED = 0x5DC5C4EE2025ULL;
+
+/**
+ * @brief Returns a short display name for a kernel.
+ * @param kernel Kernel to name.
+ * @return Static string.
+ */
+const char* sdc_kernel_name(SdcKernel kernel);
+
+/**
+ * @brief Runs one kernel once.
+ * @param kernel Kernel to run.
+ * @param seed Input seed; equal seeds give equal digests on a healthy core.
+ * @return Digest of every intermediate result.
+ */
+uint64_t run_sdc_kernel(SdcKernel kernel, uint64_t seed);
+
+/**
+ * @brief Returns the expected digest of a kernel for SDC_GOLDEN_SEED.
+ * @param kernel Kernel.
+ * @return Golden digest.
+ */
+uint64_t sdc_golden_digest(SdcKernel kernel);
+
+/**
+ * @brief Checks whether a kernel runs on dedicated CPU instructions.
+ * @param kernel Kernel.
+ * @return true for the CRC and crypto kernels when the running CPU
+ *         reports the extensions they use.
+ */
+bool sdc_kernel_accelerated(SdcKernel kernel);
+
+/**
+ * @struct SdcMismatch
+ * @brief One wrong digest, attributed to a core, kernel and round.
+ */
+struct SdcMismatch {
+    int cpu;            /**< Core that produced the digest */
+    SdcKernel kernel;   /**< Kernel that was running */
+    uint64_t round;     /**< Round in which it happened */
+    bool golden;        /**< true: golden-seed check; false: disagreed with the other cores */
+    uint64_t expected;  /**< Golden or majority digest */
+    uint64_t actual;    /**< Digest the core produced */
+};
+
+/**
+ * @struct SdcScreenResult
+ * @brief Outcome of a screening run.
+ */
+struct SdcScreenResult {
+    std::vector<int> cpus;               /**< Cores screened */
+    std::vector<uint64_t> rounds;        /**< Rounds completed per core */
+    uint64_t kernel_runs = 0;            /**< Kernel executions across all cores */
+    double runs_per_second = 0.0;        /**< Aggregate kernel executions per second */
+    uint64_t rounds_compared = 0;        /**< Rounds cross-checked between cores */
+    std::vector<SdcMismatch> mismatches; /**< Every detected mismatch */
+};
+
+/**
+ * @brief Screens the listed cores for @p duration.
+ *
+ * One pinned worker per core runs rounds back to back. Each round first
+ * runs every kernel with SDC_GOLDEN_SEED and compares against the golden
+ * table, then runs a batch of round-specific seeds and records one
+ * digest per kernel. After the run, rounds completed by every core are
+ * compared and cores disagreeing with the majority are reported.
+ *
+ * @param cpus Cores to screen; one worker per entry.
+ * @param duration Screening time.
+ * @return SdcScreenResult.
+ */
+SdcScreenResult run_sdc_screen(const std::vector<int>& cpus, std::chrono::milliseconds duration);
+
+} // namespace cm5_peripheral_test
+
+#endif // SDC_SCREEN_H
@@ -0,0 +1,190 @@
+/**
+ * @file series_file.h
+ * @brief Compressed append-only time-series file (Gorilla encoding).
+ * @author Sandesh Ghimire | sandesh@soccentric
+ * @copyright (C) Soccentric LLC. All rights reserved.
+ *
+ * Keeps every sample of a long burn-in in a few bits each, following
+ * the Gorilla scheme (Pelkonen et al., VLDB 2015):
+ *
+ * - timestamps (ms) as the delta of the delta to the previous one; a
+ *   steady cadence costs one bit per sample,
+ * - values as the XOR with the previous value, storing only the
+ *   meaningful bits and reusing the previous leading/trailing-zero
+ *   window when it fits; an unchanged value costs one bit.
+ *
+ * Samples are encoded into per-series chunks of up to a fixed sample count.
+ * A chunk is appended to the file only once complete or on flush(), so
+ * a crash loses the partial chunk of every series but never corrupts
+ * what is already on disk; SeriesRecorder flushes on a time bound to
+ * keep that loss short, and a flushed partial chunk is simply a chunk
+ * with fewer samples. Reopening for append first cuts off a torn tail
+ * left by a crash. Each chunk header carries the series name, sample
+ * count, time bounds and payload size, so a reader indexes the file by
+ * hopping from header to header and decodes only the chunks that
+ * overlap a queried range.
+ */
+
+#ifndef SERIES_FILE_H
+#define SERIES_FILE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace cm5_peripheral_test {
+
+/**
+ * @struct SeriesSample
+ * @brief One decoded sample.
+ */
+struct SeriesSample {
+    int64_t time_ms;  /**< Timestamp in milliseconds (epoch or run-relative) */
+    double value;     /**< Sample value, bit-exact */
+};
+
+/**
+ * @struct SeriesChunkInfo
+ * @brief Header of one chunk, as indexed by SeriesFileReader.
+ */
+struct SeriesChunkInfo {
+    std::string name;        /**< Series the chunk belongs to */
+    uint32_t samples = 0;    /**< Samples encoded */
+    int64_t min_time_ms = 0; /**< Earliest timestamp in the chunk */
+    int64_t max_time_ms = 0; /**< Latest timestamp in the chunk */
+    uint64_t offset = 0;     /**< File offset of the payload */
+    uint32_t bytes = 0;      /**< Payload size */
+};
+
+/**
+ * @class SeriesFileWriter
+ * @brief Encodes samples of one or more named series into a series file.
+ *
+ * Not thread-safe; SeriesRecorder drives it from a background thread.
+ */
+class SeriesFileWriter {
+public:
+    /** Samples per chunk unless configured otherwise. */
+    static constexpr size_t DEFAULT_CHUNK_SAMPLES = 512;
+
+    /**
+     * @brief Opens @p path for appending, writing the file header if new.
+     *
+     * An existing file is truncated to the end of its last complete
+     * chunk first, so new chunks never follow a torn one.
+     *
+     * @param path File to append to.
+     * @param chunk_samples Samples per chunk (at least 1).
+     */
+    explicit SeriesFileWriter(const std::string& path, size_t chunk_samples = DEFAULT_CHUNK_SAMPLES);
+
+    /**
+     * @brief Flushes partial chunks.
+     */
+    ~SeriesFileWriter();
+
+    SeriesFileWriter(const SeriesFileWriter&) = delete;
+    SeriesFileWriter& operator=(const SeriesFileWriter&) = delete;
+
+    /**
+     * @brief Returns true if the file opened and is not some other format.
+     */
+    bool is_open() const { return open_; }
+
+    /**
+     * @brief Registers a series.
+     * @param name Series name, e.g. "cpu/temperature_c".
+     * @return Series id for append().
+     */
+    int add_series(const std::string& name);
+
+    /**
+     * @brief Encodes one sample; writes the chunk out when it fills.
+     * @param series Id from add_series().
+     * @param time_ms Timestamp in milliseconds.
+     * @param value Sample value.
+     * @return false if @p series is unknown or the write failed.
+     */
+    bool append(int series, int64_t time_ms, double value);
+
+    /**
+     * @brief Writes every partial chunk and flushes the stream.
+     * @return false if a write failed.
+     */
+    bool flush();
+
+    /**
+     * @brief Returns the samples appended so far.
+     */
+    uint64_t samples() const { return samples_; }
+
+    /**
+     * @brief Returns the bytes appended to the file so far (headers included).
+     */
+    uint64_t bytes_written() const { return bytes_written_; }
+
+private:
+    struct Encoder;
+
+    bool write_chunk(Encoder& encoder);
+
+    std::ofstream file_;               /**< Output stream in append mode */
+    bool open_ = false;                /**< File is usable */
+    size_t chunk_samples_;             /**< Samples per chunk */
+    std::vector<Encoder> encoders_;    /**< One per registered series */
+    uint64_t samples_ = 0;             /**< Samples appended */
+    uint64_t bytes_written_ = 0;       /**< Bytes appended */
+};
+
+/**
+ * @class SeriesFileReader
+ * @brief Indexes a series file and decodes time ranges on demand.
+ */
+class SeriesFileReader {
+public:
+    /**
+     * @brief Reads every chunk header of @p path.
+     *
+     * A truncated trailing chunk (a crash mid-write) ends the index; the
+     * chunks before it stay readable.
+     */
+    explicit SeriesFileReader(const std::string& path);
+
+    /**
+     * @brief Returns true if the file exists and has a valid header.
+     */
+    bool is_valid() const { return valid_; }
+
+    /**
+     * @brief Returns the chunk index in file order.
+     */
+    const std::vector<SeriesChunkInfo>& chunks() const { return chunks_; }
+
+    /**
+     * @brief Returns the distinct series names in order of first appearance.
+     */
+    std::vector<std::string> series_names() const;
+
+    /**
+     * @brief Decodes the samples of @p name with from_ms <= time <= to_ms.
+     * @return Samples in file order.
+     */
+    std::vector<SeriesSample> query(const std::string& name, int64_t from_ms, int64_t to_ms) const;
+
+    /**
+     * @brief Returns the number of chunks decoded by query() so far.
+     */
+    size_t chunks_decoded() const { return chunks_decoded_; }
+
+private:
+    std::string path_;                     /**< File read */
+    bool valid_ = false;                   /**< Header matched */
+    std::vector<SeriesChunkInfo> chunks_;  /**< Chunk index */
+    mutable size_t chunks_decoded_ = 0;    /**< Chunks decoded by query() */
+};
+
+} // namespace cm5_peripheral_test
+
+#endif // SERIES_FILE_H
@@ -0,0 +1,130 @@
+/**
+ * @file series_recorder.h
+ * @brief Background writer feeding a series file from monitor loops.
+ * @author Sandesh Ghimire | sandesh@soccentric
+ * @copyright (C) Soccentric LLC. All rights reserved.
+ *
+ * Monitor loops hand samples to record(), which only copies them into a
+ * lock-free SpscRing; a background thread drains it in batches, encodes
+ * the samples and appends the chunks, so a slow or stalled disk never
+ * delays the sampling cadence. When the ring is full the sample is
+ * dropped and counted rather than blocking the caller. The thread also
+ * writes out partial chunks on a time bound, so a crash loses at most
+ * the last flush interval of each series, not a whole chunk.
+ */
+
+#ifndef SERIES_RECORDER_H
+#define SERIES_RECORDER_H
+
+#include "series_file.h"
+#include "spsc_ring.h"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace cm5_peripheral_test {
+
+/**
+ * @class SeriesRecorder
+ * @brief Queues samples for a SeriesFileWriter running on its own thread.
+ *
+ * record() and stop() must be called from one thread, the sampler;
+ * the counters and describe() may be read from any thread.
+ */
+class SeriesRecorder {
+public:
+    /** Samples queued before record() starts dropping. */
+    static constexpr size_t DEFAULT_QUEUE_CAPACITY = 4096;
+
+    /** Longest time a recorded sample waits in a partial chunk before it is written. */
+    static constexpr std::chrono::milliseconds DEFAULT_FLUSH_INTERVAL{5000};
+
+    /**
+     * @brief Opens the file, registers the series and starts the writer thread.
+     * @param path Series file to append to.
+     * @param series Series names; record() takes their index.
+     * @param queue_capacity Samples queued before record() drops
+     *        (rounded up to a power of two).
+     * @param chunk_samples Samples per chunk in the file.
+     * @param flush_interval Longest time between writing out partial
+     *        chunks while samples are pending.
+     */
+    SeriesRecorder(const std::string& path, const std::vector<std::string>& series,
+                   size_t queue_capacity = DEFAULT_QUEUE_CAPACITY,
+                   size_t chunk_samples = SeriesFileWriter::DEFAULT_CHUNK_SAMPLES,
+                   std::chrono::milliseconds flush_interval = DEFAULT_FLUSH_INTERVAL);
+
+    /**
+     * @brief Calls stop().
+     */
+    ~SeriesRecorder();
+
+    SeriesRecorder(const SeriesRecorder&) = delete;
+    SeriesRecorder& operator=(const SeriesRecorder&) = delete;
+
+    /**
+     * @brief Returns true if the file opened.
+     */
+    bool is_open() const { return writer_.is_open(); }
+
+    /**
+     * @brief Queues one sample without touching the disk.
+     * @param series Index into the names given at construction.
+     * @param time_ms Timestamp in milliseconds, e.g. now_ms().
+     * @param value Sample value.
+     * @return false if the recorder is closed or the queue is full.
+     */
+    bool record(int series, int64_t time_ms, double value);
+
+    /**
+     * @brief Writes everything queued, flushes partial chunks and joins
+     *        the thread. Further record() calls fail.
+     */
+    void stop();
+
+    /**
+     * @brief Returns the samples written to the file.
+     */
+    uint64_t written() const { return written_.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Returns the samples dropped because the queue was full.
+     */
+    uint64_t dropped() const { return queue_.overflowed(); }
+
+    /**
+     * @brief Describes what was recorded in one line.
+     * @return e.g. "Recorded 3600 samples (41.2 KiB) to soak.cm5ts, 0 dropped".
+     */
+    std::string describe() const;
+
+    /**
+     * @brief Returns wall-clock time in milliseconds since the epoch.
+     */
+    static int64_t now_ms();
+
+private:
+    struct Entry {
+        int series;       /**< Series index */
+        int64_t time_ms;  /**< Timestamp */
+        double value;     /**< Sample value */
+    };
+
+    void run();
+
+    std::string path_;                     /**< File being written */
+    std::chrono::milliseconds flush_interval_; /**< Bound on partial chunk age */
+    SeriesFileWriter writer_;              /**< Encoder, used only by the thread */
+    SpscRing<Entry> queue_;                /**< Samples waiting for the thread */
+    std::atomic<bool> stopping_{false};    /**< stop() was called */
+    std::atomic<uint64_t> written_{0};     /**< Samples written */
+    std::atomic<uint64_t> bytes_{0};       /**< Bytes appended to the file */
+    std::thread thread_;                   /**< Writer thread */
+};
+
+} // namespace cm5_peripheral_test
+
+#endif // SERIES_RECORDER_H
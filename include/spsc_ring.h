@@ -0,0 +1,163 @@
+/**
+ * @file spsc_ring.h
+ * @brief Bounded lock-free single-producer/single-consumer ring.
+ * @author Sandesh Ghimire | sandesh@soccentric
+ * @copyright (C) Soccentric LLC. All rights reserved.
+ *
+ * Hands items from one sampler thread to one consumer thread without a
+ * lock, so a slow consumer can never block the sampler. The producer
+ * owns the tail index and the consumer the head index; each lives on
+ * its own cache line next to the owner's cached copy of the other
+ * index, so in steady state a push or pop touches no line the other
+ * side is writing. When the ring is full, pushes are rejected and
+ * counted instead of waiting.
+ */
+
+#ifndef SPSC_RING_H
+#define SPSC_RING_H
+
+#include "cache_line.h"
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace cm5_peripheral_test {
+
+/**
+ * @class SpscRing
+ * @brief Fixed-capacity FIFO for exactly one producer and one consumer thread.
+ *
+ * push() may only be called from the producer thread and pop() from
+ * the consumer thread; the counters and size() may be read from any
+ * thread. T must be default-constructible and copy-assignable.
+ *
+ * @tparam T Item type, copied in and out of preallocated slots.
+ */
+template <typename T>
+class SpscRing {
+public:
+    /**
+     * @brief Allocates the slots.
+     * @param capacity Minimum number of items held; rounded up to a
+     *        power of two, at least 2.
+     */
+    explicit SpscRing(size_t capacity) {
+        size_t rounded = 2;
+        while (rounded < capacity) {
+            rounded <<= 1;
+        }
+        mask_ = rounded - 1;
+        slots_.resize(rounded);
+    }
+
+    SpscRing(const SpscRing&) = delete;
+    SpscRing& operator=(const SpscRing&) = delete;
+
+    /**
+     * @brief Returns the number of items the ring holds when full.
+     */
+    size_t capacity() const { return mask_ + 1; }
+
+    /**
+     * @brief Appends one item (producer only).
+     * @param item Item to copy in.
+     * @return false, counting an overflow, if the ring is full.
+     */
+    bool push(const T& item) { return push(&item, 1) == 1; }
+
+    /**
+     * @brief Appends up to @p count items with one index publication
+     *        (producer only).
+     * @param items Items to copy in, in order.
+     * @param count Number of items offered.
+     * @return Items accepted; the rest are counted as overflows.
+     */
+    size_t push(const T* items, size_t count) {
+        size_t tail = tail_.load(std::memory_order_relaxed);
+        if (capacity() - (tail - cached_head_) < count) {
+            cached_head_ = head_.load(std::memory_order_acquire);
+        }
+        size_t accepted = std::min(count, capacity() - (tail - cached_head_));
+        for (size_t i = 0; i < accepted; ++i) {
+            slots_[(tail + i) & mask_] = items[i];
+        }
+        if (accepted > 0) {
+            tail_.store(tail + accepted, std::memory_order_release);
+        }
+        if (accepted < count) {
+            overflowed_.store(overflowed_.load(std::memory_order_relaxed) + (count - accepted),
+                              std::memory_order_relaxed);
+        }
+        return accepted;
+    }
+
+    /**
+     * @brief Removes the oldest item (consumer only).
+     * @param item Receives the item.
+     * @return false if the ring is empty.
+     */
+    bool pop(T& item) { return pop(&item, 1) == 1; }
+
+    /**
+     * @brief Removes up to @p max_count of the oldest items with one
+     *        index publication (consumer only).
+     * @param items Receives the items, oldest first.
+     * @param max_count Room in @p items.
+     * @return Items removed.
+     */
+    size_t pop(T* items, size_t max_count) {
+        size_t head = head_.load(std::memory_order_relaxed);
+        if (cached_tail_ - head < max_count) {
+            cached_tail_ = tail_.load(std::memory_order_acquire);
+        }
+        size_t taken = std::min(max_count, cached_tail_ - head);
+        for (size_t i = 0; i < taken; ++i) {
+            items[i] = slots_[(head + i) & mask_];
+        }
+        if (taken > 0) {
+            head_.store(head + taken, std::memory_order_release);
+        }
+        return taken;
+    }
+
+    /**
+     * @brief Returns the number of items queued; a snapshot when read
+     *        while either side is running.
+     */
+    size_t size() const {
+        size_t head = head_.load(std::memory_order_acquire);
+        return tail_.load(std::memory_order_acquire) - head;
+    }
+
+    /**
+     * @brief Returns true if nothing is queued (same caveat as size()).
+     */
+    bool empty() const { return size() == 0; }
+
+    /**
+     * @brief Returns the items accepted since construction.
+     */
+    uint64_t pushed() const { return tail_.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Returns the items rejected because the ring was full.
+     */
+    uint64_t overflowed() const { return overflowed_.load(std::memory_order_relaxed); }
+
+private:
+    alignas(CACHE_LINE_SIZE) std::atomic<size_t> head_{0}; /**< Next slot to pop, written by the consumer */
+    size_t cached_tail_ = 0;                               /**< Consumer's last view of tail_ */
+
+    alignas(CACHE_LINE_SIZE) std::atomic<size_t> tail_{0}; /**< Next slot to fill, written by the producer */
+    size_t cached_head_ = 0;                               /**< Producer's last view of head_ */
+    std::atomic<uint64_t> overflowed_{0};                  /**< Items rejected, written by the producer */
+
+    alignas(CACHE_LINE_SIZE) size_t mask_ = 0;             /**< capacity() - 1 */
+    std::vector<T> slots_;                                 /**< Item storage */
+};
+
+} // namespace cm5_peripheral_test
+
+#endif // SPSC_RING_H
@@ -0,0 +1,248 @@
+/**
+ * @file streaming_stats.h
+ * @brief Constant-memory estimators for arbitrarily long sample streams.
+ * @author Sandesh Ghimire | sandesh@soccentric
+ * @copyright (C) Soccentric LLC. All rights reserved.
+ *
+ * Every estimator updates in O(1) per sample and keeps a fixed handful
+ * of numbers:
+ *
+ * - RunningMoments: mean and variance by Welford's recurrence, which
+ *   does not lose precision when the mean is large next to the spread.
+ * - P2Quantile: the P² algorithm of Jain and Chlamtac, five markers
+ *   adjusted with piecewise-parabolic interpolation.
+ * - Ewma: exponentially weighted mean with a time constant, so uneven
+ *   sample intervals weigh correctly.
+ * - Extremes: minimum and maximum with the time each was seen.
+ *
+ * StreamingSummary bundles them for one monitored quantity.
+ */
+
+#ifndef STREAMING_STATS_H
+#define STREAMING_STATS_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace cm5_peripheral_test {
+
+/**
+ * @class RunningMoments
+ * @brief Count, mean and variance by Welford's method.
+ */
+class RunningMoments {
+public:
+    /**
+     * @brief Adds one sample.
+     */
+    void add(double value);
+
+    /**
+     * @brief Returns the number of samples.
+     */
+    uint64_t count() const { return count_; }
+
+    /**
+     * @brief Returns the mean, 0 if empty.
+     */
+    double mean() const { return mean_; }
+
+    /**
+     * @brief Returns the sample variance (n - 1 denominator), 0 below two samples.
+     */
+    double variance() const;
+
+    /**
+     * @brief Returns the sample standard deviation.
+     */
+    double stddev() const;
+
+private:
+    uint64_t count_ = 0;  /**< Samples added */
+    double mean_ = 0.0;   /**< Running mean */
+    double m2_ = 0.0;     /**< Sum of squared deviations from the mean */
+};
+
+/**
+ * @class P2Quantile
+ * @brief Single quantile estimated with the P² algorithm.
+ */
+class P2Quantile {
+public:
+    /**
+     * @brief Creates an estimator.
+     * @param quantile Quantile to track, 0 < quantile < 1 (e.g. 0.99).
+     */
+    explicit P2Quantile(double quantile);
+
+    /**
+     * @brief Adds one sample.
+     */
+    void add(double value);
+
+    /**
+     * @brief Returns the estimate; exact (nearest rank) below five samples, 0 if empty.
+     */
+    double value() const;
+
+    /**
+     * @brief Returns the tracked quantile.
+     */
+    double quantile() const { return quantile_; }
+
+    /**
+     * @brief Returns the number of samples.
+     */
+    uint64_t count() const { return count_; }
+
+private:
+    double parabolic(int i, double d) const;
+    double linear(int i, int d) const;
+
+    double quantile_;          /**< Quantile tracked */
+    uint64_t count_ = 0;       /**< Samples added */
+    double heights_[5] = {};    /**< Marker heights (the first five samples until initialised) */
+    double positions_[5] = {};  /**< Actual marker positions */
+    double desired_[5] = {};    /**< Desired marker positions */
+    double increments_[5] = {}; /**< Desired position increment per sample */
+};
+
+/**
+ * @class Ewma
+ * @brief Exponentially weighted moving average over time.
+ */
+class Ewma {
+public:
+    /**
+     * @brief Creates an average.
+     * @param time_constant_s Time over which a step input reaches 63% of its new level.
+     */
+    explicit Ewma(double time_constant_s);
+
+    /**
+     * @brief Adds one sample; the first sample sets the average.
+     * @param time_s Time of the sample.
+     * @param value Sample value.
+     */
+    void add(double time_s, double value);
+
+    /**
+     * @brief Returns the average, 0 if empty.
+     */
+    double value() const { return value_; }
+
+    /**
+     * @brief Returns the time constant.
+     */
+    double time_constant() const { return time_constant_; }
+
+private:
+    double time_constant_;    /**< Time constant in seconds */
+    double value_ = 0.0;      /**< Current average */
+    double last_time_ = 0.0;  /**< Time of the last sample */
+    bool primed_ = false;     /**< A sample has been added */
+};
+
+/**
+ * @class Extremes
+ * @brief Minimum and maximum with their timestamps.
+ */
+class Extremes {
+public:
+    /**
+     * @brief Adds one sample.
+     */
+    void add(double time_s, double value);
+
+    /**
+     * @brief Returns true until a sample is added.
+     */
+    bool empty() const { return count_ == 0; }
+
+    /**
+     * @brief Returns the smallest sample.
+     */
+    double min() const { return min_; }
+
+    /**
+     * @brief Returns the largest sample.
+     */
+    double max() const { return max_; }
+
+    /**
+     * @brief Returns the time the smallest sample was first seen.
+     */
+    double min_time() const { return min_time_; }
+
+    /**
+     * @brief Returns the time the largest sample was first seen.
+     */
+    double max_time() const { return max_time_; }
+
+    /**
+     * @brief Returns max() - min(), 0 if empty.
+     */
+    double range() const { return count_ > 0 ? max_ - min_ : 0.0; }
+
+private:
+    uint64_t count_ = 0;     /**< Samples added */
+    double min_ = 0.0;       /**< Smallest sample */
+    double max_ = 0.0;       /**< Largest sample */
+    double min_time_ = 0.0;  /**< Time of the first smallest sample */
+    double max_time_ = 0.0;  /**< Time of the first largest sample */
+};
+
+/**
+ * @class StreamingSummary
+ * @brief Moments, median, p95, p99, EWMA and extremes of one quantity.
+ */
+class StreamingSummary {
+public:
+    /**
+     * @brief Creates an empty summary.
+     * @param name Quantity name, including the unit (e.g. "temperature_c").
+     * @param ewma_time_constant_s Time constant of the moving average.
+     */
+    StreamingSummary(std::string name, double ewma_time_constant_s);
+
+    /**
+     * @brief Adds one sample to every estimator.
+     */
+    void add(double time_s, double value);
+
+    /**
+     * @brief Returns the quantity name.
+     */
+    const std::string& name() const { return name_; }
+
+    /**
+     * @brief Returns the individual estimators.
+     */
+    const RunningMoments& moments() const { return moments_; }
+    const P2Quantile& median() const { return median_; }
+    const P2Quantile& p95() const { return p95_; }
+    const P2Quantile& p99() const { return p99_; }
+    const Ewma& ewma() const { return ewma_; }
+    const Extremes& extremes() const { return extremes_; }
+
+    /**
+     * @brief Describes the summary in one line.
+     * @return e.g. "temperature_c: n 600, mean 52.31 sd 1.20, p50 52.30 p95 54.10
+     *         p99 54.60, EWMA 53.02, min 49.80 at 3.0 s, max 55.10 at 588.0 s".
+     */
+    std::string describe() const;
+
+private:
+    std::string name_;         /**< Quantity name and unit */
+    RunningMoments moments_;   /**< Count, mean, variance */
+    P2Quantile median_;        /**< 50th percentile */
+    P2Quantile p95_;           /**< 95th percentile */
+    P2Quantile p99_;           /**< 99th percentile */
+    Ewma ewma_;                /**< Recent level */
+    Extremes extremes_;        /**< Minimum and maximum */
+};
+
+} // namespace cm5_peripheral_test
+
+#endif // STREAMING_STATS_H
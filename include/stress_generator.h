@@ -0,0 +1,128 @@
+/**
+ * @file stress_generator.h
+ * @brief Configurable CPU load generator for burn-in and thermal testing.
+ * @author Sandesh Ghimire | sandesh@soccentric
+ * @copyright (C) Soccentric LLC. All rights reserved.
+ *
+ * Drives pinned worker threads with selectable workloads (integer,
+ * FP/SIMD, cache thrashing, memory streaming) modulated by a per-core
+ * square wave. Running every core in phase at a low period reproduces
+ * the sharpest load steps the power supply will see; a 100% duty cycle
+ * gives the worst-case steady thermal load.
+ */
+
+#ifndef STRESS_GENERATOR_H
+#define STRESS_GENERATOR_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace cm5_peripheral_test {
+
+/**
+ * @enum StressWorkload
+ * @brief Kind of load a stress worker applies.
+ */
+enum class StressWorkload {
+    INTEGER,        /**< Independent integer multiply/xorshift chains */
+    FLOAT_SIMD,     /**< Vectorisable fused multiply-add over an L1-resident array */
+    CACHE_THRASH,   /**< Line-stride read-modify-write over a buffer larger than L2 */
+    MEMORY_STREAM   /**< Streaming triad over a buffer much larger than the LLC */
+};
+
+/**
+ * @brief Parses a workload name ("int", "fp", "cache", "mem").
+ * @param name Workload name.
+ * @param workload Receives the parsed workload.
+ * @return true if the name is recognised.
+ */
+bool parse_stress_workload(const std::string& name, StressWorkload& workload);
+
+/**
+ * @brief Returns the short name of a workload.
+ * @param workload Workload to name.
+ * @return Static string accepted by parse_stress_workload().
+ */
+const char* stress_workload_name(StressWorkload workload);
+
+/**
+ * @struct StressConfig
+ * @brief Load pattern for a StressGenerator.
+ */
+struct StressConfig {
+    std::vector<StressWorkload> mix{StressWorkload::INTEGER}; /**< Assigned round-robin to cores */
+    std::vector<int> cpus;                  /**< Cores to load; empty = every allowed CPU */
+    std::vector<double> duty_cycles{1.0};   /**< Per-core on-fraction (0..1), last entry repeats */
+    std::chrono::milliseconds period{100};  /**< Square-wave period */
+    bool staggered = false;                 /**< Offset each core's phase instead of switching together */
+    size_t cache_bytes = 0;                 /**< Largest per-core data cache, 0 = assume 2 MiB */
+};
+
+/**
+ * @class StressGenerator
+ * @brief Runs a StressConfig on pinned worker threads until stopped.
+ */
+class StressGenerator {
+public:
+    /**
+     * @brief Creates a generator; no threads are started.
+     * @param config Load pattern.
+     */
+    explicit StressGenerator(StressConfig config);
+
+    /**
+     * @brief Stops the workers if still running.
+     */
+    ~StressGenerator();
+
+    StressGenerator(const StressGenerator&) = delete;
+    StressGenerator& operator=(const StressGenerator&) = delete;
+
+    /**
+     * @brief Starts one worker per configured core.
+     * @return false if already running or no cores are available.
+     */
+    bool start();
+
+    /**
+     * @brief Signals the workers to stop and joins them.
+     */
+    void stop();
+
+    /**
+     * @brief Checks whether workers are running.
+     * @return true between start() and stop().
+     */
+    bool is_running() const { return !workers_.empty(); }
+
+    /**
+     * @brief Returns the work units completed by each worker so far.
+     * @return Per-core counts, in the order of the configured cores.
+     */
+    std::vector<uint64_t> work_done() const;
+
+    /**
+     * @brief Formats the configuration for reports.
+     * @return One line per core: CPU, workload and duty cycle.
+     */
+    std::string describe() const;
+
+private:
+    void worker(size_t index, int cpu);
+
+    StressConfig config_;                            /**< Load pattern */
+    std::vector<int> cpus_;                          /**< Resolved core list */
+    std::vector<std::thread> workers_;               /**< Worker threads */
+    std::unique_ptr<std::atomic<uint64_t>[]> work_;  /**< Work units per worker */
+    std::atomic<bool> stop_{false};                  /**< Stop request */
+    std::chrono::steady_clock::time_point epoch_;    /**< Common phase reference */
+};
+
+} // namespace cm5_peripheral_test
+
+#endif // STRESS_GENERATOR_H
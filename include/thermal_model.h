@@ -0,0 +1,142 @@
+/**
+ * @file thermal_model.h
+ * @brief Online first-order thermal model and time-to-limit prediction.
+ * @author Sandesh Ghimire | sandesh@soccentric
+ * @copyright (C) Soccentric LLC. All rights reserved.
+ *
+ * Models the SoC as one thermal mass behind one thermal resistance:
+ *
+ *     dT/dt = (T_ambient + rise * load - T) / tau
+ *
+ * With samples a fixed interval dt apart this becomes the linear
+ * recurrence T[k+1] = a T[k] + c0 + c1 u[k], a = exp(-dt / tau), so
+ * a least-squares fit of each temperature on the previous one and the
+ * load in between recovers tau, the ambient temperature and the
+ * steady-state rise at full load. The model keeps only the normal-equation
+ * sums, so memory does not grow with the run length, and the fit can be
+ * read at any point. Extrapolating the exponential gives the time to a
+ * trip point long before a soak would reach it.
+ */
+
+#ifndef THERMAL_MODEL_H
+#define THERMAL_MODEL_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace cm5_peripheral_test {
+
+/**
+ * @struct ThermalFit
+ * @brief Parameters recovered by ThermalModel::fit().
+ */
+struct ThermalFit {
+    bool valid = false;             /**< Enough samples and a decaying response (0 < a < 1) */
+    bool load_separable = false;    /**< Load varied enough to separate ambient from rise */
+    size_t samples = 0;             /**< Sample pairs used */
+    double interval_s = 0.0;        /**< Mean time between samples */
+    double tau_s = 0.0;             /**< Time constant */
+    double ambient_c = 0.0;         /**< Steady-state temperature at zero load (if separable) */
+    double rise_c = 0.0;            /**< Steady-state rise at full load (if separable) */
+    double mean_load = 0.0;         /**< Mean load over the run, 0..1 */
+    double steady_state_c = 0.0;    /**< Steady-state temperature at the mean load */
+    double rms_error_c = 0.0;       /**< RMS one-step prediction error */
+};
+
+/**
+ * @class ThermalModel
+ * @brief Accumulates (temperature, load) samples and fits the model on demand.
+ */
+class ThermalModel {
+public:
+    /**
+     * @brief Adds one reading.
+     * @param time_s Time of the reading in seconds on any monotonic timeline.
+     * @param temperature_c Temperature at @p time_s.
+     * @param load Mean CPU load (0..1) since the previous reading; ignored
+     *        for the first reading.
+     */
+    void add_sample(double time_s, double temperature_c, double load);
+
+    /**
+     * @brief Solves the least-squares fit over all readings so far.
+     * @return ThermalFit; valid is false until the response can be fitted.
+     */
+    ThermalFit fit() const;
+
+    /**
+     * @brief Returns the number of readings added.
+     */
+    size_t readings() const { return readings_; }
+
+private:
+    size_t readings_ = 0;         /**< Readings added */
+    double previous_time_ = 0.0;  /**< Time of the last reading */
+    double previous_temp_ = 0.0;  /**< Temperature of the last reading */
+    double elapsed_ = 0.0;        /**< Sum of sample intervals */
+    double sums_[3][3] = {};      /**< Sum of x x^T over x = (T[k], 1, u[k]) */
+    double targets_[3] = {};      /**< Sum of x T[k+1] */
+    double target_squares_ = 0.0; /**< Sum of T[k+1]^2 */
+};
+
+/**
+ * @brief Predicts the time until the temperature reaches @p limit_c.
+ * @param fit Valid model fit.
+ * @param temperature_c Current temperature.
+ * @param load Load to hold from now on (0..1); only used if the fit
+ *        separates ambient from rise, otherwise the mean load applies.
+ * @return Seconds; 0 if already at or above the limit, infinity if the
+ *         steady state stays below it.
+ */
+double predict_time_to_limit(const ThermalFit& fit, double temperature_c, double load, double limit_c);
+
+/**
+ * @brief Formats a fit and its prediction for a report.
+ * @param fit Model fit (valid or not).
+ * @param temperature_c Latest temperature.
+ * @param load Latest load (0..1).
+ * @param limit_c Trip point to predict against.
+ * @return Two lines: the fitted parameters, then time to @p limit_c at
+ *         the latest load and, when separable, at full load.
+ */
+std::string format_thermal_prediction(const ThermalFit& fit, double temperature_c, double load, double limit_c);
+
+/**
+ * @brief Reads the lowest passive trip point of a thermal zone.
+ * @param zone_path Thermal zone directory, e.g. /sys/class/thermal/thermal_zone0.
+ * @return Trip temperature in °C, falling back to the lowest trip of any
+ *         type; -1 if the zone exposes none.
+ */
+double read_trip_point(const std::string& zone_path = "/sys/class/thermal/thermal_zone0");
+
+/**
+ * @class SystemLoadSampler
+ * @brief Busy fraction of all CPUs between calls, from /proc/stat.
+ */
+class SystemLoadSampler {
+public:
+    /**
+     * @brief Reads the baseline counters.
+     * @param proc_root Root of procfs (overridable for tests).
+     */
+    explicit SystemLoadSampler(const std::string& proc_root = "/proc");
+
+    /**
+     * @brief Returns the busy fraction since the previous call.
+     * @return 0..1, or -1 if /proc/stat could not be read.
+     */
+    double sample();
+
+private:
+    bool read(uint64_t& busy, uint64_t& total) const;
+
+    std::string stat_path_;  /**< /proc/stat */
+    uint64_t busy_ = 0;      /**< Busy jiffies at the last call */
+    uint64_t total_ = 0;     /**< Total jiffies at the last call */
+    bool valid_ = false;     /**< Baseline was read */
+};
+
+} // namespace cm5_peripheral_test
+
+#endif // THERMAL_MODEL_H
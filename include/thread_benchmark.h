@@ -0,0 +1,76 @@
+/**
+ * @file thread_benchmark.h
+ * @brief Thread lifecycle and blocking synchronization cost benchmarks.
+ * @author Sandesh Ghimire | sandesh@soccentric
+ * @copyright (C) Soccentric LLC. All rights reserved.
+ *
+ * Measures what it costs to start work on another core: creating and
+ * joining a thread, and waking a blocked thread through a condition
+ * variable, a raw futex, a barrier or an eventfd. The wake-up
+ * primitives are timed as a token passed around a ring of pinned
+ * threads that each block until it arrives, so every operation is a
+ * full sleep/wake through the kernel scheduler.
+ */
+
+#ifndef THREAD_BENCHMARK_H
+#define THREAD_BENCHMARK_H
+
+#include <cstdint>
+#include <vector>
+
+namespace cm5_peripheral_test {
+
+/**
+ * @enum ThreadOperation
+ * @brief Operations covered by the thread cost benchmark.
+ */
+enum class ThreadOperation {
+    CREATE_JOIN,      /**< std::thread construction and join, per thread */
+    CONDVAR_HANDOFF,  /**< Token passed via std::condition_variable, per hop */
+    FUTEX,            /**< Token passed via FUTEX_WAIT/FUTEX_WAKE, per hop */
+    BARRIER,          /**< pthread_barrier_wait crossing by all threads */
+    EVENTFD           /**< Token passed via eventfd write/read, per hop */
+};
+
+/**
+ * @brief Returns a short display name for an operation.
+ * @param operation Operation to name.
+ * @return Static string.
+ */
+const char* thread_operation_name(ThreadOperation operation);
+
+/**
+ * @struct ThreadCostResult
+ * @brief Latency distribution of one operation at one thread count.
+ */
+struct ThreadCostResult {
+    ThreadOperation operation;  /**< Operation measured */
+    int threads = 0;            /**< Threads taking part */
+    uint64_t rounds = 0;        /**< Rounds timed after warm-up */
+    double median_ns = 0.0;     /**< Median cost per operation */
+    double p99_ns = 0.0;        /**< 99th percentile cost per operation */
+    double max_ns = 0.0;        /**< Worst cost per operation */
+    bool completed = false;     /**< Every thread saw every round */
+};
+
+/**
+ * @brief Times @p rounds rounds of @p operation.
+ *
+ * A round is one batch of threads created and joined, one lap of the
+ * token around the ring, or one barrier crossing. Create/join and token
+ * rounds are divided by the thread count so results are per thread or
+ * per hop. Threads are pinned round-robin to @p cpus; fewer than two
+ * CPUs still uses two threads, which then hand off on a shared core.
+ *
+ * @param operation Operation to measure.
+ * @param cpus CPUs to run on.
+ * @param threads Threads taking part (at least 2).
+ * @param rounds Rounds to time, after a short untimed warm-up.
+ * @return ThreadCostResult.
+ */
+ThreadCostResult run_thread_benchmark(ThreadOperation operation, const std::vector<int>& cpus, int threads,
+                                      uint64_t rounds);
+
+} // namespace cm5_peripheral_test
+
+#endif // THREAD_BENCHMARK_H
@@ -0,0 +1,113 @@
+/**
+ * @file time_series.h
+ * @brief Fixed-capacity ring buffer of timestamped samples.
+ * @author Sandesh Ghimire | sandesh@soccentric
+ * @copyright (C) Soccentric LLC. All rights reserved.
+ *
+ * Monitor loops append one (time, value) pair per reading. Both columns
+ * are allocated once at construction; when the buffer is full the
+ * oldest sample is overwritten, so memory is the same for a one-minute
+ * check and a multi-day soak and the most recent window is always
+ * available for the report.
+ */
+
+#ifndef TIME_SERIES_H
+#define TIME_SERIES_H
+
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace cm5_peripheral_test {
+
+/**
+ * @class TimeSeries
+ * @brief Named ring buffer with separate timestamp and value columns.
+ */
+class TimeSeries {
+public:
+    /**
+     * @brief Allocates both columns.
+     * @param name Series name, including the unit (e.g. "temperature_c").
+     * @param capacity Samples retained; at least 1.
+     */
+    TimeSeries(std::string name, size_t capacity);
+
+    /**
+     * @brief Appends a sample, overwriting the oldest one when full.
+     * @param time_s Seconds since the start of the run.
+     * @param value Sample value.
+     */
+    void append(double time_s, double value);
+
+    /**
+     * @brief Drops all samples, keeping the allocation.
+     */
+    void clear();
+
+    /**
+     * @brief Returns the i-th retained timestamp, 0 being the oldest.
+     */
+    double time_at(size_t index) const { return times_[physical(index)]; }
+
+    /**
+     * @brief Returns the i-th retained value, 0 being the oldest.
+     */
+    double value_at(size_t index) const { return values_[physical(index)]; }
+
+    /**
+     * @brief Returns the series name.
+     */
+    const std::string& name() const { return name_; }
+
+    /**
+     * @brief Returns the number of samples retained.
+     */
+    size_t size() const { return size_; }
+
+    /**
+     * @brief Returns the number of samples the buffer can hold.
+     */
+    size_t capacity() const { return times_.size(); }
+
+    /**
+     * @brief Returns the number of samples appended since construction or clear().
+     */
+    uint64_t appended() const { return appended_; }
+
+    /**
+     * @brief Returns the number of samples overwritten.
+     */
+    uint64_t overwritten() const { return appended_ - size_; }
+
+    /**
+     * @brief Describes the retained window in one line.
+     * @return e.g. "temperature_c: 3600 of 86400 samples retained, 82800.0 s to 86399.0 s".
+     */
+    std::string describe() const;
+
+    /**
+     * @brief Writes the retained samples, oldest first, as "time_s,<name>" CSV.
+     * @param out Stream to write to.
+     */
+    void write_csv(std::ostream& out) const;
+
+private:
+    size_t physical(size_t index) const {
+        size_t slot = head_ + index;
+        return slot < times_.size() ? slot : slot - times_.size();
+    }
+
+    std::string name_;           /**< Series name and unit */
+    std::vector<double> times_;  /**< Timestamp column */
+    std::vector<double> values_; /**< Value column */
+    size_t head_ = 0;            /**< Slot of the oldest retained sample */
+    size_t size_ = 0;            /**< Samples retained */
+    uint64_t appended_ = 0;      /**< Samples appended */
+};
+
+} // namespace cm5_peripheral_test
+
+#endif // TIME_SERIES_H
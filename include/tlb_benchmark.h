@@ -0,0 +1,98 @@
+/**
+ * @file tlb_benchmark.h
+ * @brief Page-stride access latency with base, transparent and hugetlbfs pages.
+ * @author Sandesh Ghimire | sandesh@soccentric
+ * @copyright (C) Soccentric LLC. All rights reserved.
+ *
+ * Chases a pointer through one cache line of every base page in a
+ * working set, visiting the pages in a random order so the hardware
+ * prefetcher cannot hide the walk. The line used within each page
+ * rotates so the chase spreads over all cache sets. With base pages
+ * every access needs its own TLB entry; with huge pages one entry
+ * covers hundreds of consecutive base pages. Comparing the backings
+ * at the same working set therefore isolates the TLB reach and
+ * page-walk cost from the cache misses they share.
+ */
+
+#ifndef TLB_BENCHMARK_H
+#define TLB_BENCHMARK_H
+
+#include "measurement_harness.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace cm5_peripheral_test {
+
+/**
+ * @enum PageBacking
+ * @brief How the working set is mapped.
+ */
+enum class PageBacking {
+    BASE_PAGES,        /**< Anonymous mapping with MADV_NOHUGEPAGE */
+    TRANSPARENT_HUGE,  /**< Huge-aligned anonymous mapping with MADV_HUGEPAGE */
+    HUGETLB            /**< MAP_HUGETLB from the reserved hugetlbfs pool */
+};
+
+/**
+ * @brief Returns a short display name for a backing.
+ * @param backing Backing to name.
+ * @return Static string.
+ */
+const char* page_backing_name(PageBacking backing);
+
+/**
+ * @brief Returns the kernel's base page size.
+ */
+size_t base_page_size();
+
+/**
+ * @brief Returns the PMD huge page size used by THP and the default hugetlbfs pool.
+ * @param sysfs_root Root of sysfs (overridable for tests).
+ * @return hpage_pmd_size, or 2 MiB if it cannot be read.
+ */
+size_t huge_page_size(const std::string& sysfs_root = "/sys");
+
+/**
+ * @brief Reads the AnonHugePages figure of the mapping containing @p address.
+ * @param address Any address inside the mapping.
+ * @param smaps_path smaps file to parse (overridable for tests).
+ * @return Bytes of the mapping backed by transparent huge pages.
+ */
+size_t anon_huge_bytes(const void* address, const std::string& smaps_path = "/proc/self/smaps");
+
+/**
+ * @struct TlbResult
+ * @brief Outcome of one backing at one working-set size.
+ */
+struct TlbResult {
+    PageBacking backing;             /**< Backing measured */
+    size_t working_set = 0;          /**< Bytes spanned by the chase */
+    size_t pages = 0;                /**< Base pages visited per lap */
+    double ns_per_access = 0.0;      /**< Median over the timed laps of the mean load latency */
+    MeasurementSummary latency;      /**< ns per load across the timed laps */
+    double misses_per_access = -1.0; /**< DTLB read misses per load, -1 if no counter */
+    double huge_fraction = 0.0;      /**< Share of the working set on huge pages */
+    bool available = false;          /**< Mapping could be created */
+    std::string note;                /**< Reason when unavailable */
+};
+
+/**
+ * @brief Runs the page-stride chase on the calling thread.
+ *
+ * The mapping is populated once before timing starts, so page faults
+ * are not part of the measured latency; the chase is then repeated
+ * through measure_until_converged() on that mapping.
+ *
+ * @param backing How to map the working set.
+ * @param working_set Bytes to span; rounded up to whole base pages.
+ * @param accesses Dependent loads per timed lap.
+ * @param criteria When to stop repeating the lap.
+ * @return TlbResult.
+ */
+TlbResult run_tlb_benchmark(PageBacking backing, size_t working_set, uint64_t accesses,
+                            const ConvergenceCriteria& criteria = ConvergenceCriteria());
+
+} // namespace cm5_peripheral_test
+
+#endif // TLB_BENCHMARK_H
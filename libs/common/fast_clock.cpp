@@ -0,0 +1,166 @@
+/**
+ * @file fast_clock.cpp
+ * @brief Calibration of the fast timestamp counter.
+ * @author Sandesh Ghimire | sandesh@soccentric
+ * @copyright (C) Soccentric LLC. All rights reserved.
+ */
+
+#include "fast_clock.h"
+#include <chrono>
+#include <limits>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <cpuid.h>
+#endif
+
+namespace cm5_peripheral_test {
+
+namespace {
+
+/** Interval between the two calibration points when the rate is unknown. */
+constexpr long CALIBRATION_INTERVAL_NS = 20000000;
+
+/** Attempts per calibration point; the tightest bracket wins. */
+constexpr int CALIBRATION_ATTEMPTS = 16;
+
+/**
+ * @brief Simultaneous reading of the counter and CLOCK_MONOTONIC.
+ */
+struct ClockPair {
+    uint64_t ticks = 0;
+    uint64_t ns = 0;
+};
+
+/**
+ * @brief Brackets a CLOCK_MONOTONIC read between two counter reads and
+ *        keeps the attempt with the smallest bracket.
+ */
+ClockPair sample_pair() {
+    ClockPair best;
+    uint64_t best_width = std::numeric_limits<uint64_t>::max();
+    for (int attempt = 0; attempt < CALIBRATION_ATTEMPTS; ++attempt) {
+        uint64_t before = FastClock::read_counter();
+        uint64_t ns = monotonic_ns();
+        uint64_t after = FastClock::read_counter();
+        if (after >= before && after - before < best_width) {
+            best_width = after - before;
+            best.ticks = before + (after - before) / 2;
+            best.ns = ns;
+        }
+    }
+    return best;
+}
+
+/**
+ * @brief Checks whether the CPU has a counter that runs at a constant
+ *        rate through frequency changes and idle states.
+ */
+bool hardware_counter_usable() {
+#if defined(__aarch64__)
+    return true;  // the generic timer is architecturally constant-rate
+#elif defined(__x86_64__) || defined(__i386__)
+    unsigned int eax = 0, ebx = 0, ecx = 0, edx = 0;
+    if (__get_cpuid(0x80000000, &eax, &ebx, &ecx, &edx) == 0 || eax < 0x80000007) {
+        return false;
+    }
+    __get_cpuid(0x80000007, &eax, &ebx, &ecx, &edx);
+    return (edx & (1u << 8)) != 0;  // invariant TSC
+#else
+    return false;
+#endif
+}
+
+/**
+ * @brief Returns the counter frequency the hardware advertises, or 0.
+ */
+uint64_t advertised_frequency_hz() {
+#if defined(__aarch64__)
+    uint64_t frequency;
+    asm volatile("mrs %0, cntfrq_el0" : "=r"(frequency));
+    return frequency;
+#else
+    return 0;
+#endif
+}
+
+} // namespace
+
+const char* clock_source_name(ClockSource source) {
+    switch (source) {
+    case ClockSource::FAST_COUNTER: return "fast counter";
+    case ClockSource::STEADY_CLOCK: return "steady_clock";
+    case ClockSource::SYSTEM_CLOCK: return "system_clock";
+    case ClockSource::MONOTONIC_RAW: return "CLOCK_MONOTONIC_RAW";
+    case ClockSource::MONOTONIC_COARSE: return "CLOCK_MONOTONIC_COARSE";
+    }
+    return "unknown";
+}
+
+uint64_t read_clock_ns(ClockSource source) {
+    timespec ts;
+    switch (source) {
+    case ClockSource::FAST_COUNTER:
+        return FastClock::instance().now_ns();
+    case ClockSource::STEADY_CLOCK:
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                         std::chrono::steady_clock::now().time_since_epoch())
+                                         .count());
+    case ClockSource::SYSTEM_CLOCK:
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                         std::chrono::system_clock::now().time_since_epoch())
+                                         .count());
+    case ClockSource::MONOTONIC_RAW:
+        clock_gettime(CLOCK_MONOTONIC_RAW, &ts);
+        break;
+    case ClockSource::MONOTONIC_COARSE:
+        clock_gettime(CLOCK_MONOTONIC_COARSE, &ts);
+        break;
+    }
+    return static_cast<uint64_t>(ts.tv_sec) * 1000000000ULL + static_cast<uint64_t>(ts.tv_nsec);
+}
+
+const FastClock& FastClock::instance() {
+    static const FastClock clock;
+    return clock;
+}
+
+FastClock::FastClock() {
+    if (!hardware_counter_usable()) {
+        return;
+    }
+
+    ClockPair start = sample_pair();
+    uint64_t frequency = advertised_frequency_hz();
+    if (frequency > 0) {
+        hardware_ = true;
+        ns_per_tick_ = 1e9 / static_cast<double>(frequency);
+        base_ticks_ = start.ticks;
+        base_ns_ = start.ns;
+        return;
+    }
+
+    timespec interval = {0, CALIBRATION_INTERVAL_NS};
+    nanosleep(&interval, nullptr);
+    ClockPair end = sample_pair();
+    if (end.ticks <= start.ticks || end.ns <= start.ns) {
+        return;
+    }
+
+    hardware_ = true;
+    ns_per_tick_ = static_cast<double>(end.ns - start.ns) / static_cast<double>(end.ticks - start.ticks);
+    base_ticks_ = end.ticks;
+    base_ns_ = end.ns;
+}
+
+const char* FastClock::counter_name() const {
+    if (!hardware_) {
+        return "CLOCK_MONOTONIC";
+    }
+#if defined(__aarch64__)
+    return "CNTVCT_EL0";
+#else
+    return "TSC";
+#endif
+}
+
+} // namespace cm5_peripheral_test
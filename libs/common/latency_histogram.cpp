@@ -0,0 +1,301 @@
+/**
+ * @file latency_histogram.cpp
+ * @brief Implementation of the log-linear latency histogram.
+ * @author Sandesh Ghimire | sandesh@soccentric
+ * @copyright (C) Soccentric LLC. All rights reserved.
+ */
+
+#include "latency_histogram.h"
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <sstream>
+#include <utility>
+#include <vector>
+
+namespace cm5_peripheral_test {
+
+namespace {
+
+/** Percentiles listed by LatencyHistogram::summary(), with their labels. */
+constexpr struct {
+    double percentile;
+    const char* label;
+} SUMMARY_PERCENTILES[] = {{50.0, "p50"}, {90.0, "p90"}, {99.0, "p99"}, {99.9, "p99.9"}};
+
+/** Leading tag of the serialized form; bump when the layout changes. */
+constexpr const char* SERIAL_TAG = "hdr1";
+
+/**
+ * @brief Bucket of @p value for a given resolution, without clamping.
+ */
+size_t raw_index(uint64_t value, int bits) {
+    if (value < (uint64_t(1) << bits)) {
+        return static_cast<size_t>(value);
+    }
+    int highest_bit = 63 - __builtin_clzll(value);
+    int shift = highest_bit - bits + 1;
+    return (static_cast<size_t>(shift) << (bits - 1)) + static_cast<size_t>(value >> shift);
+}
+
+void increase(std::atomic<uint64_t>& counter, uint64_t amount) {
+    // Single writer: a relaxed load and store avoids a locked add
+    counter.store(counter.load(std::memory_order_relaxed) + amount, std::memory_order_relaxed);
+}
+
+} // namespace
+
+LatencyHistogram::LatencyHistogram(std::string name, uint64_t highest_value, int precision_bits)
+    : name_(std::move(name)),
+      highest_value_(std::max<uint64_t>(highest_value, 1)),
+      precision_bits_(std::min(std::max(precision_bits, 2), 16)),
+      bucket_count_(raw_index(highest_value_, precision_bits_) + 1),
+      counts_(new std::atomic<uint64_t>[bucket_count_]()) {}
+
+LatencyHistogram::LatencyHistogram(const LatencyHistogram& other)
+    : name_(other.name_),
+      highest_value_(other.highest_value_),
+      precision_bits_(other.precision_bits_),
+      bucket_count_(other.bucket_count_),
+      counts_(new std::atomic<uint64_t>[bucket_count_]()) {
+    copy_from(other);
+}
+
+LatencyHistogram& LatencyHistogram::operator=(const LatencyHistogram& other) {
+    if (this != &other) {
+        name_ = other.name_;
+        if (bucket_count_ != other.bucket_count_) {
+            counts_.reset(new std::atomic<uint64_t>[other.bucket_count_]());
+        }
+        highest_value_ = other.highest_value_;
+        precision_bits_ = other.precision_bits_;
+        bucket_count_ = other.bucket_count_;
+        copy_from(other);
+    }
+    return *this;
+}
+
+LatencyHistogram::LatencyHistogram(LatencyHistogram&& other) noexcept
+    : name_(std::move(other.name_)),
+      highest_value_(other.highest_value_),
+      precision_bits_(other.precision_bits_),
+      bucket_count_(other.bucket_count_),
+      counts_(std::move(other.counts_)),
+      count_(other.count()),
+      min_(other.min_.load(std::memory_order_relaxed)),
+      max_(other.max()),
+      sum_(other.sum_.load(std::memory_order_relaxed)) {
+    other.bucket_count_ = 0;
+}
+
+LatencyHistogram& LatencyHistogram::operator=(LatencyHistogram&& other) noexcept {
+    if (this != &other) {
+        name_ = std::move(other.name_);
+        highest_value_ = other.highest_value_;
+        precision_bits_ = other.precision_bits_;
+        bucket_count_ = other.bucket_count_;
+        counts_ = std::move(other.counts_);
+        count_.store(other.count(), std::memory_order_relaxed);
+        min_.store(other.min_.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        max_.store(other.max(), std::memory_order_relaxed);
+        sum_.store(other.sum_.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        other.bucket_count_ = 0;
+    }
+    return *this;
+}
+
+void LatencyHistogram::copy_from(const LatencyHistogram& other) {
+    for (size_t i = 0; i < bucket_count_; ++i) {
+        counts_[i].store(other.counts_[i].load(std::memory_order_relaxed), std::memory_order_relaxed);
+    }
+    count_.store(other.count(), std::memory_order_relaxed);
+    min_.store(other.min_.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    max_.store(other.max(), std::memory_order_relaxed);
+    sum_.store(other.sum_.load(std::memory_order_relaxed), std::memory_order_relaxed);
+}
+
+void LatencyHistogram::record(uint64_t value, uint64_t count) {
+    if (count == 0 || bucket_count_ == 0) {
+        return;
+    }
+    increase(counts_[index_of(value)], count);
+    increase(count_, count);
+    increase(sum_, value * count);
+    if (value < min_.load(std::memory_order_relaxed)) {
+        min_.store(value, std::memory_order_relaxed);
+    }
+    if (value > max()) {
+        max_.store(value, std::memory_order_relaxed);
+    }
+}
+
+bool LatencyHistogram::add(const LatencyHistogram& other) {
+    if (other.precision_bits_ != precision_bits_ || other.bucket_count_ != bucket_count_) {
+        return false;
+    }
+    uint64_t added = 0;
+    for (size_t i = 0; i < bucket_count_; ++i) {
+        uint64_t count = other.counts_[i].load(std::memory_order_relaxed);
+        if (count > 0) {
+            increase(counts_[i], count);
+            added += count;
+        }
+    }
+    if (added == 0) {
+        return true;
+    }
+    // Derive the total from the buckets so it stays consistent with them
+    // even if the other owner recorded during the merge
+    increase(count_, added);
+    increase(sum_, other.sum_.load(std::memory_order_relaxed));
+    min_.store(std::min(min_.load(std::memory_order_relaxed), other.min_.load(std::memory_order_relaxed)),
+               std::memory_order_relaxed);
+    max_.store(std::max(max(), other.max()), std::memory_order_relaxed);
+    return true;
+}
+
+void LatencyHistogram::reset() {
+    for (size_t i = 0; i < bucket_count_; ++i) {
+        counts_[i].store(0, std::memory_order_relaxed);
+    }
+    count_.store(0, std::memory_order_relaxed);
+    min_.store(UINT64_MAX, std::memory_order_relaxed);
+    max_.store(0, std::memory_order_relaxed);
+    sum_.store(0, std::memory_order_relaxed);
+}
+
+uint64_t LatencyHistogram::percentile(double percentile) const {
+    uint64_t total = count();
+    if (total == 0) {
+        return 0;
+    }
+    double fraction = std::min(std::max(percentile, 0.0), 100.0) / 100.0;
+    uint64_t target = std::max<uint64_t>(1, static_cast<uint64_t>(std::ceil(fraction * total)));
+    uint64_t seen = 0;
+    for (size_t i = 0; i < bucket_count_; ++i) {
+        seen += counts_[i].load(std::memory_order_relaxed);
+        if (seen >= target) {
+            // The last bucket also holds everything above the highest value
+            uint64_t highest = i + 1 == bucket_count_ ? max() : highest_in_bucket(i);
+            return std::min(std::max(highest, min()), max());
+        }
+    }
+    return max();
+}
+
+uint64_t LatencyHistogram::min() const {
+    return count() > 0 ? min_.load(std::memory_order_relaxed) : 0;
+}
+
+double LatencyHistogram::mean() const {
+    uint64_t total = count();
+    return total > 0 ? static_cast<double>(sum_.load(std::memory_order_relaxed)) / total : 0.0;
+}
+
+std::string LatencyHistogram::summary(double divisor, const char* unit) const {
+    std::stringstream out;
+    out << std::fixed << std::setprecision(1);
+    out << "n " << count();
+    if (count() == 0) {
+        return out.str();
+    }
+    std::string suffix = unit[0] != '\0' ? std::string(" ") + unit : std::string();
+    for (const auto& entry : SUMMARY_PERCENTILES) {
+        out << ", " << entry.label << " " << percentile(entry.percentile) / divisor << suffix;
+    }
+    out << ", max " << max() / divisor << suffix;
+    return out.str();
+}
+
+std::string LatencyHistogram::serialize() const {
+    std::stringstream out;
+    out << SERIAL_TAG << "/" << precision_bits_ << "/" << highest_value_ << "/" << min() << "/" << max() << "/"
+        << sum_.load(std::memory_order_relaxed) << "/";
+    size_t previous = 0;
+    bool first = true;
+    for (size_t i = 0; i < bucket_count_; ++i) {
+        uint64_t count = counts_[i].load(std::memory_order_relaxed);
+        if (count == 0) {
+            continue;
+        }
+        out << (first ? "" : ",") << i - previous;
+        if (count > 1) {
+            out << "x" << count;
+        }
+        previous = i;
+        first = false;
+    }
+    return out.str();
+}
+
+bool LatencyHistogram::deserialize(const std::string& name, const std::string& text, LatencyHistogram& out) {
+    std::vector<std::string> fields;
+    std::stringstream stream(text);
+    std::string field;
+    while (std::getline(stream, field, '/')) {
+        fields.push_back(field);
+    }
+    if (!text.empty() && text.back() == '/') {
+        fields.push_back("");
+    }
+    if (fields.size() != 7 || fields[0] != SERIAL_TAG) {
+        return false;
+    }
+
+    uint64_t header[5];
+    for (int i = 0; i < 5; ++i) {
+        std::istringstream number(fields[i + 1]);
+        if (!(number >> header[i]) || !number.eof()) {
+            return false;
+        }
+    }
+    LatencyHistogram result(name, header[1], static_cast<int>(header[0]));
+    if (result.precision_bits_ != static_cast<int>(header[0])) {
+        return false;
+    }
+
+    std::stringstream buckets(fields[6]);
+    std::string entry;
+    size_t index = 0;
+    uint64_t total = 0;
+    while (std::getline(buckets, entry, ',')) {
+        size_t gap = 0;
+        uint64_t count = 1;
+        char separator = 0;
+        std::istringstream parts(entry);
+        if (!(parts >> gap)) {
+            return false;
+        }
+        if (parts >> separator && (separator != 'x' || !(parts >> count))) {
+            return false;
+        }
+        index += gap;
+        if (index >= result.bucket_count_ || count == 0) {
+            return false;
+        }
+        increase(result.counts_[index], count);
+        total += count;
+    }
+
+    result.count_.store(total, std::memory_order_relaxed);
+    result.min_.store(total > 0 ? header[2] : UINT64_MAX, std::memory_order_relaxed);
+    result.max_.store(header[3], std::memory_order_relaxed);
+    result.sum_.store(header[4], std::memory_order_relaxed);
+    out = std::move(result);
+    return true;
+}
+
+size_t LatencyHistogram::index_of(uint64_t value) const {
+    return std::min(raw_index(value, precision_bits_), bucket_count_ - 1);
+}
+
+uint64_t LatencyHistogram::highest_in_bucket(size_t index) const {
+    if (index < (size_t(1) << precision_bits_)) {
+        return index;
+    }
+    size_t shift = (index >> (precision_bits_ - 1)) - 1;
+    uint64_t sub_bucket = index - (shift << (precision_bits_ - 1));
+    return ((sub_bucket + 1) << shift) - 1;
+}
+
+} // namespace cm5_peripheral_test
@@ -0,0 +1,132 @@
+/**
+ * @file measurement_harness.cpp
+ * @brief Implementation of the adaptive repetition harness.
+ * @author Sandesh Ghimire | sandesh@soccentric
+ * @copyright (C) Soccentric LLC. All rights reserved.
+ */
+
+#include "measurement_harness.h"
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <numeric>
+#include <sstream>
+
+namespace cm5_peripheral_test {
+
+namespace {
+
+/** Two-sided 95% Student-t quantiles for 1..30 degrees of freedom. */
+constexpr double T_95[] = {
+    12.706, 4.303, 3.182, 2.776, 2.571, 2.447, 2.365, 2.306, 2.262, 2.228,
+    2.201,  2.179, 2.160, 2.145, 2.131, 2.120, 2.110, 2.101, 2.093, 2.086,
+    2.080,  2.074, 2.069, 2.064, 2.060, 2.056, 2.052, 2.048, 2.045, 2.042,
+};
+
+double t_quantile_95(size_t degrees_of_freedom) {
+    if (degrees_of_freedom == 0) {
+        return 0.0;
+    }
+    if (degrees_of_freedom <= sizeof(T_95) / sizeof(T_95[0])) {
+        return T_95[degrees_of_freedom - 1];
+    }
+    return 1.960;
+}
+
+double median_of(std::vector<double>& values) {
+    size_t middle = values.size() / 2;
+    std::nth_element(values.begin(), values.begin() + middle, values.end());
+    double upper = values[middle];
+    if (values.size() % 2 == 1) {
+        return upper;
+    }
+    double lower = *std::max_element(values.begin(), values.begin() + middle);
+    return (lower + upper) / 2.0;
+}
+
+/**
+ * @brief Checks whether the last @p window samples agree within @p tolerance.
+ */
+bool window_is_stable(const std::vector<double>& samples, size_t window, double tolerance) {
+    if (samples.size() < window || window == 0) {
+        return false;
+    }
+    std::vector<double> tail(samples.end() - window, samples.end());
+    auto bounds = std::minmax_element(tail.begin(), tail.end());
+    double range = *bounds.second - *bounds.first;
+    double middle = median_of(tail);
+    return middle != 0.0 && range / std::fabs(middle) <= tolerance;
+}
+
+} // namespace
+
+MeasurementSummary summarize_samples(std::vector<double> samples) {
+    MeasurementSummary summary;
+    summary.iterations = samples.size();
+    if (samples.empty()) {
+        return summary;
+    }
+
+    size_t n = samples.size();
+    summary.mean = std::accumulate(samples.begin(), samples.end(), 0.0) / n;
+    if (n > 1) {
+        double squares = 0.0;
+        for (double value : samples) {
+            squares += (value - summary.mean) * (value - summary.mean);
+        }
+        double stddev = std::sqrt(squares / (n - 1));
+        summary.ci_half_width = t_quantile_95(n - 1) * stddev / std::sqrt(static_cast<double>(n));
+    }
+    summary.relative_ci = summary.mean != 0.0 ? summary.ci_half_width / std::fabs(summary.mean) : 0.0;
+
+    summary.median = median_of(samples);
+    for (double& value : samples) {
+        value = std::fabs(value - summary.median);
+    }
+    summary.mad = median_of(samples);
+    return summary;
+}
+
+MeasurementSummary measure_until_converged(const std::function<double()>& sample,
+                                           const ConvergenceCriteria& criteria) {
+    auto deadline = std::chrono::steady_clock::now() + criteria.time_cap;
+    auto expired = [&deadline]() { return std::chrono::steady_clock::now() >= deadline; };
+
+    // Warm-up: sample until a window agrees, then keep that window
+    std::vector<double> warm;
+    size_t window = std::max<size_t>(criteria.warmup_window, 1);
+    do {
+        warm.push_back(sample());
+    } while (!window_is_stable(warm, window, criteria.warmup_tolerance) &&
+             warm.size() < std::max(criteria.max_warmup, window) && !expired());
+
+    size_t keep = std::min(window, warm.size());
+    std::vector<double> kept(warm.end() - keep, warm.end());
+    size_t discarded = warm.size() - keep;
+
+    MeasurementSummary summary = summarize_samples(kept);
+    while (kept.size() < criteria.max_samples && !expired()) {
+        if (kept.size() >= criteria.min_samples && summary.relative_ci <= criteria.target_relative_ci) {
+            break;
+        }
+        kept.push_back(sample());
+        summary = summarize_samples(kept);
+    }
+
+    summary.warmup = discarded;
+    summary.converged = kept.size() >= std::min(criteria.min_samples, criteria.max_samples) &&
+                        summary.relative_ci <= criteria.target_relative_ci;
+    return summary;
+}
+
+std::string format_measurement(const MeasurementSummary& summary, double scale, int precision) {
+    std::stringstream out;
+    out << std::fixed << std::setprecision(precision) << summary.median * scale << " (MAD " << summary.mad * scale
+        << ", ±" << std::setprecision(1) << summary.relative_ci * 100.0 << "% CI95, n=" << summary.iterations << ")";
+    if (!summary.converged) {
+        out << " [NOT CONVERGED]";
+    }
+    return out.str();
+}
+
+} // namespace cm5_peripheral_test
@@ -0,0 +1,73 @@
+/**
+ * @file resource_usage.cpp
+ * @brief Implementation of process resource usage snapshots.
+ * @author Sandesh Ghimire | sandesh@soccentric
+ * @copyright (C) Soccentric LLC. All rights reserved.
+ */
+
+#include "resource_usage.h"
+#include <iomanip>
+#include <sstream>
+#include <sys/resource.h>
+
+namespace cm5_peripheral_test {
+
+namespace {
+
+double to_ms(const timeval& time) {
+    return time.tv_sec * 1000.0 + time.tv_usec / 1000.0;
+}
+
+} // namespace
+
+ResourceUsage capture_resource_usage() {
+    ResourceUsage usage;
+    struct rusage raw {};
+    if (getrusage(RUSAGE_SELF, &raw) != 0) {
+        return usage;
+    }
+    usage.valid = true;
+    usage.user_ms = to_ms(raw.ru_utime);
+    usage.system_ms = to_ms(raw.ru_stime);
+    usage.voluntary_switches = raw.ru_nvcsw;
+    usage.involuntary_switches = raw.ru_nivcsw;
+    usage.minor_faults = raw.ru_minflt;
+    usage.major_faults = raw.ru_majflt;
+    // Linux reports ru_maxrss in KiB
+    usage.peak_rss_kib = raw.ru_maxrss;
+    return usage;
+}
+
+ResourceUsage resource_usage_delta(const ResourceUsage& start, const ResourceUsage& end) {
+    ResourceUsage delta;
+    if (!start.valid || !end.valid) {
+        return delta;
+    }
+    delta.valid = true;
+    delta.user_ms = end.user_ms - start.user_ms;
+    delta.system_ms = end.system_ms - start.system_ms;
+    delta.voluntary_switches = end.voluntary_switches - start.voluntary_switches;
+    delta.involuntary_switches = end.involuntary_switches - start.involuntary_switches;
+    delta.minor_faults = end.minor_faults - start.minor_faults;
+    delta.major_faults = end.major_faults - start.major_faults;
+    delta.peak_rss_kib = end.peak_rss_kib - start.peak_rss_kib;
+    return delta;
+}
+
+std::string format_resource_usage(const ResourceUsage& usage, std::chrono::milliseconds wall) {
+    if (!usage.valid) {
+        return "n/a";
+    }
+    std::stringstream out;
+    out << std::fixed << std::setprecision(0);
+    out << "CPU " << usage.user_ms << " ms user + " << usage.system_ms << " ms sys";
+    if (wall.count() > 0) {
+        out << " (" << (usage.user_ms + usage.system_ms) / wall.count() * 100.0 << "% of one core)";
+    }
+    out << ", context switches " << usage.voluntary_switches << " voluntary / " << usage.involuntary_switches
+        << " involuntary, page faults " << usage.minor_faults << " minor / " << usage.major_faults
+        << " major, peak RSS +" << usage.peak_rss_kib << " KiB";
+    return out.str();
+}
+
+} // namespace cm5_peripheral_test
@@ -0,0 +1,444 @@
+/**
+ * @file series_file.cpp
+ * @brief Implementation of the Gorilla-encoded series file.
+ * @author Sandesh Ghimire | sandesh@soccentric
+ * @copyright (C) Soccentric LLC. All rights reserved.
+ */
+
+#include "series_file.h"
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <limits>
+
+namespace cm5_peripheral_test {
+
+namespace {
+
+/** File header; bump the digit when the layout changes. */
+constexpr char FILE_MAGIC[8] = {'C', 'M', '5', 'S', 'E', 'R', '1', '\n'};
+
+/** Marker at the start of every chunk header ("CHNK"). */
+constexpr uint32_t CHUNK_MAGIC = 0x4B4E4843;
+
+/** Longest series name stored in a chunk header. */
+constexpr size_t MAX_NAME_LENGTH = 255;
+
+/**
+ * @brief Appends bits most-significant first to a byte vector.
+ */
+class BitWriter {
+public:
+    void write(uint64_t value, int bits) {
+        for (int bit = bits - 1; bit >= 0; --bit) {
+            if (used_ == 0) {
+                bytes_.push_back(0);
+            }
+            if ((value >> bit) & 1) {
+                bytes_.back() |= static_cast<uint8_t>(0x80 >> used_);
+            }
+            used_ = (used_ + 1) & 7;
+        }
+    }
+
+    const std::vector<uint8_t>& bytes() const { return bytes_; }
+
+    void clear() {
+        bytes_.clear();
+        used_ = 0;
+    }
+
+private:
+    std::vector<uint8_t> bytes_;
+    int used_ = 0;  // Bits used in the last byte, 0 meaning full
+};
+
+/**
+ * @brief Reads bits most-significant first from a byte vector.
+ */
+class BitReader {
+public:
+    explicit BitReader(const std::vector<uint8_t>& bytes) : bytes_(bytes) {}
+
+    bool read(int bits, uint64_t& value) {
+        if (position_ + bits > bytes_.size() * 8) {
+            return false;
+        }
+        value = 0;
+        for (int i = 0; i < bits; ++i, ++position_) {
+            value = (value << 1) | ((bytes_[position_ >> 3] >> (7 - (position_ & 7))) & 1);
+        }
+        return true;
+    }
+
+private:
+    const std::vector<uint8_t>& bytes_;
+    size_t position_ = 0;
+};
+
+uint64_t double_bits(double value) {
+    uint64_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+double bits_double(uint64_t bits) {
+    double value;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+template <typename T>
+void put(std::string& out, T value) {
+    // Little-endian regardless of host order
+    for (size_t i = 0; i < sizeof(T); ++i) {
+        out.push_back(static_cast<char>((static_cast<uint64_t>(value) >> (8 * i)) & 0xFF));
+    }
+}
+
+template <typename T>
+bool get(std::istream& in, T& value) {
+    unsigned char bytes[sizeof(T)];
+    if (!in.read(reinterpret_cast<char*>(bytes), sizeof(T))) {
+        return false;
+    }
+    uint64_t raw = 0;
+    for (size_t i = 0; i < sizeof(T); ++i) {
+        raw |= static_cast<uint64_t>(bytes[i]) << (8 * i);
+    }
+    value = static_cast<T>(raw);
+    return true;
+}
+
+/**
+ * @brief Walks the chunk headers from the current position of @p file.
+ * @param file Stream positioned just after the file header.
+ * @param file_size Size of the file in bytes.
+ * @param chunks Receives each complete chunk, or nullptr.
+ * @return Offset just past the last complete chunk.
+ */
+uint64_t scan_chunks(std::istream& file, uint64_t file_size, std::vector<SeriesChunkInfo>* chunks) {
+    uint64_t complete_end = static_cast<uint64_t>(file.tellg());
+    while (true) {
+        SeriesChunkInfo info;
+        uint32_t marker = 0;
+        uint16_t name_length = 0;
+        if (!get(file, marker) || marker != CHUNK_MAGIC || !get(file, name_length)) {
+            break;
+        }
+        info.name.resize(name_length);
+        if (!file.read(&info.name[0], name_length) || !get(file, info.samples) || !get(file, info.min_time_ms) ||
+            !get(file, info.max_time_ms) || !get(file, info.bytes)) {
+            break;
+        }
+        info.offset = static_cast<uint64_t>(file.tellg());
+        if (info.offset + info.bytes > file_size) {
+            break;
+        }
+        file.seekg(info.bytes, std::ios::cur);
+        complete_end = info.offset + info.bytes;
+        if (chunks != nullptr) {
+            chunks->push_back(std::move(info));
+        }
+    }
+    return complete_end;
+}
+
+/**
+ * @brief Decodes one chunk payload into @p out, keeping samples in range.
+ */
+bool decode_chunk(const std::vector<uint8_t>& payload, uint32_t samples, int64_t from_ms, int64_t to_ms,
+                  std::vector<SeriesSample>& out) {
+    BitReader reader(payload);
+    int64_t time = 0;
+    int64_t delta = 0;
+    uint64_t value = 0;
+    int leading = 0;
+    int trailing = 0;
+
+    for (uint32_t index = 0; index < samples; ++index) {
+        uint64_t bits = 0;
+        if (index == 0) {
+            uint64_t raw_time = 0;
+            if (!reader.read(64, raw_time) || !reader.read(64, value)) {
+                return false;
+            }
+            time = static_cast<int64_t>(raw_time);
+        } else {
+            // Delta of delta: 0, 10+7, 110+9, 1110+12, 1111+64 bits
+            int prefix = 0;
+            while (prefix < 4) {
+                if (!reader.read(1, bits)) {
+                    return false;
+                }
+                if (bits == 0) {
+                    break;
+                }
+                ++prefix;
+            }
+            static const int WIDTHS[] = {0, 7, 9, 12, 64};
+            static const int64_t BIASES[] = {0, 63, 255, 2047, 0};
+            int64_t dod = 0;
+            if (prefix > 0) {
+                if (!reader.read(WIDTHS[prefix], bits)) {
+                    return false;
+                }
+                dod = static_cast<int64_t>(bits) - BIASES[prefix];
+            }
+            delta += dod;
+            time += delta;
+
+            // Value XOR: 0 = repeat, 10 = reuse window, 11 = new window
+            if (!reader.read(1, bits)) {
+                return false;
+            }
+            if (bits == 1) {
+                if (!reader.read(1, bits)) {
+                    return false;
+                }
+                if (bits == 1) {
+                    uint64_t lead = 0;
+                    uint64_t length = 0;
+                    if (!reader.read(5, lead) || !reader.read(6, length)) {
+                        return false;
+                    }
+                    leading = static_cast<int>(lead);
+                    int meaningful = length == 0 ? 64 : static_cast<int>(length);
+                    trailing = 64 - leading - meaningful;
+                    if (trailing < 0) {
+                        return false;
+                    }
+                }
+                uint64_t xor_bits = 0;
+                if (!reader.read(64 - leading - trailing, xor_bits)) {
+                    return false;
+                }
+                value ^= xor_bits << trailing;
+            }
+        }
+        if (time >= from_ms && time <= to_ms) {
+            out.push_back({time, bits_double(value)});
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+/**
+ * @brief Encoder state of one series.
+ */
+struct SeriesFileWriter::Encoder {
+    std::string name;             /**< Series name */
+    BitWriter payload;            /**< Chunk being encoded */
+    uint32_t samples = 0;         /**< Samples in the chunk */
+    int64_t min_time = 0;         /**< Earliest timestamp in the chunk */
+    int64_t max_time = 0;         /**< Latest timestamp in the chunk */
+    int64_t previous_time = 0;    /**< Last timestamp */
+    int64_t previous_delta = 0;   /**< Last timestamp delta */
+    uint64_t previous_value = 0;  /**< Bits of the last value */
+    int leading = -1;             /**< Leading zeros of the current XOR window, -1 if none */
+    int trailing = 0;             /**< Trailing zeros of the current XOR window */
+};
+
+SeriesFileWriter::SeriesFileWriter(const std::string& path, size_t chunk_samples)
+    : chunk_samples_(std::max<size_t>(chunk_samples, 1)) {
+    // Refuse to append to a file that is not a series file
+    uint64_t file_size = 0;
+    uint64_t complete_size = 0;
+    {
+        std::ifstream existing(path, std::ios::binary);
+        char magic[sizeof(FILE_MAGIC)];
+        if (existing.is_open() && existing.read(magic, sizeof(magic))) {
+            if (std::memcmp(magic, FILE_MAGIC, sizeof(magic)) != 0) {
+                return;
+            }
+            existing.seekg(0, std::ios::end);
+            file_size = static_cast<uint64_t>(existing.tellg());
+            existing.seekg(sizeof(FILE_MAGIC));
+            complete_size = scan_chunks(existing, file_size, nullptr);
+        } else if (existing.is_open() && existing.gcount() > 0) {
+            return;
+        }
+    }
+
+    // Drop a torn tail left by a crash, or the next chunk would be read as its payload
+    if (complete_size < file_size) {
+        std::error_code error;
+        std::filesystem::resize_file(path, complete_size, error);
+        if (error) {
+            return;
+        }
+    }
+
+    file_.open(path, std::ios::binary | std::ios::app);
+    if (!file_.is_open()) {
+        return;
+    }
+    file_.seekp(0, std::ios::end);
+    if (file_.tellp() == 0) {
+        file_.write(FILE_MAGIC, sizeof(FILE_MAGIC));
+        bytes_written_ += sizeof(FILE_MAGIC);
+    }
+    open_ = static_cast<bool>(file_);
+}
+
+SeriesFileWriter::~SeriesFileWriter() {
+    flush();
+}
+
+int SeriesFileWriter::add_series(const std::string& name) {
+    Encoder encoder;
+    encoder.name = name.substr(0, MAX_NAME_LENGTH);
+    encoders_.push_back(std::move(encoder));
+    return static_cast<int>(encoders_.size() - 1);
+}
+
+bool SeriesFileWriter::append(int series, int64_t time_ms, double value) {
+    if (!open_ || series < 0 || static_cast<size_t>(series) >= encoders_.size()) {
+        return false;
+    }
+    Encoder& encoder = encoders_[series];
+    uint64_t bits = double_bits(value);
+
+    if (encoder.samples == 0) {
+        encoder.payload.write(static_cast<uint64_t>(time_ms), 64);
+        encoder.payload.write(bits, 64);
+        encoder.min_time = time_ms;
+        encoder.max_time = time_ms;
+        encoder.previous_delta = 0;
+        encoder.leading = -1;
+    } else {
+        int64_t delta = time_ms - encoder.previous_time;
+        int64_t dod = delta - encoder.previous_delta;
+        if (dod == 0) {
+            encoder.payload.write(0, 1);
+        } else if (dod >= -63 && dod <= 64) {
+            encoder.payload.write(0b10, 2);
+            encoder.payload.write(static_cast<uint64_t>(dod + 63), 7);
+        } else if (dod >= -255 && dod <= 256) {
+            encoder.payload.write(0b110, 3);
+            encoder.payload.write(static_cast<uint64_t>(dod + 255), 9);
+        } else if (dod >= -2047 && dod <= 2048) {
+            encoder.payload.write(0b1110, 4);
+            encoder.payload.write(static_cast<uint64_t>(dod + 2047), 12);
+        } else {
+            encoder.payload.write(0b1111, 4);
+            encoder.payload.write(static_cast<uint64_t>(dod), 64);
+        }
+        encoder.previous_delta = delta;
+
+        uint64_t xor_bits = bits ^ encoder.previous_value;
+        if (xor_bits == 0) {
+            encoder.payload.write(0, 1);
+        } else {
+            // Five bits hold at most 31 leading zeros
+            int leading = std::min(__builtin_clzll(xor_bits), 31);
+            int trailing = __builtin_ctzll(xor_bits);
+            if (encoder.leading >= 0 && leading >= encoder.leading && trailing >= encoder.trailing) {
+                encoder.payload.write(0b10, 2);
+                encoder.payload.write(xor_bits >> encoder.trailing, 64 - encoder.leading - encoder.trailing);
+            } else {
+                int meaningful = 64 - leading - trailing;
+                encoder.payload.write(0b11, 2);
+                encoder.payload.write(static_cast<uint64_t>(leading), 5);
+                encoder.payload.write(static_cast<uint64_t>(meaningful & 63), 6);
+                encoder.payload.write(xor_bits >> trailing, meaningful);
+                encoder.leading = leading;
+                encoder.trailing = trailing;
+            }
+        }
+        encoder.min_time = std::min(encoder.min_time, time_ms);
+        encoder.max_time = std::max(encoder.max_time, time_ms);
+    }
+
+    encoder.previous_time = time_ms;
+    encoder.previous_value = bits;
+    ++encoder.samples;
+    ++samples_;
+    if (encoder.samples >= chunk_samples_) {
+        return write_chunk(encoder);
+    }
+    return true;
+}
+
+bool SeriesFileWriter::flush() {
+    bool ok = open_;
+    for (Encoder& encoder : encoders_) {
+        if (encoder.samples > 0 && !write_chunk(encoder)) {
+            ok = false;
+        }
+    }
+    if (open_) {
+        file_.flush();
+    }
+    return ok && static_cast<bool>(file_);
+}
+
+bool SeriesFileWriter::write_chunk(Encoder& encoder) {
+    const std::vector<uint8_t>& payload = encoder.payload.bytes();
+    std::string chunk;
+    put<uint32_t>(chunk, CHUNK_MAGIC);
+    put<uint16_t>(chunk, static_cast<uint16_t>(encoder.name.size()));
+    chunk += encoder.name;
+    put<uint32_t>(chunk, encoder.samples);
+    put<int64_t>(chunk, encoder.min_time);
+    put<int64_t>(chunk, encoder.max_time);
+    put<uint32_t>(chunk, static_cast<uint32_t>(payload.size()));
+    chunk.append(payload.begin(), payload.end());
+
+    // One write per chunk so a crash leaves whole chunks or a short tail
+    file_.write(chunk.data(), static_cast<std::streamsize>(chunk.size()));
+    file_.flush();
+    bytes_written_ += chunk.size();
+    encoder.payload.clear();
+    encoder.samples = 0;
+    return static_cast<bool>(file_);
+}
+
+SeriesFileReader::SeriesFileReader(const std::string& path) : path_(path) {
+    std::ifstream file(path, std::ios::binary);
+    char magic[sizeof(FILE_MAGIC)];
+    if (!file.read(magic, sizeof(magic)) || std::memcmp(magic, FILE_MAGIC, sizeof(magic)) != 0) {
+        return;
+    }
+    valid_ = true;
+
+    file.seekg(0, std::ios::end);
+    uint64_t file_size = static_cast<uint64_t>(file.tellg());
+    file.seekg(sizeof(FILE_MAGIC));
+    scan_chunks(file, file_size, &chunks_);
+}
+
+std::vector<std::string> SeriesFileReader::series_names() const {
+    std::vector<std::string> names;
+    for (const SeriesChunkInfo& chunk : chunks_) {
+        if (std::find(names.begin(), names.end(), chunk.name) == names.end()) {
+            names.push_back(chunk.name);
+        }
+    }
+    return names;
+}
+
+std::vector<SeriesSample> SeriesFileReader::query(const std::string& name, int64_t from_ms, int64_t to_ms) const {
+    std::vector<SeriesSample> samples;
+    std::ifstream file(path_, std::ios::binary);
+    std::vector<uint8_t> payload;
+    for (const SeriesChunkInfo& chunk : chunks_) {
+        if (chunk.name != name || chunk.max_time_ms < from_ms || chunk.min_time_ms > to_ms) {
+            continue;
+        }
+        payload.resize(chunk.bytes);
+        file.seekg(static_cast<std::streamoff>(chunk.offset));
+        if (!file.read(reinterpret_cast<char*>(payload.data()), chunk.bytes)) {
+            break;
+        }
+        ++chunks_decoded_;
+        if (!decode_chunk(payload, chunk.samples, from_ms, to_ms, samples)) {
+            break;
+        }
+    }
+    return samples;
+}
+
+} // namespace cm5_peripheral_test
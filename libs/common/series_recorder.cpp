@@ -0,0 +1,120 @@
+/**
+ * @file series_recorder.cpp
+ * @brief Implementation of the background series file writer.
+ * @author Sandesh Ghimire | sandesh@soccentric
+ * @copyright (C) Soccentric LLC. All rights reserved.
+ */
+
+#include "series_recorder.h"
+#include <chrono>
+#include <iomanip>
+#include <sstream>
+
+namespace cm5_peripheral_test {
+
+namespace {
+
+/** Samples the writer thread takes from the ring at a time. */
+constexpr size_t RECORDER_BATCH = 256;
+
+/**
+ * How long the writer thread sleeps when the ring is empty. Monitors
+ * sample at 1-100 Hz, so the default ring covers many polls.
+ */
+constexpr std::chrono::milliseconds RECORDER_POLL_INTERVAL(10);
+
+} // namespace
+
+SeriesRecorder::SeriesRecorder(const std::string& path, const std::vector<std::string>& series,
+                               size_t queue_capacity, size_t chunk_samples,
+                               std::chrono::milliseconds flush_interval)
+    : path_(path), flush_interval_(flush_interval), writer_(path, chunk_samples), queue_(queue_capacity) {
+    for (const std::string& name : series) {
+        writer_.add_series(name);
+    }
+    if (!writer_.is_open()) {
+        stopping_.store(true, std::memory_order_relaxed);
+        return;
+    }
+    thread_ = std::thread(&SeriesRecorder::run, this);
+}
+
+SeriesRecorder::~SeriesRecorder() {
+    stop();
+}
+
+bool SeriesRecorder::record(int series, int64_t time_ms, double value) {
+    if (stopping_.load(std::memory_order_relaxed)) {
+        return false;
+    }
+    return queue_.push({series, time_ms, value});
+}
+
+void SeriesRecorder::stop() {
+    // Release orders every pushed sample before the flag the thread acquires
+    stopping_.store(true, std::memory_order_release);
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+}
+
+std::string SeriesRecorder::describe() const {
+    std::stringstream out;
+    if (!writer_.is_open()) {
+        out << "Recording to " << path_ << " failed: cannot open file or not a series file";
+        return out.str();
+    }
+    out << std::fixed << std::setprecision(1);
+    out << "Recorded " << written() << " samples (" << bytes_.load(std::memory_order_relaxed) / 1024.0 << " KiB) to "
+        << path_ << ", " << dropped() << " dropped";
+    return out.str();
+}
+
+int64_t SeriesRecorder::now_ms() {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(
+               std::chrono::system_clock::now().time_since_epoch())
+        .count();
+}
+
+void SeriesRecorder::run() {
+    Entry batch[RECORDER_BATCH];
+    auto last_flush = std::chrono::steady_clock::now();
+    bool pending = false;
+    for (;;) {
+        // Read the flag before draining so samples pushed before stop() are seen
+        bool stopping = stopping_.load(std::memory_order_acquire);
+        size_t taken;
+        size_t drained = 0;
+        while ((taken = queue_.pop(batch, RECORDER_BATCH)) > 0) {
+            for (size_t i = 0; i < taken; ++i) {
+                if (writer_.append(batch[i].series, batch[i].time_ms, batch[i].value)) {
+                    written_.fetch_add(1, std::memory_order_relaxed);
+                }
+            }
+            drained += taken;
+        }
+        pending = pending || drained > 0;
+
+        // Bound what a crash can lose: write out partial chunks once the
+        // oldest unwritten sample may have waited a full interval
+        auto now = std::chrono::steady_clock::now();
+        if (pending && now - last_flush >= flush_interval_) {
+            writer_.flush();
+            pending = false;
+        }
+        if (!pending) {
+            last_flush = now;
+        }
+        bytes_.store(writer_.bytes_written(), std::memory_order_relaxed);
+        if (stopping) {
+            break;
+        }
+        if (drained == 0) {
+            std::this_thread::sleep_for(RECORDER_POLL_INTERVAL);
+        }
+    }
+    writer_.flush();
+    bytes_.store(writer_.bytes_written(), std::memory_order_relaxed);
+}
+
+} // namespace cm5_peripheral_test
@@ -0,0 +1,169 @@
+/**
+ * @file streaming_stats.cpp
+ * @brief Implementation of the constant-memory streaming estimators.
+ * @author Sandesh Ghimire | sandesh@soccentric
+ * @copyright (C) Soccentric LLC. All rights reserved.
+ */
+
+#include "streaming_stats.h"
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <sstream>
+#include <utility>
+
+namespace cm5_peripheral_test {
+
+void RunningMoments::add(double value) {
+    ++count_;
+    double delta = value - mean_;
+    mean_ += delta / static_cast<double>(count_);
+    m2_ += delta * (value - mean_);
+}
+
+double RunningMoments::variance() const {
+    return count_ > 1 ? m2_ / static_cast<double>(count_ - 1) : 0.0;
+}
+
+double RunningMoments::stddev() const {
+    return std::sqrt(variance());
+}
+
+P2Quantile::P2Quantile(double quantile) : quantile_(quantile) {
+    double p = quantile_;
+    const double desired[5] = {0.0, 2.0 * p, 4.0 * p, 2.0 + 2.0 * p, 4.0};
+    const double increments[5] = {0.0, p / 2.0, p, (1.0 + p) / 2.0, 1.0};
+    for (int i = 0; i < 5; ++i) {
+        positions_[i] = i;
+        desired_[i] = desired[i];
+        increments_[i] = increments[i];
+    }
+}
+
+void P2Quantile::add(double value) {
+    if (count_ < 5) {
+        heights_[count_++] = value;
+        if (count_ == 5) {
+            std::sort(std::begin(heights_), std::end(heights_));
+        }
+        return;
+    }
+    ++count_;
+
+    // Cell the sample falls in, stretching the outer markers if needed
+    int cell;
+    if (value < heights_[0]) {
+        heights_[0] = value;
+        cell = 0;
+    } else if (value >= heights_[4]) {
+        heights_[4] = std::max(heights_[4], value);
+        cell = 3;
+    } else {
+        cell = 0;
+        while (value >= heights_[cell + 1]) {
+            ++cell;
+        }
+    }
+    for (int i = cell + 1; i < 5; ++i) {
+        positions_[i] += 1.0;
+    }
+    for (int i = 0; i < 5; ++i) {
+        desired_[i] += increments_[i];
+    }
+
+    // Move the middle markers one step toward their desired positions
+    for (int i = 1; i <= 3; ++i) {
+        double offset = desired_[i] - positions_[i];
+        if ((offset >= 1.0 && positions_[i + 1] - positions_[i] > 1.0) ||
+            (offset <= -1.0 && positions_[i - 1] - positions_[i] < -1.0)) {
+            int step = offset > 0 ? 1 : -1;
+            double candidate = parabolic(i, step);
+            if (heights_[i - 1] < candidate && candidate < heights_[i + 1]) {
+                heights_[i] = candidate;
+            } else {
+                heights_[i] = linear(i, step);
+            }
+            positions_[i] += step;
+        }
+    }
+}
+
+double P2Quantile::value() const {
+    if (count_ >= 5) {
+        return heights_[2];
+    }
+    if (count_ == 0) {
+        return 0.0;
+    }
+    double sorted[5];
+    std::copy(heights_, heights_ + count_, sorted);
+    std::sort(sorted, sorted + count_);
+    size_t rank = static_cast<size_t>(std::ceil(quantile_ * count_));
+    return sorted[rank > 0 ? rank - 1 : 0];
+}
+
+double P2Quantile::parabolic(int i, double d) const {
+    const double* n = positions_;
+    const double* q = heights_;
+    return q[i] + d / (n[i + 1] - n[i - 1]) *
+                      ((n[i] - n[i - 1] + d) * (q[i + 1] - q[i]) / (n[i + 1] - n[i]) +
+                       (n[i + 1] - n[i] - d) * (q[i] - q[i - 1]) / (n[i] - n[i - 1]));
+}
+
+double P2Quantile::linear(int i, int d) const {
+    return heights_[i] + d * (heights_[i + d] - heights_[i]) / (positions_[i + d] - positions_[i]);
+}
+
+Ewma::Ewma(double time_constant_s) : time_constant_(time_constant_s) {}
+
+void Ewma::add(double time_s, double value) {
+    if (!primed_) {
+        value_ = value;
+        primed_ = true;
+    } else {
+        double dt = std::max(time_s - last_time_, 0.0);
+        double weight = time_constant_ > 0 ? 1.0 - std::exp(-dt / time_constant_) : 1.0;
+        value_ += weight * (value - value_);
+    }
+    last_time_ = time_s;
+}
+
+void Extremes::add(double time_s, double value) {
+    if (count_ == 0 || value < min_) {
+        min_ = value;
+        min_time_ = time_s;
+    }
+    if (count_ == 0 || value > max_) {
+        max_ = value;
+        max_time_ = time_s;
+    }
+    ++count_;
+}
+
+StreamingSummary::StreamingSummary(std::string name, double ewma_time_constant_s)
+    : name_(std::move(name)), median_(0.5), p95_(0.95), p99_(0.99), ewma_(ewma_time_constant_s) {}
+
+void StreamingSummary::add(double time_s, double value) {
+    moments_.add(value);
+    median_.add(value);
+    p95_.add(value);
+    p99_.add(value);
+    ewma_.add(time_s, value);
+    extremes_.add(time_s, value);
+}
+
+std::string StreamingSummary::describe() const {
+    std::stringstream out;
+    out << std::fixed << std::setprecision(2);
+    out << name_ << ": n " << moments_.count();
+    if (moments_.count() == 0) {
+        return out.str();
+    }
+    out << ", mean " << moments_.mean() << " sd " << moments_.stddev() << ", p50 " << median_.value() << " p95 "
+        << p95_.value() << " p99 " << p99_.value() << ", EWMA " << ewma_.value() << ", min " << extremes_.min()
+        << std::setprecision(1) << " at " << extremes_.min_time() << " s, max " << std::setprecision(2)
+        << extremes_.max() << std::setprecision(1) << " at " << extremes_.max_time() << " s";
+    return out.str();
+}
+
+} // namespace cm5_peripheral_test
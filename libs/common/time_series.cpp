@@ -0,0 +1,56 @@
+/**
+ * @file time_series.cpp
+ * @brief Implementation of the fixed-capacity time-series ring buffer.
+ * @author Sandesh Ghimire | sandesh@soccentric
+ * @copyright (C) Soccentric LLC. All rights reserved.
+ */
+
+#include "time_series.h"
+#include <algorithm>
+#include <iomanip>
+#include <sstream>
+#include <utility>
+
+namespace cm5_peripheral_test {
+
+TimeSeries::TimeSeries(std::string name, size_t capacity)
+    : name_(std::move(name)), times_(std::max<size_t>(capacity, 1)), values_(times_.size()) {}
+
+void TimeSeries::append(double time_s, double value) {
+    size_t slot;
+    if (size_ < times_.size()) {
+        slot = physical(size_);
+        ++size_;
+    } else {
+        slot = head_;
+        head_ = physical(1);
+    }
+    times_[slot] = time_s;
+    values_[slot] = value;
+    ++appended_;
+}
+
+void TimeSeries::clear() {
+    head_ = 0;
+    size_ = 0;
+    appended_ = 0;
+}
+
+std::string TimeSeries::describe() const {
+    std::stringstream out;
+    out << std::fixed << std::setprecision(1);
+    out << name_ << ": " << size_ << " of " << appended_ << " samples retained";
+    if (size_ > 0) {
+        out << ", " << time_at(0) << " s to " << time_at(size_ - 1) << " s";
+    }
+    return out.str();
+}
+
+void TimeSeries::write_csv(std::ostream& out) const {
+    out << "time_s," << name_ << "\n";
+    for (size_t i = 0; i < size_; ++i) {
+        out << time_at(i) << "," << value_at(i) << "\n";
+    }
+}
+
+} // namespace cm5_peripheral_test
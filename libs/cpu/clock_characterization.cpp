@@ -0,0 +1,146 @@
+/**
+ * @file clock_characterization.cpp
+ * @brief Implementation of the clock cost, resolution and monotonicity checks.
+ * @author Sandesh Ghimire | sandesh@soccentric
+ * @copyright (C) Soccentric LLC. All rights reserved.
+ */
+
+#include "clock_characterization.h"
+#include "cache_line.h"
+#include "cpu_affinity.h"
+#include <atomic>
+#include <chrono>
+#include <limits>
+#include <thread>
+
+namespace cm5_peripheral_test {
+
+namespace {
+
+/** Spins before a handoff waiter starts yielding (oversubscribed hosts). */
+constexpr int HANDOFF_SPINS = 4096;
+
+/**
+ * @brief Timestamp mailbox shared by the two handoff threads.
+ */
+struct ClockHandoff {
+    alignas(CACHE_LINE_SIZE) std::atomic<uint64_t> stamp{0};
+    alignas(CACHE_LINE_SIZE) std::atomic<uint64_t> published{0};
+    alignas(CACHE_LINE_SIZE) std::atomic<uint64_t> consumed{0};
+};
+
+void wait_for(const std::atomic<uint64_t>& value, uint64_t expected) {
+    for (int spins = 0; value.load(std::memory_order_acquire) != expected; ++spins) {
+        if (spins < HANDOFF_SPINS) {
+            cpu_relax();
+        } else {
+            std::this_thread::yield();
+        }
+    }
+}
+
+/**
+ * @brief Back-to-back reads through @p read, timed by steady_clock.
+ */
+template <typename Read>
+void time_reads(Read read, uint64_t reads, ClockCharacteristics& result) {
+    uint64_t min_step = std::numeric_limits<uint64_t>::max();
+    uint64_t previous = read();
+
+    auto start = std::chrono::steady_clock::now();
+    for (uint64_t i = 0; i < reads; ++i) {
+        uint64_t now = read();
+        if (now < previous) {
+            ++result.backward_steps;
+        } else if (now > previous && now - previous < min_step) {
+            min_step = now - previous;
+        }
+        previous = now;
+    }
+    std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+
+    result.cost_ns = reads > 0 ? elapsed.count() / reads : 0.0;
+    result.resolution_ns = min_step == std::numeric_limits<uint64_t>::max() ? 0.0 : static_cast<double>(min_step);
+}
+
+double posix_resolution_ns(clockid_t id) {
+    timespec res;
+    if (clock_getres(id, &res) != 0) {
+        return 0.0;
+    }
+    return res.tv_sec * 1e9 + res.tv_nsec;
+}
+
+/**
+ * @brief Publishes @p handoffs timestamps from @p writer_cpu to @p reader_cpu.
+ */
+uint64_t one_way_inversions(ClockSource source, int writer_cpu, int reader_cpu, uint64_t handoffs) {
+    ClockHandoff mailbox;
+    uint64_t inversions = 0;
+
+    std::thread writer([&]() {
+        pin_current_thread(writer_cpu);
+        for (uint64_t i = 1; i <= handoffs; ++i) {
+            wait_for(mailbox.consumed, i - 1);
+            mailbox.stamp.store(read_clock_ns(source), std::memory_order_relaxed);
+            mailbox.published.store(i, std::memory_order_release);
+        }
+    });
+    std::thread reader([&]() {
+        pin_current_thread(reader_cpu);
+        for (uint64_t i = 1; i <= handoffs; ++i) {
+            wait_for(mailbox.published, i);
+            uint64_t stamp = mailbox.stamp.load(std::memory_order_relaxed);
+            if (read_clock_ns(source) < stamp) {
+                ++inversions;
+            }
+            mailbox.consumed.store(i, std::memory_order_release);
+        }
+    });
+
+    writer.join();
+    reader.join();
+    return inversions;
+}
+
+} // namespace
+
+ClockCharacteristics characterize_clock(ClockSource source, int cpu, uint64_t reads) {
+    ClockCharacteristics result;
+    result.source = source;
+    result.cpu = cpu;
+
+    ScopedAffinity pin(cpu);
+    const FastClock& fast = FastClock::instance();
+
+    switch (source) {
+    case ClockSource::FAST_COUNTER:
+        result.nominal_resolution_ns = 1e9 / fast.frequency_hz();
+        time_reads([&fast]() { return fast.now_ns(); }, reads, result);
+        break;
+    case ClockSource::STEADY_CLOCK:
+        result.nominal_resolution_ns = posix_resolution_ns(CLOCK_MONOTONIC);
+        time_reads([]() { return read_clock_ns(ClockSource::STEADY_CLOCK); }, reads, result);
+        break;
+    case ClockSource::SYSTEM_CLOCK:
+        result.nominal_resolution_ns = posix_resolution_ns(CLOCK_REALTIME);
+        time_reads([]() { return read_clock_ns(ClockSource::SYSTEM_CLOCK); }, reads, result);
+        break;
+    case ClockSource::MONOTONIC_RAW:
+        result.nominal_resolution_ns = posix_resolution_ns(CLOCK_MONOTONIC_RAW);
+        time_reads([]() { return read_clock_ns(ClockSource::MONOTONIC_RAW); }, reads, result);
+        break;
+    case ClockSource::MONOTONIC_COARSE:
+        result.nominal_resolution_ns = posix_resolution_ns(CLOCK_MONOTONIC_COARSE);
+        time_reads([]() { return read_clock_ns(ClockSource::MONOTONIC_COARSE); }, reads, result);
+        break;
+    }
+    return result;
+}
+
+uint64_t cross_core_clock_inversions(ClockSource source, int cpu_a, int cpu_b, uint64_t handoffs) {
+    FastClock::instance();  // calibrate before either thread starts timing
+    return one_way_inversions(source, cpu_a, cpu_b, handoffs) + one_way_inversions(source, cpu_b, cpu_a, handoffs);
+}
+
+} // namespace cm5_peripheral_test
@@ -0,0 +1,106 @@
+/**
+ * @file core_partition.cpp
+ * @brief Implementation of housekeeping / measurement core partitioning.
+ * @author Sandesh Ghimire | sandesh@soccentric
+ * @copyright (C) Soccentric LLC. All rights reserved.
+ */
+
+#include "core_partition.h"
+#include "cpu_topology.h"
+#include <algorithm>
+#include <fstream>
+#include <iterator>
+#include <sstream>
+
+namespace cm5_peripheral_test {
+
+namespace {
+
+std::string read_line(const std::string& path) {
+    std::ifstream file(path);
+    std::string value;
+    if (file.is_open()) {
+        std::getline(file, value);
+    }
+    return value;
+}
+
+} // namespace
+
+std::string CorePartition::describe() const {
+    std::stringstream out;
+    switch (mode) {
+    case PartitionMode::SHARED: out << "shared (too few CPUs to isolate)"; break;
+    case PartitionMode::KERNEL: out << "kernel isolation"; break;
+    case PartitionMode::AFFINITY: out << "affinity"; break;
+    }
+    out << ": housekeeping " << format_cpu_list(housekeeping) << ", measurement " << format_cpu_list(measurement);
+    if (!isolated.empty()) {
+        out << ", isolcpus " << format_cpu_list(isolated);
+    }
+    if (!nohz_full.empty()) {
+        out << ", nohz_full " << format_cpu_list(nohz_full);
+    }
+    return out.str();
+}
+
+CorePartition plan_core_partition(const std::vector<int>& online, const std::vector<int>& isolated,
+                                  const std::vector<int>& nohz_full) {
+    CorePartition partition;
+    partition.isolated = isolated;
+    partition.nohz_full = nohz_full;
+
+    std::vector<int> kernel_isolated;
+    std::set_union(isolated.begin(), isolated.end(), nohz_full.begin(), nohz_full.end(),
+                   std::back_inserter(kernel_isolated));
+    std::set_intersection(online.begin(), online.end(), kernel_isolated.begin(), kernel_isolated.end(),
+                          std::back_inserter(partition.measurement));
+    std::set_difference(online.begin(), online.end(), partition.measurement.begin(), partition.measurement.end(),
+                        std::back_inserter(partition.housekeeping));
+
+    if (!partition.measurement.empty() && !partition.housekeeping.empty()) {
+        partition.mode = PartitionMode::KERNEL;
+        return partition;
+    }
+
+    partition.measurement.clear();
+    partition.housekeeping.clear();
+    if (online.size() < 2) {
+        partition.housekeeping = online;
+        partition.measurement = online;
+        return partition;
+    }
+
+    partition.mode = PartitionMode::AFFINITY;
+    partition.housekeeping.push_back(online.front());
+    partition.measurement.assign(online.begin() + 1, online.end());
+    return partition;
+}
+
+CorePartition detect_core_partition(const std::string& sysfs_root) {
+    return plan_core_partition(parse_cpu_list(read_line(sysfs_root + "/online")),
+                               parse_cpu_list(read_line(sysfs_root + "/isolated")),
+                               parse_cpu_list(read_line(sysfs_root + "/nohz_full")));
+}
+
+std::string format_cpu_list(const std::vector<int>& cpus) {
+    if (cpus.empty()) {
+        return "none";
+    }
+
+    std::stringstream out;
+    for (size_t i = 0; i < cpus.size();) {
+        size_t j = i;
+        while (j + 1 < cpus.size() && cpus[j + 1] == cpus[j] + 1) {
+            ++j;
+        }
+        out << (i > 0 ? "," : "") << cpus[i];
+        if (j > i) {
+            out << "-" << cpus[j];
+        }
+        i = j + 1;
+    }
+    return out.str();
+}
+
+} // namespace cm5_peripheral_test
@@ -0,0 +1,68 @@
+/**
+ * @file cpu_affinity.cpp
+ * @brief Implementation of thread-to-core pinning helpers.
+ * @author Sandesh Ghimire | sandesh@soccentric
+ * @copyright (C) Soccentric LLC. All rights reserved.
+ */
+
+#include "cpu_affinity.h"
+#include <sched.h>
+
+namespace cm5_peripheral_test {
+
+namespace {
+
+bool apply_affinity(const std::vector<int>& cpus) {
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    for (int cpu : cpus) {
+        if (cpu >= 0 && cpu < CPU_SETSIZE) {
+            CPU_SET(cpu, &set);
+        }
+    }
+    return sched_setaffinity(0, sizeof(set), &set) == 0;
+}
+
+} // namespace
+
+bool pin_current_thread(int cpu) {
+    if (cpu < 0 || cpu >= CPU_SETSIZE) {
+        return false;
+    }
+    return apply_affinity({cpu});
+}
+
+bool set_current_thread_cpus(const std::vector<int>& cpus) {
+    if (cpus.empty()) {
+        return false;
+    }
+    return apply_affinity(cpus);
+}
+
+std::vector<int> current_thread_cpus() {
+    std::vector<int> cpus;
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    if (sched_getaffinity(0, sizeof(set), &set) != 0) {
+        return cpus;
+    }
+
+    for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+        if (CPU_ISSET(cpu, &set)) {
+            cpus.push_back(cpu);
+        }
+    }
+    return cpus;
+}
+
+ScopedAffinity::ScopedAffinity(int cpu) : previous_cpus_(current_thread_cpus()), pinned_(false) {
+    pinned_ = pin_current_thread(cpu);
+}
+
+ScopedAffinity::~ScopedAffinity() {
+    if (pinned_ && !previous_cpus_.empty()) {
+        apply_affinity(previous_cpus_);
+    }
+}
+
+} // namespace cm5_peripheral_test
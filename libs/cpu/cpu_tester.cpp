@@ -6,6 +6,28 @@
  */
 
 #include "cpu_tester.h"
+#include "clock_characterization.h"
+#include "core_partition.h"
+#include "cpu_affinity.h"
+#include "cpufreq_policy.h"
+#include "cpuidle_monitor.h"
+#include "crypto_benchmark.h"
+#include "fast_clock.h"
+#include "frontend_benchmark.h"
+#include "handoff_benchmark.h"
+#include "gemm_benchmark.h"
+#include "interrupt_monitor.h"
+#include "litmus_test.h"
+#include "lock_benchmark.h"
+#include "mapping_benchmark.h"
+#include "measurement_harness.h"
+#include "perf_counter.h"
+#include "sdc_screen.h"
+#include "series_recorder.h"
+#include "stress_generator.h"
+#include "thermal_model.h"
+#include "thread_benchmark.h"
+#include "tlb_benchmark.h"
 #include <iostream>
 #include <fstream>
 #include <sstream>
@@ -15,11 +37,204 @@
 #include <cmath>
 #include <algorithm>
 #include <numeric>
+#include <iomanip>
+#include <iterator>
+#include <atomic>
+#include <time.h>
 
 namespace fs = std::filesystem;
 
 namespace cm5_peripheral_test {
 
+namespace {
+
+/** Iterations of the sweep kernel per sample. */
+constexpr uint64_t SWEEP_KERNEL_ITERATIONS = 10000000;
+
+/** Longest a frequency step may keep sampling before reporting. */
+constexpr std::chrono::milliseconds SWEEP_TIME_CAP(2000);
+
+/** Time allowed for the clock to settle after a cpufreq change. */
+constexpr std::chrono::milliseconds SWEEP_SETTLE_TIME(100);
+
+/** Maximum relative deviation between requested and measured clock. */
+constexpr double SWEEP_FREQUENCY_TOLERANCE = 0.10;
+
+/** Maximum relative deviation of throughput/MHz from the top step. */
+constexpr double SWEEP_LINEARITY_TOLERANCE = 0.15;
+
+/** Idle time before each DVFS ramp so the governor can drop the clock. */
+constexpr std::chrono::milliseconds DVFS_IDLE_TIME(1000);
+
+/** Duration of the full-load phase of a DVFS ramp. */
+constexpr std::chrono::milliseconds DVFS_LOAD_TIME(1000);
+
+/** Busy window over which one effective-frequency sample is taken. */
+constexpr std::chrono::microseconds DVFS_SAMPLE_WINDOW(500);
+
+/** Poll interval for scaling_cur_freq while waiting for ramp-down. */
+constexpr std::chrono::milliseconds DVFS_IDLE_POLL(1);
+
+/** Give up waiting for ramp-down after this long. */
+constexpr std::chrono::milliseconds DVFS_IDLE_TIMEOUT(3000);
+
+/** Fraction of the plateau (or of the idle clock) that counts as arrived. */
+constexpr double DVFS_SETTLED_FRACTION = 0.95;
+
+/** Cadence of the interrupt sampler during monitoring. */
+constexpr std::chrono::milliseconds INTERRUPT_SAMPLE_INTERVAL(100);
+
+/** Interrupt sources listed in the monitoring report. */
+constexpr size_t INTERRUPT_REPORT_LIMIT = 10;
+
+/** Per-CPU interval rate of a single source reported as a storm. */
+constexpr double INTERRUPT_STORM_RATE = 100000.0;
+
+/** Trip point assumed when the thermal zone exposes none (BCM2712 firmware soft throttle). */
+constexpr double THERMAL_DEFAULT_TRIP_C = 85.0;
+
+/** Readings retained per monitored quantity: the last hour at the 1 s cadence. */
+constexpr size_t MONITOR_SERIES_CAPACITY = 3600;
+
+/** Time constant of the moving averages reported by the monitors. */
+constexpr double MONITOR_EWMA_TIME_CONSTANT_S = 60.0;
+
+/** Timer wakeups sampled per idle configuration. */
+constexpr int WAKEUP_SAMPLES = 200;
+
+/** Sleep between wakeups; long enough for deep states to be selected. */
+constexpr long WAKEUP_INTERVAL_NS = 5000000;
+
+/** Largest wakeup lateness tracked exactly by the histogram (1 s). */
+constexpr uint64_t WAKEUP_HISTOGRAM_HIGHEST_NS = 1000000000;
+
+/** Length of one contention sample. */
+constexpr std::chrono::milliseconds CONTENTION_SAMPLE_TIME(50);
+
+/** Longest a primitive and thread count may keep sampling. */
+constexpr std::chrono::milliseconds CONTENTION_TIME_CAP(1000);
+
+/** Litmus instances per test, ordering and core placement. */
+constexpr uint64_t LITMUS_ITERATIONS = 1000000;
+
+/** Length of one crypto throughput sample. */
+constexpr std::chrono::milliseconds CRYPTO_SAMPLE_TIME(50);
+
+/** Longest an algorithm and implementation may keep sampling. */
+constexpr std::chrono::milliseconds CRYPTO_TIME_CAP(1500);
+
+/** Minimum speedup of an accelerated crypto path over portable C. */
+constexpr double CRYPTO_MIN_SPEEDUP = 3.0;
+
+/** Matrix dimension for the GEMM benchmark (3 x 1 MiB in single precision). */
+constexpr int GEMM_SIZE = 512;
+
+/** Length of one GEMM sample. */
+constexpr std::chrono::milliseconds GEMM_SAMPLE_TIME(200);
+
+/** Longest a GEMM configuration may keep sampling. */
+constexpr std::chrono::milliseconds GEMM_TIME_CAP(4000);
+
+/** Target 95% confidence half-width, relative to the mean, for benchmarks. */
+constexpr double BENCHMARK_TARGET_CI = 0.02;
+
+/** Consecutive reads per clock source and core. */
+constexpr uint64_t CLOCK_READS = 1000000;
+
+/** Timestamps handed each way between a pair of cores. */
+constexpr uint64_t CLOCK_HANDOFFS = 20000;
+
+/** Maximum disagreement between the fast counter and CLOCK_MONOTONIC. */
+constexpr double CLOCK_MAX_DRIFT_PPM = 500.0;
+
+/** Rounds timed per thread operation and thread count. */
+constexpr uint64_t THREAD_COST_ROUNDS = 2000;
+
+/** Working sets for the TLB benchmark: inside, near and far beyond the L2 TLB reach. */
+constexpr size_t TLB_WORKING_SETS[] = {4u << 20, 32u << 20, 128u << 20};
+
+/** Dependent loads per timed lap; laps repeat until converged. */
+constexpr uint64_t TLB_ACCESSES = 1000000;
+
+/** Time cap of the repeated laps per backing and working set. */
+constexpr std::chrono::milliseconds TLB_TIME_CAP(1500);
+
+/** Buffer faulted in, or carved into chunks, by the mapping benchmark. */
+constexpr size_t MAPPING_REGION_BYTES = 64u << 20;
+
+/** Time cap of the repeated runs per mapping operation. */
+constexpr std::chrono::milliseconds MAPPING_TIME_CAP(3000);
+
+/** Iterations (branches, calls or code blocks) per front-end kernel run. */
+constexpr uint64_t FRONTEND_ITERATIONS = 5000000;
+
+/** Time cap of the repeated runs per front-end kernel. */
+constexpr std::chrono::milliseconds FRONTEND_TIME_CAP(1500);
+
+/** Items streamed through a queue per handoff benchmark run. */
+constexpr uint64_t HANDOFF_ITEMS = 500000;
+
+/** Time cap of the repeated runs per handoff queue. */
+constexpr std::chrono::milliseconds HANDOFF_TIME_CAP(3000);
+
+/** Length of a silent data corruption screen. */
+constexpr std::chrono::seconds SDC_SCREEN_TIME(30);
+
+/** Mismatches listed individually before the report is truncated. */
+constexpr size_t SDC_REPORT_LIMIT = 20;
+
+/**
+ * @brief Serial xorshift chain with a fixed instruction count per iteration.
+ *
+ * Every iteration depends on the previous one, so the kernel is
+ * latency-bound on the integer ALU and its throughput scales linearly
+ * with core clock when nothing else is limiting it.
+ */
+uint64_t sweep_kernel(uint64_t iterations) {
+    uint64_t x = 0x9E3779B97F4A7C15ULL;
+    for (uint64_t i = 0; i < iterations; ++i) {
+        x ^= x << 13;
+        x ^= x >> 7;
+        x ^= x << 17;
+    }
+    return x;
+}
+
+/**
+ * @brief Convergence rules shared by the benchmark-style tests.
+ */
+ConvergenceCriteria benchmark_criteria(std::chrono::milliseconds time_cap) {
+    ConvergenceCriteria criteria;
+    criteria.target_relative_ci = BENCHMARK_TARGET_CI;
+    criteria.time_cap = time_cap;
+    return criteria;
+}
+
+/**
+ * @brief Coefficient of determination of a least-squares line through (x, y).
+ */
+double linear_fit_r_squared(const std::vector<double>& x, const std::vector<double>& y) {
+    size_t n = x.size();
+    if (n < 2) {
+        return 1.0;
+    }
+
+    double mean_x = std::accumulate(x.begin(), x.end(), 0.0) / n;
+    double mean_y = std::accumulate(y.begin(), y.end(), 0.0) / n;
+    double sxx = 0.0, sxy = 0.0, syy = 0.0;
+    for (size_t i = 0; i < n; ++i) {
+        sxx += (x[i] - mean_x) * (x[i] - mean_x);
+        sxy += (x[i] - mean_x) * (y[i] - mean_y);
+        syy += (y[i] - mean_y) * (y[i] - mean_y);
+    }
+    if (sxx == 0.0 || syy == 0.0) {
+        return 1.0;
+    }
+    return (sxy * sxy) / (sxx * syy);
+}
+
+} // namespace
+
 CPUTester::CPUTester() : cpu_available_(false) {
     // Check if CPU information is available
     cpu_available_ = fs::exists("/proc/cpuinfo");
@@ -28,8 +243,34 @@ CPUTester::CPUTester() : cpu_available_(false) {
     }
 }
 
+bool CPUTester::enable_core_isolation() {
+    partition_ = detect_core_partition();
+    if (partition_.housekeeping.empty() || !set_current_thread_cpus(partition_.housekeeping)) {
+        return false;
+    }
+    isolated_ = partition_.mode != PartitionMode::SHARED;
+    placement_ = partition_.describe();
+    return isolated_;
+}
+
+std::vector<int> CPUTester::measurement_cpus() const {
+    std::vector<int> cpus = cpu_info_.topology.one_cpu_per_core();
+    if (!isolated_) {
+        return cpus.empty() ? current_thread_cpus() : cpus;
+    }
+
+    // Isolated CPUs may be SMT siblings the per-core list skipped
+    std::vector<int> measured;
+    for (int cpu : cpus) {
+        if (std::find(partition_.measurement.begin(), partition_.measurement.end(), cpu) != partition_.measurement.end()) {
+            measured.push_back(cpu);
+        }
+    }
+    return measured.empty() ? partition_.measurement : measured;
+}
+
 TestReport CPUTester::short_test() {
-    auto start_time = std::chrono::steady_clock::now();
+    auto start_time = begin_test();
 
     if (!cpu_available_) {
         return create_report(TestResult::NOT_SUPPORTED, "CPU information not available", std::chrono::milliseconds(0));
@@ -43,6 +284,7 @@ TestReport CPUTester::short_test() {
     details << "Cores: " << cpu_info_.cores << "\n";
     details << "Architecture: " << cpu_info_.architecture << "\n";
     details << "Frequency: " << cpu_info_.frequency_mhz << " MHz\n";
+    details << cpu_info_.topology.describe();
 
     // Test basic computation
     TestResult benchmark_result = benchmark_cpu();
@@ -72,25 +314,222 @@ TestReport CPUTester::short_test() {
 }
 
 TestReport CPUTester::monitor_test(std::chrono::seconds duration) {
-    auto start_time = std::chrono::steady_clock::now();
+    auto start_time = begin_test();
 
     if (!cpu_available_) {
         return create_report(TestResult::NOT_SUPPORTED, "CPU information not available", std::chrono::milliseconds(0));
     }
 
-    TestResult result = monitor_temperature(duration);
+    CpuidleMonitor idle_monitor;
+    if (idle_monitor.is_available()) {
+        idle_monitor.start();
+    }
+
+    // Interrupt counters are sampled on their own thread at a much finer
+    // cadence than the temperature loop so short storms are not averaged away
+    InterruptMonitor irq_monitor;
+    std::atomic<bool> stop_sampling{false};
+    std::thread irq_sampler;
+    if (irq_monitor.is_available()) {
+        irq_monitor.start();
+        irq_sampler = std::thread([&irq_monitor, &stop_sampling]() {
+            auto next = std::chrono::steady_clock::now();
+            while (!stop_sampling.load(std::memory_order_relaxed)) {
+                next += INTERRUPT_SAMPLE_INTERVAL;
+                std::this_thread::sleep_until(next);
+                irq_monitor.sample();
+            }
+        });
+    }
+
+    std::string thermal_summary;
+    std::vector<TimeSeries> series;
+    std::vector<StreamingSummary> statistics;
+    TestResult result = monitor_temperature(duration, thermal_summary, series, statistics);
+
+    stop_sampling.store(true);
+    if (irq_sampler.joinable()) {
+        irq_sampler.join();
+    }
 
     auto end_time = std::chrono::steady_clock::now();
     auto test_duration = std::chrono::duration_cast<std::chrono::milliseconds>(end_time - start_time);
 
     std::string details = "CPU monitoring completed for " + std::to_string(duration.count()) + " seconds";
-    return create_report(result, details, test_duration);
+    details += "\n" + thermal_summary;
+    if (idle_monitor.is_available()) {
+        details += "\n" + idle_monitor.format_residency(idle_monitor.sample());
+    }
+    if (irq_monitor.is_available()) {
+        details += "\n" + irq_monitor.format_summary(INTERRUPT_REPORT_LIMIT, INTERRUPT_STORM_RATE);
+    }
+    TestReport report = create_report(result, details, test_duration);
+    report.series = std::move(series);
+    report.statistics = std::move(statistics);
+    return report;
 }
 
 bool CPUTester::is_available() const {
     return cpu_available_;
 }
 
+TestReport CPUTester::frequency_sweep_test() {
+    auto start_time = begin_test();
+
+    if (!cpu_available_) {
+        return create_report(TestResult::NOT_SUPPORTED, "CPU information not available", std::chrono::milliseconds(0));
+    }
+
+    std::vector<int> cpus = measurement_cpus();
+    CpufreqPolicy policy(cpus.empty() ? 0 : cpus.front());
+    if (!policy.is_available()) {
+        return create_report(TestResult::NOT_SUPPORTED, "cpufreq policy not available", std::chrono::milliseconds(0));
+    }
+    if (!policy.is_writable()) {
+        return create_report(TestResult::SKIPPED, "cpufreq policy not writable (requires root)", std::chrono::milliseconds(0));
+    }
+
+    std::vector<long> frequencies = policy.available_frequencies_khz();
+    if (frequencies.empty()) {
+        return create_report(TestResult::NOT_SUPPORTED, "No cpufreq steps reported", std::chrono::milliseconds(0));
+    }
+
+    ScopedAffinity affinity(policy.cpu());
+    CpufreqSettings original = policy.snapshot();
+
+    std::stringstream details;
+    bool all_passed = true;
+    std::vector<FrequencyStep> steps;
+
+    for (long khz : frequencies) {
+        if (!policy.pin_frequency(khz)) {
+            details << "Failed to pin " << khz / 1000 << " MHz\n";
+            all_passed = false;
+            continue;
+        }
+        std::this_thread::sleep_for(SWEEP_SETTLE_TIME);
+        steps.push_back(measure_frequency_step(khz));
+    }
+
+    bool restored = policy.restore(original);
+
+    if (steps.empty()) {
+        details << "Restored governor: " << (restored ? "yes" : "NO") << "\n";
+        auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start_time);
+        return create_report(TestResult::FAILURE, details.str(), duration);
+    }
+
+    // Normalise efficiency against the highest step, which should be the
+    // least affected by fixed overheads
+    double reference_efficiency = steps.back().throughput_per_mhz;
+    std::vector<double> requested_mhz;
+    std::vector<double> throughputs;
+
+    details << std::fixed << std::setprecision(1);
+    details << "Step (MHz) | Measured (MHz) | Throughput (Mit/s, median) | Relative efficiency\n";
+    for (const auto& step : steps) {
+        double requested = step.requested_khz / 1000.0;
+        double relative = reference_efficiency > 0 ? step.throughput_per_mhz / reference_efficiency : 0.0;
+        requested_mhz.push_back(requested);
+        throughputs.push_back(step.throughput);
+
+        details << requested << " | ";
+        if (step.measured_mhz > 0) {
+            details << step.measured_mhz;
+        } else {
+            details << "n/a";
+        }
+        details << " | " << step.throughput / 1e6 << " ±" << step.throughput_ci * 100.0 << "% n=" << step.samples
+                << " | " << std::setprecision(3) << relative << std::setprecision(1);
+
+        bool clock_ok = step.measured_mhz <= 0 ||
+                        std::abs(step.measured_mhz - requested) <= requested * SWEEP_FREQUENCY_TOLERANCE;
+        bool linear_ok = std::abs(relative - 1.0) <= SWEEP_LINEARITY_TOLERANCE;
+        if (!clock_ok) details << " [clock mismatch]";
+        if (!linear_ok) details << " [non-linear]";
+        details << "\n";
+
+        if (!clock_ok || !linear_ok) all_passed = false;
+    }
+
+    details << "Linearity R^2: " << std::setprecision(4) << linear_fit_r_squared(requested_mhz, throughputs) << "\n";
+    details << "Restored governor: " << (restored ? "yes" : "NO") << " (" << original.governor << ")\n";
+    if (!restored) all_passed = false;
+
+    auto end_time = std::chrono::steady_clock::now();
+    auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(end_time - start_time);
+
+    return create_report(all_passed ? TestResult::SUCCESS : TestResult::FAILURE, details.str(), duration);
+}
+
+TestReport CPUTester::dvfs_latency_test() {
+    auto start_time = begin_test();
+
+    if (!cpu_available_) {
+        return create_report(TestResult::NOT_SUPPORTED, "CPU information not available", std::chrono::milliseconds(0));
+    }
+
+    std::vector<int> cpus = measurement_cpus();
+    CpufreqPolicy policy(cpus.empty() ? 0 : cpus.front());
+    if (!policy.is_available()) {
+        return create_report(TestResult::NOT_SUPPORTED, "cpufreq policy not available", std::chrono::milliseconds(0));
+    }
+    if (!policy.is_writable()) {
+        return create_report(TestResult::SKIPPED, "cpufreq policy not writable (requires root)", std::chrono::milliseconds(0));
+    }
+
+    ScopedAffinity affinity(policy.cpu());
+    CpufreqSettings original = policy.snapshot();
+
+    std::stringstream details;
+    details << std::fixed << std::setprecision(1);
+    details << "Governor | Idle (MHz) | Peak (MHz) | Time-to-max (ms) | Time-to-idle (ms)\n";
+    bool all_passed = true;
+
+    for (const auto& governor : policy.available_governors()) {
+        // userspace holds whatever setspeed was last written and never ramps
+        if (governor == "userspace") {
+            continue;
+        }
+
+        if (!policy.set_governor(governor) ||
+            !policy.set_limits(policy.hardware_min_khz(), policy.hardware_max_khz())) {
+            details << governor << " | failed to select\n";
+            all_passed = false;
+            continue;
+        }
+
+        DvfsTransition transition = measure_dvfs_transition(policy);
+        transition.governor = governor;
+
+        details << transition.governor << " | " << transition.idle_mhz << " | " << transition.peak_mhz << " | ";
+        if (transition.time_to_max_ms >= 0) {
+            details << transition.time_to_max_ms;
+        } else {
+            details << "never";
+        }
+        details << " | ";
+        if (transition.time_to_idle_ms >= 0) {
+            details << transition.time_to_idle_ms;
+        } else {
+            details << "never";
+        }
+        if (!transition.cycle_counter) {
+            details << " [scaling_cur_freq]";
+        }
+        details << "\n";
+    }
+
+    bool restored = policy.restore(original);
+    details << "Restored governor: " << (restored ? "yes" : "NO") << " (" << original.governor << ")\n";
+    if (!restored) all_passed = false;
+
+    auto end_time = std::chrono::steady_clock::now();
+    auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(end_time - start_time);
+
+    return create_report(all_passed ? TestResult::SUCCESS : TestResult::FAILURE, details.str(), duration);
+}
+
 CPUInfo CPUTester::get_cpu_info() {
     CPUInfo info;
     std::ifstream cpuinfo("/proc/cpuinfo");
@@ -131,6 +570,13 @@ CPUInfo CPUTester::get_cpu_info() {
         }
     }
 
+    // Get topology and cache hierarchy
+    info.topology = CpuTopology("/sys/devices/system/cpu");
+    if (info.cores <= 0) {
+        // ARM kernels do not publish "cpu cores" in /proc/cpuinfo
+        info.cores = info.topology.physical_core_count();
+    }
+
     // Get temperature
     info.temperature_c = get_cpu_temperature();
 
@@ -177,35 +623,80 @@ TestResult CPUTester::test_temperature() {
     return TestResult::SUCCESS;
 }
 
-TestResult CPUTester::monitor_temperature(std::chrono::seconds duration) {
+TestResult CPUTester::monitor_temperature(std::chrono::seconds duration, std::string& summary,
+                                          std::vector<TimeSeries>& series,
+                                          std::vector<StreamingSummary>& statistics) {
     auto start_time = std::chrono::steady_clock::now();
     auto end_time = start_time + duration;
 
-    std::vector<double> temperatures;
-    double min_temp = 999.0;
-    double max_temp = -999.0;
+    ThermalModel model;
+    SystemLoadSampler load_sampler;
+    TimeSeries temperatures("temperature_c", MONITOR_SERIES_CAPACITY);
+    TimeSeries loads("load_fraction", MONITOR_SERIES_CAPACITY);
+    StreamingSummary temperature_stats("temperature_c", MONITOR_EWMA_TIME_CONSTANT_S);
+    StreamingSummary load_stats("load_fraction", MONITOR_EWMA_TIME_CONSTANT_S);
+    std::unique_ptr<SeriesRecorder> recorder;
+    if (!recording_path_.empty()) {
+        recorder.reset(new SeriesRecorder(recording_path_, {"cpu/temperature_c", "cpu/load_fraction"}));
+    }
+    double last_temp = 0.0;
+    double last_load = 0.0;
 
     while (std::chrono::steady_clock::now() < end_time) {
         double temp = get_cpu_temperature();
+        double load = load_sampler.sample();
+        double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start_time).count();
+        if (load >= 0) {
+            last_load = load;
+            loads.append(elapsed, load);
+            load_stats.add(elapsed, load);
+            if (recorder) {
+                recorder->record(1, SeriesRecorder::now_ms(), load);
+            }
+        }
         if (temp >= 0) {
-            temperatures.push_back(temp);
-            min_temp = std::min(min_temp, temp);
-            max_temp = std::max(max_temp, temp);
+            last_temp = temp;
+            temperatures.append(elapsed, temp);
+            temperature_stats.add(elapsed, temp);
+            if (recorder) {
+                recorder->record(0, SeriesRecorder::now_ms(), temp);
+            }
+            model.add_sample(elapsed, temp, last_load);
         }
 
         std::this_thread::sleep_for(std::chrono::seconds(1));
     }
 
-    if (temperatures.empty()) {
+    series.push_back(std::move(temperatures));
+    series.push_back(std::move(loads));
+    statistics.push_back(temperature_stats);
+    statistics.push_back(load_stats);
+    std::string recording;
+    if (recorder) {
+        recorder->stop();
+        recording = recorder->describe() + "\n";
+    }
+
+    const Extremes& extremes = temperature_stats.extremes();
+    if (extremes.empty()) {
+        summary = "Temperature: not available\n" + recording;
         return TestResult::NOT_SUPPORTED;
     }
 
-    // Check temperature stability (variation should be reasonable)
-    double avg_temp = std::accumulate(temperatures.begin(), temperatures.end(), 0.0) / temperatures.size();
-    double temp_variation = max_temp - min_temp;
+    double trip = read_trip_point();
+    std::stringstream text;
+    text << std::fixed << std::setprecision(1);
+    text << "Temperature: " << extremes.min() << "°C to " << extremes.max() << "°C over "
+         << temperature_stats.moments().count() << " readings\n";
+    if (trip < 0) {
+        trip = THERMAL_DEFAULT_TRIP_C;
+        text << "No trip point exposed; assuming " << trip << "°C\n";
+    }
+    text << format_thermal_prediction(model.fit(), last_temp, last_load, trip);
+    summary = text.str() + recording;
 
     // Allow up to 20°C variation during monitoring
-    return (temp_variation <= 20.0) ? TestResult::SUCCESS : TestResult::FAILURE;
+    return (extremes.range() <= 20.0) ? TestResult::SUCCESS : TestResult::FAILURE;
 }
 
 TestResult CPUTester::test_multi_core() {
@@ -244,6 +735,1131 @@ TestResult CPUTester::test_multi_core() {
     return TestResult::SUCCESS;
 }
 
+FrequencyStep CPUTester::measure_frequency_step(long requested_khz) {
+    PerfCounter cycles(PerfEvent::CPU_CYCLES);
+    uint64_t total_cycles = 0;
+    double total_seconds = 0.0;
+    volatile uint64_t sink = 0;
+
+    // Warm-up samples let the governor/PLL finish any pending transition
+    MeasurementSummary throughput = measure_until_converged([&]() {
+        auto start = std::chrono::steady_clock::now();
+        cycles.start();
+        sink = sweep_kernel(SWEEP_KERNEL_ITERATIONS);
+        uint64_t cycle_count = cycles.stop();
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        total_cycles += cycle_count;
+        total_seconds += seconds;
+        return seconds > 0 ? SWEEP_KERNEL_ITERATIONS / seconds : 0.0;
+    }, benchmark_criteria(SWEEP_TIME_CAP));
+    (void)sink;
+
+    FrequencyStep step;
+    step.requested_khz = requested_khz;
+    step.throughput = throughput.median;
+    step.throughput_ci = throughput.relative_ci;
+    step.samples = throughput.iterations;
+    step.measured_mhz = (cycles.is_available() && total_seconds > 0) ? total_cycles / total_seconds / 1e6 : 0.0;
+    step.throughput_per_mhz = requested_khz > 0 ? step.throughput / (requested_khz / 1000.0) : 0.0;
+    return step;
+}
+
+TestReport CPUTester::idle_latency_test() {
+    auto start_time = begin_test();
+
+    if (!cpu_available_) {
+        return create_report(TestResult::NOT_SUPPORTED, "CPU information not available", std::chrono::milliseconds(0));
+    }
+
+    CpuidleMonitor idle;
+    if (!idle.is_available()) {
+        return create_report(TestResult::NOT_SUPPORTED, "cpuidle states not available", std::chrono::milliseconds(0));
+    }
+
+    std::vector<int> measured = measurement_cpus();
+    size_t cpu_position = 0;
+    for (size_t i = 0; i < idle.cpus().size(); ++i) {
+        if (std::find(measured.begin(), measured.end(), idle.cpus()[i]) != measured.end()) {
+            cpu_position = i;
+            break;
+        }
+    }
+    int cpu = idle.cpus()[cpu_position];
+    const auto& states = idle.states();
+    ScopedAffinity affinity(cpu);
+
+    std::vector<bool> original_disabled;
+    for (const auto& state : states) {
+        original_disabled.push_back(idle.is_state_disabled(cpu, state.index));
+    }
+
+    std::stringstream details;
+    details << std::fixed << std::setprecision(1);
+    details << "Deepest allowed | Exit latency (us) | Median (us) | p99 (us) | Max (us) | Cost (us) | Residency (%)\n";
+
+    bool controllable = true;
+    double baseline_median = -1.0;
+    std::vector<LatencyHistogram> histograms;
+
+    for (const auto& deepest : states) {
+        for (const auto& state : states) {
+            if (!idle.set_state_disabled(cpu, state.index, state.index > deepest.index)) {
+                controllable = false;
+            }
+        }
+        if (!controllable) {
+            break;
+        }
+
+        idle.start();
+        LatencyHistogram histogram("wakeup_" + deepest.name + "_ns", WAKEUP_HISTOGRAM_HIGHEST_NS);
+        WakeupLatency latency = measure_wakeup_latency(histogram);
+        auto deltas = idle.sample();
+        histograms.push_back(std::move(histogram));
+
+        if (baseline_median < 0) {
+            baseline_median = latency.median_us;
+        }
+        details << deepest.name << " | " << deepest.exit_latency_us << " | " << latency.median_us << " | "
+                << latency.p99_us << " | " << latency.max_us << " | " << latency.median_us - baseline_median << " | ";
+        const IdleStateDelta& residency = deltas[cpu_position][deepest.index];
+        if (residency.valid) {
+            details << residency.residency * 100.0 << "\n";
+        } else {
+            details << "-\n";
+        }
+    }
+
+    for (const auto& state : states) {
+        idle.set_state_disabled(cpu, state.index, original_disabled[state.index]);
+    }
+
+    TestResult result = TestResult::SUCCESS;
+    if (!controllable) {
+        // Without write access only the configuration in force can be measured
+        idle.start();
+        LatencyHistogram histogram("wakeup_current_ns", WAKEUP_HISTOGRAM_HIGHEST_NS);
+        WakeupLatency latency = measure_wakeup_latency(histogram);
+        auto deltas = idle.sample();
+        histograms.push_back(std::move(histogram));
+        details << "current | - | " << latency.median_us << " | " << latency.p99_us << " | " << latency.max_us
+                << " | - | -\n";
+        details << idle.format_residency(deltas);
+        details << "Idle states not writable (requires root); per-state comparison skipped\n";
+        result = TestResult::SKIPPED;
+    }
+
+    auto end_time = std::chrono::steady_clock::now();
+    auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(end_time - start_time);
+
+    TestReport report = create_report(result, details.str(), duration);
+    report.histograms = std::move(histograms);
+    return report;
+}
+
+TestReport CPUTester::lock_contention_test() {
+    auto start_time = begin_test();
+
+    if (!cpu_available_) {
+        return create_report(TestResult::NOT_SUPPORTED, "CPU information not available", std::chrono::milliseconds(0));
+    }
+
+    std::vector<int> cpus = measurement_cpus();
+    if (cpus.empty()) {
+        return create_report(TestResult::NOT_SUPPORTED, "No CPUs available for placement", std::chrono::milliseconds(0));
+    }
+
+    std::vector<size_t> thread_counts;
+    for (size_t count = 1; count < cpus.size(); count *= 2) {
+        thread_counts.push_back(count);
+    }
+    thread_counts.push_back(cpus.size());
+
+    const SyncPrimitive primitives[] = {
+        SyncPrimitive::STD_MUTEX,       SyncPrimitive::TICKET_SPINLOCK, SyncPrimitive::MCS_LOCK,
+        SyncPrimitive::ATOMIC_RELAXED,  SyncPrimitive::ATOMIC_SEQ_CST,  SyncPrimitive::SHARED_COUNTERS,
+        SyncPrimitive::PADDED_COUNTERS,
+    };
+
+    std::stringstream details;
+    details << std::fixed;
+    details << "Primitive | Threads | Mops/s (median) | Fairness\n";
+    bool all_passed = true;
+    double shared_rate = 0.0;
+    double padded_rate = 0.0;
+
+    for (SyncPrimitive primitive : primitives) {
+        for (size_t threads : thread_counts) {
+            std::vector<int> placement(cpus.begin(), cpus.begin() + threads);
+            ContentionResult result;
+            bool consistent = true;
+            MeasurementSummary rate = measure_until_converged([&]() {
+                result = run_contention_benchmark(primitive, placement, CONTENTION_SAMPLE_TIME);
+                consistent = consistent && result.consistent;
+                return result.ops_per_second;
+            }, benchmark_criteria(CONTENTION_TIME_CAP));
+
+            details << sync_primitive_name(primitive) << " | " << threads << " | "
+                    << format_measurement(rate, 1e-6, 2) << " | " << std::setprecision(3) << result.fairness;
+            if (!consistent) {
+                details << " [LOST UPDATES]";
+                all_passed = false;
+            }
+            details << "\n";
+
+            if (threads == cpus.size()) {
+                if (primitive == SyncPrimitive::SHARED_COUNTERS) shared_rate = rate.median;
+                if (primitive == SyncPrimitive::PADDED_COUNTERS) padded_rate = rate.median;
+            }
+        }
+    }
+
+    if (shared_rate > 0) {
+        details << "False-sharing slowdown at " << cpus.size() << " thread(s): " << std::setprecision(2)
+                << padded_rate / shared_rate << "x\n";
+    }
+
+    auto end_time = std::chrono::steady_clock::now();
+    auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(end_time - start_time);
+
+    return create_report(all_passed ? TestResult::SUCCESS : TestResult::FAILURE, details.str(), duration);
+}
+
+TestReport CPUTester::stress_test(const StressConfig& config, std::chrono::seconds duration) {
+    auto start_time = begin_test();
+
+    if (!cpu_available_) {
+        return create_report(TestResult::NOT_SUPPORTED, "CPU information not available", std::chrono::milliseconds(0));
+    }
+
+    StressConfig resolved = config;
+    if (resolved.cpus.empty()) {
+        resolved.cpus = measurement_cpus();
+    }
+    if (resolved.cache_bytes == 0) {
+        // Size the thrash buffer against the last-level data cache
+        for (int level = 1; level <= 4; ++level) {
+            if (const CacheDescriptor* cache = cpu_info_.topology.data_cache(level)) {
+                resolved.cache_bytes = cache->size_bytes;
+            }
+        }
+    }
+
+    StressGenerator generator(resolved);
+    double start_temp = get_cpu_temperature();
+    if (!generator.start()) {
+        return create_report(TestResult::NOT_SUPPORTED, "No CPUs available for placement", std::chrono::milliseconds(0));
+    }
+
+    std::string thermal_summary;
+    std::vector<TimeSeries> series;
+    std::vector<StreamingSummary> statistics;
+    TestResult temperature_result = monitor_temperature(duration, thermal_summary, series, statistics);
+    double end_temp = get_cpu_temperature();
+    generator.stop();
+
+    std::stringstream details;
+    details << std::fixed << std::setprecision(1);
+    details << "Stress pattern:\n" << generator.describe();
+
+    bool all_progressed = true;
+    std::vector<uint64_t> work = generator.work_done();
+    const std::vector<int>& cpus = resolved.cpus;
+    for (size_t i = 0; i < work.size() && i < cpus.size(); ++i) {
+        double duty = resolved.duty_cycles.empty()
+                          ? 1.0
+                          : resolved.duty_cycles[std::min(i, resolved.duty_cycles.size() - 1)];
+        details << "  cpu" << cpus[i] << " work units: " << work[i] << "\n";
+        if (duty > 0.0 && work[i] == 0) {
+            all_progressed = false;
+        }
+    }
+
+    if (start_temp >= 0 && end_temp >= 0) {
+        details << "Temperature: " << start_temp << "°C -> " << end_temp << "°C\n";
+    }
+    details << thermal_summary;
+
+    auto end_time = std::chrono::steady_clock::now();
+    auto test_duration = std::chrono::duration_cast<std::chrono::milliseconds>(end_time - start_time);
+
+    bool passed = all_progressed && temperature_result != TestResult::FAILURE;
+    TestReport report = create_report(passed ? TestResult::SUCCESS : TestResult::FAILURE, details.str(), test_duration);
+    report.series = std::move(series);
+    report.statistics = std::move(statistics);
+    return report;
+}
+
+TestReport CPUTester::sdc_screen_test() {
+    auto start_time = begin_test();
+
+    if (!cpu_available_) {
+        return create_report(TestResult::NOT_SUPPORTED, "CPU information not available", std::chrono::milliseconds(0));
+    }
+
+    std::vector<int> cpus = measurement_cpus();
+    if (cpus.empty()) {
+        return create_report(TestResult::NOT_SUPPORTED, "No CPUs available for placement", std::chrono::milliseconds(0));
+    }
+
+    std::stringstream details;
+    details << std::fixed;
+
+    // Marginal cores usually fail first at their highest operating point
+    std::vector<std::pair<CpufreqPolicy, CpufreqSettings>> pinned;
+    for (int cpu : cpus) {
+        CpufreqPolicy policy(cpu);
+        if (!policy.is_available() || !policy.is_writable()) {
+            continue;
+        }
+        CpufreqSettings original = policy.snapshot();
+        if (policy.pin_frequency(policy.hardware_max_khz())) {
+            pinned.emplace_back(policy, original);
+        }
+    }
+    details << "Cores pinned to max frequency: " << pinned.size() << "/" << cpus.size() << "\n";
+
+    double start_temp = get_cpu_temperature();
+    SdcScreenResult result = run_sdc_screen(cpus, std::chrono::duration_cast<std::chrono::milliseconds>(SDC_SCREEN_TIME));
+    double end_temp = get_cpu_temperature();
+
+    bool restored = true;
+    for (auto it = pinned.rbegin(); it != pinned.rend(); ++it) {
+        restored = it->first.restore(it->second) && restored;
+    }
+
+    details << "Kernel runs: " << result.kernel_runs << " (" << std::setprecision(0) << result.runs_per_second
+            << "/s)\n";
+    for (SdcKernel kernel : {SdcKernel::CRC32C, SdcKernel::CRYPTO}) {
+        details << "  " << sdc_kernel_name(kernel) << " kernel: "
+                << (sdc_kernel_accelerated(kernel) ? "CPU instructions" : "portable code") << "\n";
+    }
+    for (size_t i = 0; i < result.cpus.size(); ++i) {
+        details << "  cpu" << result.cpus[i] << ": " << result.rounds[i] << " rounds\n";
+    }
+    if (result.cpus.size() > 1) {
+        details << "Rounds cross-checked: " << result.rounds_compared << "\n";
+    } else {
+        details << "Single core: golden checks only\n";
+    }
+    if (start_temp >= 0 && end_temp >= 0) {
+        details << "Temperature: " << std::setprecision(1) << start_temp << "°C -> " << end_temp << "°C\n";
+    }
+
+    details << "Mismatches: " << result.mismatches.size() << "\n";
+    for (size_t i = 0; i < result.mismatches.size() && i < SDC_REPORT_LIMIT; ++i) {
+        const SdcMismatch& mismatch = result.mismatches[i];
+        details << "  cpu" << mismatch.cpu << " " << sdc_kernel_name(mismatch.kernel) << " round " << mismatch.round
+                << (mismatch.golden ? " (golden)" : " (cross-core)") << ": expected 0x" << std::hex
+                << mismatch.expected << " got 0x" << mismatch.actual << std::dec << "\n";
+    }
+    if (!pinned.empty()) {
+        details << "Restored governors: " << (restored ? "yes" : "NO") << "\n";
+    }
+
+    auto end_time = std::chrono::steady_clock::now();
+    auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(end_time - start_time);
+
+    bool passed = result.mismatches.empty() && restored;
+    return create_report(passed ? TestResult::SUCCESS : TestResult::FAILURE, details.str(), duration);
+}
+
+TestReport CPUTester::litmus_test() {
+    auto start_time = begin_test();
+
+    if (!cpu_available_) {
+        return create_report(TestResult::NOT_SUPPORTED, "CPU information not available", std::chrono::milliseconds(0));
+    }
+
+    std::vector<int> cpus = measurement_cpus();
+    if (cpus.size() < 2) {
+        return create_report(TestResult::SKIPPED, "Litmus tests need at least two cores", std::chrono::milliseconds(0));
+    }
+
+    std::vector<std::vector<int>> pairs;
+    for (size_t a = 0; a < cpus.size(); ++a) {
+        for (size_t b = a + 1; b < cpus.size(); ++b) {
+            pairs.push_back({cpus[a], cpus[b]});
+        }
+    }
+    std::vector<int> quad;
+    for (size_t i = 0; i < 4; ++i) {
+        quad.push_back(cpus[i % cpus.size()]);
+    }
+
+    const LitmusTest tests[] = {LitmusTest::MESSAGE_PASSING, LitmusTest::STORE_BUFFERING,
+                                LitmusTest::LOAD_BUFFERING, LitmusTest::IRIW};
+    const LitmusOrdering orderings[] = {LitmusOrdering::RELAXED, LitmusOrdering::ACQUIRE_RELEASE,
+                                        LitmusOrdering::SEQ_CST};
+
+    std::stringstream details;
+    details << std::fixed << std::setprecision(2);
+    details << "Core pairs: " << pairs.size() << ", " << LITMUS_ITERATIONS << " iterations per placement\n";
+    bool all_passed = true;
+
+    for (LitmusTest test : tests) {
+        std::vector<std::vector<int>> placements = test == LitmusTest::IRIW ? std::vector<std::vector<int>>{quad}
+                                                                            : pairs;
+        for (LitmusOrdering ordering : orderings) {
+            std::vector<uint64_t> outcomes(litmus_outcome_count(test), 0);
+            uint64_t iterations = 0;
+            double rate = 0.0;
+            std::stringstream forbidden_on;
+
+            for (const auto& placement : placements) {
+                LitmusResult result = run_litmus_test(test, ordering, placement, LITMUS_ITERATIONS);
+                iterations += result.iterations;
+                rate += result.iterations_per_second;
+                for (size_t outcome = 0; outcome < outcomes.size(); ++outcome) {
+                    outcomes[outcome] += result.outcomes[outcome];
+                }
+                if (result.forbidden > 0) {
+                    forbidden_on << " [FORBIDDEN x" << result.forbidden << " on cpus";
+                    for (int cpu : result.cpus) {
+                        forbidden_on << " " << cpu;
+                    }
+                    forbidden_on << "]";
+                    all_passed = false;
+                }
+            }
+
+            details << litmus_test_name(test) << " " << litmus_ordering_name(ordering) << " ("
+                    << rate / placements.size() / 1e6 << " M/s):";
+            for (size_t outcome = 0; outcome < outcomes.size(); ++outcome) {
+                if (outcomes[outcome] > 0) {
+                    details << " {" << format_litmus_outcome(test, outcome) << "}=" << outcomes[outcome];
+                }
+            }
+            details << forbidden_on.str() << "\n";
+        }
+    }
+
+    auto end_time = std::chrono::steady_clock::now();
+    auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(end_time - start_time);
+
+    return create_report(all_passed ? TestResult::SUCCESS : TestResult::FAILURE, details.str(), duration);
+}
+
+TestReport CPUTester::crypto_test() {
+    auto start_time = begin_test();
+
+    if (!cpu_available_) {
+        return create_report(TestResult::NOT_SUPPORTED, "CPU information not available", std::chrono::milliseconds(0));
+    }
+
+    CryptoFeatures features = detect_crypto_features();
+    std::stringstream details;
+    details << std::fixed << std::setprecision(2);
+    details << "Extensions: aes=" << (features.aes ? "yes" : "no") << " pmull=" << (features.pmull ? "yes" : "no")
+            << " sha2=" << (features.sha2 ? "yes" : "no") << " crc32=" << (features.crc32 ? "yes" : "no") << "\n";
+
+    bool all_passed = true;
+#if defined(__aarch64__)
+    // Every ARMv8 core the product ships on has these; a gap means a
+    // misconfigured firmware or the wrong SoC
+    if (!features.aes || !features.pmull || !features.sha2 || !features.crc32) {
+        details << "[MISSING] crypto extensions not reported by the kernel\n";
+        all_passed = false;
+    }
+#endif
+
+    // Repeats short runs until the throughput converges; cycles per byte
+    // is the median of the counted runs, or estimated from the nominal
+    // clock when the cycle counter is unavailable
+    auto measure = [](CryptoAlgorithm algorithm, CryptoImpl impl, double& cycles_per_byte) {
+        std::vector<double> cpb_samples;
+        MeasurementSummary rate = measure_until_converged([&]() {
+            CryptoThroughput result = benchmark_crypto(algorithm, impl, CRYPTO_SAMPLE_TIME);
+            if (result.cycles_per_byte >= 0) {
+                cpb_samples.push_back(result.cycles_per_byte);
+            }
+            return result.bytes_per_second;
+        }, benchmark_criteria(CRYPTO_TIME_CAP));
+        cycles_per_byte = cpb_samples.empty() ? -1.0 : summarize_samples(cpb_samples).median;
+        return rate;
+    };
+    auto format_rate = [this](const MeasurementSummary& rate, double cpb) {
+        if (cpb < 0 && cpu_info_.frequency_mhz > 0 && rate.median > 0) {
+            cpb = cpu_info_.frequency_mhz * 1e6 / rate.median;
+        }
+        std::stringstream text;
+        text << std::fixed << std::setprecision(2);
+        if (cpb >= 0) {
+            text << cpb << " cpb, ";
+        }
+        text << format_measurement(rate, 1e-6, 2) << " MB/s";
+        return text.str();
+    };
+
+    std::vector<int> cpus = measurement_cpus();
+    ScopedAffinity affinity(cpus.empty() ? 0 : cpus.front());
+    const CryptoAlgorithm algorithms[] = {CryptoAlgorithm::AES_GCM, CryptoAlgorithm::SHA256, CryptoAlgorithm::CRC32C};
+    for (CryptoAlgorithm algorithm : algorithms) {
+        double portable_cpb = -1.0;
+        MeasurementSummary portable = measure(algorithm, CryptoImpl::PORTABLE, portable_cpb);
+        details << crypto_algorithm_name(algorithm) << ": portable " << format_rate(portable, portable_cpb);
+
+        if (!crypto_accelerated(algorithm, features)) {
+            details << ", accelerated n/a\n";
+            continue;
+        }
+
+        double accelerated_cpb = -1.0;
+        MeasurementSummary accelerated = measure(algorithm, CryptoImpl::ACCELERATED, accelerated_cpb);
+        double speedup = portable.median > 0 ? accelerated.median / portable.median : 0.0;
+        details << ", accelerated " << format_rate(accelerated, accelerated_cpb) << ", " << speedup << "x";
+
+        if (!crypto_implementations_agree(algorithm)) {
+            details << " [MISMATCH]";
+            all_passed = false;
+        }
+        if (speedup < CRYPTO_MIN_SPEEDUP) {
+            details << " [SLOW]";
+            all_passed = false;
+        }
+        details << "\n";
+    }
+
+    auto end_time = std::chrono::steady_clock::now();
+    auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(end_time - start_time);
+
+    return create_report(all_passed ? TestResult::SUCCESS : TestResult::FAILURE, details.str(), duration);
+}
+
+TestReport CPUTester::gemm_test() {
+    auto start_time = begin_test();
+
+    if (!cpu_available_) {
+        return create_report(TestResult::NOT_SUPPORTED, "CPU information not available", std::chrono::milliseconds(0));
+    }
+
+    std::vector<int> cpus = measurement_cpus();
+    if (cpus.empty()) {
+        return create_report(TestResult::NOT_SUPPORTED, "No CPUs available for placement", std::chrono::milliseconds(0));
+    }
+
+    std::vector<std::vector<int>> placements = {{cpus.front()}};
+    if (cpus.size() > 1) {
+        placements.push_back(cpus);
+    }
+
+    std::stringstream details;
+    details << std::fixed << std::setprecision(2);
+    details << "Matrix: " << GEMM_SIZE << "x" << GEMM_SIZE << "\n";
+    bool all_passed = true;
+
+    const GemmPrecision precisions[] = {GemmPrecision::SINGLE, GemmPrecision::DOUBLE};
+    for (GemmPrecision precision : precisions) {
+        for (const auto& placement : placements) {
+            GemmResult result;
+            bool verified = true;
+            MeasurementSummary gflops = measure_until_converged([&]() {
+                result = run_gemm_benchmark(precision, GEMM_SIZE, placement, GEMM_SAMPLE_TIME);
+                verified = verified && result.verified;
+                return result.gflops;
+            }, benchmark_criteria(GEMM_TIME_CAP));
+            result.gflops = gflops.median;
+            result.verified = verified;
+
+            double mhz = cpu_info_.frequency_mhz > 0 ? cpu_info_.frequency_mhz : result.effective_mhz;
+            double peak = result.threads * mhz * gemm_peak_flops_per_cycle(precision) / 1000.0;
+
+            details << (precision == GemmPrecision::SINGLE ? "SGEMM" : "DGEMM") << " " << result.threads
+                    << " thread(s): " << format_measurement(gflops) << " GFLOP/s";
+            if (peak > 0) {
+                details << " of " << peak << " peak (" << std::setprecision(1) << 100.0 * result.gflops / peak
+                        << "%)" << std::setprecision(2);
+            } else {
+                details << " (peak unknown)";
+            }
+            if (result.effective_mhz > 0) {
+                details << " @ " << std::setprecision(0) << result.effective_mhz << " MHz" << std::setprecision(2);
+            }
+            if (!result.verified) {
+                details << " [WRONG RESULT]";
+                all_passed = false;
+            }
+            details << "\n";
+        }
+    }
+
+    auto end_time = std::chrono::steady_clock::now();
+    auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(end_time - start_time);
+
+    return create_report(all_passed ? TestResult::SUCCESS : TestResult::FAILURE, details.str(), duration);
+}
+
+TestReport CPUTester::clock_test() {
+    auto start_time = begin_test();
+
+    if (!cpu_available_) {
+        return create_report(TestResult::NOT_SUPPORTED, "CPU information not available", std::chrono::milliseconds(0));
+    }
+
+    std::vector<int> cpus = measurement_cpus();
+    if (cpus.empty()) {
+        return create_report(TestResult::NOT_SUPPORTED, "No CPUs available for placement", std::chrono::milliseconds(0));
+    }
+
+    const FastClock& fast = FastClock::instance();
+    uint64_t fast_start = fast.now_ns();
+    uint64_t monotonic_start = monotonic_ns();
+
+    std::stringstream details;
+    details << std::fixed << std::setprecision(1);
+    details << "Fast counter: " << fast.counter_name();
+    if (fast.is_hardware()) {
+        details << " @ " << std::setprecision(3) << fast.frequency_hz() / 1e6 << " MHz" << std::setprecision(1);
+    }
+    details << "\n";
+    bool all_passed = true;
+
+    for (int index = 0; index < CLOCK_SOURCE_COUNT; ++index) {
+        ClockSource source = static_cast<ClockSource>(index);
+        bool may_step = source == ClockSource::SYSTEM_CLOCK;
+        details << clock_source_name(source) << ":\n";
+
+        for (int cpu : cpus) {
+            ClockCharacteristics clock = characterize_clock(source, cpu, CLOCK_READS);
+            details << "  cpu" << cpu << ": " << clock.cost_ns << " ns/read, step " << clock.resolution_ns
+                    << " ns (nominal " << clock.nominal_resolution_ns << " ns)";
+            if (clock.backward_steps > 0) {
+                details << ", " << clock.backward_steps << " backward";
+                details << (may_step ? " [STEPPED]" : " [NOT MONOTONIC]");
+                all_passed = all_passed && may_step;
+            }
+            details << "\n";
+        }
+
+        for (size_t i = 1; i < cpus.size(); ++i) {
+            uint64_t inversions = cross_core_clock_inversions(source, cpus.front(), cpus[i], CLOCK_HANDOFFS);
+            details << "  cpu" << cpus.front() << "<->cpu" << cpus[i] << ": " << inversions << " of "
+                    << 2 * CLOCK_HANDOFFS << " handoffs inverted";
+            if (inversions > 0) {
+                details << (may_step ? " [STEPPED]" : " [SKEWED]");
+                all_passed = all_passed && may_step;
+            }
+            details << "\n";
+        }
+    }
+
+    double fast_elapsed = static_cast<double>(fast.now_ns() - fast_start);
+    double monotonic_elapsed = static_cast<double>(monotonic_ns() - monotonic_start);
+    if (fast.is_hardware() && monotonic_elapsed > 0) {
+        double drift_ppm = (fast_elapsed - monotonic_elapsed) / monotonic_elapsed * 1e6;
+        details << "Fast counter drift vs CLOCK_MONOTONIC: " << drift_ppm << " ppm over " << monotonic_elapsed / 1e6
+                << " ms";
+        if (std::fabs(drift_ppm) > CLOCK_MAX_DRIFT_PPM) {
+            details << " [DRIFT]";
+            all_passed = false;
+        }
+        details << "\n";
+    }
+
+    auto end_time = std::chrono::steady_clock::now();
+    auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(end_time - start_time);
+
+    return create_report(all_passed ? TestResult::SUCCESS : TestResult::FAILURE, details.str(), duration);
+}
+
+TestReport CPUTester::thread_cost_test() {
+    auto start_time = begin_test();
+
+    if (!cpu_available_) {
+        return create_report(TestResult::NOT_SUPPORTED, "CPU information not available", std::chrono::milliseconds(0));
+    }
+
+    std::vector<int> cpus = measurement_cpus();
+    if (cpus.empty()) {
+        return create_report(TestResult::NOT_SUPPORTED, "No CPUs available for placement", std::chrono::milliseconds(0));
+    }
+
+    // Handoffs need two threads; on a single core they share it
+    std::vector<int> thread_counts;
+    for (int count = 2; count < static_cast<int>(cpus.size()); count *= 2) {
+        thread_counts.push_back(count);
+    }
+    thread_counts.push_back(std::max<int>(2, static_cast<int>(cpus.size())));
+
+    const ThreadOperation operations[] = {
+        ThreadOperation::CREATE_JOIN, ThreadOperation::CONDVAR_HANDOFF, ThreadOperation::FUTEX,
+        ThreadOperation::BARRIER,     ThreadOperation::EVENTFD,
+    };
+
+    std::stringstream details;
+    details << std::fixed << std::setprecision(0);
+    if (cpus.size() < 2) {
+        details << "Single measurement core: threads share CPU " << cpus[0] << "\n";
+    }
+    details << "Operation | Threads | Median ns | p99 ns | Max ns\n";
+    bool all_passed = true;
+    double spawn_ns = 0.0;
+    double futex_ns = 0.0;
+
+    for (ThreadOperation operation : operations) {
+        for (int threads : thread_counts) {
+            ThreadCostResult result = run_thread_benchmark(operation, cpus, threads, THREAD_COST_ROUNDS);
+            details << thread_operation_name(operation) << " | " << result.threads << " | " << result.median_ns
+                    << " | " << result.p99_ns << " | " << result.max_ns;
+            if (!result.completed) {
+                details << " [INCOMPLETE]";
+                all_passed = false;
+            }
+            details << "\n";
+
+            if (threads == thread_counts.back()) {
+                if (operation == ThreadOperation::CREATE_JOIN) spawn_ns = result.median_ns;
+                if (operation == ThreadOperation::FUTEX) futex_ns = result.median_ns;
+            }
+        }
+    }
+
+    if (futex_ns > 0) {
+        details << "Spawning a thread costs " << std::setprecision(1) << spawn_ns / futex_ns
+                << " futex handoffs at " << thread_counts.back() << " threads\n";
+    }
+
+    auto end_time = std::chrono::steady_clock::now();
+    auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(end_time - start_time);
+
+    return create_report(all_passed ? TestResult::SUCCESS : TestResult::FAILURE, details.str(), duration);
+}
+
+TestReport CPUTester::tlb_test() {
+    auto start_time = begin_test();
+
+    if (!cpu_available_) {
+        return create_report(TestResult::NOT_SUPPORTED, "CPU information not available", std::chrono::milliseconds(0));
+    }
+
+    std::vector<int> cpus = measurement_cpus();
+    if (cpus.empty()) {
+        return create_report(TestResult::NOT_SUPPORTED, "No CPUs available for placement", std::chrono::milliseconds(0));
+    }
+    ScopedAffinity affinity(cpus[0]);
+
+    std::stringstream details;
+    details << std::fixed << std::setprecision(2);
+    details << "Base page " << base_page_size() / 1024 << " KiB, huge page " << huge_page_size() / 1024
+            << " KiB, CPU " << cpus[0] << "\n";
+    details << "Backing | Working set | ns/access | DTLB misses/access | Huge coverage\n";
+
+    const PageBacking backings[] = {PageBacking::BASE_PAGES, PageBacking::TRANSPARENT_HUGE, PageBacking::HUGETLB};
+    const size_t largest_set = TLB_WORKING_SETS[std::size(TLB_WORKING_SETS) - 1];
+    MeasurementSummary largest[3];
+    for (size_t working_set : TLB_WORKING_SETS) {
+        for (PageBacking backing : backings) {
+            TlbResult result =
+                run_tlb_benchmark(backing, working_set, TLB_ACCESSES, benchmark_criteria(TLB_TIME_CAP));
+            details << page_backing_name(backing) << " | " << (working_set >> 20) << " MiB | ";
+            if (!result.available) {
+                details << "n/a (" << result.note << ")\n";
+                continue;
+            }
+            details << format_measurement(result.latency) << " | ";
+            if (result.misses_per_access >= 0) {
+                details << std::setprecision(3) << result.misses_per_access << std::setprecision(2);
+            } else {
+                details << "n/a";
+            }
+            details << " | " << std::setprecision(0) << result.huge_fraction * 100.0 << "%" << std::setprecision(2)
+                    << "\n";
+            if (working_set == largest_set) {
+                largest[static_cast<int>(backing)] = result.latency;
+            }
+        }
+    }
+
+    for (int index = 1; index < 3; ++index) {
+        if (largest[0].median > 0 && largest[index].median > 0) {
+            // Relative CIs of a ratio add in quadrature
+            double ci = std::sqrt(largest[0].relative_ci * largest[0].relative_ci +
+                                  largest[index].relative_ci * largest[index].relative_ci);
+            details << page_backing_name(backings[index]) << " speedup over base pages at " << (largest_set >> 20)
+                    << " MiB: " << largest[0].median / largest[index].median << "x (±" << std::setprecision(1)
+                    << ci * 100.0 << "%)" << std::setprecision(2) << "\n";
+        }
+    }
+
+    auto end_time = std::chrono::steady_clock::now();
+    auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(end_time - start_time);
+
+    return create_report(TestResult::SUCCESS, details.str(), duration);
+}
+
+TestReport CPUTester::mapping_test() {
+    auto start_time = begin_test();
+
+    if (!cpu_available_) {
+        return create_report(TestResult::NOT_SUPPORTED, "CPU information not available", std::chrono::milliseconds(0));
+    }
+
+    std::vector<int> cpus = measurement_cpus();
+    if (cpus.empty()) {
+        return create_report(TestResult::NOT_SUPPORTED, "No CPUs available for placement", std::chrono::milliseconds(0));
+    }
+
+    std::stringstream details;
+    details << std::fixed << std::setprecision(0);
+    details << "Region " << (MAPPING_REGION_BYTES >> 20) << " MiB\n";
+    details << "Operation | Threads | ns/op | ops/s (median) | Faults/op\n";
+    bool all_passed = true;
+
+    // Every run maps a fresh region, so each harness sample is a whole run.
+    // The first sample doubles as the availability check; once a run
+    // reports the operation unavailable, the remaining samples are skipped.
+    auto measure = [&details, &all_passed](MappingOperation operation, const std::vector<int>& placement) {
+        MappingCostResult result;
+        bool available = true;
+        std::vector<double> rates;
+        MeasurementSummary latency = measure_until_converged([&]() {
+            if (!available) {
+                return 0.0;
+            }
+            result = run_mapping_benchmark(operation, placement, MAPPING_REGION_BYTES);
+            available = result.available;
+            rates.push_back(result.ops_per_second);
+            return result.ns_per_op;
+        }, benchmark_criteria(MAPPING_TIME_CAP));
+
+        details << mapping_operation_name(result.operation);
+        if (result.chunk_bytes > 0) {
+            details << " (" << result.chunk_bytes / 1024 << " KiB)";
+        }
+        details << " | " << result.threads << " | ";
+        if (!available) {
+            details << "n/a (" << result.note << ")\n";
+            // Only the file-backed case depends on the environment
+            if (result.operation != MappingOperation::MAJOR_FAULT) {
+                all_passed = false;
+            }
+            return 0.0;
+        }
+
+        // The harness keeps the last samples it took
+        rates.erase(rates.begin(), rates.end() - std::min(rates.size(), latency.iterations));
+        double rate = summarize_samples(rates).median;
+
+        details << format_measurement(latency, 1.0, 0) << " | " << rate << " | ";
+        if (result.faults_per_op >= 0) {
+            details << std::setprecision(2) << result.faults_per_op << std::setprecision(0);
+        } else {
+            details << "-";
+        }
+        if (!result.note.empty()) {
+            details << " (" << result.note << ")";
+        }
+        details << "\n";
+        return rate;
+    };
+
+    {
+        ScopedAffinity affinity(cpus[0]);
+        const MappingOperation operations[] = {
+            MappingOperation::MINOR_FAULT, MappingOperation::MAJOR_FAULT, MappingOperation::MMAP_MUNMAP,
+            MappingOperation::MADVISE_DONTNEED, MappingOperation::MPROTECT,
+        };
+        for (MappingOperation operation : operations) {
+            measure(operation, {cpus[0]});
+        }
+    }
+
+    std::vector<size_t> thread_counts;
+    for (size_t count = 1; count < cpus.size(); count *= 2) {
+        thread_counts.push_back(count);
+    }
+    thread_counts.push_back(cpus.size());
+
+    double single_ms = 0.0;
+    double parallel_ms = 0.0;
+    for (size_t threads : thread_counts) {
+        std::vector<int> placement(cpus.begin(), cpus.begin() + threads);
+        double rate = measure(MappingOperation::FIRST_TOUCH, placement);
+        if (rate > 0) {
+            double ms = MAPPING_REGION_BYTES / static_cast<double>(base_page_size()) / rate * 1000.0;
+            if (threads == 1) single_ms = ms;
+            if (threads == cpus.size()) parallel_ms = ms;
+        }
+    }
+
+    if (cpus.size() > 1 && single_ms > 0 && parallel_ms > 0) {
+        details << "Faulting in " << (MAPPING_REGION_BYTES >> 20) << " MiB: " << std::setprecision(1) << single_ms
+                << " ms on 1 thread, " << parallel_ms << " ms on " << cpus.size() << " thread(s)\n";
+    }
+
+    auto end_time = std::chrono::steady_clock::now();
+    auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(end_time - start_time);
+
+    return create_report(all_passed ? TestResult::SUCCESS : TestResult::FAILURE, details.str(), duration);
+}
+
+TestReport CPUTester::frontend_test() {
+    auto start_time = begin_test();
+
+    if (!cpu_available_) {
+        return create_report(TestResult::NOT_SUPPORTED, "CPU information not available", std::chrono::milliseconds(0));
+    }
+
+    std::vector<int> cpus = measurement_cpus();
+    if (cpus.empty()) {
+        return create_report(TestResult::NOT_SUPPORTED, "No CPUs available for placement", std::chrono::milliseconds(0));
+    }
+
+    std::stringstream details;
+    details << std::fixed << std::setprecision(2);
+    details << "Kernel | ns/iter | Cycles/iter | Branch misses/iter | FE stall cycles/iter | L1I misses/iter\n";
+
+    // Counters are the median over the runs the harness kept
+    std::vector<FrontendResult> runs;
+    auto counter = [&details, &runs](double FrontendResult::*field) {
+        std::vector<double> values;
+        for (const FrontendResult& run : runs) {
+            values.push_back(run.*field);
+        }
+        double value = summarize_samples(values).median;
+        if (value >= 0) {
+            details << value;
+        } else {
+            details << "n/a";
+        }
+    };
+
+    bool estimated = false;
+    {
+        ScopedAffinity affinity(cpus[0]);
+        for (int index = 0; index < FRONTEND_KERNEL_COUNT; ++index) {
+            FrontendKernel kernel = static_cast<FrontendKernel>(index);
+            FrontendResult result;
+            runs.clear();
+            MeasurementSummary time = measure_until_converged([&]() {
+                result = run_frontend_benchmark(kernel, FRONTEND_ITERATIONS);
+                runs.push_back(result);
+                return result.ns_per_iteration;
+            }, benchmark_criteria(FRONTEND_TIME_CAP));
+            runs.erase(runs.begin(), runs.end() - std::min(runs.size(), time.iterations));
+
+            details << frontend_kernel_name(kernel);
+            if (result.code_bytes > 0) {
+                details << " (" << result.code_bytes / 1024 << " KiB)";
+            }
+            details << " | " << format_measurement(time) << " | ";
+            if (result.cycles_per_iteration >= 0) {
+                counter(&FrontendResult::cycles_per_iteration);
+            } else if (cpu_info_.frequency_mhz > 0) {
+                // No cycle counter: scale the wall time by the nominal clock
+                details << "~" << time.median * cpu_info_.frequency_mhz / 1000.0;
+                estimated = true;
+            } else {
+                details << "n/a";
+            }
+            details << " | ";
+            counter(&FrontendResult::branch_misses);
+            details << " | ";
+            counter(&FrontendResult::frontend_stalls);
+            details << " | ";
+            counter(&FrontendResult::icache_misses);
+            details << "\n";
+        }
+    }
+    if (estimated) {
+        details << "~ cycles estimated from the " << std::setprecision(0) << cpu_info_.frequency_mhz
+                << " MHz reported clock\n";
+    }
+
+    auto end_time = std::chrono::steady_clock::now();
+    auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(end_time - start_time);
+
+    return create_report(TestResult::SUCCESS, details.str(), duration);
+}
+
+TestReport CPUTester::handoff_test() {
+    auto start_time = begin_test();
+
+    if (!cpu_available_) {
+        return create_report(TestResult::NOT_SUPPORTED, "CPU information not available", std::chrono::milliseconds(0));
+    }
+
+    std::vector<int> cpus = measurement_cpus();
+    if (cpus.empty()) {
+        return create_report(TestResult::NOT_SUPPORTED, "No CPUs available for placement", std::chrono::milliseconds(0));
+    }
+    std::vector<int> placement(cpus.begin(), cpus.begin() + std::min<size_t>(2, cpus.size()));
+
+    const HandoffQueue queues[] = {
+        HandoffQueue::MUTEX_QUEUE,
+        HandoffQueue::MUTEX_BATCH,
+        HandoffQueue::SPSC_SINGLE,
+        HandoffQueue::SPSC_BATCH,
+    };
+
+    std::stringstream details;
+    details << std::fixed << std::setprecision(2);
+    if (placement.size() < 2) {
+        details << "Single measurement core: producer and consumer share CPU " << placement[0] << "\n";
+    } else {
+        details << "Producer on CPU " << placement[0] << ", consumer on CPU " << placement[1] << "\n";
+    }
+    details << "Queue | Mitems/s | Full-queue retries/run | In order\n";
+    bool all_passed = true;
+    MeasurementSummary rates[std::size(queues)];
+
+    for (HandoffQueue queue : queues) {
+        HandoffResult result;
+        bool in_order = true;
+        MeasurementSummary rate = measure_until_converged([&]() {
+            result = run_handoff_benchmark(queue, placement, HANDOFF_ITEMS, SeriesRecorder::DEFAULT_QUEUE_CAPACITY);
+            in_order = in_order && result.in_order;
+            return result.items_per_second;
+        }, benchmark_criteria(HANDOFF_TIME_CAP));
+        details << handoff_queue_name(queue) << " | " << format_measurement(rate, 1e-6) << " | "
+                << result.full_rejections << " | " << (in_order ? "yes" : "NO") << "\n";
+        all_passed = all_passed && in_order;
+        rates[static_cast<int>(queue)] = rate;
+    }
+
+    // Same batch size on both sides, so the ratio isolates locking
+    auto compare = [&details, &rates](const char* label, HandoffQueue ring, HandoffQueue mutex) {
+        const MeasurementSummary& a = rates[static_cast<int>(ring)];
+        const MeasurementSummary& b = rates[static_cast<int>(mutex)];
+        if (b.median > 0) {
+            double ci = std::sqrt(a.relative_ci * a.relative_ci + b.relative_ci * b.relative_ci);
+            details << "SPSC ring vs mutex queue, " << label << ": " << a.median / b.median << "x (±"
+                    << std::setprecision(1) << ci * 100.0 << "%)" << std::setprecision(2) << "\n";
+        }
+    };
+    compare("single items", HandoffQueue::SPSC_SINGLE, HandoffQueue::MUTEX_QUEUE);
+    compare("batched", HandoffQueue::SPSC_BATCH, HandoffQueue::MUTEX_BATCH);
+
+    auto end_time = std::chrono::steady_clock::now();
+    auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(end_time - start_time);
+
+    return create_report(all_passed ? TestResult::SUCCESS : TestResult::FAILURE, details.str(), duration);
+}
+
+DvfsTransition CPUTester::measure_dvfs_transition(const CpufreqPolicy& policy) {
+    using clock = std::chrono::steady_clock;
+
+    DvfsTransition transition;
+    transition.time_to_max_ms = -1.0;
+    transition.time_to_idle_ms = -1.0;
+
+    std::this_thread::sleep_for(DVFS_IDLE_TIME);
+    transition.idle_mhz = policy.current_khz() / 1000.0;
+
+    // Ramp-up: spin in short windows and derive the clock from each window
+    PerfCounter cycles(PerfEvent::CPU_CYCLES);
+    transition.cycle_counter = cycles.is_available();
+
+    std::vector<std::pair<double, double>> samples; // (ms since load start, MHz)
+    samples.reserve(DVFS_LOAD_TIME / DVFS_SAMPLE_WINDOW);
+
+    // Windows are timed with the fast counter so the clock reads inside
+    // the spin loop do not dilute the cycle count
+    const FastClock& fast = FastClock::instance();
+    const uint64_t window_ticks = fast.ns_to_ticks(std::chrono::duration<double, std::nano>(DVFS_SAMPLE_WINDOW).count());
+    const uint64_t load_ticks = fast.ns_to_ticks(std::chrono::duration<double, std::nano>(DVFS_LOAD_TIME).count());
+
+    volatile uint64_t sink = 0;
+    cycles.start();
+    uint64_t last_cycles = 0;
+    uint64_t load_start = fast.ticks();
+    uint64_t window_start = load_start;
+
+    while (window_start - load_start < load_ticks) {
+        uint64_t now = window_start;
+        while (now - window_start < window_ticks) {
+            sink = sweep_kernel(256);
+            now = fast.ticks();
+        }
+
+        double window_us = fast.ticks_to_ns(now - window_start) / 1000.0;
+        double mhz = 0.0;
+        if (transition.cycle_counter) {
+            uint64_t current_cycles = cycles.read();
+            mhz = (current_cycles - last_cycles) / window_us;
+            last_cycles = current_cycles;
+        } else {
+            mhz = policy.current_khz() / 1000.0;
+        }
+        samples.emplace_back(fast.ticks_to_ns(now - load_start) / 1e6, mhz);
+        window_start = now;
+    }
+    cycles.stop();
+    (void)sink;
+
+    if (samples.empty()) {
+        return transition;
+    }
+
+    // Plateau is the median of the last quarter of the load phase
+    std::vector<double> tail;
+    for (size_t i = samples.size() * 3 / 4; i < samples.size(); ++i) {
+        tail.push_back(samples[i].second);
+    }
+    std::nth_element(tail.begin(), tail.begin() + tail.size() / 2, tail.end());
+    transition.peak_mhz = tail[tail.size() / 2];
+
+    for (const auto& sample : samples) {
+        if (sample.second >= transition.peak_mhz * DVFS_SETTLED_FRACTION) {
+            transition.time_to_max_ms = sample.first;
+            break;
+        }
+    }
+
+    // Ramp-down: the core is idle now, so the policy's view is the only
+    // non-intrusive source; poll until it is back near the idle clock
+    double idle_threshold_mhz = transition.idle_mhz / DVFS_SETTLED_FRACTION;
+    auto release = clock::now();
+    while (clock::now() - release < DVFS_IDLE_TIMEOUT) {
+        if (policy.current_khz() / 1000.0 <= idle_threshold_mhz) {
+            transition.time_to_idle_ms = std::chrono::duration<double, std::milli>(clock::now() - release).count();
+            break;
+        }
+        std::this_thread::sleep_for(DVFS_IDLE_POLL);
+    }
+
+    return transition;
+}
+
+WakeupLatency CPUTester::measure_wakeup_latency(LatencyHistogram& histogram) {
+    // The wake side is timed with the fast counter, anchored to
+    // CLOCK_MONOTONIC just before each sleep so slew cannot accumulate
+    const FastClock& fast = FastClock::instance();
+
+    timespec deadline;
+    clock_gettime(CLOCK_MONOTONIC, &deadline);
+
+    for (int i = 0; i < WAKEUP_SAMPLES; ++i) {
+        deadline.tv_nsec += WAKEUP_INTERVAL_NS;
+        while (deadline.tv_nsec >= 1000000000L) {
+            deadline.tv_nsec -= 1000000000L;
+            deadline.tv_sec += 1;
+        }
+
+        uint64_t armed_ticks = fast.ticks();
+        uint64_t armed_ns = monotonic_ns();
+        if (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &deadline, nullptr) != 0) {
+            continue;
+        }
+        uint64_t woke_ticks = fast.ticks();
+
+        double deadline_ns = deadline.tv_sec * 1e9 + deadline.tv_nsec;
+        double late_ns = fast.ticks_to_ns(woke_ticks - armed_ticks) - (deadline_ns - static_cast<double>(armed_ns));
+        // Counter and clock disagree by a few ns at most; an early wakeup is not late
+        histogram.record(late_ns > 0 ? static_cast<uint64_t>(late_ns) : 0);
+    }
+
+    WakeupLatency latency = {0.0, 0.0, 0.0};
+    if (histogram.count() == 0) {
+        return latency;
+    }
+
+    latency.median_us = histogram.percentile(50.0) / 1000.0;
+    latency.p99_us = histogram.percentile(99.0) / 1000.0;
+    latency.max_us = histogram.max() / 1000.0;
+    return latency;
+}
+
 double CPUTester::get_cpu_temperature() {
     // Try different temperature sensor locations
     std::vector<std::string> temp_files = {
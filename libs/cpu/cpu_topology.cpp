@@ -0,0 +1,283 @@
+/**
+ * @file cpu_topology.cpp
+ * @brief Implementation of CPU topology and cache hierarchy discovery.
+ * @author Sandesh Ghimire | sandesh@soccentric
+ * @copyright (C) Soccentric LLC. All rights reserved.
+ */
+
+#include "cpu_topology.h"
+#include <algorithm>
+#include <cctype>
+#include <filesystem>
+#include <fstream>
+#include <set>
+#include <sstream>
+#include <utility>
+
+namespace fs = std::filesystem;
+
+namespace cm5_peripheral_test {
+
+namespace {
+
+constexpr int MAX_MASK_CPUS = 64;
+
+std::string read_line(const fs::path& path) {
+    std::ifstream file(path);
+    std::string value;
+    if (file.is_open()) {
+        std::getline(file, value);
+    }
+    return value;
+}
+
+long read_long(const fs::path& path, long fallback) {
+    try {
+        return std::stol(read_line(path));
+    } catch (...) {
+        return fallback;
+    }
+}
+
+uint64_t to_mask(const std::vector<int>& cpus) {
+    uint64_t mask = 0;
+    for (int cpu : cpus) {
+        if (cpu >= 0 && cpu < MAX_MASK_CPUS) {
+            mask |= uint64_t{1} << cpu;
+        }
+    }
+    return mask;
+}
+
+int lowest_cpu(uint64_t mask) {
+    for (int cpu = 0; cpu < MAX_MASK_CPUS; ++cpu) {
+        if (mask & (uint64_t{1} << cpu)) {
+            return cpu;
+        }
+    }
+    return -1;
+}
+
+/**
+ * @brief Parses sizes such as "48K", "2048K" or "8M".
+ */
+uint64_t parse_size(const std::string& text) {
+    if (text.empty()) {
+        return 0;
+    }
+
+    uint64_t value = 0;
+    size_t pos = 0;
+    try {
+        value = std::stoull(text, &pos);
+    } catch (...) {
+        return 0;
+    }
+
+    char unit = pos < text.size() ? static_cast<char>(std::toupper(text[pos])) : '\0';
+    switch (unit) {
+    case 'K': return value * 1024;
+    case 'M': return value * 1024 * 1024;
+    case 'G': return value * 1024 * 1024 * 1024;
+    default: return value;
+    }
+}
+
+CacheType parse_cache_type(const std::string& text) {
+    if (text == "Data") return CacheType::DATA;
+    if (text == "Instruction") return CacheType::INSTRUCTION;
+    return CacheType::UNIFIED;
+}
+
+const char* cache_type_suffix(CacheType type) {
+    switch (type) {
+    case CacheType::DATA: return "d";
+    case CacheType::INSTRUCTION: return "i";
+    case CacheType::UNIFIED: return "";
+    }
+    return "";
+}
+
+} // namespace
+
+std::vector<int> parse_cpu_list(const std::string& list) {
+    std::set<int> cpus;
+    std::stringstream stream(list);
+    std::string range;
+
+    while (std::getline(stream, range, ',')) {
+        range.erase(std::remove_if(range.begin(), range.end(), ::isspace), range.end());
+        if (range.empty()) {
+            continue;
+        }
+
+        try {
+            size_t dash = range.find('-');
+            int first = std::stoi(range.substr(0, dash));
+            int last = dash == std::string::npos ? first : std::stoi(range.substr(dash + 1));
+            for (int cpu = first; cpu <= last; ++cpu) {
+                cpus.insert(cpu);
+            }
+        } catch (...) {
+            return {};
+        }
+    }
+    return std::vector<int>(cpus.begin(), cpus.end());
+}
+
+CpuTopology::CpuTopology(const std::string& sysfs_root) {
+    fs::path root(sysfs_root);
+
+    std::vector<int> possible = parse_cpu_list(read_line(root / "possible"));
+    if (possible.empty()) {
+        std::error_code ec;
+        for (const auto& entry : fs::directory_iterator(root, ec)) {
+            std::string name = entry.path().filename().string();
+            if (name.size() > 3 && name.compare(0, 3, "cpu") == 0 &&
+                std::all_of(name.begin() + 3, name.end(), ::isdigit)) {
+                possible.push_back(std::stoi(name.substr(3)));
+            }
+        }
+        std::sort(possible.begin(), possible.end());
+    }
+
+    std::string online_list = read_line(root / "online");
+    uint64_t online_mask = online_list.empty() ? to_mask(possible) : to_mask(parse_cpu_list(online_list));
+
+    std::set<std::pair<int, uint64_t>> seen_caches; // (level * 4 + type, shared mask)
+
+    for (int cpu : possible) {
+        if (cpu >= MAX_MASK_CPUS) {
+            break;
+        }
+
+        fs::path cpu_dir = root / ("cpu" + std::to_string(cpu));
+        fs::path topology = cpu_dir / "topology";
+
+        CoreDescriptor core;
+        core.cpu = static_cast<int16_t>(cpu);
+        core.package_id = static_cast<int16_t>(read_long(topology / "physical_package_id", -1));
+        core.cluster_id = static_cast<int16_t>(read_long(topology / "cluster_id", -1));
+        core.core_id = static_cast<int16_t>(read_long(topology / "core_id", -1));
+        core.capacity = static_cast<int16_t>(read_long(cpu_dir / "cpu_capacity", -1));
+        core.online = (online_mask & (uint64_t{1} << cpu)) != 0;
+        core.smt_siblings = to_mask(parse_cpu_list(read_line(topology / "thread_siblings_list")));
+        if (core.smt_siblings == 0) {
+            core.smt_siblings = uint64_t{1} << cpu;
+        }
+        cores_.push_back(core);
+
+        for (int index = 0; fs::exists(cpu_dir / "cache" / ("index" + std::to_string(index))); ++index) {
+            fs::path cache_dir = cpu_dir / "cache" / ("index" + std::to_string(index));
+
+            CacheDescriptor cache;
+            cache.level = static_cast<uint8_t>(read_long(cache_dir / "level", 0));
+            cache.type = parse_cache_type(read_line(cache_dir / "type"));
+            cache.line_size = static_cast<uint16_t>(read_long(cache_dir / "coherency_line_size", 0));
+            cache.ways = static_cast<uint16_t>(read_long(cache_dir / "ways_of_associativity", 0));
+            cache.sets = static_cast<uint32_t>(read_long(cache_dir / "number_of_sets", 0));
+            cache.size_bytes = parse_size(read_line(cache_dir / "size"));
+            cache.shared_cpus = to_mask(parse_cpu_list(read_line(cache_dir / "shared_cpu_list")));
+            if (cache.shared_cpus == 0) {
+                cache.shared_cpus = uint64_t{1} << cpu;
+            }
+
+            int key = cache.level * 4 + static_cast<int>(cache.type);
+            if (seen_caches.insert({key, cache.shared_cpus}).second) {
+                caches_.push_back(cache);
+            }
+        }
+    }
+
+    std::stable_sort(caches_.begin(), caches_.end(), [](const CacheDescriptor& a, const CacheDescriptor& b) {
+        if (a.level != b.level) return a.level < b.level;
+        return lowest_cpu(a.shared_cpus) < lowest_cpu(b.shared_cpus);
+    });
+}
+
+int CpuTopology::package_count() const {
+    std::set<int> packages;
+    for (const auto& core : cores_) {
+        if (core.online) packages.insert(core.package_id);
+    }
+    return static_cast<int>(packages.size());
+}
+
+int CpuTopology::cluster_count() const {
+    std::set<std::pair<int, int>> clusters;
+    for (const auto& core : cores_) {
+        if (core.online) clusters.insert({core.package_id, core.cluster_id});
+    }
+    return static_cast<int>(clusters.size());
+}
+
+int CpuTopology::physical_core_count() const {
+    return static_cast<int>(one_cpu_per_core().size());
+}
+
+int CpuTopology::online_count() const {
+    return static_cast<int>(std::count_if(cores_.begin(), cores_.end(),
+                                          [](const CoreDescriptor& core) { return core.online; }));
+}
+
+std::vector<int> CpuTopology::one_cpu_per_core() const {
+    uint64_t online_mask = 0;
+    for (const auto& core : cores_) {
+        if (core.online) online_mask |= uint64_t{1} << core.cpu;
+    }
+
+    std::vector<int> cpus;
+    for (const auto& core : cores_) {
+        if (core.online && lowest_cpu(core.smt_siblings & online_mask) == core.cpu) {
+            cpus.push_back(core.cpu);
+        }
+    }
+    return cpus;
+}
+
+const CacheDescriptor* CpuTopology::data_cache(int level, int cpu) const {
+    if (cpu < 0 || cpu >= MAX_MASK_CPUS) {
+        return nullptr;
+    }
+
+    for (const auto& cache : caches_) {
+        if (cache.level == level && cache.type != CacheType::INSTRUCTION &&
+            (cache.shared_cpus & (uint64_t{1} << cpu))) {
+            return &cache;
+        }
+    }
+    return nullptr;
+}
+
+int CpuTopology::line_size() const {
+    const CacheDescriptor* l1 = data_cache(1);
+    return (l1 && l1->line_size > 0) ? l1->line_size : 64;
+}
+
+std::string CpuTopology::describe() const {
+    std::stringstream out;
+    out << "Topology: " << package_count() << " package(s), " << cluster_count() << " cluster(s), "
+        << physical_core_count() << " core(s), " << online_count() << "/" << cores_.size() << " CPU(s) online\n";
+
+    std::set<int> printed; // one line per (level, type)
+    for (const auto& cache : caches_) {
+        if (!printed.insert(cache.level * 4 + static_cast<int>(cache.type)).second) {
+            continue;
+        }
+
+        int instances = static_cast<int>(std::count_if(caches_.begin(), caches_.end(), [&](const CacheDescriptor& c) {
+            return c.level == cache.level && c.type == cache.type;
+        }));
+        int sharing = 0;
+        for (uint64_t mask = cache.shared_cpus; mask; mask &= mask - 1) {
+            ++sharing;
+        }
+
+        out << "L" << static_cast<int>(cache.level) << cache_type_suffix(cache.type) << ": "
+            << cache.size_bytes / 1024 << " KiB, " << cache.line_size << " B line, " << cache.ways << "-way, "
+            << instances << " instance(s) shared by " << sharing << " CPU(s)\n";
+    }
+    return out.str();
+}
+
+} // namespace cm5_peripheral_test
@@ -0,0 +1,175 @@
+/**
+ * @file cpufreq_policy.cpp
+ * @brief Implementation of cpufreq policy access.
+ * @author Sandesh Ghimire | sandesh@soccentric
+ * @copyright (C) Soccentric LLC. All rights reserved.
+ */
+
+#include "cpufreq_policy.h"
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <utility>
+#include <unistd.h>
+
+namespace fs = std::filesystem;
+
+namespace cm5_peripheral_test {
+
+CpufreqPolicy::CpufreqPolicy(int cpu, std::string sysfs_root)
+    : cpu_(cpu), policy_dir_(std::move(sysfs_root) + "/cpu" + std::to_string(cpu) + "/cpufreq") {}
+
+bool CpufreqPolicy::is_available() const {
+    return fs::exists(policy_dir_);
+}
+
+bool CpufreqPolicy::is_writable() const {
+    return access(attribute_path("scaling_min_freq").c_str(), W_OK) == 0 &&
+           access(attribute_path("scaling_max_freq").c_str(), W_OK) == 0;
+}
+
+std::vector<long> CpufreqPolicy::available_frequencies_khz() const {
+    std::vector<long> frequencies;
+    std::stringstream list(read_attribute("scaling_available_frequencies"));
+    long khz = 0;
+    while (list >> khz) {
+        frequencies.push_back(khz);
+    }
+
+    if (frequencies.empty()) {
+        long min_khz = hardware_min_khz();
+        long max_khz = hardware_max_khz();
+        if (min_khz > 0) frequencies.push_back(min_khz);
+        if (max_khz > 0 && max_khz != min_khz) frequencies.push_back(max_khz);
+    }
+
+    std::sort(frequencies.begin(), frequencies.end());
+    frequencies.erase(std::unique(frequencies.begin(), frequencies.end()), frequencies.end());
+    return frequencies;
+}
+
+std::vector<std::string> CpufreqPolicy::available_governors() const {
+    std::vector<std::string> governors;
+    std::stringstream list(read_attribute("scaling_available_governors"));
+    std::string name;
+    while (list >> name) {
+        governors.push_back(name);
+    }
+    return governors;
+}
+
+std::string CpufreqPolicy::governor() const {
+    return read_attribute("scaling_governor");
+}
+
+long CpufreqPolicy::current_khz() const {
+    return read_khz("scaling_cur_freq");
+}
+
+long CpufreqPolicy::hardware_max_khz() const {
+    return read_khz("cpuinfo_max_freq");
+}
+
+long CpufreqPolicy::hardware_min_khz() const {
+    return read_khz("cpuinfo_min_freq");
+}
+
+CpufreqSettings CpufreqPolicy::snapshot() const {
+    CpufreqSettings settings;
+    settings.governor = governor();
+    settings.min_khz = read_khz("scaling_min_freq");
+    settings.max_khz = read_khz("scaling_max_freq");
+    if (settings.governor == "userspace") {
+        settings.setspeed_khz = read_khz("scaling_setspeed");
+    }
+    return settings;
+}
+
+bool CpufreqPolicy::restore(const CpufreqSettings& settings) {
+    bool ok = true;
+    if (!settings.governor.empty() && governor() != settings.governor) {
+        ok = set_governor(settings.governor) && ok;
+    }
+    if (settings.min_khz > 0 && settings.max_khz > 0) {
+        ok = set_limits(settings.min_khz, settings.max_khz) && ok;
+    }
+    // After the limits, so the original speed is not clipped by a pin
+    if (settings.governor == "userspace" && settings.setspeed_khz > 0) {
+        ok = write_attribute("scaling_setspeed", std::to_string(settings.setspeed_khz)) && ok;
+    }
+    return ok;
+}
+
+bool CpufreqPolicy::set_governor(const std::string& governor) {
+    return write_attribute("scaling_governor", governor);
+}
+
+bool CpufreqPolicy::set_limits(long min_khz, long max_khz) {
+    if (min_khz > max_khz) {
+        return false;
+    }
+
+    // Raising: move max first so min never exceeds it; lowering: the reverse
+    long current_max = read_khz("scaling_max_freq");
+    if (max_khz >= current_max) {
+        return write_attribute("scaling_max_freq", std::to_string(max_khz)) &&
+               write_attribute("scaling_min_freq", std::to_string(min_khz));
+    }
+    return write_attribute("scaling_min_freq", std::to_string(min_khz)) &&
+           write_attribute("scaling_max_freq", std::to_string(max_khz));
+}
+
+bool CpufreqPolicy::pin_frequency(long khz) {
+    std::vector<std::string> governors = available_governors();
+    bool has_userspace = std::find(governors.begin(), governors.end(), "userspace") != governors.end();
+
+    if (has_userspace && (governor() == "userspace" || set_governor("userspace"))) {
+        // Open the limits wide so setspeed is not clipped by a previous clamp
+        set_limits(hardware_min_khz(), hardware_max_khz());
+        if (write_attribute("scaling_setspeed", std::to_string(khz))) {
+            return true;
+        }
+    }
+
+    return set_limits(khz, khz);
+}
+
+std::string CpufreqPolicy::attribute_path(const std::string& name) const {
+    return policy_dir_ + "/" + name;
+}
+
+std::string CpufreqPolicy::read_attribute(const std::string& name) const {
+    std::ifstream file(attribute_path(name));
+    if (!file.is_open()) {
+        return "";
+    }
+
+    std::string value;
+    std::getline(file, value);
+    while (!value.empty() && (value.back() == ' ' || value.back() == '\n')) {
+        value.pop_back();
+    }
+    return value;
+}
+
+long CpufreqPolicy::read_khz(const std::string& name) const {
+    try {
+        return std::stol(read_attribute(name));
+    } catch (...) {
+        return 0;
+    }
+}
+
+bool CpufreqPolicy::write_attribute(const std::string& name, const std::string& value) {
+    std::ofstream file(attribute_path(name));
+    if (!file.is_open()) {
+        return false;
+    }
+
+    file << value;
+    file.flush();
+    return file.good();
+}
+
+} // namespace cm5_peripheral_test
@@ -0,0 +1,165 @@
+/**
+ * @file cpuidle_monitor.cpp
+ * @brief Implementation of per-core idle-state residency sampling.
+ * @author Sandesh Ghimire | sandesh@soccentric
+ * @copyright (C) Soccentric LLC. All rights reserved.
+ */
+
+#include "cpuidle_monitor.h"
+#include <algorithm>
+#include <cctype>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <utility>
+
+namespace fs = std::filesystem;
+
+namespace cm5_peripheral_test {
+
+namespace {
+
+std::string read_line(const std::string& path) {
+    std::ifstream file(path);
+    std::string value;
+    if (file.is_open()) {
+        std::getline(file, value);
+    }
+    return value;
+}
+
+bool try_read_u64(const std::string& path, uint64_t& value) {
+    try {
+        value = std::stoull(read_line(path));
+        return true;
+    } catch (...) {
+        return false;
+    }
+}
+
+uint64_t read_u64(const std::string& path) {
+    uint64_t value = 0;
+    return try_read_u64(path, value) ? value : 0;
+}
+
+} // namespace
+
+CpuidleMonitor::CpuidleMonitor(std::string sysfs_root) : sysfs_root_(std::move(sysfs_root)) {
+    std::error_code ec;
+    for (const auto& entry : fs::directory_iterator(sysfs_root_, ec)) {
+        std::string name = entry.path().filename().string();
+        if (name.size() < 4 || name.compare(0, 3, "cpu") != 0 ||
+            !std::all_of(name.begin() + 3, name.end(), ::isdigit)) {
+            continue;
+        }
+        if (fs::exists(entry.path() / "cpuidle" / "state0")) {
+            cpus_.push_back(std::stoi(name.substr(3)));
+        }
+    }
+    std::sort(cpus_.begin(), cpus_.end());
+
+    if (cpus_.empty()) {
+        return;
+    }
+
+    for (int state = 0; fs::exists(state_path(cpus_.front(), state, "")); ++state) {
+        IdleStateInfo info;
+        info.index = state;
+        info.name = read_line(state_path(cpus_.front(), state, "name"));
+        info.exit_latency_us = static_cast<long>(read_u64(state_path(cpus_.front(), state, "latency")));
+        info.target_residency_us = static_cast<long>(read_u64(state_path(cpus_.front(), state, "residency")));
+        states_.push_back(info);
+    }
+}
+
+void CpuidleMonitor::start() {
+    previous_ = read_counters();
+    previous_time_ = std::chrono::steady_clock::now();
+}
+
+std::vector<std::vector<IdleStateDelta>> CpuidleMonitor::sample() {
+    std::vector<std::vector<Counters>> current = read_counters();
+    auto now = std::chrono::steady_clock::now();
+    double interval_us = std::chrono::duration<double, std::micro>(now - previous_time_).count();
+
+    std::vector<std::vector<IdleStateDelta>> deltas(cpus_.size(), std::vector<IdleStateDelta>(states_.size()));
+    for (size_t c = 0; c < cpus_.size() && c < previous_.size(); ++c) {
+        for (size_t s = 0; s < states_.size(); ++s) {
+            const Counters& before = previous_[c][s];
+            const Counters& after = current[c][s];
+            // An offline core's counters vanish or restart; report no data
+            // rather than a wrapped unsigned delta
+            if (!before.readable || !after.readable || after.usage < before.usage ||
+                after.time_us < before.time_us) {
+                continue;
+            }
+            IdleStateDelta& delta = deltas[c][s];
+            delta.entries = after.usage - before.usage;
+            delta.time_us = after.time_us - before.time_us;
+            delta.residency = interval_us > 0 ? delta.time_us / interval_us : 0.0;
+            delta.valid = true;
+        }
+    }
+
+    previous_ = std::move(current);
+    previous_time_ = now;
+    return deltas;
+}
+
+std::string CpuidleMonitor::format_residency(const std::vector<std::vector<IdleStateDelta>>& deltas) const {
+    std::stringstream out;
+    out << std::fixed << std::setprecision(1);
+    out << "Idle residency (%):";
+    for (const auto& state : states_) {
+        out << " " << state.name;
+    }
+    out << "\n";
+
+    for (size_t c = 0; c < deltas.size() && c < cpus_.size(); ++c) {
+        out << "  cpu" << cpus_[c] << ":";
+        for (const auto& delta : deltas[c]) {
+            if (delta.valid) {
+                out << " " << delta.residency * 100.0;
+            } else {
+                out << " -";
+            }
+        }
+        out << "\n";
+    }
+    return out.str();
+}
+
+bool CpuidleMonitor::is_state_disabled(int cpu, int state) const {
+    return read_u64(state_path(cpu, state, "disable")) != 0;
+}
+
+bool CpuidleMonitor::set_state_disabled(int cpu, int state, bool disabled) {
+    std::ofstream file(state_path(cpu, state, "disable"));
+    if (!file.is_open()) {
+        return false;
+    }
+
+    file << (disabled ? "1" : "0");
+    file.flush();
+    return file.good();
+}
+
+std::string CpuidleMonitor::state_path(int cpu, int state, const std::string& attribute) const {
+    std::string path = sysfs_root_ + "/cpu" + std::to_string(cpu) + "/cpuidle/state" + std::to_string(state);
+    return attribute.empty() ? path : path + "/" + attribute;
+}
+
+std::vector<std::vector<CpuidleMonitor::Counters>> CpuidleMonitor::read_counters() const {
+    std::vector<std::vector<Counters>> counters(cpus_.size(), std::vector<Counters>(states_.size()));
+    for (size_t c = 0; c < cpus_.size(); ++c) {
+        for (size_t s = 0; s < states_.size(); ++s) {
+            Counters& counter = counters[c][s];
+            counter.readable = try_read_u64(state_path(cpus_[c], static_cast<int>(s), "usage"), counter.usage) &&
+                               try_read_u64(state_path(cpus_[c], static_cast<int>(s), "time"), counter.time_us);
+        }
+    }
+    return counters;
+}
+
+} // namespace cm5_peripheral_test
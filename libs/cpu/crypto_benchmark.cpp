@@ -0,0 +1,753 @@
+/**
+ * @file crypto_benchmark.cpp
+ * @brief Implementation of crypto extension detection and benchmarks.
+ * @author Sandesh Ghimire | sandesh@soccentric
+ * @copyright (C) Soccentric LLC. All rights reserved.
+ *
+ * The implementations favour clarity over peak speed: accelerated paths
+ * replace the per-block primitive (AES round sequence, 64-bit carry-less
+ * multiply, SHA-256 block compression, CRC word update) and share the
+ * surrounding mode logic with the portable code. The portable primitives
+ * are the usual table-driven software forms (AES T-tables, a 4-bit
+ * windowed multiply, a byte-wise CRC table), so the measured speedup
+ * reflects the hardware rather than a naive baseline. Neither is
+ * constant-time; they exist to measure the hardware, not to protect data.
+ */
+
+#include "crypto_benchmark.h"
+#include "perf_counter.h"
+#include <array>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <vector>
+
+#if defined(__aarch64__)
+#include <arm_acle.h>
+#include <arm_neon.h>
+#if defined(__linux__)
+#include <asm/hwcap.h>
+#include <sys/auxv.h>
+#endif
+#elif defined(__x86_64__)
+#include <nmmintrin.h>
+#include <wmmintrin.h>
+#endif
+
+namespace cm5_peripheral_test {
+
+namespace {
+
+/** Size of the buffer processed by each benchmark pass. */
+constexpr size_t CRYPTO_BUFFER_BYTES = 16 * 1024;
+
+typedef void (*AesBlockFn)(const uint8_t* round_keys, const uint8_t* in, uint8_t* out);
+typedef void (*Clmul64Fn)(uint64_t a, uint64_t b, uint64_t& lo, uint64_t& hi);
+typedef void (*Sha256BlockFn)(uint32_t* state, const uint8_t* block);
+typedef uint32_t (*Crc32cFn)(uint32_t crc, const uint8_t* data, size_t length);
+
+const CryptoFeatures& runtime_features() {
+    static const CryptoFeatures features = detect_crypto_features();
+    return features;
+}
+
+// ---------------------------------------------------------------------------
+// Portable AES-128
+// ---------------------------------------------------------------------------
+
+uint8_t gf256_mul(uint8_t a, uint8_t b) {
+    uint8_t product = 0;
+    while (b != 0) {
+        if (b & 1) {
+            product ^= a;
+        }
+        a = static_cast<uint8_t>((a << 1) ^ ((a & 0x80) ? 0x1B : 0x00));
+        b >>= 1;
+    }
+    return product;
+}
+
+/**
+ * @brief AES S-box, derived from the GF(2^8) inverse and affine map.
+ */
+const std::array<uint8_t, 256>& aes_sbox() {
+    static const std::array<uint8_t, 256> sbox = []() {
+        std::array<uint8_t, 256> table{};
+        for (int x = 0; x < 256; ++x) {
+            uint8_t inverse = 0;
+            for (int y = 1; y < 256 && x != 0; ++y) {
+                if (gf256_mul(static_cast<uint8_t>(x), static_cast<uint8_t>(y)) == 1) {
+                    inverse = static_cast<uint8_t>(y);
+                    break;
+                }
+            }
+            uint8_t s = inverse;
+            for (int shift = 1; shift <= 4; ++shift) {
+                s ^= static_cast<uint8_t>((inverse << shift) | (inverse >> (8 - shift)));
+            }
+            table[x] = s ^ 0x63;
+        }
+        return table;
+    }();
+    return sbox;
+}
+
+inline uint8_t xtime(uint8_t a) {
+    return static_cast<uint8_t>((a << 1) ^ ((a & 0x80) ? 0x1B : 0x00));
+}
+
+inline uint32_t load_be32(const uint8_t* bytes) {
+    return (static_cast<uint32_t>(bytes[0]) << 24) | (static_cast<uint32_t>(bytes[1]) << 16) |
+           (static_cast<uint32_t>(bytes[2]) << 8) | static_cast<uint32_t>(bytes[3]);
+}
+
+inline void store_be32(uint32_t word, uint8_t* bytes) {
+    bytes[0] = static_cast<uint8_t>(word >> 24);
+    bytes[1] = static_cast<uint8_t>(word >> 16);
+    bytes[2] = static_cast<uint8_t>(word >> 8);
+    bytes[3] = static_cast<uint8_t>(word);
+}
+
+/**
+ * @brief AES encryption T-tables: entry x of table r is the MixColumns
+ *        column of S(x) placed in row r, with columns as big-endian words.
+ */
+const std::array<std::array<uint32_t, 256>, 4>& aes_ttables() {
+    static const std::array<std::array<uint32_t, 256>, 4> tables = []() {
+        const auto& sbox = aes_sbox();
+        std::array<std::array<uint32_t, 256>, 4> entries{};
+        for (int x = 0; x < 256; ++x) {
+            uint8_t s = sbox[x];
+            uint8_t s2 = xtime(s);
+            uint32_t word = (static_cast<uint32_t>(s2) << 24) | (static_cast<uint32_t>(s) << 16) |
+                            (static_cast<uint32_t>(s) << 8) | static_cast<uint32_t>(s2 ^ s);
+            for (int row = 0; row < 4; ++row) {
+                entries[row][x] = word;
+                word = (word >> 8) | (word << 24);
+            }
+        }
+        return entries;
+    }();
+    return tables;
+}
+
+void aes128_block_portable(const uint8_t* round_keys, const uint8_t* in, uint8_t* out) {
+    const auto& sbox = aes_sbox();
+    const auto& t = aes_ttables();
+    uint32_t s0 = load_be32(in) ^ load_be32(round_keys);
+    uint32_t s1 = load_be32(in + 4) ^ load_be32(round_keys + 4);
+    uint32_t s2 = load_be32(in + 8) ^ load_be32(round_keys + 8);
+    uint32_t s3 = load_be32(in + 12) ^ load_be32(round_keys + 12);
+
+    // SubBytes, ShiftRows and MixColumns as four lookups per column
+    for (int round = 1; round < 10; ++round) {
+        const uint8_t* key = round_keys + round * 16;
+        uint32_t t0 = t[0][s0 >> 24] ^ t[1][(s1 >> 16) & 0xFF] ^ t[2][(s2 >> 8) & 0xFF] ^ t[3][s3 & 0xFF];
+        uint32_t t1 = t[0][s1 >> 24] ^ t[1][(s2 >> 16) & 0xFF] ^ t[2][(s3 >> 8) & 0xFF] ^ t[3][s0 & 0xFF];
+        uint32_t t2 = t[0][s2 >> 24] ^ t[1][(s3 >> 16) & 0xFF] ^ t[2][(s0 >> 8) & 0xFF] ^ t[3][s1 & 0xFF];
+        uint32_t t3 = t[0][s3 >> 24] ^ t[1][(s0 >> 16) & 0xFF] ^ t[2][(s1 >> 8) & 0xFF] ^ t[3][s2 & 0xFF];
+        s0 = t0 ^ load_be32(key);
+        s1 = t1 ^ load_be32(key + 4);
+        s2 = t2 ^ load_be32(key + 8);
+        s3 = t3 ^ load_be32(key + 12);
+    }
+
+    // The last round has no MixColumns
+    const uint32_t columns[4] = {s0, s1, s2, s3};
+    for (int col = 0; col < 4; ++col) {
+        uint32_t word = (static_cast<uint32_t>(sbox[columns[col] >> 24]) << 24) |
+                        (static_cast<uint32_t>(sbox[(columns[(col + 1) % 4] >> 16) & 0xFF]) << 16) |
+                        (static_cast<uint32_t>(sbox[(columns[(col + 2) % 4] >> 8) & 0xFF]) << 8) |
+                        static_cast<uint32_t>(sbox[columns[(col + 3) % 4] & 0xFF]);
+        store_be32(word ^ load_be32(round_keys + 160 + 4 * col), out + 4 * col);
+    }
+}
+
+// ---------------------------------------------------------------------------
+// GHASH over GF(2^128)
+//
+// Blocks are mapped to ordinary polynomials (bit i = coefficient of x^i)
+// by reversing the bits of every byte and loading little-endian, so the
+// multiply is a plain carry-less product followed by reduction modulo
+// x^128 + x^7 + x^2 + x + 1. Both targets are little-endian.
+// ---------------------------------------------------------------------------
+
+struct Poly128 {
+    uint64_t lo;
+    uint64_t hi;
+};
+
+inline uint64_t reverse_bits_in_bytes(uint64_t x) {
+    x = ((x >> 1) & 0x5555555555555555ULL) | ((x & 0x5555555555555555ULL) << 1);
+    x = ((x >> 2) & 0x3333333333333333ULL) | ((x & 0x3333333333333333ULL) << 2);
+    x = ((x >> 4) & 0x0F0F0F0F0F0F0F0FULL) | ((x & 0x0F0F0F0F0F0F0F0FULL) << 4);
+    return x;
+}
+
+inline Poly128 block_to_poly(const uint8_t* block) {
+    Poly128 poly;
+    std::memcpy(&poly.lo, block, 8);
+    std::memcpy(&poly.hi, block + 8, 8);
+    poly.lo = reverse_bits_in_bytes(poly.lo);
+    poly.hi = reverse_bits_in_bytes(poly.hi);
+    return poly;
+}
+
+inline void poly_to_block(Poly128 poly, uint8_t* block) {
+    uint64_t lo = reverse_bits_in_bytes(poly.lo);
+    uint64_t hi = reverse_bits_in_bytes(poly.hi);
+    std::memcpy(block, &lo, 8);
+    std::memcpy(block + 8, &hi, 8);
+}
+
+void clmul64_portable(uint64_t a, uint64_t b, uint64_t& lo, uint64_t& hi) {
+    // Products of a with every 4-bit polynomial, then b a nibble at a time
+    uint64_t table_lo[16] = {0, a, a << 1, 0, a << 2, 0, 0, 0, a << 3};
+    uint64_t table_hi[16] = {0, 0, a >> 63, 0, a >> 62, 0, 0, 0, a >> 61};
+    for (int i = 3; i < 16; ++i) {
+        if ((i & (i - 1)) != 0) {
+            table_lo[i] = table_lo[i & (i - 1)] ^ table_lo[i & -i];
+            table_hi[i] = table_hi[i & (i - 1)] ^ table_hi[i & -i];
+        }
+    }
+
+    lo = 0;
+    hi = 0;
+    for (int shift = 60; shift >= 0; shift -= 4) {
+        hi = (hi << 4) | (lo >> 60);
+        lo <<= 4;
+        unsigned nibble = static_cast<unsigned>(b >> shift) & 0xF;
+        lo ^= table_lo[nibble];
+        hi ^= table_hi[nibble];
+    }
+}
+
+Poly128 gf128_mul(Poly128 a, Poly128 b, Clmul64Fn clmul) {
+    uint64_t lo0, hi0, lo1, hi1, lo2, hi2, lo3, hi3;
+    clmul(a.lo, b.lo, lo0, hi0);
+    clmul(a.lo, b.hi, lo1, hi1);
+    clmul(a.hi, b.lo, lo2, hi2);
+    clmul(a.hi, b.hi, lo3, hi3);
+
+    uint64_t r0 = lo0;
+    uint64_t r1 = hi0 ^ lo1 ^ lo2;
+    uint64_t r2 = hi1 ^ hi2 ^ lo3;
+    uint64_t r3 = hi3;
+
+    // x^128 = x^7 + x^2 + x + 1: fold the high half in, then the few bits
+    // that the shifts push past x^127
+    uint64_t overflow = (r3 >> 63) ^ (r3 >> 62) ^ (r3 >> 57);
+    uint64_t fold_lo = r2 ^ (r2 << 1) ^ (r2 << 2) ^ (r2 << 7);
+    uint64_t fold_hi = r3 ^ ((r3 << 1) | (r2 >> 63)) ^ ((r3 << 2) | (r2 >> 62)) ^ ((r3 << 7) | (r2 >> 57));
+    fold_lo ^= overflow ^ (overflow << 1) ^ (overflow << 2) ^ (overflow << 7);
+
+    return {r0 ^ fold_lo, r1 ^ fold_hi};
+}
+
+void gcm_encrypt(AesBlockFn aes, Clmul64Fn clmul, const uint8_t* key, const uint8_t* iv, const uint8_t* in,
+                 size_t length, uint8_t* out, uint8_t* tag) {
+    uint8_t round_keys[AES128_SCHEDULE_BYTES];
+    aes128_expand_key(key, round_keys);
+
+    uint8_t block[16] = {0};
+    aes(round_keys, block, block);
+    Poly128 h = block_to_poly(block);
+
+    uint8_t j0[16];
+    std::memcpy(j0, iv, 12);
+    j0[12] = 0;
+    j0[13] = 0;
+    j0[14] = 0;
+    j0[15] = 1;
+
+    uint8_t counter[16];
+    std::memcpy(counter, j0, 16);
+    uint32_t count = 1;
+
+    Poly128 y = {0, 0};
+    for (size_t offset = 0; offset < length; offset += 16) {
+        ++count;
+        counter[12] = static_cast<uint8_t>(count >> 24);
+        counter[13] = static_cast<uint8_t>(count >> 16);
+        counter[14] = static_cast<uint8_t>(count >> 8);
+        counter[15] = static_cast<uint8_t>(count);
+
+        uint8_t keystream[16];
+        aes(round_keys, counter, keystream);
+
+        size_t chunk = length - offset < 16 ? length - offset : 16;
+        uint8_t cipher[16] = {0};
+        for (size_t i = 0; i < chunk; ++i) {
+            cipher[i] = in[offset + i] ^ keystream[i];
+        }
+        std::memcpy(out + offset, cipher, chunk);
+
+        Poly128 c = block_to_poly(cipher);
+        y = gf128_mul({y.lo ^ c.lo, y.hi ^ c.hi}, h, clmul);
+    }
+
+    uint8_t lengths[16] = {0};
+    uint64_t bits = static_cast<uint64_t>(length) * 8;
+    for (int i = 0; i < 8; ++i) {
+        lengths[15 - i] = static_cast<uint8_t>(bits >> (8 * i));
+    }
+    Poly128 l = block_to_poly(lengths);
+    y = gf128_mul({y.lo ^ l.lo, y.hi ^ l.hi}, h, clmul);
+
+    uint8_t mask[16];
+    aes(round_keys, j0, mask);
+    poly_to_block(y, tag);
+    for (int i = 0; i < 16; ++i) {
+        tag[i] ^= mask[i];
+    }
+}
+
+// ---------------------------------------------------------------------------
+// SHA-256
+// ---------------------------------------------------------------------------
+
+alignas(16) constexpr uint32_t SHA256_K[64] = {
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+    0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+    0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+    0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+    0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+    0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+    0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+    0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2,
+};
+
+inline uint32_t rotr32(uint32_t x, int n) {
+    return (x >> n) | (x << (32 - n));
+}
+
+void sha256_block_portable(uint32_t* state, const uint8_t* block) {
+    uint32_t w[64];
+    for (int i = 0; i < 16; ++i) {
+        w[i] = (static_cast<uint32_t>(block[4 * i]) << 24) | (static_cast<uint32_t>(block[4 * i + 1]) << 16) |
+               (static_cast<uint32_t>(block[4 * i + 2]) << 8) | static_cast<uint32_t>(block[4 * i + 3]);
+    }
+    for (int i = 16; i < 64; ++i) {
+        uint32_t s0 = rotr32(w[i - 15], 7) ^ rotr32(w[i - 15], 18) ^ (w[i - 15] >> 3);
+        uint32_t s1 = rotr32(w[i - 2], 17) ^ rotr32(w[i - 2], 19) ^ (w[i - 2] >> 10);
+        w[i] = w[i - 16] + s0 + w[i - 7] + s1;
+    }
+
+    uint32_t a = state[0], b = state[1], c = state[2], d = state[3];
+    uint32_t e = state[4], f = state[5], g = state[6], h = state[7];
+    for (int i = 0; i < 64; ++i) {
+        uint32_t s1 = rotr32(e, 6) ^ rotr32(e, 11) ^ rotr32(e, 25);
+        uint32_t ch = (e & f) ^ (~e & g);
+        uint32_t t1 = h + s1 + ch + SHA256_K[i] + w[i];
+        uint32_t s0 = rotr32(a, 2) ^ rotr32(a, 13) ^ rotr32(a, 22);
+        uint32_t maj = (a & b) ^ (a & c) ^ (b & c);
+        uint32_t t2 = s0 + maj;
+        h = g;
+        g = f;
+        f = e;
+        e = d + t1;
+        d = c;
+        c = b;
+        b = a;
+        a = t1 + t2;
+    }
+    state[0] += a;
+    state[1] += b;
+    state[2] += c;
+    state[3] += d;
+    state[4] += e;
+    state[5] += f;
+    state[6] += g;
+    state[7] += h;
+}
+
+void sha256_run(Sha256BlockFn compress, const uint8_t* data, size_t length, uint8_t* digest) {
+    uint32_t state[8] = {0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a,
+                         0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19};
+
+    size_t full = length / 64 * 64;
+    for (size_t offset = 0; offset < full; offset += 64) {
+        compress(state, data + offset);
+    }
+
+    uint8_t tail[128] = {0};
+    size_t remaining = length - full;
+    std::memcpy(tail, data + full, remaining);
+    tail[remaining] = 0x80;
+    size_t tail_bytes = remaining + 9 <= 64 ? 64 : 128;
+    uint64_t bits = static_cast<uint64_t>(length) * 8;
+    for (int i = 0; i < 8; ++i) {
+        tail[tail_bytes - 1 - i] = static_cast<uint8_t>(bits >> (8 * i));
+    }
+    for (size_t offset = 0; offset < tail_bytes; offset += 64) {
+        compress(state, tail + offset);
+    }
+
+    for (int i = 0; i < 8; ++i) {
+        digest[4 * i] = static_cast<uint8_t>(state[i] >> 24);
+        digest[4 * i + 1] = static_cast<uint8_t>(state[i] >> 16);
+        digest[4 * i + 2] = static_cast<uint8_t>(state[i] >> 8);
+        digest[4 * i + 3] = static_cast<uint8_t>(state[i]);
+    }
+}
+
+// ---------------------------------------------------------------------------
+// CRC-32C
+// ---------------------------------------------------------------------------
+
+uint32_t crc32c_portable(uint32_t crc, const uint8_t* data, size_t length) {
+    static const std::array<uint32_t, 256> table = []() {
+        std::array<uint32_t, 256> entries{};
+        for (uint32_t i = 0; i < 256; ++i) {
+            uint32_t value = i;
+            for (int bit = 0; bit < 8; ++bit) {
+                value = (value >> 1) ^ ((value & 1) ? 0x82F63B78u : 0u);
+            }
+            entries[i] = value;
+        }
+        return entries;
+    }();
+
+    for (size_t i = 0; i < length; ++i) {
+        crc = (crc >> 8) ^ table[(crc ^ data[i]) & 0xFF];
+    }
+    return crc;
+}
+
+// ---------------------------------------------------------------------------
+// Accelerated primitives
+// ---------------------------------------------------------------------------
+
+#if defined(__aarch64__)
+
+__attribute__((target("+crypto"))) void aes128_block_armv8(const uint8_t* round_keys, const uint8_t* in,
+                                                           uint8_t* out) {
+    uint8x16_t state = vld1q_u8(in);
+    for (int round = 0; round < 9; ++round) {
+        state = vaesmcq_u8(vaeseq_u8(state, vld1q_u8(round_keys + 16 * round)));
+    }
+    state = vaeseq_u8(state, vld1q_u8(round_keys + 16 * 9));
+    state = veorq_u8(state, vld1q_u8(round_keys + 16 * 10));
+    vst1q_u8(out, state);
+}
+
+__attribute__((target("+crypto"))) void clmul64_armv8(uint64_t a, uint64_t b, uint64_t& lo, uint64_t& hi) {
+    uint64x2_t product = vreinterpretq_u64_p128(vmull_p64(static_cast<poly64_t>(a), static_cast<poly64_t>(b)));
+    lo = vgetq_lane_u64(product, 0);
+    hi = vgetq_lane_u64(product, 1);
+}
+
+__attribute__((target("+crypto"))) void sha256_block_armv8(uint32_t* state, const uint8_t* block) {
+    uint32x4_t abcd = vld1q_u32(state);
+    uint32x4_t efgh = vld1q_u32(state + 4);
+    uint32x4_t saved_abcd = abcd;
+    uint32x4_t saved_efgh = efgh;
+
+    uint32x4_t msg[4];
+    for (int i = 0; i < 4; ++i) {
+        msg[i] = vreinterpretq_u32_u8(vrev32q_u8(vld1q_u8(block + 16 * i)));
+    }
+
+    for (int group = 0; group < 16; ++group) {
+        uint32x4_t wk = vaddq_u32(msg[group % 4], vld1q_u32(SHA256_K + 4 * group));
+        if (group < 12) {
+            msg[group % 4] = vsha256su1q_u32(vsha256su0q_u32(msg[group % 4], msg[(group + 1) % 4]),
+                                             msg[(group + 2) % 4], msg[(group + 3) % 4]);
+        }
+        uint32x4_t previous_abcd = abcd;
+        abcd = vsha256hq_u32(abcd, efgh, wk);
+        efgh = vsha256h2q_u32(efgh, previous_abcd, wk);
+    }
+
+    vst1q_u32(state, vaddq_u32(abcd, saved_abcd));
+    vst1q_u32(state + 4, vaddq_u32(efgh, saved_efgh));
+}
+
+__attribute__((target("+crc"))) uint32_t crc32c_armv8(uint32_t crc, const uint8_t* data, size_t length) {
+    size_t i = 0;
+    for (; i + 8 <= length; i += 8) {
+        uint64_t word;
+        std::memcpy(&word, data + i, 8);
+        crc = __crc32cd(crc, word);
+    }
+    for (; i < length; ++i) {
+        crc = __crc32cb(crc, data[i]);
+    }
+    return crc;
+}
+
+constexpr bool HAS_GCM_PATH = true;
+constexpr bool HAS_SHA256_PATH = true;
+constexpr bool HAS_CRC32C_PATH = true;
+constexpr AesBlockFn AES_ACCELERATED = aes128_block_armv8;
+constexpr Clmul64Fn CLMUL_ACCELERATED = clmul64_armv8;
+constexpr Sha256BlockFn SHA256_ACCELERATED = sha256_block_armv8;
+constexpr Crc32cFn CRC32C_ACCELERATED = crc32c_armv8;
+
+#elif defined(__x86_64__)
+
+__attribute__((target("aes"))) void aes128_block_aesni(const uint8_t* round_keys, const uint8_t* in, uint8_t* out) {
+    const __m128i* keys = reinterpret_cast<const __m128i*>(round_keys);
+    __m128i state = _mm_xor_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(in)), _mm_loadu_si128(keys));
+    for (int round = 1; round < 10; ++round) {
+        state = _mm_aesenc_si128(state, _mm_loadu_si128(keys + round));
+    }
+    state = _mm_aesenclast_si128(state, _mm_loadu_si128(keys + 10));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(out), state);
+}
+
+__attribute__((target("pclmul"))) void clmul64_pclmul(uint64_t a, uint64_t b, uint64_t& lo, uint64_t& hi) {
+    __m128i product = _mm_clmulepi64_si128(_mm_cvtsi64_si128(static_cast<long long>(a)),
+                                           _mm_cvtsi64_si128(static_cast<long long>(b)), 0x00);
+    lo = static_cast<uint64_t>(_mm_cvtsi128_si64(product));
+    hi = static_cast<uint64_t>(_mm_cvtsi128_si64(_mm_unpackhi_epi64(product, product)));
+}
+
+__attribute__((target("sse4.2"))) uint32_t crc32c_sse42(uint32_t crc, const uint8_t* data, size_t length) {
+    uint64_t value = crc;
+    size_t i = 0;
+    for (; i + 8 <= length; i += 8) {
+        uint64_t word;
+        std::memcpy(&word, data + i, 8);
+        value = _mm_crc32_u64(value, word);
+    }
+    crc = static_cast<uint32_t>(value);
+    for (; i < length; ++i) {
+        crc = _mm_crc32_u8(crc, data[i]);
+    }
+    return crc;
+}
+
+constexpr bool HAS_GCM_PATH = true;
+constexpr bool HAS_SHA256_PATH = false; // SHA-NI path not implemented
+constexpr bool HAS_CRC32C_PATH = true;
+constexpr AesBlockFn AES_ACCELERATED = aes128_block_aesni;
+constexpr Clmul64Fn CLMUL_ACCELERATED = clmul64_pclmul;
+constexpr Sha256BlockFn SHA256_ACCELERATED = sha256_block_portable;
+constexpr Crc32cFn CRC32C_ACCELERATED = crc32c_sse42;
+
+#else
+
+constexpr bool HAS_GCM_PATH = false;
+constexpr bool HAS_SHA256_PATH = false;
+constexpr bool HAS_CRC32C_PATH = false;
+constexpr AesBlockFn AES_ACCELERATED = aes128_block_portable;
+constexpr Clmul64Fn CLMUL_ACCELERATED = clmul64_portable;
+constexpr Sha256BlockFn SHA256_ACCELERATED = sha256_block_portable;
+constexpr Crc32cFn CRC32C_ACCELERATED = crc32c_portable;
+
+#endif
+
+bool use_accelerated(CryptoImpl impl, CryptoAlgorithm algorithm) {
+    return impl == CryptoImpl::ACCELERATED && crypto_accelerated(algorithm, runtime_features());
+}
+
+/**
+ * @brief Runs one pass of an algorithm over a buffer.
+ * @return A value derived from the output, to keep the work observable.
+ */
+uint64_t run_crypto_pass(CryptoAlgorithm algorithm, CryptoImpl impl, const std::vector<uint8_t>& input,
+                         std::vector<uint8_t>& output) {
+    static const uint8_t KEY[16] = {0x2b, 0x7e, 0x15, 0x16, 0x28, 0xae, 0xd2, 0xa6,
+                                    0xab, 0xf7, 0x15, 0x88, 0x09, 0xcf, 0x4f, 0x3c};
+    static const uint8_t IV[12] = {0xca, 0xfe, 0xba, 0xbe, 0xfa, 0xce, 0xdb, 0xad, 0xde, 0xca, 0xf8, 0x88};
+
+    switch (algorithm) {
+    case CryptoAlgorithm::AES_GCM: {
+        uint8_t tag[16];
+        aes128_gcm_encrypt(impl, KEY, IV, input.data(), input.size(), output.data(), tag);
+        uint64_t value;
+        std::memcpy(&value, tag, sizeof(value));
+        return value;
+    }
+    case CryptoAlgorithm::SHA256: {
+        uint8_t digest[32];
+        sha256_digest(impl, input.data(), input.size(), digest);
+        uint64_t value;
+        std::memcpy(&value, digest, sizeof(value));
+        return value;
+    }
+    case CryptoAlgorithm::CRC32C:
+        return crc32c(impl, input.data(), input.size());
+    }
+    return 0;
+}
+
+std::vector<uint8_t> pseudo_random_buffer(size_t length) {
+    std::vector<uint8_t> buffer(length);
+    uint64_t x = 0x853C49E6748FEA9BULL;
+    for (auto& byte : buffer) {
+        x ^= x << 13;
+        x ^= x >> 7;
+        x ^= x << 17;
+        byte = static_cast<uint8_t>(x >> 24);
+    }
+    return buffer;
+}
+
+} // namespace
+
+CryptoFeatures parse_crypto_features(const std::string& flags) {
+    CryptoFeatures features;
+    std::istringstream stream(flags);
+    std::string flag;
+    while (stream >> flag) {
+        if (flag == "aes") {
+            features.aes = true;
+        } else if (flag == "pmull" || flag == "pclmulqdq") {
+            features.pmull = true;
+        } else if (flag == "sha2" || flag == "sha_ni") {
+            features.sha2 = true;
+        } else if (flag == "crc32" || flag == "sse4_2") {
+            features.crc32 = true;
+        }
+    }
+    return features;
+}
+
+CryptoFeatures detect_crypto_features(const std::string& cpuinfo_path) {
+#if defined(__aarch64__) && defined(__linux__)
+    (void)cpuinfo_path;
+    unsigned long hwcap = getauxval(AT_HWCAP);
+    CryptoFeatures features;
+    features.aes = (hwcap & HWCAP_AES) != 0;
+    features.pmull = (hwcap & HWCAP_PMULL) != 0;
+    features.sha2 = (hwcap & HWCAP_SHA2) != 0;
+    features.crc32 = (hwcap & HWCAP_CRC32) != 0;
+    return features;
+#else
+    std::ifstream cpuinfo(cpuinfo_path);
+    std::string line;
+    while (std::getline(cpuinfo, line)) {
+        if (line.compare(0, 8, "Features") == 0 || line.compare(0, 5, "flags") == 0) {
+            size_t colon = line.find(':');
+            if (colon != std::string::npos) {
+                return parse_crypto_features(line.substr(colon + 1));
+            }
+        }
+    }
+    return CryptoFeatures();
+#endif
+}
+
+bool crypto_accelerated(CryptoAlgorithm algorithm, const CryptoFeatures& features) {
+    switch (algorithm) {
+    case CryptoAlgorithm::AES_GCM:
+        return HAS_GCM_PATH && features.aes && features.pmull;
+    case CryptoAlgorithm::SHA256:
+        return HAS_SHA256_PATH && features.sha2;
+    case CryptoAlgorithm::CRC32C:
+        return HAS_CRC32C_PATH && features.crc32;
+    }
+    return false;
+}
+
+const char* crypto_algorithm_name(CryptoAlgorithm algorithm) {
+    switch (algorithm) {
+    case CryptoAlgorithm::AES_GCM: return "AES-128-GCM";
+    case CryptoAlgorithm::SHA256: return "SHA-256";
+    case CryptoAlgorithm::CRC32C: return "CRC-32C";
+    }
+    return "unknown";
+}
+
+void aes128_expand_key(const uint8_t* key, uint8_t* round_keys) {
+    const auto& sbox = aes_sbox();
+    std::memcpy(round_keys, key, 16);
+    uint8_t rcon = 0x01;
+    for (size_t i = 16; i < AES128_SCHEDULE_BYTES; i += 4) {
+        uint8_t word[4];
+        std::memcpy(word, round_keys + i - 4, 4);
+        if (i % 16 == 0) {
+            uint8_t first = word[0];
+            word[0] = sbox[word[1]] ^ rcon;
+            word[1] = sbox[word[2]];
+            word[2] = sbox[word[3]];
+            word[3] = sbox[first];
+            rcon = xtime(rcon);
+        }
+        for (int b = 0; b < 4; ++b) {
+            round_keys[i + b] = round_keys[i - 16 + b] ^ word[b];
+        }
+    }
+}
+
+void aes128_encrypt_block(CryptoImpl impl, const uint8_t* round_keys, const uint8_t* in, uint8_t* out) {
+    AesBlockFn aes = use_accelerated(impl, CryptoAlgorithm::AES_GCM) ? AES_ACCELERATED : aes128_block_portable;
+    aes(round_keys, in, out);
+}
+
+void clmul64(CryptoImpl impl, uint64_t a, uint64_t b, uint64_t& lo, uint64_t& hi) {
+    Clmul64Fn clmul = use_accelerated(impl, CryptoAlgorithm::AES_GCM) ? CLMUL_ACCELERATED : clmul64_portable;
+    clmul(a, b, lo, hi);
+}
+
+void aes128_gcm_encrypt(CryptoImpl impl, const uint8_t* key, const uint8_t* iv, const uint8_t* in, size_t length,
+                        uint8_t* out, uint8_t* tag) {
+    if (use_accelerated(impl, CryptoAlgorithm::AES_GCM)) {
+        gcm_encrypt(AES_ACCELERATED, CLMUL_ACCELERATED, key, iv, in, length, out, tag);
+    } else {
+        gcm_encrypt(aes128_block_portable, clmul64_portable, key, iv, in, length, out, tag);
+    }
+}
+
+void sha256_digest(CryptoImpl impl, const uint8_t* data, size_t length, uint8_t* digest) {
+    if (use_accelerated(impl, CryptoAlgorithm::SHA256)) {
+        sha256_run(SHA256_ACCELERATED, data, length, digest);
+    } else {
+        sha256_run(sha256_block_portable, data, length, digest);
+    }
+}
+
+uint32_t crc32c(CryptoImpl impl, const uint8_t* data, size_t length) {
+    return crc32c_update(impl, 0xFFFFFFFFu, data, length) ^ 0xFFFFFFFFu;
+}
+
+uint32_t crc32c_update(CryptoImpl impl, uint32_t crc, const uint8_t* data, size_t length) {
+    Crc32cFn update = use_accelerated(impl, CryptoAlgorithm::CRC32C) ? CRC32C_ACCELERATED : crc32c_portable;
+    return update(crc, data, length);
+}
+
+bool crypto_implementations_agree(CryptoAlgorithm algorithm) {
+    // Odd length exercises the partial-block paths
+    std::vector<uint8_t> input = pseudo_random_buffer(CRYPTO_BUFFER_BYTES - 13);
+    std::vector<uint8_t> portable(input.size());
+    std::vector<uint8_t> accelerated(input.size());
+
+    uint64_t portable_value = run_crypto_pass(algorithm, CryptoImpl::PORTABLE, input, portable);
+    uint64_t accelerated_value = run_crypto_pass(algorithm, CryptoImpl::ACCELERATED, input, accelerated);
+    return portable_value == accelerated_value && portable == accelerated;
+}
+
+CryptoThroughput benchmark_crypto(CryptoAlgorithm algorithm, CryptoImpl impl, std::chrono::milliseconds duration) {
+    CryptoThroughput result;
+    result.algorithm = algorithm;
+    result.impl = impl;
+
+    std::vector<uint8_t> input = pseudo_random_buffer(CRYPTO_BUFFER_BYTES);
+    std::vector<uint8_t> output(input.size());
+    volatile uint64_t sink = run_crypto_pass(algorithm, impl, input, output); // warm-up
+
+    PerfCounter cycles(PerfEvent::CPU_CYCLES);
+    uint64_t bytes = 0;
+    auto start = std::chrono::steady_clock::now();
+    auto end = start + duration;
+    cycles.start();
+    auto now = start;
+    while (now < end) {
+        sink = run_crypto_pass(algorithm, impl, input, output);
+        bytes += input.size();
+        now = std::chrono::steady_clock::now();
+    }
+    uint64_t cycle_count = cycles.stop();
+    (void)sink;
+
+    std::chrono::duration<double> elapsed = now - start;
+    result.bytes_per_second = elapsed.count() > 0 ? bytes / elapsed.count() : 0.0;
+    if (cycles.is_available() && bytes > 0) {
+        result.cycles_per_byte = static_cast<double>(cycle_count) / bytes;
+    }
+    return result;
+}
+
+} // namespace cm5_peripheral_test
@@ -0,0 +1,313 @@
+/**
+ * @file frontend_benchmark.cpp
+ * @brief Implementation of the branch predictor and front-end microbenchmarks.
+ * @author Sandesh Ghimire | sandesh@soccentric
+ * @copyright (C) Soccentric LLC. All rights reserved.
+ */
+
+#include "frontend_benchmark.h"
+#include "fast_clock.h"
+#include "perf_counter.h"
+#include <algorithm>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace cm5_peripheral_test {
+
+namespace {
+
+/** Entries in the branch data and dispatch selector arrays (power of two). */
+constexpr size_t PATTERN_LENGTH = 4096;
+
+/** Dispatch targets; enough that GCC and Clang emit a jump table for the switch. */
+constexpr int DISPATCH_TARGETS = 8;
+
+/** Code blocks in the footprint kernel that fits in L1I (~5 KiB). */
+constexpr size_t SMALL_FOOTPRINT_BLOCKS = 64;
+
+/** Code blocks in the footprint kernel that overflows L1I (~150 KiB, 64 KiB L1I on Cortex-A76). */
+constexpr size_t LARGE_FOOTPRINT_BLOCKS = 2048;
+
+/**
+ * @brief Dispatch target @p K; each has a different shape so the
+ *        compiler cannot merge the switch into a table of constants.
+ */
+template <int K>
+inline uint64_t dispatch_operation(uint64_t x) {
+    if constexpr (K == 0) {
+        return x + 0x9E3779B97F4A7C15ULL;
+    } else if constexpr (K == 1) {
+        return x ^ (x >> 17);
+    } else if constexpr (K == 2) {
+        return x * 0xBF58476D1CE4E5B9ULL;
+    } else if constexpr (K == 3) {
+        return (x << 23) | (x >> 41);
+    } else if constexpr (K == 4) {
+        return x - (x << 9);
+    } else if constexpr (K == 5) {
+        return ~x + 0x94D049BB133111EBULL;
+    } else if constexpr (K == 6) {
+        return x ^ (x << 13);
+    } else {
+        return x * 0xD6E8FEB86659FD93ULL + (x >> 31);
+    }
+}
+
+template <int K>
+__attribute__((noinline)) uint64_t dispatch_function(uint64_t x) {
+    return dispatch_operation<K>(x);
+}
+
+using DispatchFunction = uint64_t (*)(uint64_t);
+
+constexpr DispatchFunction DISPATCH_FUNCTIONS[DISPATCH_TARGETS] = {
+    dispatch_function<0>, dispatch_function<1>, dispatch_function<2>, dispatch_function<3>,
+    dispatch_function<4>, dispatch_function<5>, dispatch_function<6>, dispatch_function<7>,
+};
+
+/**
+ * @brief Interface dispatched through a vtable, like PeripheralTester.
+ */
+class DispatchTarget {
+public:
+    virtual ~DispatchTarget() = default;
+    virtual uint64_t apply(uint64_t x) const = 0;
+};
+
+template <int K>
+class DispatchTargetImpl : public DispatchTarget {
+public:
+    uint64_t apply(uint64_t x) const override { return dispatch_operation<K>(x); }
+};
+
+template <int... K>
+std::vector<std::unique_ptr<DispatchTarget>> make_dispatch_targets(std::integer_sequence<int, K...>) {
+    std::vector<std::unique_ptr<DispatchTarget>> objects;
+    (objects.push_back(std::make_unique<DispatchTargetImpl<K>>()), ...);
+    return objects;
+}
+
+uint64_t dispatch_switch(int target, uint64_t x) {
+    switch (target) {
+    case 0: return dispatch_operation<0>(x);
+    case 1: return dispatch_operation<1>(x);
+    case 2: return dispatch_operation<2>(x);
+    case 3: return dispatch_operation<3>(x);
+    case 4: return dispatch_operation<4>(x);
+    case 5: return dispatch_operation<5>(x);
+    case 6: return dispatch_operation<6>(x);
+    default: return dispatch_operation<7>(x);
+    }
+}
+
+/**
+ * @brief One generated code block. The constants depend on @p N so no
+ *        two blocks are identical and the linker cannot fold them.
+ */
+template <size_t N>
+__attribute__((noinline)) uint64_t code_block(uint64_t x) {
+    x = x * (0x9E3779B97F4A7C15ULL + 2 * N) + N;
+    x ^= x >> (N % 29 + 3);
+    x = x * 0xBF58476D1CE4E5B9ULL + (N * 7 + 1);
+    x ^= x >> (N % 23 + 5);
+    x += (x << (N % 13 + 1)) ^ (0x94D049BB133111EBULL + N);
+    x ^= x >> (N % 19 + 7);
+    return x;
+}
+
+template <size_t... I>
+__attribute__((noinline)) uint64_t run_code_blocks(uint64_t x, std::index_sequence<I...>) {
+    ((x = code_block<I>(x)), ...);
+    return x;
+}
+
+template <size_t... I>
+size_t code_span(std::index_sequence<I...>) {
+    const uintptr_t addresses[] = {reinterpret_cast<uintptr_t>(&code_block<I>)...};
+    auto bounds = std::minmax_element(std::begin(addresses), std::end(addresses));
+    size_t span = *bounds.second - *bounds.first;
+    // Add one average block for the last one
+    return span + span / (sizeof...(I) - 1);
+}
+
+/**
+ * @brief Times @p body with the front-end counters running.
+ * @param body Callable returning a checksum.
+ */
+template <typename Body>
+FrontendResult measure(FrontendKernel kernel, uint64_t iterations, Body body) {
+    FrontendResult result;
+    result.kernel = kernel;
+    result.iterations = iterations;
+
+    PerfCounter cycles(PerfEvent::CPU_CYCLES);
+    PerfCounter branch_misses(PerfEvent::BRANCH_MISSES);
+    PerfCounter stalls(PerfEvent::FRONTEND_STALLS);
+    PerfCounter icache_misses(PerfEvent::ICACHE_MISSES);
+
+    const FastClock& clock = FastClock::instance();
+    cycles.start();
+    branch_misses.start();
+    stalls.start();
+    icache_misses.start();
+    uint64_t begin = clock.ticks();
+    result.checksum = body();
+    uint64_t end = clock.ticks();
+    uint64_t counted_icache = icache_misses.stop();
+    uint64_t counted_stalls = stalls.stop();
+    uint64_t counted_misses = branch_misses.stop();
+    uint64_t counted_cycles = cycles.stop();
+
+    if (iterations == 0) {
+        return result;
+    }
+    double n = static_cast<double>(iterations);
+    result.ns_per_iteration = clock.ticks_to_ns(end - begin) / n;
+    if (cycles.is_available()) {
+        result.cycles_per_iteration = counted_cycles / n;
+    }
+    if (branch_misses.is_available()) {
+        result.branch_misses = counted_misses / n;
+    }
+    if (stalls.is_available()) {
+        result.frontend_stalls = counted_stalls / n;
+    }
+    if (icache_misses.is_available()) {
+        result.icache_misses = counted_icache / n;
+    }
+    return result;
+}
+
+/**
+ * @brief Fills a PATTERN_LENGTH array from a fixed-seed xorshift sequence.
+ */
+std::vector<uint8_t> random_pattern() {
+    std::vector<uint8_t> data(PATTERN_LENGTH);
+    uint64_t x = 0x2545F4914F6CDD1DULL;
+    for (size_t i = 0; i < data.size(); ++i) {
+        x ^= x << 13;
+        x ^= x >> 7;
+        x ^= x << 17;
+        data[i] = static_cast<uint8_t>(x);
+    }
+    return data;
+}
+
+FrontendResult run_branch(FrontendKernel kernel, uint64_t iterations) {
+    std::vector<uint8_t> data = random_pattern();
+    if (kernel == FrontendKernel::PREDICTABLE_BRANCH) {
+        for (size_t i = 0; i < data.size(); ++i) {
+            data[i] = i % 4 == 0 ? 200 : 50;
+        }
+    }
+
+    return measure(kernel, iterations, [&]() {
+        uint64_t sum = 0;
+        for (uint64_t i = 0; i < iterations; ++i) {
+            uint8_t value = data[i & (PATTERN_LENGTH - 1)];
+            if (value < 128) {
+                sum += value;
+                // Side effect the compiler cannot hoist, so the branch is
+                // not converted to a conditional select
+                asm volatile("" : "+r"(sum));
+            } else {
+                sum ^= value;
+            }
+        }
+        return sum;
+    });
+}
+
+FrontendResult run_dispatch(FrontendKernel kernel, uint64_t iterations) {
+    bool random = kernel == FrontendKernel::RANDOM_SWITCH || kernel == FrontendKernel::RANDOM_FUNCTION_POINTER ||
+                  kernel == FrontendKernel::RANDOM_VIRTUAL_CALL;
+    std::vector<uint8_t> targets = random_pattern();
+    for (size_t i = 0; i < targets.size(); ++i) {
+        targets[i] = static_cast<uint8_t>((random ? targets[i] : i) % DISPATCH_TARGETS);
+    }
+
+    std::vector<std::unique_ptr<DispatchTarget>> objects =
+        make_dispatch_targets(std::make_integer_sequence<int, DISPATCH_TARGETS>());
+    std::vector<const DispatchTarget*> interfaces;
+    for (const auto& object : objects) {
+        interfaces.push_back(object.get());
+    }
+
+    return measure(kernel, iterations, [&]() {
+        uint64_t x = 1;
+        for (uint64_t i = 0; i < iterations; ++i) {
+            int target = targets[i & (PATTERN_LENGTH - 1)];
+            switch (kernel) {
+            case FrontendKernel::SWITCH_DISPATCH:
+            case FrontendKernel::RANDOM_SWITCH:
+                x = dispatch_switch(target, x);
+                break;
+            case FrontendKernel::FUNCTION_POINTER:
+            case FrontendKernel::RANDOM_FUNCTION_POINTER:
+                x = DISPATCH_FUNCTIONS[target](x);
+                break;
+            default:
+                x = interfaces[target]->apply(x);
+                break;
+            }
+        }
+        return x;
+    });
+}
+
+template <size_t BLOCKS>
+FrontendResult run_footprint(FrontendKernel kernel, uint64_t iterations) {
+    uint64_t passes = std::max<uint64_t>(1, iterations / BLOCKS);
+    FrontendResult result = measure(kernel, passes * BLOCKS, [passes]() {
+        uint64_t x = 1;
+        for (uint64_t pass = 0; pass < passes; ++pass) {
+            x = run_code_blocks(x, std::make_index_sequence<BLOCKS>());
+        }
+        return x;
+    });
+    result.code_bytes = code_span(std::make_index_sequence<BLOCKS>());
+    return result;
+}
+
+} // namespace
+
+const char* frontend_kernel_name(FrontendKernel kernel) {
+    switch (kernel) {
+    case FrontendKernel::PREDICTABLE_BRANCH: return "predictable branch";
+    case FrontendKernel::RANDOM_BRANCH: return "random branch";
+    case FrontendKernel::SWITCH_DISPATCH: return "switch dispatch";
+    case FrontendKernel::FUNCTION_POINTER: return "function pointer";
+    case FrontendKernel::VIRTUAL_CALL: return "virtual call";
+    case FrontendKernel::RANDOM_SWITCH: return "switch dispatch, random";
+    case FrontendKernel::RANDOM_FUNCTION_POINTER: return "function pointer, random";
+    case FrontendKernel::RANDOM_VIRTUAL_CALL: return "virtual call, random";
+    case FrontendKernel::SMALL_FOOTPRINT: return "small code footprint";
+    case FrontendKernel::LARGE_FOOTPRINT: return "large code footprint";
+    }
+    return "unknown";
+}
+
+FrontendResult run_frontend_benchmark(FrontendKernel kernel, uint64_t iterations) {
+    switch (kernel) {
+    case FrontendKernel::PREDICTABLE_BRANCH:
+    case FrontendKernel::RANDOM_BRANCH:
+        return run_branch(kernel, iterations);
+    case FrontendKernel::SWITCH_DISPATCH:
+    case FrontendKernel::FUNCTION_POINTER:
+    case FrontendKernel::VIRTUAL_CALL:
+    case FrontendKernel::RANDOM_SWITCH:
+    case FrontendKernel::RANDOM_FUNCTION_POINTER:
+    case FrontendKernel::RANDOM_VIRTUAL_CALL:
+        return run_dispatch(kernel, iterations);
+    case FrontendKernel::SMALL_FOOTPRINT:
+        return run_footprint<SMALL_FOOTPRINT_BLOCKS>(kernel, iterations);
+    case FrontendKernel::LARGE_FOOTPRINT:
+        return run_footprint<LARGE_FOOTPRINT_BLOCKS>(kernel, iterations);
+    }
+    FrontendResult result;
+    result.kernel = kernel;
+    return result;
+}
+
+} // namespace cm5_peripheral_test
@@ -0,0 +1,155 @@
+/**
+ * @file gemm_benchmark.cpp
+ * @brief Implementation of the blocked GEMM benchmark runner.
+ * @author Sandesh Ghimire | sandesh@soccentric
+ * @copyright (C) Soccentric LLC. All rights reserved.
+ */
+
+#include "gemm_benchmark.h"
+#include "cpu_affinity.h"
+#include "perf_counter.h"
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <thread>
+
+namespace cm5_peripheral_test {
+
+namespace {
+
+/** Entries of C checked against a reference dot product. */
+constexpr int GEMM_VERIFY_SAMPLES = 16;
+
+/**
+ * @brief Per-worker measurement, written only by that worker.
+ */
+struct GemmWorkerStats {
+    uint64_t repetitions = 0;
+    double seconds = 0.0;
+    uint64_t cycles = 0;
+    bool counted = false;
+};
+
+template <typename T>
+void fill_matrix(std::vector<T>& matrix, uint64_t seed) {
+    uint64_t x = seed;
+    for (T& value : matrix) {
+        x = x * 6364136223846793005ULL + 1442695040888963407ULL;
+        value = static_cast<T>(static_cast<double>(x >> 11) / 9007199254740992.0 * 2.0 - 1.0);
+    }
+}
+
+template <typename T>
+bool verify_samples(int size, const std::vector<T>& a, const std::vector<T>& b, const std::vector<T>& c) {
+    uint64_t x = 0x2545F4914F6CDD1DULL;
+    for (int sample = 0; sample < GEMM_VERIFY_SAMPLES; ++sample) {
+        x ^= x << 13;
+        x ^= x >> 7;
+        x ^= x << 17;
+        int row = static_cast<int>(x % size);
+        int col = static_cast<int>((x >> 32) % size);
+
+        double reference = 0.0;
+        double magnitude = 0.0;
+        for (int p = 0; p < size; ++p) {
+            double term = static_cast<double>(a[row * size + p]) * b[p * size + col];
+            reference += term;
+            magnitude += std::fabs(term);
+        }
+        double tolerance = 4.0 * size * std::numeric_limits<T>::epsilon() * magnitude;
+        if (std::fabs(c[row * size + col] - reference) > tolerance) {
+            return false;
+        }
+    }
+    return true;
+}
+
+template <typename T>
+GemmResult run_typed(GemmPrecision precision, int size, const std::vector<int>& cpus,
+                     std::chrono::milliseconds duration) {
+    GemmResult result;
+    result.precision = precision;
+    result.threads = static_cast<int>(cpus.size());
+    result.size = size;
+    if (cpus.empty() || size <= 0) {
+        return result;
+    }
+
+    std::vector<T> a(static_cast<size_t>(size) * size);
+    std::vector<T> b(a.size());
+    std::vector<T> c(a.size(), T(0));
+    fill_matrix(a, 1);
+    fill_matrix(b, 2);
+
+    std::vector<GemmWorkerStats> stats(cpus.size());
+    std::atomic<bool> stop{false};
+    std::vector<std::thread> workers;
+
+    for (size_t i = 0; i < cpus.size(); ++i) {
+        int row_begin = static_cast<int>(size * i / cpus.size());
+        int row_end = static_cast<int>(size * (i + 1) / cpus.size());
+        workers.emplace_back([&, i, row_begin, row_end]() {
+            pin_current_thread(cpus[i]);
+            BlockedGemm<T> gemm;
+            PerfCounter cycles(PerfEvent::CPU_CYCLES);
+            GemmWorkerStats& own = stats[i];
+
+            auto start = std::chrono::steady_clock::now();
+            cycles.start();
+            do {
+                std::fill(c.begin() + static_cast<size_t>(row_begin) * size,
+                          c.begin() + static_cast<size_t>(row_end) * size, T(0));
+                gemm.multiply(row_begin, row_end, size, size, a.data(), b.data(), c.data());
+                ++own.repetitions;
+            } while (!stop.load(std::memory_order_relaxed));
+            own.cycles = cycles.stop();
+            own.counted = cycles.is_available();
+            own.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        });
+    }
+
+    std::this_thread::sleep_for(duration);
+    stop.store(true);
+    for (auto& worker : workers) {
+        worker.join();
+    }
+
+    double total_mhz = 0.0;
+    bool all_counted = true;
+    for (size_t i = 0; i < cpus.size(); ++i) {
+        int rows = static_cast<int>(size * (i + 1) / cpus.size()) - static_cast<int>(size * i / cpus.size());
+        double flops = 2.0 * rows * size * static_cast<double>(size) * stats[i].repetitions;
+        if (stats[i].seconds > 0) {
+            result.gflops += flops / stats[i].seconds / 1e9;
+            total_mhz += stats[i].cycles / stats[i].seconds / 1e6;
+        }
+        all_counted = all_counted && stats[i].counted;
+    }
+    if (all_counted) {
+        result.effective_mhz = total_mhz / cpus.size();
+    }
+    result.verified = verify_samples(size, a, b, c);
+    return result;
+}
+
+} // namespace
+
+double gemm_peak_flops_per_cycle(GemmPrecision precision) {
+    int lanes = precision == GemmPrecision::SINGLE ? 4 : 2;
+#if defined(__aarch64__)
+    return 2.0 * lanes * 2.0;  // two 128-bit FMA pipes, 2 FLOP per FMA lane
+#else
+    return 2.0 * lanes;        // one 128-bit add and one 128-bit multiply per cycle
+#endif
+}
+
+GemmResult run_gemm_benchmark(GemmPrecision precision, int size, const std::vector<int>& cpus,
+                              std::chrono::milliseconds duration) {
+    if (precision == GemmPrecision::SINGLE) {
+        return run_typed<float>(precision, size, cpus, duration);
+    }
+    return run_typed<double>(precision, size, cpus, duration);
+}
+
+} // namespace cm5_peripheral_test
@@ -0,0 +1,193 @@
+/**
+ * @file handoff_benchmark.cpp
+ * @brief Implementation of the producer-to-consumer handoff benchmark.
+ * @author Sandesh Ghimire | sandesh@soccentric
+ * @copyright (C) Soccentric LLC. All rights reserved.
+ */
+
+#include "handoff_benchmark.h"
+#include "cache_line.h"
+#include "cpu_affinity.h"
+#include "fast_clock.h"
+#include "spsc_ring.h"
+#include <algorithm>
+#include <atomic>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+namespace cm5_peripheral_test {
+
+namespace {
+
+/** Items moved per push and pop in the batched modes. */
+constexpr size_t HANDOFF_BATCH = 64;
+
+/** Failed attempts spent spinning before a side yields its core. */
+constexpr unsigned HANDOFF_SPINS_BEFORE_YIELD = 64;
+
+/**
+ * @brief Bounded FIFO guarded by a mutex, with the SpscRing batch interface.
+ */
+class MutexQueue {
+public:
+    explicit MutexQueue(size_t capacity) : capacity_(capacity) {}
+
+    size_t push(const uint64_t* items, size_t count) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        size_t accepted = std::min(count, capacity_ - items_.size());
+        items_.insert(items_.end(), items, items + accepted);
+        return accepted;
+    }
+
+    size_t pop(uint64_t* items, size_t max_count) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        size_t taken = std::min(max_count, items_.size());
+        std::copy(items_.begin(), items_.begin() + taken, items);
+        items_.erase(items_.begin(), items_.begin() + taken);
+        return taken;
+    }
+
+private:
+    size_t capacity_;            /**< Maximum items held */
+    std::mutex mutex_;           /**< Guards items_ */
+    std::deque<uint64_t> items_; /**< Queued items */
+};
+
+/**
+ * @brief Spins on the first few failed attempts, then yields so a
+ *        producer and consumer sharing a core both make progress.
+ */
+void back_off(unsigned& failures) {
+    if (++failures < HANDOFF_SPINS_BEFORE_YIELD) {
+        cpu_relax();
+    } else {
+        std::this_thread::yield();
+    }
+}
+
+/**
+ * @brief Streams the sequence 0 .. @p items - 1 through @p queue,
+ *        @p batch items per call.
+ */
+template <typename Queue>
+HandoffResult stream(Queue& queue, HandoffQueue kind, const std::vector<int>& cpus, uint64_t items, size_t batch) {
+    const FastClock& clock = FastClock::instance();
+    HandoffResult result;
+    result.queue = kind;
+    result.items = items;
+
+    std::atomic<int> ready{0};
+    std::atomic<bool> go{false};
+    uint64_t begin = 0;
+    uint64_t end = 0;
+    uint64_t rejections = 0;
+    bool in_order = true;
+    uint64_t received = 0;
+
+    std::thread producer([&]() {
+        pin_current_thread(cpus.front());
+        uint64_t buffer[HANDOFF_BATCH];
+        ready.fetch_add(1);
+        while (!go.load(std::memory_order_acquire)) {
+            cpu_relax();
+        }
+        begin = clock.ticks();
+        uint64_t next = 0;
+        unsigned failures = 0;
+        while (next < items) {
+            size_t count = static_cast<size_t>(std::min<uint64_t>(batch, items - next));
+            for (size_t i = 0; i < count; ++i) {
+                buffer[i] = next + i;
+            }
+            size_t accepted = queue.push(buffer, count);
+            rejections += count - accepted;
+            next += accepted;
+            if (accepted == 0) {
+                back_off(failures);
+            } else {
+                failures = 0;
+            }
+        }
+    });
+
+    std::thread consumer([&]() {
+        pin_current_thread(cpus.back());
+        uint64_t buffer[HANDOFF_BATCH];
+        ready.fetch_add(1);
+        while (!go.load(std::memory_order_acquire)) {
+            cpu_relax();
+        }
+        unsigned failures = 0;
+        while (received < items) {
+            size_t taken = queue.pop(buffer, batch);
+            for (size_t i = 0; i < taken; ++i) {
+                in_order = in_order && buffer[i] == received + i;
+            }
+            received += taken;
+            if (taken == 0) {
+                back_off(failures);
+            } else {
+                failures = 0;
+            }
+        }
+        end = clock.ticks();
+    });
+
+    while (ready.load() < 2) {
+        std::this_thread::yield();
+    }
+    go.store(true, std::memory_order_release);
+    producer.join();
+    consumer.join();
+
+    double seconds = clock.ticks_to_ns(end - begin) / 1e9;
+    result.items_per_second = seconds > 0 ? items / seconds : 0.0;
+    result.full_rejections = rejections;
+    result.in_order = in_order && received == items;
+    return result;
+}
+
+} // namespace
+
+const char* handoff_queue_name(HandoffQueue queue) {
+    switch (queue) {
+    case HandoffQueue::MUTEX_QUEUE: return "mutex queue";
+    case HandoffQueue::MUTEX_BATCH: return "mutex queue, batched";
+    case HandoffQueue::SPSC_SINGLE: return "SPSC ring";
+    case HandoffQueue::SPSC_BATCH: return "SPSC ring, batched";
+    }
+    return "unknown";
+}
+
+HandoffResult run_handoff_benchmark(HandoffQueue queue, const std::vector<int>& cpus, uint64_t items,
+                                    size_t capacity) {
+    if (cpus.empty()) {
+        HandoffResult result;
+        result.queue = queue;
+        return result;
+    }
+    switch (queue) {
+    case HandoffQueue::MUTEX_QUEUE: {
+        MutexQueue mutex_queue(capacity);
+        return stream(mutex_queue, queue, cpus, items, 1);
+    }
+    case HandoffQueue::MUTEX_BATCH: {
+        MutexQueue mutex_queue(capacity);
+        return stream(mutex_queue, queue, cpus, items, HANDOFF_BATCH);
+    }
+    case HandoffQueue::SPSC_SINGLE: {
+        SpscRing<uint64_t> ring(capacity);
+        return stream(ring, queue, cpus, items, 1);
+    }
+    case HandoffQueue::SPSC_BATCH: {
+        SpscRing<uint64_t> ring(capacity);
+        return stream(ring, queue, cpus, items, HANDOFF_BATCH);
+    }
+    }
+    HandoffResult result;
+    result.queue = queue;
+    return result;
+}
+
+} // namespace cm5_peripheral_test
@@ -0,0 +1,367 @@
+/**
+ * @file interrupt_monitor.cpp
+ * @brief Implementation of per-core interrupt and softirq rate sampling.
+ * @author Sandesh Ghimire | sandesh@soccentric
+ * @copyright (C) Soccentric LLC. All rights reserved.
+ */
+
+#include "interrupt_monitor.h"
+#include "fast_clock.h"
+#include <algorithm>
+#include <cstring>
+#include <fcntl.h>
+#include <iomanip>
+#include <numeric>
+#include <sstream>
+#include <string_view>
+#include <unistd.h>
+#include <utility>
+
+namespace cm5_peripheral_test {
+
+namespace {
+
+/** Initial read buffer; grown (once) if a file is larger. */
+constexpr size_t INITIAL_BUFFER_BYTES = 16 * 1024;
+
+/** Marks a file column whose CPU is not tracked. */
+constexpr int UNTRACKED_COLUMN = -1;
+
+/** Marks a row that matched no discovered source. */
+constexpr size_t NO_SOURCE = static_cast<size_t>(-1);
+
+bool is_space(char c) {
+    return c == ' ' || c == '\t';
+}
+
+bool is_digit(char c) {
+    return c >= '0' && c <= '9';
+}
+
+/**
+ * @brief Minimal cursor over one line of a procfs table.
+ */
+struct LineCursor {
+    const char* pos;
+    const char* end;
+
+    void skip_spaces() {
+        while (pos < end && is_space(*pos)) {
+            ++pos;
+        }
+    }
+
+    /** Parses an unsigned decimal field; false if the next field is not a number. */
+    bool next_number(uint64_t& value) {
+        skip_spaces();
+        if (pos >= end || !is_digit(*pos)) {
+            return false;
+        }
+        value = 0;
+        while (pos < end && is_digit(*pos)) {
+            value = value * 10 + static_cast<uint64_t>(*pos - '0');
+            ++pos;
+        }
+        return true;
+    }
+};
+
+/**
+ * @brief Calls @p row(cursor) for every line after the header.
+ */
+template <typename Row>
+void for_each_row(const char* data, size_t length, Row row) {
+    const char* end = data + length;
+    const char* line = static_cast<const char*>(std::memchr(data, '\n', length));
+    line = line ? line + 1 : end;
+    while (line < end) {
+        const char* line_end = static_cast<const char*>(std::memchr(line, '\n', end - line));
+        if (!line_end) {
+            line_end = end;
+        }
+        LineCursor cursor{line, line_end};
+        row(cursor);
+        line = line_end + 1;
+    }
+}
+
+/**
+ * @brief Parses the "CPU0 CPU1 ..." header into CPU numbers.
+ */
+std::vector<int> parse_header(const char* data, size_t length) {
+    std::vector<int> cpus;
+    const char* end = static_cast<const char*>(std::memchr(data, '\n', length));
+    LineCursor cursor{data, end ? end : data + length};
+    while (true) {
+        cursor.skip_spaces();
+        if (cursor.end - cursor.pos < 4 || std::strncmp(cursor.pos, "CPU", 3) != 0) {
+            break;
+        }
+        cursor.pos += 3;
+        uint64_t cpu = 0;
+        if (!cursor.next_number(cpu)) {
+            break;
+        }
+        cpus.push_back(static_cast<int>(cpu));
+    }
+    return cpus;
+}
+
+} // namespace
+
+InterruptMonitor::InterruptMonitor(const std::string& proc_root)
+    : interrupts_path_(proc_root + "/interrupts"), softirqs_path_(proc_root + "/softirqs"),
+      buffer_(INITIAL_BUFFER_BYTES) {
+    if (!discover(interrupts_path_, false)) {
+        return;
+    }
+    discover(softirqs_path_, true);
+
+    size_t cells = sources_.size() * cpus_.size();
+    previous_.assign(cells, 0);
+    current_.assign(cells, 0);
+    totals_.assign(cells, 0);
+    rates_.assign(cells, 0.0);
+    peaks_.assign(cells, 0.0);
+}
+
+void InterruptMonitor::start() {
+    if (!is_available()) {
+        return;
+    }
+    unknown_ids_[0].clear();
+    unknown_ids_[1].clear();
+    if (read_file(interrupts_path_)) {
+        parse_counters(false);
+    }
+    if (read_file(softirqs_path_)) {
+        parse_counters(true);
+    }
+    std::copy(current_.begin(), current_.end(), previous_.begin());
+    std::fill(totals_.begin(), totals_.end(), 0);
+    std::fill(rates_.begin(), rates_.end(), 0.0);
+    std::fill(peaks_.begin(), peaks_.end(), 0.0);
+    previous_ns_ = FastClock::instance().now_ns();
+    elapsed_ns_ = 0;
+}
+
+bool InterruptMonitor::sample() {
+    if (!is_available()) {
+        return false;
+    }
+
+    // Rows that vanish keep their previous value and so contribute nothing
+    std::copy(previous_.begin(), previous_.end(), current_.begin());
+
+    uint64_t now = FastClock::instance().now_ns();
+    if (!read_file(interrupts_path_)) {
+        return false;
+    }
+    parse_counters(false);
+    if (read_file(softirqs_path_)) {
+        parse_counters(true);
+    }
+
+    uint64_t interval_ns = now > previous_ns_ ? now - previous_ns_ : 0;
+    double interval_s = interval_ns / 1e9;
+    for (size_t cell = 0; cell < current_.size(); ++cell) {
+        uint64_t delta = current_[cell] >= previous_[cell] ? current_[cell] - previous_[cell] : 0;
+        totals_[cell] += delta;
+        rates_[cell] = interval_s > 0 ? delta / interval_s : 0.0;
+        peaks_[cell] = std::max(peaks_[cell], rates_[cell]);
+    }
+
+    std::swap(previous_, current_);
+    previous_ns_ = now;
+    elapsed_ns_ += interval_ns;
+    return true;
+}
+
+std::string InterruptMonitor::format_summary(size_t limit, double storm_rate) const {
+    std::stringstream out;
+    out << std::fixed << std::setprecision(1);
+    double seconds = elapsed_seconds();
+    size_t columns = cpus_.size();
+
+    std::vector<uint64_t> source_totals(sources_.size(), 0);
+    std::vector<double> hard_per_cpu(columns, 0.0);
+    std::vector<double> soft_per_cpu(columns, 0.0);
+    for (size_t s = 0; s < sources_.size(); ++s) {
+        for (size_t c = 0; c < columns; ++c) {
+            source_totals[s] += total(s, c);
+            (sources_[s].softirq ? soft_per_cpu : hard_per_cpu)[c] += total(s, c);
+        }
+    }
+
+    out << "Interrupt rate per CPU over " << seconds << " s (hardirq/softirq per second):\n";
+    for (size_t c = 0; c < columns; ++c) {
+        out << "  cpu" << cpus_[c] << ": " << (seconds > 0 ? hard_per_cpu[c] / seconds : 0.0) << " / "
+            << (seconds > 0 ? soft_per_cpu[c] / seconds : 0.0) << "\n";
+    }
+
+    std::vector<size_t> order(sources_.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(),
+                     [&source_totals](size_t a, size_t b) { return source_totals[a] > source_totals[b]; });
+
+    out << "Busiest sources (mean rate, peak per-CPU interval rate):\n";
+    for (size_t i = 0; i < order.size() && i < limit && source_totals[order[i]] > 0; ++i) {
+        size_t s = order[i];
+        size_t busiest = 0;
+        for (size_t c = 1; c < columns; ++c) {
+            if (peak_rate(s, c) > peak_rate(s, busiest)) {
+                busiest = c;
+            }
+        }
+
+        out << "  " << (sources_[s].softirq ? "softirq " : "") << sources_[s].id;
+        if (!sources_[s].device.empty()) {
+            out << " (" << sources_[s].device << ")";
+        }
+        out << ": " << (seconds > 0 ? source_totals[s] / seconds : 0.0) << "/s, peak "
+            << peak_rate(s, busiest) << "/s on cpu" << cpus_[busiest];
+        if (peak_rate(s, busiest) >= storm_rate) {
+            out << " [STORM]";
+        }
+        out << "\n";
+    }
+    if (unknown_rows() > 0) {
+        out << "Rows not present at discovery: " << unknown_rows() << "\n";
+    }
+    return out.str();
+}
+
+bool InterruptMonitor::discover(const std::string& path, bool softirq) {
+    if (!read_file(path)) {
+        return false;
+    }
+
+    std::vector<int> header = parse_header(buffer_.data(), buffer_length_);
+    if (header.empty()) {
+        return false;
+    }
+    if (cpus_.empty()) {
+        cpus_ = header;
+    }
+
+    // softirqs lists possible CPUs, interrupts only online ones; map
+    // each file column onto the tracked CPU columns
+    std::vector<int>& columns = softirq ? softirq_columns_ : hardirq_columns_;
+    for (int cpu : header) {
+        auto it = std::find(cpus_.begin(), cpus_.end(), cpu);
+        columns.push_back(it == cpus_.end() ? UNTRACKED_COLUMN : static_cast<int>(it - cpus_.begin()));
+    }
+
+    for_each_row(buffer_.data(), buffer_length_, [&](LineCursor& cursor) {
+        cursor.skip_spaces();
+        const char* id = cursor.pos;
+        const char* colon = static_cast<const char*>(std::memchr(id, ':', cursor.end - id));
+        if (!colon || colon == id) {
+            return;
+        }
+
+        InterruptSource source;
+        source.id.assign(id, colon);
+        source.softirq = softirq;
+        cursor.pos = colon + 1;
+
+        uint64_t value;
+        size_t counted = 0;
+        while (counted < columns.size() && cursor.next_number(value)) {
+            ++counted;
+        }
+
+        // Collapse the controller/trigger/device text to single spaces
+        cursor.skip_spaces();
+        bool pending_space = false;
+        for (; cursor.pos < cursor.end; ++cursor.pos) {
+            if (is_space(*cursor.pos)) {
+                pending_space = true;
+                continue;
+            }
+            if (pending_space && !source.device.empty()) {
+                source.device += ' ';
+            }
+            pending_space = false;
+            source.device += *cursor.pos;
+        }
+        sources_.push_back(std::move(source));
+    });
+    return true;
+}
+
+bool InterruptMonitor::read_file(const std::string& path) {
+    int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        return false;
+    }
+
+    buffer_length_ = 0;
+    while (true) {
+        if (buffer_length_ == buffer_.size()) {
+            buffer_.resize(buffer_.size() * 2);
+        }
+        ssize_t got = ::read(fd, buffer_.data() + buffer_length_, buffer_.size() - buffer_length_);
+        if (got <= 0) {
+            break;
+        }
+        buffer_length_ += static_cast<size_t>(got);
+    }
+    ::close(fd);
+    return buffer_length_ > 0;
+}
+
+void InterruptMonitor::parse_counters(bool softirq) {
+    const std::vector<int>& columns = softirq ? softirq_columns_ : hardirq_columns_;
+    size_t width = cpus_.size();
+    size_t hint = 0;
+
+    for_each_row(buffer_.data(), buffer_length_, [&](LineCursor& cursor) {
+        cursor.skip_spaces();
+        const char* id = cursor.pos;
+        const char* colon = static_cast<const char*>(std::memchr(id, ':', cursor.end - id));
+        if (!colon || colon == id) {
+            return;
+        }
+
+        size_t source = find_source(id, static_cast<size_t>(colon - id), softirq, hint);
+        if (source == NO_SOURCE) {
+            // Count each row once, not once per sample; allocates only the first time
+            std::string_view row(id, static_cast<size_t>(colon - id));
+            std::set<std::string, std::less<>>& unknown = unknown_ids_[softirq ? 1 : 0];
+            if (unknown.find(row) == unknown.end()) {
+                unknown.emplace(row);
+            }
+            return;
+        }
+        hint = source + 1;
+        cursor.pos = colon + 1;
+
+        uint64_t value;
+        for (size_t column = 0; column < columns.size() && cursor.next_number(value); ++column) {
+            if (columns[column] != UNTRACKED_COLUMN) {
+                current_[source * width + static_cast<size_t>(columns[column])] = value;
+            }
+        }
+    });
+}
+
+size_t InterruptMonitor::find_source(const char* id, size_t length, bool softirq, size_t hint) const {
+    auto matches = [&](size_t index) {
+        const InterruptSource& source = sources_[index];
+        return source.softirq == softirq && source.id.size() == length && source.id.compare(0, length, id, length) == 0;
+    };
+
+    // Rows almost always appear in discovery order
+    if (hint < sources_.size() && matches(hint)) {
+        return hint;
+    }
+    for (size_t index = 0; index < sources_.size(); ++index) {
+        if (matches(index)) {
+            return index;
+        }
+    }
+    return NO_SOURCE;
+}
+
+} // namespace cm5_peripheral_test
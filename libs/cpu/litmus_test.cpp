@@ -0,0 +1,294 @@
+/**
+ * @file litmus_test.cpp
+ * @brief Implementation of the memory-ordering litmus test runner.
+ * @author Sandesh Ghimire | sandesh@soccentric
+ * @copyright (C) Soccentric LLC. All rights reserved.
+ */
+
+#include "litmus_test.h"
+#include "cache_line.h"
+#include "cpu_affinity.h"
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+namespace cm5_peripheral_test {
+
+namespace {
+
+/** Instances per batch between barriers. */
+constexpr size_t LITMUS_BATCH = 1024;
+
+/** Spins before a barrier waiter starts yielding (oversubscribed hosts). */
+constexpr int BARRIER_SPINS = 4096;
+
+/**
+ * @brief One litmus instance; x and y live on separate cache lines.
+ */
+struct LitmusInstance {
+    alignas(CACHE_LINE_SIZE) std::atomic<uint32_t> x{0};
+    alignas(CACHE_LINE_SIZE) std::atomic<uint32_t> y{0};
+};
+
+/**
+ * @brief Reusable centralised barrier for a fixed number of threads.
+ */
+class SpinBarrier {
+public:
+    explicit SpinBarrier(size_t threads) : threads_(threads) {}
+
+    void wait() {
+        uint32_t generation = generation_.load(std::memory_order_acquire);
+        if (arrived_.fetch_add(1, std::memory_order_acq_rel) + 1 == threads_) {
+            arrived_.store(0, std::memory_order_relaxed);
+            generation_.fetch_add(1, std::memory_order_release);
+            return;
+        }
+        for (int spins = 0; generation_.load(std::memory_order_acquire) == generation; ++spins) {
+            if (spins < BARRIER_SPINS) {
+                cpu_relax();
+            } else {
+                std::this_thread::yield();
+            }
+        }
+    }
+
+private:
+    const size_t threads_;
+    alignas(CACHE_LINE_SIZE) std::atomic<size_t> arrived_{0};
+    alignas(CACHE_LINE_SIZE) std::atomic<uint32_t> generation_{0};
+};
+
+std::memory_order store_order(LitmusOrdering ordering) {
+    switch (ordering) {
+    case LitmusOrdering::RELAXED: return std::memory_order_relaxed;
+    case LitmusOrdering::ACQUIRE_RELEASE: return std::memory_order_release;
+    case LitmusOrdering::SEQ_CST: return std::memory_order_seq_cst;
+    }
+    return std::memory_order_seq_cst;
+}
+
+std::memory_order load_order(LitmusOrdering ordering) {
+    switch (ordering) {
+    case LitmusOrdering::RELAXED: return std::memory_order_relaxed;
+    case LitmusOrdering::ACQUIRE_RELEASE: return std::memory_order_acquire;
+    case LitmusOrdering::SEQ_CST: return std::memory_order_seq_cst;
+    }
+    return std::memory_order_seq_cst;
+}
+
+/**
+ * @brief Bit position of a thread's first register in the outcome index.
+ */
+unsigned register_shift(LitmusTest test, size_t thread) {
+    switch (test) {
+    case LitmusTest::STORE_BUFFERING:
+    case LitmusTest::LOAD_BUFFERING:
+        return static_cast<unsigned>(thread);
+    case LitmusTest::IRIW:
+        return thread == 3 ? 2 : 0;
+    default:
+        return 0;
+    }
+}
+
+/**
+ * @brief Short random busy-wait to shift the threads against each other.
+ */
+inline void jitter(uint32_t& state) {
+    state ^= state << 13;
+    state ^= state >> 17;
+    state ^= state << 5;
+    volatile uint32_t spin = state & 15;
+    while (spin != 0) {
+        spin = spin - 1;
+    }
+}
+
+/**
+ * @brief Executes thread @p thread's part of instance @p instance.
+ * @return Registers read by the thread, packed from bit 0.
+ */
+inline uint8_t run_instance(LitmusTest test, size_t thread, LitmusInstance& instance, std::memory_order store,
+                            std::memory_order load) {
+    switch (test) {
+    case LitmusTest::MESSAGE_PASSING:
+        if (thread == 0) {
+            instance.x.store(1, store);
+            instance.y.store(1, store);
+            return 0;
+        } else {
+            uint32_t r0 = instance.y.load(load);
+            uint32_t r1 = instance.x.load(load);
+            return static_cast<uint8_t>(r0 | (r1 << 1));
+        }
+    case LitmusTest::STORE_BUFFERING:
+        if (thread == 0) {
+            instance.x.store(1, store);
+            return static_cast<uint8_t>(instance.y.load(load));
+        } else {
+            instance.y.store(1, store);
+            return static_cast<uint8_t>(instance.x.load(load));
+        }
+    case LitmusTest::LOAD_BUFFERING:
+        if (thread == 0) {
+            uint32_t r0 = instance.x.load(load);
+            instance.y.store(1, store);
+            return static_cast<uint8_t>(r0);
+        } else {
+            uint32_t r1 = instance.y.load(load);
+            instance.x.store(1, store);
+            return static_cast<uint8_t>(r1);
+        }
+    case LitmusTest::IRIW:
+        if (thread == 0) {
+            instance.x.store(1, store);
+            return 0;
+        } else if (thread == 1) {
+            instance.y.store(1, store);
+            return 0;
+        } else if (thread == 2) {
+            uint32_t r0 = instance.x.load(load);
+            uint32_t r1 = instance.y.load(load);
+            return static_cast<uint8_t>(r0 | (r1 << 1));
+        } else {
+            uint32_t r2 = instance.y.load(load);
+            uint32_t r3 = instance.x.load(load);
+            return static_cast<uint8_t>(r2 | (r3 << 1));
+        }
+    }
+    return 0;
+}
+
+} // namespace
+
+const char* litmus_test_name(LitmusTest test) {
+    switch (test) {
+    case LitmusTest::MESSAGE_PASSING: return "MP";
+    case LitmusTest::STORE_BUFFERING: return "SB";
+    case LitmusTest::LOAD_BUFFERING: return "LB";
+    case LitmusTest::IRIW: return "IRIW";
+    }
+    return "unknown";
+}
+
+const char* litmus_ordering_name(LitmusOrdering ordering) {
+    switch (ordering) {
+    case LitmusOrdering::RELAXED: return "relaxed";
+    case LitmusOrdering::ACQUIRE_RELEASE: return "acq_rel";
+    case LitmusOrdering::SEQ_CST: return "seq_cst";
+    }
+    return "unknown";
+}
+
+size_t litmus_thread_count(LitmusTest test) {
+    return test == LitmusTest::IRIW ? 4 : 2;
+}
+
+size_t litmus_outcome_count(LitmusTest test) {
+    return test == LitmusTest::IRIW ? 16 : 4;
+}
+
+bool litmus_forbidden(LitmusTest test, LitmusOrdering ordering, size_t outcome) {
+    switch (test) {
+    case LitmusTest::MESSAGE_PASSING:
+        // Seeing the flag but not the data needs the release/acquire pair
+        return ordering != LitmusOrdering::RELAXED && outcome == 0b01;
+    case LitmusTest::STORE_BUFFERING:
+        // Both loads missing the other store needs a total store order
+        return ordering == LitmusOrdering::SEQ_CST && outcome == 0b00;
+    case LitmusTest::LOAD_BUFFERING:
+        // Each load seeing the other thread's later store is a causality cycle
+        return ordering != LitmusOrdering::RELAXED && outcome == 0b11;
+    case LitmusTest::IRIW:
+        // Readers disagreeing on the order of independent writes
+        return ordering == LitmusOrdering::SEQ_CST && outcome == 0b0101;
+    }
+    return false;
+}
+
+std::string format_litmus_outcome(LitmusTest test, size_t outcome) {
+    size_t registers = test == LitmusTest::IRIW ? 4 : 2;
+    std::string text;
+    for (size_t reg = 0; reg < registers; ++reg) {
+        if (!text.empty()) {
+            text += " ";
+        }
+        text += "r" + std::to_string(reg) + "=" + std::to_string((outcome >> reg) & 1);
+    }
+    return text;
+}
+
+LitmusResult run_litmus_test(LitmusTest test, LitmusOrdering ordering, const std::vector<int>& cpus,
+                             uint64_t iterations) {
+    LitmusResult result;
+    result.test = test;
+    result.ordering = ordering;
+    result.outcomes.assign(litmus_outcome_count(test), 0);
+    if (cpus.empty()) {
+        return result;
+    }
+
+    const size_t threads = litmus_thread_count(test);
+    const uint64_t batches = (iterations + LITMUS_BATCH - 1) / LITMUS_BATCH;
+    const std::memory_order store = store_order(ordering);
+    const std::memory_order load = load_order(ordering);
+
+    for (size_t t = 0; t < threads; ++t) {
+        result.cpus.push_back(cpus[t % cpus.size()]);
+    }
+
+    std::vector<LitmusInstance> instances(LITMUS_BATCH);
+    std::vector<std::vector<uint8_t>> registers(threads, std::vector<uint8_t>(LITMUS_BATCH, 0));
+    SpinBarrier barrier(threads);
+    std::vector<std::thread> workers;
+
+    auto start = std::chrono::steady_clock::now();
+    for (size_t t = 0; t < threads; ++t) {
+        workers.emplace_back([&, t]() {
+            pin_current_thread(result.cpus[t]);
+            uint32_t rng = 0x9E3779B9u * static_cast<uint32_t>(t + 1) ^
+                           static_cast<uint32_t>(std::chrono::steady_clock::now().time_since_epoch().count());
+            if (rng == 0) {
+                rng = 1;
+            }
+            std::vector<uint8_t>& own = registers[t];
+
+            for (uint64_t batch = 0; batch < batches; ++batch) {
+                barrier.wait();
+                for (size_t i = 0; i < LITMUS_BATCH; ++i) {
+                    jitter(rng);
+                    own[i] = run_instance(test, t, instances[i], store, load);
+                }
+                barrier.wait();
+
+                if (t == 0) {
+                    for (size_t i = 0; i < LITMUS_BATCH; ++i) {
+                        size_t outcome = 0;
+                        for (size_t reader = 0; reader < threads; ++reader) {
+                            outcome |= static_cast<size_t>(registers[reader][i]) << register_shift(test, reader);
+                        }
+                        ++result.outcomes[outcome];
+                        instances[i].x.store(0, std::memory_order_relaxed);
+                        instances[i].y.store(0, std::memory_order_relaxed);
+                    }
+                }
+            }
+        });
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+    result.iterations = batches * LITMUS_BATCH;
+    for (size_t outcome = 0; outcome < result.outcomes.size(); ++outcome) {
+        if (litmus_forbidden(test, ordering, outcome)) {
+            result.forbidden += result.outcomes[outcome];
+        }
+    }
+    result.iterations_per_second = elapsed.count() > 0 ? result.iterations / elapsed.count() : 0.0;
+    return result;
+}
+
+} // namespace cm5_peripheral_test
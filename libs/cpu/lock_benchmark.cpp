@@ -0,0 +1,212 @@
+/**
+ * @file lock_benchmark.cpp
+ * @brief Implementation of synchronization primitive contention benchmarks.
+ * @author Sandesh Ghimire | sandesh@soccentric
+ * @copyright (C) Soccentric LLC. All rights reserved.
+ */
+
+#include "lock_benchmark.h"
+#include "cpu_affinity.h"
+#include <mutex>
+#include <numeric>
+#include <thread>
+
+namespace cm5_peripheral_test {
+
+namespace {
+
+/**
+ * @brief Per-thread counter occupying a full cache line.
+ */
+struct alignas(CACHE_LINE_SIZE) PaddedCounter {
+    std::atomic<uint64_t> value{0};
+};
+
+/**
+ * @brief Starts one pinned thread per CPU, releases them together and
+ *        stops them after @p duration.
+ *
+ * @param body Callable (thread index, stop flag) returning the number of
+ *             operations the thread completed.
+ * @param elapsed Receives the measured window.
+ * @return Per-thread operation counts.
+ */
+template <typename Body>
+std::vector<uint64_t> run_pinned_workers(const std::vector<int>& cpus, std::chrono::milliseconds duration,
+                                         Body body, std::chrono::duration<double>& elapsed) {
+    std::atomic<size_t> ready{0};
+    std::atomic<bool> go{false};
+    std::atomic<bool> stop{false};
+    std::vector<uint64_t> counts(cpus.size(), 0);
+    std::vector<std::thread> threads;
+
+    for (size_t i = 0; i < cpus.size(); ++i) {
+        threads.emplace_back([&, i]() {
+            pin_current_thread(cpus[i]);
+            ready.fetch_add(1, std::memory_order_acq_rel);
+            while (!go.load(std::memory_order_acquire)) {
+                cpu_relax();
+            }
+            counts[i] = body(i, stop);
+        });
+    }
+
+    while (ready.load(std::memory_order_acquire) < cpus.size()) {
+        std::this_thread::yield();
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    go.store(true, std::memory_order_release);
+    std::this_thread::sleep_for(duration);
+    stop.store(true, std::memory_order_release);
+
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    elapsed = std::chrono::steady_clock::now() - start;
+
+    return counts;
+}
+
+} // namespace
+
+const char* sync_primitive_name(SyncPrimitive primitive) {
+    switch (primitive) {
+    case SyncPrimitive::STD_MUTEX: return "std::mutex";
+    case SyncPrimitive::TICKET_SPINLOCK: return "ticket spinlock";
+    case SyncPrimitive::MCS_LOCK: return "MCS lock";
+    case SyncPrimitive::ATOMIC_RELAXED: return "atomic relaxed";
+    case SyncPrimitive::ATOMIC_SEQ_CST: return "atomic seq_cst";
+    case SyncPrimitive::SHARED_COUNTERS: return "shared-line counters";
+    case SyncPrimitive::PADDED_COUNTERS: return "padded counters";
+    }
+    return "unknown";
+}
+
+double jain_fairness(const std::vector<uint64_t>& counts) {
+    if (counts.size() < 2) {
+        return 1.0;
+    }
+
+    double sum = 0.0;
+    double sum_squares = 0.0;
+    for (uint64_t count : counts) {
+        sum += static_cast<double>(count);
+        sum_squares += static_cast<double>(count) * static_cast<double>(count);
+    }
+    if (sum_squares == 0.0) {
+        return 1.0;
+    }
+    return (sum * sum) / (counts.size() * sum_squares);
+}
+
+ContentionResult run_contention_benchmark(SyncPrimitive primitive, const std::vector<int>& cpus,
+                                          std::chrono::milliseconds duration) {
+    ContentionResult result;
+    result.primitive = primitive;
+    result.threads = static_cast<int>(cpus.size());
+    result.ops_per_second = 0.0;
+    result.fairness = 1.0;
+    result.consistent = true;
+
+    if (cpus.empty()) {
+        return result;
+    }
+
+    std::mutex mutex;
+    TicketSpinlock ticket;
+    McsLock mcs;
+    alignas(CACHE_LINE_SIZE) uint64_t protected_counter = 0;
+    alignas(CACHE_LINE_SIZE) std::atomic<uint64_t> shared_atomic{0};
+    std::vector<std::atomic<uint64_t>> packed(cpus.size());
+    std::vector<PaddedCounter> padded(cpus.size());
+    for (auto& slot : packed) {
+        slot.store(0, std::memory_order_relaxed);
+    }
+
+    auto body = [&](size_t index, const std::atomic<bool>& stop) -> uint64_t {
+        uint64_t ops = 0;
+        switch (primitive) {
+        case SyncPrimitive::STD_MUTEX:
+            while (!stop.load(std::memory_order_relaxed)) {
+                std::lock_guard<std::mutex> guard(mutex);
+                ++protected_counter;
+                ++ops;
+            }
+            break;
+        case SyncPrimitive::TICKET_SPINLOCK:
+            while (!stop.load(std::memory_order_relaxed)) {
+                ticket.lock();
+                ++protected_counter;
+                ticket.unlock();
+                ++ops;
+            }
+            break;
+        case SyncPrimitive::MCS_LOCK: {
+            McsLock::Node node;
+            while (!stop.load(std::memory_order_relaxed)) {
+                mcs.lock(node);
+                ++protected_counter;
+                mcs.unlock(node);
+                ++ops;
+            }
+            break;
+        }
+        case SyncPrimitive::ATOMIC_RELAXED:
+            while (!stop.load(std::memory_order_relaxed)) {
+                shared_atomic.fetch_add(1, std::memory_order_relaxed);
+                ++ops;
+            }
+            break;
+        case SyncPrimitive::ATOMIC_SEQ_CST:
+            while (!stop.load(std::memory_order_relaxed)) {
+                shared_atomic.fetch_add(1, std::memory_order_seq_cst);
+                ++ops;
+            }
+            break;
+        case SyncPrimitive::SHARED_COUNTERS: {
+            // Same layout as test_multi_core's result vector: neighbours
+            // write adjacent words of one cache line
+            std::atomic<uint64_t>& slot = packed[index];
+            while (!stop.load(std::memory_order_relaxed)) {
+                slot.store(slot.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+            }
+            ops = slot.load(std::memory_order_relaxed);
+            break;
+        }
+        case SyncPrimitive::PADDED_COUNTERS: {
+            std::atomic<uint64_t>& slot = padded[index].value;
+            while (!stop.load(std::memory_order_relaxed)) {
+                slot.store(slot.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+            }
+            ops = slot.load(std::memory_order_relaxed);
+            break;
+        }
+        }
+        return ops;
+    };
+
+    std::chrono::duration<double> elapsed(0);
+    std::vector<uint64_t> counts = run_pinned_workers(cpus, duration, body, elapsed);
+    uint64_t total = std::accumulate(counts.begin(), counts.end(), uint64_t{0});
+
+    switch (primitive) {
+    case SyncPrimitive::STD_MUTEX:
+    case SyncPrimitive::TICKET_SPINLOCK:
+    case SyncPrimitive::MCS_LOCK:
+        result.consistent = protected_counter == total;
+        break;
+    case SyncPrimitive::ATOMIC_RELAXED:
+    case SyncPrimitive::ATOMIC_SEQ_CST:
+        result.consistent = shared_atomic.load() == total;
+        break;
+    default:
+        break;
+    }
+
+    result.ops_per_second = elapsed.count() > 0 ? total / elapsed.count() : 0.0;
+    result.fairness = jain_fairness(counts);
+    return result;
+}
+
+} // namespace cm5_peripheral_test
@@ -0,0 +1,308 @@
+/**
+ * @file mapping_benchmark.cpp
+ * @brief Implementation of the page-fault and memory-mapping benchmarks.
+ * @author Sandesh Ghimire | sandesh@soccentric
+ * @copyright (C) Soccentric LLC. All rights reserved.
+ */
+
+#include "mapping_benchmark.h"
+#include "anonymous_mapping.h"
+#include "cache_line.h"
+#include "cpu_affinity.h"
+#include "fast_clock.h"
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <thread>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/resource.h>
+#include <unistd.h>
+
+namespace cm5_peripheral_test {
+
+namespace {
+
+/** Region passed to each mmap, madvise and mprotect call. */
+constexpr size_t MAPPING_CHUNK_BYTES = 256 * 1024;
+
+/** Calls timed for each of the chunked system calls. */
+constexpr uint64_t MAPPING_SYSCALL_ROUNDS = 2000;
+
+/** Write size used to fill the major-fault backing file. */
+constexpr size_t MAJOR_FAULT_WRITE_BYTES = 1024 * 1024;
+
+struct FaultCounts {
+    uint64_t minor = 0;
+    uint64_t major = 0;
+};
+
+FaultCounts fault_counts() {
+    rusage usage;
+    std::memset(&usage, 0, sizeof(usage));
+    getrusage(RUSAGE_SELF, &usage);
+    return {static_cast<uint64_t>(usage.ru_minflt), static_cast<uint64_t>(usage.ru_majflt)};
+}
+
+size_t page_size() {
+    long size = sysconf(_SC_PAGESIZE);
+    return size > 0 ? static_cast<size_t>(size) : 4096;
+}
+
+void touch_pages(char* base, size_t pages, size_t stride) {
+    for (size_t page = 0; page < pages; ++page) {
+        base[page * stride] = 1;
+    }
+}
+
+void finish(MappingCostResult& result, uint64_t operations, double elapsed_ns) {
+    result.operations = operations;
+    result.available = true;
+    if (operations > 0) {
+        result.ns_per_op = elapsed_ns / operations;
+    }
+    if (elapsed_ns > 0) {
+        result.ops_per_second = operations * 1e9 / elapsed_ns;
+    }
+}
+
+void run_minor_fault(MappingCostResult& result, size_t pages, size_t stride) {
+    AnonymousMapping region;
+    if (!region.map_base_pages(pages * stride)) {
+        result.note = "mmap failed";
+        return;
+    }
+    const FastClock& clock = FastClock::instance();
+    FaultCounts before = fault_counts();
+    uint64_t begin = clock.ticks();
+    touch_pages(region.data(), pages, stride);
+    uint64_t end = clock.ticks();
+    FaultCounts after = fault_counts();
+
+    finish(result, pages, clock.ticks_to_ns(end - begin));
+    result.faults_per_op = static_cast<double>(after.minor - before.minor) / pages;
+}
+
+void run_major_fault(MappingCostResult& result, size_t pages, size_t stride, const std::string& scratch_dir) {
+    std::string path = scratch_dir + "/cm5_mapping_XXXXXX";
+    std::vector<char> name(path.begin(), path.end());
+    name.push_back('\0');
+    int fd = mkstemp(name.data());
+    if (fd < 0) {
+        result.note = "cannot create a file in " + scratch_dir;
+        return;
+    }
+    unlink(name.data());
+
+    size_t length = pages * stride;
+    std::vector<char> block(MAJOR_FAULT_WRITE_BYTES, 0x5A);
+    bool written = true;
+    for (size_t offset = 0; offset < length && written; offset += block.size()) {
+        size_t count = std::min(block.size(), length - offset);
+        written = write(fd, block.data(), count) == static_cast<ssize_t>(count);
+    }
+    // Write back and evict the file so the first access must read storage
+    if (!written || fsync(fd) != 0) {
+        close(fd);
+        result.note = "cannot write the backing file";
+        return;
+    }
+    posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED);
+
+    void* mapped = mmap(nullptr, length, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (mapped == MAP_FAILED) {
+        result.note = "mmap of the backing file failed";
+        return;
+    }
+    const volatile char* base = static_cast<const char*>(mapped);
+    madvise(mapped, length, MADV_RANDOM);
+
+    const FastClock& clock = FastClock::instance();
+    FaultCounts before = fault_counts();
+    uint64_t begin = clock.ticks();
+    unsigned sum = 0;
+    for (size_t page = 0; page < pages; ++page) {
+        sum += static_cast<unsigned char>(base[page * stride]);
+    }
+    uint64_t end = clock.ticks();
+    FaultCounts after = fault_counts();
+    munmap(mapped, length);
+
+    finish(result, pages, clock.ticks_to_ns(end - begin));
+    result.faults_per_op = static_cast<double>(after.major - before.major) / pages;
+    if (sum != pages * 0x5Au) {
+        result.note = "file contents read back wrong";
+        result.available = false;
+    } else if (after.major == before.major) {
+        result.note = "file stayed in the page cache (tmpfs scratch directory?)";
+    }
+}
+
+void run_mmap_munmap(MappingCostResult& result) {
+    const FastClock& clock = FastClock::instance();
+    uint64_t begin = clock.ticks();
+    for (uint64_t round = 0; round < MAPPING_SYSCALL_ROUNDS; ++round) {
+        void* base = mmap(nullptr, MAPPING_CHUNK_BYTES, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (base == MAP_FAILED) {
+            result.note = "mmap failed";
+            return;
+        }
+        munmap(base, MAPPING_CHUNK_BYTES);
+    }
+    uint64_t end = clock.ticks();
+    finish(result, MAPPING_SYSCALL_ROUNDS, clock.ticks_to_ns(end - begin));
+}
+
+/**
+ * @brief Times a call on successive populated chunks of a region,
+ *        cycling through the region in laps.
+ * @param before Untimed preparation of a chunk (e.g. re-populating it).
+ * @param call Timed system call on the chunk and lap; false on error.
+ */
+template <typename Prepare, typename Call>
+void run_chunked(MappingCostResult& result, size_t pages, size_t stride, Prepare before, Call call) {
+    size_t length = std::max(pages * stride, MAPPING_CHUNK_BYTES);
+    size_t chunks = length / MAPPING_CHUNK_BYTES;
+    AnonymousMapping region;
+    if (!region.map_base_pages(length)) {
+        result.note = "mmap failed";
+        return;
+    }
+    touch_pages(region.data(), length / stride, stride);
+
+    const FastClock& clock = FastClock::instance();
+    uint64_t timed = 0;
+    for (uint64_t round = 0; round < MAPPING_SYSCALL_ROUNDS; ++round) {
+        char* chunk = region.data() + (round % chunks) * MAPPING_CHUNK_BYTES;
+        uint64_t lap = round / chunks;
+        before(chunk, lap);
+        uint64_t begin = clock.ticks();
+        bool ok = call(chunk, lap);
+        timed += clock.ticks() - begin;
+        if (!ok) {
+            result.note = "system call failed";
+            return;
+        }
+    }
+    finish(result, MAPPING_SYSCALL_ROUNDS, clock.ticks_to_ns(timed));
+}
+
+void run_first_touch(MappingCostResult& result, const std::vector<int>& cpus, size_t pages, size_t stride) {
+    AnonymousMapping region;
+    if (!region.map_base_pages(pages * stride)) {
+        result.note = "mmap failed";
+        return;
+    }
+
+    const FastClock& clock = FastClock::instance();
+    std::atomic<size_t> ready{0};
+    std::atomic<bool> go{false};
+    std::vector<double> per_page_ns(cpus.size(), 0.0);
+    std::vector<std::thread> workers;
+
+    for (size_t i = 0; i < cpus.size(); ++i) {
+        workers.emplace_back([&, i]() {
+            pin_current_thread(cpus[i]);
+            size_t first = pages * i / cpus.size();
+            size_t last = pages * (i + 1) / cpus.size();
+            ready.fetch_add(1, std::memory_order_acq_rel);
+            while (!go.load(std::memory_order_acquire)) {
+                cpu_relax();
+            }
+            uint64_t begin = clock.ticks();
+            touch_pages(region.data() + first * stride, last - first, stride);
+            uint64_t end = clock.ticks();
+            if (last > first) {
+                per_page_ns[i] = clock.ticks_to_ns(end - begin) / (last - first);
+            }
+        });
+    }
+    while (ready.load(std::memory_order_acquire) < cpus.size()) {
+        std::this_thread::yield();
+    }
+
+    FaultCounts before = fault_counts();
+    uint64_t begin = clock.ticks();
+    go.store(true, std::memory_order_release);
+    for (auto& worker : workers) {
+        worker.join();
+    }
+    uint64_t end = clock.ticks();
+    FaultCounts after = fault_counts();
+
+    finish(result, pages, clock.ticks_to_ns(end - begin));
+    // Latency is what each thread sees per page; the rate is aggregate
+    double sum = 0.0;
+    for (double value : per_page_ns) {
+        sum += value;
+    }
+    result.ns_per_op = sum / per_page_ns.size();
+    result.faults_per_op = static_cast<double>(after.minor - before.minor) / pages;
+}
+
+} // namespace
+
+const char* mapping_operation_name(MappingOperation operation) {
+    switch (operation) {
+    case MappingOperation::MINOR_FAULT: return "minor fault";
+    case MappingOperation::MAJOR_FAULT: return "major fault";
+    case MappingOperation::MMAP_MUNMAP: return "mmap+munmap";
+    case MappingOperation::MADVISE_DONTNEED: return "madvise(DONTNEED)";
+    case MappingOperation::MPROTECT: return "mprotect";
+    case MappingOperation::FIRST_TOUCH: return "first touch";
+    }
+    return "unknown";
+}
+
+MappingCostResult run_mapping_benchmark(MappingOperation operation, const std::vector<int>& cpus, size_t bytes,
+                                        const std::string& scratch_dir) {
+    MappingCostResult result;
+    result.operation = operation;
+    const size_t stride = page_size();
+    const size_t pages = (bytes + stride - 1) / stride;
+    if (pages == 0) {
+        result.note = "empty region";
+        return result;
+    }
+
+    switch (operation) {
+    case MappingOperation::MINOR_FAULT:
+        run_minor_fault(result, pages, stride);
+        break;
+    case MappingOperation::MAJOR_FAULT:
+        run_major_fault(result, pages, stride, scratch_dir);
+        break;
+    case MappingOperation::MMAP_MUNMAP:
+        result.chunk_bytes = MAPPING_CHUNK_BYTES;
+        run_mmap_munmap(result);
+        break;
+    case MappingOperation::MADVISE_DONTNEED:
+        result.chunk_bytes = MAPPING_CHUNK_BYTES;
+        run_chunked(
+            result, pages, stride,
+            [stride](char* chunk, uint64_t) { touch_pages(chunk, MAPPING_CHUNK_BYTES / stride, stride); },
+            [](char* chunk, uint64_t) { return madvise(chunk, MAPPING_CHUNK_BYTES, MADV_DONTNEED) == 0; });
+        break;
+    case MappingOperation::MPROTECT:
+        result.chunk_bytes = MAPPING_CHUNK_BYTES;
+        run_chunked(
+            result, pages, stride, [](char*, uint64_t) {},
+            [](char* chunk, uint64_t lap) {
+                int protection = lap % 2 == 0 ? PROT_READ : PROT_READ | PROT_WRITE;
+                return mprotect(chunk, MAPPING_CHUNK_BYTES, protection) == 0;
+            });
+        break;
+    case MappingOperation::FIRST_TOUCH:
+        if (cpus.empty()) {
+            result.note = "no CPUs";
+            break;
+        }
+        result.threads = static_cast<int>(cpus.size());
+        run_first_touch(result, cpus, pages, stride);
+        break;
+    }
+    return result;
+}
+
+} // namespace cm5_peripheral_test
@@ -0,0 +1,98 @@
+/**
+ * @file perf_counter.cpp
+ * @brief Implementation of hardware performance counter access.
+ * @author Sandesh Ghimire | sandesh@soccentric
+ * @copyright (C) Soccentric LLC. All rights reserved.
+ */
+
+#include "perf_counter.h"
+#include <cstring>
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+namespace cm5_peripheral_test {
+
+namespace {
+
+void configure_event(PerfEvent event, perf_event_attr& attr) {
+    switch (event) {
+    case PerfEvent::CPU_CYCLES:
+        attr.type = PERF_TYPE_HARDWARE;
+        attr.config = PERF_COUNT_HW_CPU_CYCLES;
+        break;
+    case PerfEvent::INSTRUCTIONS:
+        attr.type = PERF_TYPE_HARDWARE;
+        attr.config = PERF_COUNT_HW_INSTRUCTIONS;
+        break;
+    case PerfEvent::DTLB_MISSES:
+        attr.type = PERF_TYPE_HW_CACHE;
+        attr.config = PERF_COUNT_HW_CACHE_DTLB | (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                      (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+        break;
+    case PerfEvent::BRANCH_MISSES:
+        attr.type = PERF_TYPE_HARDWARE;
+        attr.config = PERF_COUNT_HW_BRANCH_MISSES;
+        break;
+    case PerfEvent::FRONTEND_STALLS:
+        attr.type = PERF_TYPE_HARDWARE;
+        attr.config = PERF_COUNT_HW_STALLED_CYCLES_FRONTEND;
+        break;
+    case PerfEvent::ICACHE_MISSES:
+        attr.type = PERF_TYPE_HW_CACHE;
+        attr.config = PERF_COUNT_HW_CACHE_L1I | (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                      (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+        break;
+    }
+}
+
+} // namespace
+
+PerfCounter::PerfCounter(PerfEvent event) : fd_(-1) {
+    perf_event_attr attr;
+    std::memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.disabled = 1;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    configure_event(event, attr);
+
+    // pid 0 / cpu -1: follow the calling thread on whichever core it runs
+    fd_ = static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+}
+
+PerfCounter::~PerfCounter() {
+    if (fd_ >= 0) {
+        close(fd_);
+    }
+}
+
+void PerfCounter::start() {
+    if (fd_ < 0) {
+        return;
+    }
+    ioctl(fd_, PERF_EVENT_IOC_RESET, 0);
+    ioctl(fd_, PERF_EVENT_IOC_ENABLE, 0);
+}
+
+uint64_t PerfCounter::stop() {
+    if (fd_ < 0) {
+        return 0;
+    }
+    ioctl(fd_, PERF_EVENT_IOC_DISABLE, 0);
+    return read();
+}
+
+uint64_t PerfCounter::read() const {
+    if (fd_ < 0) {
+        return 0;
+    }
+    uint64_t count = 0;
+    if (::read(fd_, &count, sizeof(count)) != static_cast<ssize_t>(sizeof(count))) {
+        return 0;
+    }
+    return count;
+}
+
+} // namespace cm5_peripheral_test
@@ -0,0 +1,335 @@
+/**
+ * @file sdc_screen.cpp
+ * @brief Implementation of silent data corruption screening.
+ * @author Sandesh Ghimire | sandesh@soccentric
+ * @copyright (C) Soccentric LLC. All rights reserved.
+ */
+
+#include "sdc_screen.h"
+#include "cpu_affinity.h"
+#include "crypto_benchmark.h"
+#include <array>
+#include <atomic>
+#include <cmath>
+#include <cstring>
+#include <thread>
+
+namespace cm5_peripheral_test {
+
+namespace {
+
+/** Seeded runs per kernel in each round, after the golden check. */
+constexpr int SDC_ROUND_RUNS = 16;
+
+/** Iterations of the scalar kernels. */
+constexpr int SDC_SCALAR_ITERATIONS = 2048;
+
+/** Iterations of the SIMD kernel (16 lanes each). */
+constexpr int SDC_VECTOR_ITERATIONS = 512;
+
+/** Bytes checksummed by the CRC kernel. */
+constexpr size_t SDC_CRC_BYTES = 4096;
+
+/** Words generated and checksummed per CRC update; the CRC is folded into the digest after each. */
+constexpr size_t SDC_CRC_WORDS_PER_UPDATE = 64;
+
+/** Blocks chained through AES and the carry-less multiply by the crypto kernel. */
+constexpr int SDC_CRYPTO_BLOCKS = 256;
+
+/**
+ * @brief Digests of each kernel for SDC_GOLDEN_SEED, indexed by SdcKernel.
+ *
+ * Regenerate with run_sdc_kernel(kernel, SDC_GOLDEN_SEED) on a known-good
+ * machine whenever a kernel changes.
+ */
+constexpr uint64_t SDC_GOLDEN_DIGESTS[SDC_KERNEL_COUNT] = {
+    0x03BBF49C1E140D57ULL, // INTEGER
+    0x397807F12979F263ULL, // FLOAT
+    0x6787A7208F28C68DULL, // SIMD
+    0x98938C76578149E9ULL, // CRC32C
+    0x9257FEE0014F4ACFULL, // CRYPTO
+};
+
+typedef uint32_t u32x4 __attribute__((vector_size(16)));
+typedef float f32x4 __attribute__((vector_size(16)));
+
+uint64_t splitmix64(uint64_t x) {
+    x += 0x9E3779B97F4A7C15ULL;
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+    return x ^ (x >> 31);
+}
+
+/**
+ * @brief Folds a value into a running digest (FNV-1a style with rotate).
+ */
+inline uint64_t fold(uint64_t digest, uint64_t value) {
+    digest ^= value;
+    digest *= 0x100000001B3ULL;
+    return (digest << 23) | (digest >> 41);
+}
+
+inline uint64_t bits_of(double value) {
+    uint64_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+uint64_t integer_kernel(uint64_t seed) {
+    uint64_t x = splitmix64(seed);
+    uint64_t digest = 0xCBF29CE484222325ULL;
+    for (int i = 0; i < SDC_SCALAR_ITERATIONS; ++i) {
+        x = x * 0x9E3779B97F4A7C15ULL + static_cast<uint64_t>(i);
+        uint64_t rotated = (x << 17) | (x >> 47);
+        uint64_t quotient = rotated / ((x >> 40) | 1);
+        uint64_t count = static_cast<uint64_t>(__builtin_popcountll(x ^ quotient));
+        x ^= quotient + count;
+        digest = fold(digest, x);
+    }
+    return digest;
+}
+
+uint64_t float_kernel(uint64_t seed) {
+    uint64_t x = splitmix64(seed);
+    // Inputs in [1, 2), [0.5, 0.75) and [1, 2); each step keeps them bounded.
+    // Multiply-adds are explicit std::fma and every other expression is a
+    // single operation, so contraction settings cannot change the result.
+    double a = 1.0 + static_cast<double>(x & 0xFFFFF) / 1048576.0;
+    double b = 0.5 + static_cast<double>((x >> 20) & 0xFFFFF) / 4194304.0;
+    double c = 1.0 + static_cast<double>((x >> 40) & 0xFFFFF) / 1048576.0;
+    uint64_t digest = 0xCBF29CE484222325ULL;
+    for (int i = 0; i < SDC_SCALAR_ITERATIONS; ++i) {
+        a = std::fma(a, b, 0.5);
+        double q = c / a;
+        double s = std::sqrt(a + q);
+        double frac = s - std::floor(s);
+        b = std::fma(frac, 0.25, 0.5);
+        c = q + 1.0;
+        digest = fold(digest, bits_of(a) ^ bits_of(s));
+    }
+    return digest;
+}
+
+uint64_t simd_kernel(uint64_t seed) {
+    u32x4 u[4];
+    f32x4 f[4];
+    const u32x4 multiplier = {0x9E3779B1u, 0x85EBCA77u, 0xC2B2AE3Du, 0x27D4EB2Fu};
+    const f32x4 gain = {0.5f, 0.625f, 0.75f, 0.875f};
+    const f32x4 offset = {0.25f, 0.125f, 0.0625f, 0.03125f};
+    const f32x4 scale = {1.0f / 4096, 1.0f / 4096, 1.0f / 4096, 1.0f / 4096};
+
+    uint64_t x = splitmix64(seed);
+    for (int v = 0; v < 4; ++v) {
+        for (int lane = 0; lane < 4; ++lane) {
+            x = splitmix64(x);
+            u[v][lane] = static_cast<uint32_t>(x);
+            f[v][lane] = static_cast<float>(x >> 40) / 16777216.0f;
+        }
+    }
+
+    for (int i = 0; i < SDC_VECTOR_ITERATIONS; ++i) {
+        for (int v = 0; v < 4; ++v) {
+            u[v] = u[v] * multiplier + (u[v] >> 7);
+            u[v] ^= (u[v] << 13) | (u[v] >> 19);
+            f32x4 noise = __builtin_convertvector(u[v] & 0xFFu, f32x4);
+            noise = noise * scale;
+            f32x4 product = f[v] * gain;
+            f[v] = product + offset;
+            f[v] = f[v] + noise;
+        }
+    }
+
+    uint64_t digest = 0xCBF29CE484222325ULL;
+    for (int v = 0; v < 4; ++v) {
+        uint64_t lanes[4];
+        std::memcpy(lanes, &u[v], sizeof(u[v]));
+        std::memcpy(lanes + 2, &f[v], sizeof(f[v]));
+        for (uint64_t lane : lanes) {
+            digest = fold(digest, lane);
+        }
+    }
+    return digest;
+}
+
+uint64_t crc32c_kernel(uint64_t seed) {
+    uint64_t x = splitmix64(seed);
+    uint32_t crc = 0xFFFFFFFFu;
+    uint64_t digest = 0xCBF29CE484222325ULL;
+    uint64_t words[SDC_CRC_WORDS_PER_UPDATE];
+    for (size_t done = 0; done < SDC_CRC_BYTES / sizeof(uint64_t); done += SDC_CRC_WORDS_PER_UPDATE) {
+        for (uint64_t& word : words) {
+            x ^= x << 13;
+            x ^= x >> 7;
+            x ^= x << 17;
+            word = x;
+        }
+        crc = crc32c_update(CryptoImpl::ACCELERATED, crc, reinterpret_cast<const uint8_t*>(words), sizeof(words));
+        digest = fold(digest, crc);
+    }
+    return fold(digest, crc ^ 0xFFFFFFFFu);
+}
+
+uint64_t crypto_kernel(uint64_t seed) {
+    uint64_t words[2] = {splitmix64(seed), splitmix64(seed + 1)};
+    uint8_t round_keys[AES128_SCHEDULE_BYTES];
+    aes128_expand_key(reinterpret_cast<const uint8_t*>(words), round_keys);
+
+    // The carry-less product of each ciphertext's halves is mixed back into
+    // it to form the next plaintext, so an error in either unit propagates
+    uint8_t block[16];
+    words[0] = splitmix64(words[1]);
+    words[1] = splitmix64(words[0]);
+    std::memcpy(block, words, sizeof(block));
+    uint64_t digest = 0xCBF29CE484222325ULL;
+    for (int i = 0; i < SDC_CRYPTO_BLOCKS; ++i) {
+        aes128_encrypt_block(CryptoImpl::ACCELERATED, round_keys, block, block);
+        std::memcpy(words, block, sizeof(words));
+        uint64_t lo = 0;
+        uint64_t hi = 0;
+        clmul64(CryptoImpl::ACCELERATED, words[0], words[1], lo, hi);
+        digest = fold(fold(digest, words[0] ^ words[1]), lo ^ hi);
+        words[0] ^= hi;
+        words[1] ^= lo;
+        std::memcpy(block, words, sizeof(block));
+    }
+    return digest;
+}
+
+/**
+ * @brief Per-core results, written only by that core's worker.
+ */
+struct SdcWorkerLog {
+    std::vector<std::array<uint64_t, SDC_KERNEL_COUNT>> round_digests;
+    std::vector<SdcMismatch> golden_failures;
+    uint64_t runs = 0;
+};
+
+} // namespace
+
+const char* sdc_kernel_name(SdcKernel kernel) {
+    switch (kernel) {
+    case SdcKernel::INTEGER: return "integer";
+    case SdcKernel::FLOAT: return "float";
+    case SdcKernel::SIMD: return "simd";
+    case SdcKernel::CRC32C: return "crc32c";
+    case SdcKernel::CRYPTO: return "crypto";
+    }
+    return "unknown";
+}
+
+uint64_t run_sdc_kernel(SdcKernel kernel, uint64_t seed) {
+    switch (kernel) {
+    case SdcKernel::INTEGER: return integer_kernel(seed);
+    case SdcKernel::FLOAT: return float_kernel(seed);
+    case SdcKernel::SIMD: return simd_kernel(seed);
+    case SdcKernel::CRC32C: return crc32c_kernel(seed);
+    case SdcKernel::CRYPTO: return crypto_kernel(seed);
+    }
+    return 0;
+}
+
+uint64_t sdc_golden_digest(SdcKernel kernel) {
+    return SDC_GOLDEN_DIGESTS[static_cast<size_t>(kernel)];
+}
+
+bool sdc_kernel_accelerated(SdcKernel kernel) {
+    static const CryptoFeatures features = detect_crypto_features();
+    switch (kernel) {
+    case SdcKernel::CRC32C: return crypto_accelerated(CryptoAlgorithm::CRC32C, features);
+    case SdcKernel::CRYPTO: return crypto_accelerated(CryptoAlgorithm::AES_GCM, features);
+    case SdcKernel::INTEGER:
+    case SdcKernel::FLOAT:
+    case SdcKernel::SIMD: return false;
+    }
+    return false;
+}
+
+SdcScreenResult run_sdc_screen(const std::vector<int>& cpus, std::chrono::milliseconds duration) {
+    SdcScreenResult result;
+    result.cpus = cpus;
+    if (cpus.empty()) {
+        return result;
+    }
+
+    std::vector<SdcWorkerLog> logs(cpus.size());
+    std::atomic<bool> stop{false};
+    std::vector<std::thread> threads;
+
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < cpus.size(); ++i) {
+        threads.emplace_back([&, i]() {
+            pin_current_thread(cpus[i]);
+            SdcWorkerLog& log = logs[i];
+
+            for (uint64_t round = 0; !stop.load(std::memory_order_relaxed); ++round) {
+                std::array<uint64_t, SDC_KERNEL_COUNT> digests{};
+                for (size_t k = 0; k < SDC_KERNEL_COUNT; ++k) {
+                    SdcKernel kernel = static_cast<SdcKernel>(k);
+
+                    uint64_t golden = run_sdc_kernel(kernel, SDC_GOLDEN_SEED);
+                    if (golden != SDC_GOLDEN_DIGESTS[k]) {
+                        log.golden_failures.push_back({cpus[i], kernel, round, true, SDC_GOLDEN_DIGESTS[k], golden});
+                    }
+
+                    uint64_t digest = 0;
+                    for (int run = 0; run < SDC_ROUND_RUNS; ++run) {
+                        uint64_t seed = splitmix64(round * SDC_ROUND_RUNS + run);
+                        digest = fold(digest, run_sdc_kernel(kernel, seed));
+                    }
+                    digests[k] = digest;
+                    log.runs += SDC_ROUND_RUNS + 1;
+                }
+                log.round_digests.push_back(digests);
+            }
+        });
+    }
+
+    std::this_thread::sleep_for(duration);
+    stop.store(true);
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+    size_t common_rounds = logs.front().round_digests.size();
+    for (const auto& log : logs) {
+        result.rounds.push_back(log.round_digests.size());
+        result.kernel_runs += log.runs;
+        common_rounds = std::min(common_rounds, log.round_digests.size());
+        result.mismatches.insert(result.mismatches.end(), log.golden_failures.begin(), log.golden_failures.end());
+    }
+    result.runs_per_second = elapsed.count() > 0 ? result.kernel_runs / elapsed.count() : 0.0;
+
+    // Cross-check: the most common digest is taken as correct, the rest
+    // are attributed to the cores that produced them
+    if (logs.size() > 1) {
+        result.rounds_compared = common_rounds;
+        for (size_t round = 0; round < common_rounds; ++round) {
+            for (size_t k = 0; k < SDC_KERNEL_COUNT; ++k) {
+                uint64_t majority = logs.front().round_digests[round][k];
+                size_t best_votes = 0;
+                for (const auto& candidate : logs) {
+                    uint64_t value = candidate.round_digests[round][k];
+                    size_t votes = 0;
+                    for (const auto& other : logs) {
+                        votes += other.round_digests[round][k] == value ? 1 : 0;
+                    }
+                    if (votes > best_votes) {
+                        best_votes = votes;
+                        majority = value;
+                    }
+                }
+                for (size_t i = 0; i < logs.size(); ++i) {
+                    uint64_t value = logs[i].round_digests[round][k];
+                    if (value != majority) {
+                        result.mismatches.push_back({cpus[i], static_cast<SdcKernel>(k), round, false, majority, value});
+                    }
+                }
+            }
+        }
+    }
+
+    return result;
+}
+
+} // namespace cm5_peripheral_test
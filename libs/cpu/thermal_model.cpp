@@ -0,0 +1,263 @@
+/**
+ * @file thermal_model.cpp
+ * @brief Implementation of the online thermal model.
+ * @author Sandesh Ghimire | sandesh@soccentric
+ * @copyright (C) Soccentric LLC. All rights reserved.
+ */
+
+#include "thermal_model.h"
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <limits>
+#include <sstream>
+
+namespace cm5_peripheral_test {
+
+namespace {
+
+/** Sample pairs needed before a fit is reported. */
+constexpr size_t THERMAL_MIN_SAMPLES = 10;
+
+/** Load variance below which ambient and rise cannot be told apart. */
+constexpr double THERMAL_MIN_LOAD_VARIANCE = 0.005;
+
+/** Pivots smaller than this fraction of the diagonal are treated as singular. */
+constexpr double THERMAL_PIVOT_TOLERANCE = 1e-12;
+
+/**
+ * @brief Solves the leading n x n block of A x = b by Gaussian elimination.
+ * @return false if the block is singular.
+ */
+bool solve(const double (&a_in)[3][3], const double (&b_in)[3], int n, double (&x)[3]) {
+    double a[3][3];
+    double b[3];
+    double scale = 0.0;
+    for (int i = 0; i < n; ++i) {
+        for (int j = 0; j < n; ++j) {
+            a[i][j] = a_in[i][j];
+        }
+        b[i] = b_in[i];
+        scale = std::max(scale, std::fabs(a[i][i]));
+    }
+
+    for (int column = 0; column < n; ++column) {
+        int pivot = column;
+        for (int row = column + 1; row < n; ++row) {
+            if (std::fabs(a[row][column]) > std::fabs(a[pivot][column])) {
+                pivot = row;
+            }
+        }
+        if (std::fabs(a[pivot][column]) <= THERMAL_PIVOT_TOLERANCE * scale) {
+            return false;
+        }
+        std::swap(a[column], a[pivot]);
+        std::swap(b[column], b[pivot]);
+        for (int row = column + 1; row < n; ++row) {
+            double factor = a[row][column] / a[column][column];
+            for (int j = column; j < n; ++j) {
+                a[row][j] -= factor * a[column][j];
+            }
+            b[row] -= factor * b[column];
+        }
+    }
+    for (int row = n - 1; row >= 0; --row) {
+        double value = b[row];
+        for (int j = row + 1; j < n; ++j) {
+            value -= a[row][j] * x[j];
+        }
+        x[row] = value / a[row][row];
+    }
+    return true;
+}
+
+bool read_number(const std::string& path, double& value) {
+    std::ifstream file(path);
+    return static_cast<bool>(file >> value);
+}
+
+} // namespace
+
+void ThermalModel::add_sample(double time_s, double temperature_c, double load) {
+    if (readings_ > 0) {
+        double x[3] = {previous_temp_, 1.0, std::min(std::max(load, 0.0), 1.0)};
+        for (int i = 0; i < 3; ++i) {
+            for (int j = 0; j < 3; ++j) {
+                sums_[i][j] += x[i] * x[j];
+            }
+            targets_[i] += x[i] * temperature_c;
+        }
+        target_squares_ += temperature_c * temperature_c;
+        elapsed_ += time_s - previous_time_;
+    }
+    previous_time_ = time_s;
+    previous_temp_ = temperature_c;
+    ++readings_;
+}
+
+ThermalFit ThermalModel::fit() const {
+    ThermalFit fit;
+    fit.samples = readings_ > 0 ? readings_ - 1 : 0;
+    if (fit.samples < THERMAL_MIN_SAMPLES || elapsed_ <= 0.0) {
+        return fit;
+    }
+
+    double n = static_cast<double>(fit.samples);
+    fit.interval_s = elapsed_ / n;
+    fit.mean_load = sums_[1][2] / n;
+    double load_variance = sums_[2][2] / n - fit.mean_load * fit.mean_load;
+
+    // T[k+1] = a T[k] + c0 + c1 u[k]; drop the load term when it is constant
+    int terms = load_variance >= THERMAL_MIN_LOAD_VARIANCE ? 3 : 2;
+    double theta[3] = {0.0, 0.0, 0.0};
+    if (!solve(sums_, targets_, terms, theta)) {
+        return fit;
+    }
+    double a = theta[0];
+    if (!(a > 0.0 && a < 1.0)) {
+        return fit;
+    }
+
+    fit.valid = true;
+    fit.load_separable = terms == 3;
+    fit.tau_s = -fit.interval_s / std::log(a);
+    if (fit.load_separable) {
+        fit.ambient_c = theta[1] / (1.0 - a);
+        fit.rise_c = theta[2] / (1.0 - a);
+        fit.steady_state_c = fit.ambient_c + fit.rise_c * fit.mean_load;
+    } else {
+        fit.steady_state_c = theta[1] / (1.0 - a);
+    }
+
+    // Residual sum of squares from the normal-equation sums
+    double sse = target_squares_;
+    for (int i = 0; i < terms; ++i) {
+        sse -= 2.0 * theta[i] * targets_[i];
+        for (int j = 0; j < terms; ++j) {
+            sse += theta[i] * sums_[i][j] * theta[j];
+        }
+    }
+    fit.rms_error_c = std::sqrt(std::max(sse, 0.0) / n);
+    return fit;
+}
+
+double predict_time_to_limit(const ThermalFit& fit, double temperature_c, double load, double limit_c) {
+    if (temperature_c >= limit_c) {
+        return 0.0;
+    }
+    double steady = fit.load_separable ? fit.ambient_c + fit.rise_c * std::min(std::max(load, 0.0), 1.0)
+                                       : fit.steady_state_c;
+    if (!fit.valid || steady <= limit_c) {
+        return std::numeric_limits<double>::infinity();
+    }
+    return fit.tau_s * std::log((steady - temperature_c) / (steady - limit_c));
+}
+
+std::string format_thermal_prediction(const ThermalFit& fit, double temperature_c, double load, double limit_c) {
+    std::stringstream out;
+    out << std::fixed << std::setprecision(1);
+    if (!fit.valid) {
+        out << "Thermal model: not fitted (no first-order response in " << fit.samples << " samples)\n";
+        return out.str();
+    }
+
+    out << "Thermal model: tau " << std::setprecision(0) << fit.tau_s << " s" << std::setprecision(1);
+    if (fit.load_separable) {
+        out << ", ambient " << fit.ambient_c << "°C, full-load rise " << fit.rise_c << "°C";
+    }
+    out << ", steady state " << fit.steady_state_c << "°C at " << std::setprecision(0) << fit.mean_load * 100.0
+        << "% load" << std::setprecision(2) << " (RMS error " << fit.rms_error_c << "°C, " << fit.samples
+        << " samples)\n" << std::setprecision(1);
+
+    auto describe = [&](double hold_load) {
+        double seconds = predict_time_to_limit(fit, temperature_c, hold_load, limit_c);
+        std::stringstream text;
+        text << std::fixed << std::setprecision(1);
+        if (std::isinf(seconds)) {
+            text << "not reached";
+        } else if (seconds == 0.0) {
+            text << "already reached";
+        } else {
+            text << "in " << seconds / 60.0 << " min";
+        }
+        return text.str();
+    };
+    out << "Trip point " << limit_c << "°C: " << describe(load) << " at " << std::setprecision(0) << load * 100.0
+        << "% load";
+    if (fit.load_separable) {
+        out << ", " << describe(1.0) << " at full load";
+    }
+    out << "\n";
+    return out.str();
+}
+
+double read_trip_point(const std::string& zone_path) {
+    double lowest_passive = -1.0;
+    double lowest_any = -1.0;
+    for (int index = 0;; ++index) {
+        std::string prefix = zone_path + "/trip_point_" + std::to_string(index);
+        std::ifstream type_file(prefix + "_type");
+        double millidegrees = 0.0;
+        if (!type_file.is_open() || !read_number(prefix + "_temp", millidegrees)) {
+            break;
+        }
+        std::string type;
+        type_file >> type;
+        double celsius = millidegrees / 1000.0;
+        if (type == "passive" && (lowest_passive < 0 || celsius < lowest_passive)) {
+            lowest_passive = celsius;
+        }
+        if (lowest_any < 0 || celsius < lowest_any) {
+            lowest_any = celsius;
+        }
+    }
+    return lowest_passive >= 0 ? lowest_passive : lowest_any;
+}
+
+SystemLoadSampler::SystemLoadSampler(const std::string& proc_root) : stat_path_(proc_root + "/stat") {
+    valid_ = read(busy_, total_);
+}
+
+double SystemLoadSampler::sample() {
+    uint64_t busy = 0;
+    uint64_t total = 0;
+    if (!read(busy, total)) {
+        return -1.0;
+    }
+    double load = -1.0;
+    if (valid_ && total > total_) {
+        load = static_cast<double>(busy - busy_) / static_cast<double>(total - total_);
+    } else if (valid_) {
+        load = 0.0;
+    }
+    busy_ = busy;
+    total_ = total;
+    valid_ = true;
+    return load;
+}
+
+bool SystemLoadSampler::read(uint64_t& busy, uint64_t& total) const {
+    std::ifstream file(stat_path_);
+    std::string line;
+    if (!std::getline(file, line) || line.compare(0, 4, "cpu ") != 0) {
+        return false;
+    }
+    // user nice system idle iowait irq softirq steal; guest time is
+    // already included in user
+    std::istringstream fields(line.substr(4));
+    uint64_t values[8] = {};
+    for (uint64_t& value : values) {
+        if (!(fields >> value)) {
+            return false;
+        }
+    }
+    total = 0;
+    for (uint64_t value : values) {
+        total += value;
+    }
+    busy = total - values[3] - values[4];
+    return true;
+}
+
+} // namespace cm5_peripheral_test
@@ -0,0 +1,329 @@
+/**
+ * @file thread_benchmark.cpp
+ * @brief Implementation of the thread lifecycle and synchronization cost benchmarks.
+ * @author Sandesh Ghimire | sandesh@soccentric
+ * @copyright (C) Soccentric LLC. All rights reserved.
+ */
+
+#include "thread_benchmark.h"
+#include "cache_line.h"
+#include "cpu_affinity.h"
+#include "fast_clock.h"
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <linux/futex.h>
+#include <pthread.h>
+#include <sys/eventfd.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+namespace cm5_peripheral_test {
+
+namespace {
+
+/** Untimed rounds run first so thread stacks and kernel objects are warm. */
+constexpr uint64_t THREAD_WARMUP_ROUNDS = 16;
+
+/**
+ * @brief Token slot signalled through a mutex and condition variable.
+ */
+struct alignas(CACHE_LINE_SIZE) CondvarSlot {
+    std::mutex mutex;
+    std::condition_variable ready;
+    uint64_t posted = 0;
+    uint64_t taken = 0;
+};
+
+class CondvarChannel {
+public:
+    explicit CondvarChannel(size_t slots) : slots_(new CondvarSlot[slots]) {}
+
+    void post(size_t slot) {
+        CondvarSlot& target = slots_[slot];
+        {
+            std::lock_guard<std::mutex> guard(target.mutex);
+            ++target.posted;
+        }
+        target.ready.notify_one();
+    }
+
+    void wait(size_t slot) {
+        CondvarSlot& own = slots_[slot];
+        std::unique_lock<std::mutex> lock(own.mutex);
+        own.ready.wait(lock, [&own]() { return own.posted != own.taken; });
+        ++own.taken;
+    }
+
+private:
+    std::unique_ptr<CondvarSlot[]> slots_;
+};
+
+/**
+ * @brief Token slot signalled through a raw futex word.
+ */
+struct alignas(CACHE_LINE_SIZE) FutexSlot {
+    std::atomic<uint32_t> posted{0};
+    uint32_t taken = 0;  /**< Only touched by the owning thread */
+};
+
+static_assert(sizeof(std::atomic<uint32_t>) == sizeof(uint32_t), "futex word must be a plain 32-bit integer");
+
+class FutexChannel {
+public:
+    explicit FutexChannel(size_t slots) : slots_(new FutexSlot[slots]) {}
+
+    void post(size_t slot) {
+        FutexSlot& target = slots_[slot];
+        target.posted.fetch_add(1, std::memory_order_release);
+        syscall(SYS_futex, word(target), FUTEX_WAKE_PRIVATE, 1, nullptr, nullptr, 0);
+    }
+
+    void wait(size_t slot) {
+        FutexSlot& own = slots_[slot];
+        // FUTEX_WAIT returns at once if the word no longer holds the value
+        while (own.posted.load(std::memory_order_acquire) == own.taken) {
+            syscall(SYS_futex, word(own), FUTEX_WAIT_PRIVATE, own.taken, nullptr, nullptr, 0);
+        }
+        ++own.taken;
+    }
+
+private:
+    static uint32_t* word(FutexSlot& slot) { return reinterpret_cast<uint32_t*>(&slot.posted); }
+
+    std::unique_ptr<FutexSlot[]> slots_;
+};
+
+class EventfdChannel {
+public:
+    explicit EventfdChannel(size_t slots) : fds_(slots, -1) {
+        for (int& fd : fds_) {
+            fd = eventfd(0, EFD_CLOEXEC);
+        }
+    }
+
+    ~EventfdChannel() {
+        for (int fd : fds_) {
+            if (fd >= 0) {
+                close(fd);
+            }
+        }
+    }
+
+    EventfdChannel(const EventfdChannel&) = delete;
+    EventfdChannel& operator=(const EventfdChannel&) = delete;
+
+    bool is_open() const {
+        return std::all_of(fds_.begin(), fds_.end(), [](int fd) { return fd >= 0; });
+    }
+
+    void post(size_t slot) {
+        uint64_t one = 1;
+        while (write(fds_[slot], &one, sizeof(one)) < 0 && errno == EINTR) {
+        }
+    }
+
+    void wait(size_t slot) {
+        uint64_t value = 0;
+        while (read(fds_[slot], &value, sizeof(value)) < 0 && errno == EINTR) {
+        }
+    }
+
+private:
+    std::vector<int> fds_;
+};
+
+/**
+ * @brief Passes a token around @p threads pinned threads.
+ *
+ * Thread 0 times each lap; every other thread blocks on its own slot,
+ * then posts to the next one. Returns the per-hop cost of each timed lap.
+ */
+template <typename Channel>
+std::vector<double> run_token_ring(Channel& channel, const std::vector<int>& cpus, int threads, uint64_t rounds,
+                                   bool& completed) {
+    const FastClock& clock = FastClock::instance();
+    const uint64_t total = THREAD_WARMUP_ROUNDS + rounds;
+    std::vector<double> samples;
+    samples.reserve(rounds);
+    std::atomic<uint64_t> hops{0};
+    std::vector<std::thread> workers;
+
+    for (int i = 0; i < threads; ++i) {
+        workers.emplace_back([&, i]() {
+            pin_current_thread(cpus[i % cpus.size()]);
+            size_t next = static_cast<size_t>((i + 1) % threads);
+            for (uint64_t round = 0; round < total; ++round) {
+                if (i == 0) {
+                    uint64_t begin = clock.ticks();
+                    channel.post(next);
+                    channel.wait(0);
+                    if (round >= THREAD_WARMUP_ROUNDS) {
+                        samples.push_back(clock.ticks_to_ns(clock.ticks() - begin) / threads);
+                    }
+                } else {
+                    channel.wait(static_cast<size_t>(i));
+                    channel.post(next);
+                }
+                hops.fetch_add(1, std::memory_order_relaxed);
+            }
+        });
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+
+    completed = hops.load() == total * threads;
+    return samples;
+}
+
+/**
+ * @brief Crosses a pthread barrier @p rounds times; thread 0 times each crossing.
+ */
+std::vector<double> run_barrier(const std::vector<int>& cpus, int threads, uint64_t rounds, bool& completed) {
+    const FastClock& clock = FastClock::instance();
+    const uint64_t total = THREAD_WARMUP_ROUNDS + rounds;
+    std::vector<double> samples;
+    samples.reserve(rounds);
+
+    pthread_barrier_t barrier;
+    if (pthread_barrier_init(&barrier, nullptr, static_cast<unsigned>(threads)) != 0) {
+        completed = false;
+        return samples;
+    }
+
+    std::atomic<uint64_t> serial{0};
+    std::vector<std::thread> workers;
+    for (int i = 0; i < threads; ++i) {
+        workers.emplace_back([&, i]() {
+            pin_current_thread(cpus[i % cpus.size()]);
+            uint64_t previous = clock.ticks();
+            for (uint64_t round = 0; round < total; ++round) {
+                if (pthread_barrier_wait(&barrier) == PTHREAD_BARRIER_SERIAL_THREAD) {
+                    serial.fetch_add(1, std::memory_order_relaxed);
+                }
+                if (i == 0) {
+                    uint64_t now = clock.ticks();
+                    if (round >= THREAD_WARMUP_ROUNDS) {
+                        samples.push_back(clock.ticks_to_ns(now - previous));
+                    }
+                    previous = now;
+                }
+            }
+        });
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+    pthread_barrier_destroy(&barrier);
+
+    // Exactly one thread per crossing is told it was the last to arrive
+    completed = serial.load() == total;
+    return samples;
+}
+
+/**
+ * @brief Creates and joins @p threads threads per round from a driver
+ *        thread whose affinity (inherited by the children) is @p cpus.
+ */
+std::vector<double> run_create_join(const std::vector<int>& cpus, int threads, uint64_t rounds, bool& completed) {
+    const FastClock& clock = FastClock::instance();
+    const uint64_t total = THREAD_WARMUP_ROUNDS + rounds;
+    std::vector<double> samples;
+    samples.reserve(rounds);
+    std::atomic<uint64_t> started{0};
+
+    std::thread driver([&]() {
+        set_current_thread_cpus(cpus);
+        std::vector<std::thread> children;
+        children.reserve(threads);
+        for (uint64_t round = 0; round < total; ++round) {
+            uint64_t begin = clock.ticks();
+            for (int i = 0; i < threads; ++i) {
+                children.emplace_back([&started]() { started.fetch_add(1, std::memory_order_relaxed); });
+            }
+            for (auto& child : children) {
+                child.join();
+            }
+            uint64_t end = clock.ticks();
+            children.clear();
+            if (round >= THREAD_WARMUP_ROUNDS) {
+                samples.push_back(clock.ticks_to_ns(end - begin) / threads);
+            }
+        }
+    });
+    driver.join();
+
+    completed = started.load() == total * threads;
+    return samples;
+}
+
+} // namespace
+
+const char* thread_operation_name(ThreadOperation operation) {
+    switch (operation) {
+    case ThreadOperation::CREATE_JOIN: return "create/join";
+    case ThreadOperation::CONDVAR_HANDOFF: return "condvar handoff";
+    case ThreadOperation::FUTEX: return "futex wake";
+    case ThreadOperation::BARRIER: return "barrier crossing";
+    case ThreadOperation::EVENTFD: return "eventfd signal";
+    }
+    return "unknown";
+}
+
+ThreadCostResult run_thread_benchmark(ThreadOperation operation, const std::vector<int>& cpus, int threads,
+                                      uint64_t rounds) {
+    ThreadCostResult result;
+    result.operation = operation;
+    result.threads = std::max(threads, 2);
+    if (cpus.empty() || rounds == 0) {
+        return result;
+    }
+
+    bool completed = false;
+    std::vector<double> samples;
+    switch (operation) {
+    case ThreadOperation::CREATE_JOIN:
+        samples = run_create_join(cpus, result.threads, rounds, completed);
+        break;
+    case ThreadOperation::CONDVAR_HANDOFF: {
+        CondvarChannel channel(result.threads);
+        samples = run_token_ring(channel, cpus, result.threads, rounds, completed);
+        break;
+    }
+    case ThreadOperation::FUTEX: {
+        FutexChannel channel(result.threads);
+        samples = run_token_ring(channel, cpus, result.threads, rounds, completed);
+        break;
+    }
+    case ThreadOperation::BARRIER:
+        samples = run_barrier(cpus, result.threads, rounds, completed);
+        break;
+    case ThreadOperation::EVENTFD: {
+        EventfdChannel channel(result.threads);
+        if (!channel.is_open()) {
+            return result;
+        }
+        samples = run_token_ring(channel, cpus, result.threads, rounds, completed);
+        break;
+    }
+    }
+
+    result.rounds = samples.size();
+    result.completed = completed && samples.size() == rounds;
+    if (samples.empty()) {
+        return result;
+    }
+
+    std::sort(samples.begin(), samples.end());
+    result.median_ns = samples[samples.size() / 2];
+    result.p99_ns = samples[std::min(samples.size() - 1, samples.size() * 99 / 100)];
+    result.max_ns = samples.back();
+    return result;
+}
+
+} // namespace cm5_peripheral_test
@@ -0,0 +1,198 @@
+/**
+ * @file tlb_benchmark.cpp
+ * @brief Implementation of the TLB and huge-page benchmark.
+ * @author Sandesh Ghimire | sandesh@soccentric
+ * @copyright (C) Soccentric LLC. All rights reserved.
+ */
+
+#include "tlb_benchmark.h"
+#include "anonymous_mapping.h"
+#include "fast_clock.h"
+#include "perf_counter.h"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <vector>
+#include <sys/mman.h>
+#include <unistd.h>
+
+namespace cm5_peripheral_test {
+
+namespace {
+
+/** Fallback when hpage_pmd_size is not exposed. */
+constexpr size_t DEFAULT_HUGE_PAGE_SIZE = 2 * 1024 * 1024;
+
+/** Line size used to rotate the chase slot within each page. */
+constexpr size_t CHASE_LINE_SIZE = 64;
+
+size_t round_up(size_t value, size_t multiple) {
+    return (value + multiple - 1) / multiple * multiple;
+}
+
+/**
+ * @brief Links one line of every page into a single random cycle.
+ * @return Address of the first slot.
+ */
+void** build_chase(char* region, size_t pages, size_t page_size) {
+    std::vector<size_t> order(pages);
+    for (size_t i = 0; i < pages; ++i) {
+        order[i] = i;
+    }
+    uint64_t x = 0x9E3779B97F4A7C15ULL;
+    for (size_t i = pages - 1; i > 0; --i) {
+        x ^= x << 13;
+        x ^= x >> 7;
+        x ^= x << 17;
+        std::swap(order[i], order[x % (i + 1)]);
+    }
+
+    size_t lines = page_size / CHASE_LINE_SIZE;
+    auto slot = [&](size_t page) {
+        return reinterpret_cast<void**>(region + page * page_size + (page % lines) * CHASE_LINE_SIZE);
+    };
+    for (size_t i = 0; i < pages; ++i) {
+        *slot(order[i]) = slot(order[(i + 1) % pages]);
+    }
+    return slot(order[0]);
+}
+
+} // namespace
+
+const char* page_backing_name(PageBacking backing) {
+    switch (backing) {
+    case PageBacking::BASE_PAGES: return "base pages";
+    case PageBacking::TRANSPARENT_HUGE: return "THP";
+    case PageBacking::HUGETLB: return "hugetlbfs";
+    }
+    return "unknown";
+}
+
+size_t base_page_size() {
+    long size = sysconf(_SC_PAGESIZE);
+    return size > 0 ? static_cast<size_t>(size) : 4096;
+}
+
+size_t huge_page_size(const std::string& sysfs_root) {
+    std::ifstream file(sysfs_root + "/kernel/mm/transparent_hugepage/hpage_pmd_size");
+    size_t size = 0;
+    if (file >> size && size > 0) {
+        return size;
+    }
+    return DEFAULT_HUGE_PAGE_SIZE;
+}
+
+size_t anon_huge_bytes(const void* address, const std::string& smaps_path) {
+    std::ifstream file(smaps_path);
+    uintptr_t target = reinterpret_cast<uintptr_t>(address);
+    bool inside = false;
+    std::string line;
+    while (std::getline(file, line)) {
+        // Mapping headers start with "start-end"; field lines with "Name:"
+        size_t dash = line.find('-');
+        size_t space = line.find(' ');
+        if (dash != std::string::npos && space != std::string::npos && dash < space &&
+            line.find(':') > space) {
+            uintptr_t start = std::stoull(line.substr(0, dash), nullptr, 16);
+            uintptr_t end = std::stoull(line.substr(dash + 1, space - dash - 1), nullptr, 16);
+            inside = target >= start && target < end;
+            continue;
+        }
+        if (inside && line.compare(0, 14, "AnonHugePages:") == 0) {
+            std::istringstream fields(line.substr(14));
+            size_t kib = 0;
+            fields >> kib;
+            return kib * 1024;
+        }
+    }
+    return 0;
+}
+
+TlbResult run_tlb_benchmark(PageBacking backing, size_t working_set, uint64_t accesses,
+                            const ConvergenceCriteria& criteria) {
+    TlbResult result;
+    result.backing = backing;
+
+    const size_t page_size = base_page_size();
+    const size_t huge_size = huge_page_size();
+    result.pages = round_up(working_set, page_size) / page_size;
+    result.working_set = result.pages * page_size;
+    if (result.pages < 2 || accesses == 0) {
+        result.note = "working set too small";
+        return result;
+    }
+
+    AnonymousMapping mapping;
+    char* region = nullptr;
+    switch (backing) {
+    case PageBacking::BASE_PAGES:
+        if (mapping.map_base_pages(result.working_set)) {
+            region = mapping.data();
+        }
+        break;
+    case PageBacking::TRANSPARENT_HUGE:
+        // Over-allocate so the chase can start on a huge page boundary
+        if (mapping.map(round_up(result.working_set, huge_size) + huge_size)) {
+            uintptr_t aligned = round_up(reinterpret_cast<uintptr_t>(mapping.data()), huge_size);
+            region = reinterpret_cast<char*>(aligned);
+            madvise(region, round_up(result.working_set, huge_size), MADV_HUGEPAGE);
+        }
+        break;
+    case PageBacking::HUGETLB:
+        if (mapping.map(round_up(result.working_set, huge_size), MAP_HUGETLB)) {
+            region = mapping.data();
+        }
+        break;
+    }
+    if (region == nullptr) {
+        result.note = backing == PageBacking::HUGETLB ? "no hugetlbfs pages reserved (vm.nr_hugepages)"
+                                                      : "mmap failed";
+        return result;
+    }
+
+    // Populate every page before timing so faults are excluded
+    std::memset(region, 0, result.working_set);
+    void** start = build_chase(region, result.pages, page_size);
+    result.available = true;
+    result.huge_fraction = backing == PageBacking::HUGETLB
+                               ? 1.0
+                               : std::min(1.0, static_cast<double>(anon_huge_bytes(region)) / result.working_set);
+
+    // One untimed lap brings the chased lines and page tables into cache
+    void** cursor = start;
+    for (size_t i = 0; i < result.pages; ++i) {
+        cursor = static_cast<void**>(*cursor);
+    }
+
+    const FastClock& clock = FastClock::instance();
+    PerfCounter misses(PerfEvent::DTLB_MISSES);
+    uint64_t counted = 0;
+    uint64_t counted_accesses = 0;
+    result.latency = measure_until_converged([&]() {
+        misses.start();
+        uint64_t begin = clock.ticks();
+        for (uint64_t i = 0; i < accesses; ++i) {
+            cursor = static_cast<void**>(*cursor);
+        }
+        uint64_t end = clock.ticks();
+        counted += misses.stop();
+        counted_accesses += accesses;
+        return clock.ticks_to_ns(end - begin) / accesses;
+    }, criteria);
+
+    // Keep the chase live so the loop is not removed
+    if (cursor == nullptr) {
+        result.note = "broken chain";
+        result.available = false;
+        return result;
+    }
+
+    result.ns_per_access = result.latency.median;
+    if (misses.is_available() && counted_accesses > 0) {
+        result.misses_per_access = static_cast<double>(counted) / counted_accesses;
+    }
+    return result;
+}
+
+} // namespace cm5_peripheral_test
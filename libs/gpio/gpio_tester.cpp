@@ -9,6 +9,7 @@
  */
 
 #include "gpio_tester.h"
+#include "series_recorder.h"
 #include <iostream>
 #include <fstream>
 #include <sstream>
@@ -23,6 +24,19 @@ namespace cm5_peripheral_test {
 
 namespace fs = std::filesystem;
 
+namespace {
+
+/** Readings retained by the stability monitor: the last five minutes at the 100 ms cadence. */
+constexpr size_t GPIO_SERIES_CAPACITY = 3000;
+
+/** Time constant of the moving average of the pin level. */
+constexpr double GPIO_EWMA_TIME_CONSTANT_S = 10.0;
+
+/** Largest sysfs read time tracked exactly by the histogram (100 ms). */
+constexpr uint64_t GPIO_READ_HISTOGRAM_HIGHEST_NS = 100000000;
+
+} // namespace
+
 GPIOTester::GPIOTester() : gpio_available_(false) {
     // Check if GPIO sysfs is available
     gpio_available_ = fs::exists("/sys/class/gpio");
@@ -67,7 +81,7 @@ GPIOTester::~GPIOTester() {
 }
 
 TestReport GPIOTester::short_test() {
-    auto start_time = std::chrono::steady_clock::now();
+    auto start_time = begin_test();
 
     if (!gpio_available_) {
         return create_report(TestResult::NOT_SUPPORTED, "GPIO sysfs interface not available", std::chrono::milliseconds(0));
@@ -109,19 +123,34 @@ TestReport GPIOTester::short_test() {
 }
 
 TestReport GPIOTester::monitor_test(std::chrono::seconds duration) {
-    auto start_time = std::chrono::steady_clock::now();
+    auto start_time = begin_test();
 
     if (!gpio_available_) {
         return create_report(TestResult::NOT_SUPPORTED, "GPIO sysfs interface not available", std::chrono::milliseconds(0));
     }
 
-    TestResult result = monitor_gpio_stability(duration);
+    TimeSeries levels("gpio2_level", GPIO_SERIES_CAPACITY);
+    StreamingSummary level_stats("gpio2_level", GPIO_EWMA_TIME_CONSTANT_S);
+    LatencyHistogram read_latency("gpio2_read_ns", GPIO_READ_HISTOGRAM_HIGHEST_NS);
+    std::unique_ptr<SeriesRecorder> recorder;
+    if (!recording_path_.empty()) {
+        recorder.reset(new SeriesRecorder(recording_path_, {"gpio/gpio2_level", "gpio/gpio2_read_ns"}));
+    }
+    TestResult result = monitor_gpio_stability(duration, levels, level_stats, read_latency, recorder.get());
 
     auto end_time = std::chrono::steady_clock::now();
     auto test_duration = std::chrono::duration_cast<std::chrono::milliseconds>(end_time - start_time);
 
     std::string details = "GPIO monitoring completed for " + std::to_string(duration.count()) + " seconds";
-    return create_report(result, details, test_duration);
+    if (recorder) {
+        recorder->stop();
+        details += "\n" + recorder->describe();
+    }
+    TestReport report = create_report(result, details, test_duration);
+    report.series.push_back(std::move(levels));
+    report.statistics.push_back(level_stats);
+    report.histograms.push_back(std::move(read_latency));
+    return report;
 }
 
 bool GPIOTester::is_available() const {
@@ -263,7 +292,9 @@ TestResult GPIOTester::test_uart() {
     return TestResult::SUCCESS;
 }
 
-TestResult GPIOTester::monitor_gpio_stability(std::chrono::seconds duration) {
+TestResult GPIOTester::monitor_gpio_stability(std::chrono::seconds duration, TimeSeries& levels,
+                                              StreamingSummary& level_stats, LatencyHistogram& read_latency,
+                                              SeriesRecorder* recorder) {
     auto start_time = std::chrono::steady_clock::now();
     auto end_time = start_time + duration;
 
@@ -278,11 +309,23 @@ TestResult GPIOTester::monitor_gpio_stability(std::chrono::seconds duration) {
     int total_reads = 0;
 
     while (std::chrono::steady_clock::now() < end_time) {
+        auto read_start = std::chrono::steady_clock::now();
         int value = read_gpio(test_gpio);
+        auto read_end = std::chrono::steady_clock::now();
+        uint64_t read_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(read_end - read_start).count();
+        read_latency.record(read_ns);
+        if (recorder) {
+            int64_t now_ms = SeriesRecorder::now_ms();
+            recorder->record(0, now_ms, value);
+            recorder->record(1, now_ms, static_cast<double>(read_ns));
+        }
+        double elapsed = std::chrono::duration<double>(read_end - start_time).count();
         if (value != -1) {
             stable_count++;
+            level_stats.add(elapsed, value);
         }
         total_reads++;
+        levels.append(elapsed, value);
 
         std::this_thread::sleep_for(std::chrono::milliseconds(100));
     }
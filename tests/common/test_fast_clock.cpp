@@ -0,0 +1,72 @@
+/**
+ * @file test_fast_clock.cpp
+ * @brief Unit tests for the calibrated fast clock.
+ * @author Sandesh Ghimire | sandesh@soccentric
+ * @copyright (C) Soccentric LLC. All rights reserved.
+ */
+
+#include "fast_clock.h"
+#include <gtest/gtest.h>
+#include <chrono>
+#include <cstdlib>
+#include <string>
+#include <thread>
+
+namespace cm5_peripheral_test {
+
+/**
+ * @test FastClock_Calibration
+ * @brief Tests that the counter runs on the CLOCK_MONOTONIC timeline.
+ */
+TEST(FastClockTest, Calibration) {
+    const FastClock& clock = FastClock::instance();
+    EXPECT_GT(clock.frequency_hz(), 0.0);
+    EXPECT_FALSE(std::string(clock.counter_name()).empty());
+
+    int64_t offset = static_cast<int64_t>(clock.now_ns() - monotonic_ns());
+    EXPECT_LT(std::llabs(offset), 1000000);
+}
+
+/**
+ * @test FastClock_Monotonic
+ * @brief Tests that consecutive reads on one thread never go backwards.
+ */
+TEST(FastClockTest, Monotonic) {
+    const FastClock& clock = FastClock::instance();
+    uint64_t previous = clock.ticks();
+    for (int i = 0; i < 100000; ++i) {
+        uint64_t now = clock.ticks();
+        ASSERT_GE(now, previous);
+        previous = now;
+    }
+}
+
+/**
+ * @test FastClock_Conversion
+ * @brief Tests tick/ns conversion against a timed sleep.
+ */
+TEST(FastClockTest, Conversion) {
+    const FastClock& clock = FastClock::instance();
+    EXPECT_NEAR(clock.ticks_to_ns(clock.ns_to_ticks(1e6)), 1e6, 1e6 * 1e-3);
+
+    uint64_t start_ticks = clock.ticks();
+    uint64_t start_ns = monotonic_ns();
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    double measured = clock.ticks_to_ns(clock.ticks() - start_ticks);
+    double reference = static_cast<double>(monotonic_ns() - start_ns);
+    EXPECT_NEAR(measured, reference, reference * 0.01);
+}
+
+/**
+ * @test FastClock_ReadEverySource
+ * @brief Tests that every clock source can be named and read.
+ */
+TEST(FastClockTest, ReadEverySource) {
+    for (int index = 0; index < CLOCK_SOURCE_COUNT; ++index) {
+        ClockSource source = static_cast<ClockSource>(index);
+        EXPECT_STRNE(clock_source_name(source), "unknown");
+        EXPECT_GT(read_clock_ns(source), 0u);
+    }
+}
+
+} // namespace cm5_peripheral_test
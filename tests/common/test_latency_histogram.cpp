@@ -0,0 +1,171 @@
+/**
+ * @file test_latency_histogram.cpp
+ * @brief Unit tests for the log-linear latency histogram.
+ * @author Sandesh Ghimire | sandesh@soccentric
+ * @copyright (C) Soccentric LLC. All rights reserved.
+ */
+
+#include "latency_histogram.h"
+#include <gtest/gtest.h>
+#include <atomic>
+#include <cmath>
+#include <thread>
+#include <vector>
+
+namespace cm5_peripheral_test {
+
+/**
+ * @test LatencyHistogram_Percentiles
+ * @brief Tests percentile accuracy against the 2^-(bits-1) bound.
+ */
+TEST(LatencyHistogramTest, Percentiles) {
+    LatencyHistogram histogram("uniform_ns");
+    EXPECT_EQ(histogram.percentile(50.0), 0u);
+    for (uint64_t value = 1; value <= 100000; ++value) {
+        histogram.record(value);
+    }
+    EXPECT_EQ(histogram.count(), 100000u);
+    EXPECT_EQ(histogram.min(), 1u);
+    EXPECT_EQ(histogram.max(), 100000u);
+    EXPECT_DOUBLE_EQ(histogram.mean(), 50000.5);
+
+    const double bound = 1.0 / 128.0;
+    EXPECT_NEAR(histogram.percentile(50.0), 50000.0, 50000.0 * bound);
+    EXPECT_NEAR(histogram.percentile(99.0), 99000.0, 99000.0 * bound);
+    EXPECT_NEAR(histogram.percentile(99.9), 99900.0, 99900.0 * bound);
+    EXPECT_EQ(histogram.percentile(100.0), 100000u);
+    EXPECT_EQ(histogram.percentile(0.0), 1u);
+
+    // Small values have a bucket each
+    LatencyHistogram small("small_ns");
+    small.record(3);
+    small.record(7, 3);
+    EXPECT_EQ(small.percentile(25.0), 3u);
+    EXPECT_EQ(small.percentile(50.0), 7u);
+    EXPECT_LT(small.memory_bytes(), 64u * 1024u);
+}
+
+/**
+ * @test LatencyHistogram_Overflow
+ * @brief Tests that values above the highest trackable value keep an exact max.
+ */
+TEST(LatencyHistogramTest, Overflow) {
+    LatencyHistogram histogram("capped_ns", 1000);
+    size_t buckets = histogram.bucket_count();
+    histogram.record(10);
+    histogram.record(5000000);
+    EXPECT_EQ(histogram.bucket_count(), buckets);
+    EXPECT_EQ(histogram.max(), 5000000u);
+    EXPECT_EQ(histogram.percentile(100.0), 5000000u);
+    EXPECT_EQ(histogram.percentile(50.0), 10u);
+
+    histogram.reset();
+    EXPECT_EQ(histogram.count(), 0u);
+    EXPECT_EQ(histogram.min(), 0u);
+    EXPECT_EQ(histogram.max(), 0u);
+}
+
+/**
+ * @test LatencyHistogram_ConcurrentMerge
+ * @brief Tests per-thread recording merged while the owners are still recording.
+ */
+TEST(LatencyHistogramTest, ConcurrentMerge) {
+    const int threads = 4;
+    const uint64_t per_thread = 50000;
+    std::vector<LatencyHistogram> histograms;
+    for (int t = 0; t < threads; ++t) {
+        histograms.emplace_back("thread_ns");
+    }
+
+    std::atomic<int> running{threads};
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threads; ++t) {
+        workers.emplace_back([&histograms, &running, t, per_thread]() {
+            for (uint64_t i = 0; i < per_thread; ++i) {
+                histograms[t].record(1000 * (t + 1) + i % 100);
+            }
+            running.fetch_sub(1);
+        });
+    }
+
+    // Partial merges must never see more than was recorded
+    while (running.load() > 0) {
+        LatencyHistogram partial("partial_ns");
+        for (const auto& histogram : histograms) {
+            EXPECT_TRUE(partial.add(histogram));
+        }
+        EXPECT_LE(partial.count(), threads * per_thread);
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+
+    LatencyHistogram merged("merged_ns");
+    for (const auto& histogram : histograms) {
+        ASSERT_TRUE(merged.add(histogram));
+    }
+    EXPECT_EQ(merged.count(), threads * per_thread);
+    EXPECT_EQ(merged.min(), 1000u);
+    EXPECT_EQ(merged.max(), 4099u);
+    EXPECT_NEAR(merged.percentile(50.0), 2050.0, 2050.0 / 128.0 + 50.0);
+
+    LatencyHistogram coarse("coarse_ns", LatencyHistogram::DEFAULT_HIGHEST_VALUE, 4);
+    EXPECT_FALSE(coarse.add(merged));
+    EXPECT_EQ(coarse.count(), 0u);
+}
+
+/**
+ * @test LatencyHistogram_Serialization
+ * @brief Tests the compact text form round trip and malformed input.
+ */
+TEST(LatencyHistogramTest, Serialization) {
+    LatencyHistogram histogram("wakeup_ns", 1000000000);
+    histogram.record(55000, 90);
+    histogram.record(61000, 9);
+    histogram.record(900000);
+
+    std::string text = histogram.serialize();
+    EXPECT_EQ(text.rfind("hdr1/8/1000000000/55000/900000/", 0), 0u);
+    EXPECT_LT(text.size(), 64u);
+
+    LatencyHistogram restored("empty_ns");
+    ASSERT_TRUE(LatencyHistogram::deserialize("wakeup_ns", text, restored));
+    EXPECT_EQ(restored.name(), "wakeup_ns");
+    EXPECT_EQ(restored.count(), 100u);
+    EXPECT_EQ(restored.min(), 55000u);
+    EXPECT_EQ(restored.max(), 900000u);
+    EXPECT_DOUBLE_EQ(restored.mean(), histogram.mean());
+    EXPECT_EQ(restored.percentile(99.0), histogram.percentile(99.0));
+    EXPECT_EQ(restored.serialize(), text);
+
+    LatencyHistogram empty("empty_ns");
+    ASSERT_TRUE(LatencyHistogram::deserialize("empty_ns", empty.serialize(), restored));
+    EXPECT_EQ(restored.count(), 0u);
+
+    EXPECT_FALSE(LatencyHistogram::deserialize("x", "", restored));
+    EXPECT_FALSE(LatencyHistogram::deserialize("x", "hdr2/8/1000/0/0/0/", restored));
+    EXPECT_FALSE(LatencyHistogram::deserialize("x", "hdr1/8/1000/1/1/1/99999", restored));
+    EXPECT_FALSE(LatencyHistogram::deserialize("x", "hdr1/8/1000/1/1/1/3y2", restored));
+}
+
+/**
+ * @test LatencyHistogram_CopyAndSummary
+ * @brief Tests that copies are independent and the summary line.
+ */
+TEST(LatencyHistogramTest, CopyAndSummary) {
+    LatencyHistogram original("read_ns");
+    original.record(2000, 10);
+    LatencyHistogram copy = original;
+    copy.record(4000);
+    EXPECT_EQ(original.count(), 10u);
+    EXPECT_EQ(copy.count(), 11u);
+
+    LatencyHistogram moved = std::move(copy);
+    EXPECT_EQ(moved.count(), 11u);
+    EXPECT_EQ(moved.max(), 4000u);
+
+    EXPECT_EQ(original.summary(1000.0, "us"), "n 10, p50 2.0 us, p90 2.0 us, p99 2.0 us, p99.9 2.0 us, max 2.0 us");
+    EXPECT_EQ(LatencyHistogram("none").summary(), "n 0");
+}
+
+} // namespace cm5_peripheral_test
@@ -0,0 +1,99 @@
+/**
+ * @file test_measurement_harness.cpp
+ * @brief Unit tests for the adaptive repetition harness.
+ * @author Sandesh Ghimire | sandesh@soccentric
+ * @copyright (C) Soccentric LLC. All rights reserved.
+ */
+
+#include "measurement_harness.h"
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+
+namespace cm5_peripheral_test {
+
+/**
+ * @test MeasurementHarness_Summarize
+ * @brief Tests median, MAD and confidence interval on known samples.
+ */
+TEST(MeasurementHarnessTest, Summarize) {
+    MeasurementSummary summary = summarize_samples({1.0, 2.0, 3.0, 4.0, 100.0});
+    EXPECT_EQ(summary.iterations, 5u);
+    EXPECT_DOUBLE_EQ(summary.median, 3.0);
+    EXPECT_DOUBLE_EQ(summary.mad, 1.0);
+    EXPECT_DOUBLE_EQ(summary.mean, 22.0);
+    EXPECT_GT(summary.ci_half_width, 0.0);
+
+    MeasurementSummary even = summarize_samples({4.0, 1.0, 3.0, 2.0});
+    EXPECT_DOUBLE_EQ(even.median, 2.5);
+
+    // Two samples: t(1) = 12.706, stddev = sqrt(2)
+    MeasurementSummary pair = summarize_samples({1.0, 3.0});
+    EXPECT_NEAR(pair.ci_half_width, 12.706, 1e-9);
+    EXPECT_NEAR(pair.relative_ci, 12.706 / 2.0, 1e-9);
+
+    MeasurementSummary empty = summarize_samples({});
+    EXPECT_EQ(empty.iterations, 0u);
+    EXPECT_FALSE(empty.converged);
+}
+
+/**
+ * @test MeasurementHarness_ConstantConverges
+ * @brief Tests that a steady sample stops at the minimum sample count.
+ */
+TEST(MeasurementHarnessTest, ConstantConverges) {
+    ConvergenceCriteria criteria;
+    int calls = 0;
+    MeasurementSummary summary = measure_until_converged([&calls]() {
+        ++calls;
+        return 10.0;
+    }, criteria);
+
+    EXPECT_TRUE(summary.converged);
+    EXPECT_DOUBLE_EQ(summary.median, 10.0);
+    EXPECT_EQ(summary.warmup, 0u);
+    EXPECT_EQ(summary.iterations, criteria.min_samples);
+    EXPECT_EQ(calls, static_cast<int>(criteria.min_samples));
+}
+
+/**
+ * @test MeasurementHarness_WarmupDiscarded
+ * @brief Tests that samples taken before the window settles are dropped.
+ */
+TEST(MeasurementHarnessTest, WarmupDiscarded) {
+    std::vector<double> values = {50.0, 30.0, 20.0, 10.0, 10.0, 10.0};
+    size_t next = 0;
+    MeasurementSummary summary = measure_until_converged([&]() {
+        double value = next < values.size() ? values[next] : 10.0;
+        ++next;
+        return value;
+    });
+
+    EXPECT_TRUE(summary.converged);
+    EXPECT_EQ(summary.warmup, 3u);
+    EXPECT_DOUBLE_EQ(summary.median, 10.0);
+    EXPECT_DOUBLE_EQ(summary.mean, 10.0);
+}
+
+/**
+ * @test MeasurementHarness_NoisyNotConverged
+ * @brief Tests that a sample that never settles is capped and flagged.
+ */
+TEST(MeasurementHarnessTest, NoisyNotConverged) {
+    ConvergenceCriteria criteria;
+    criteria.max_samples = 40;
+    int calls = 0;
+    MeasurementSummary summary = measure_until_converged([&calls]() {
+        return ++calls % 2 == 0 ? 1.0 : 100.0;
+    }, criteria);
+
+    EXPECT_FALSE(summary.converged);
+    EXPECT_EQ(summary.iterations, criteria.max_samples);
+    EXPECT_EQ(summary.warmup, criteria.max_warmup - criteria.warmup_window);
+
+    std::string text = format_measurement(summary);
+    EXPECT_NE(text.find("[NOT CONVERGED]"), std::string::npos);
+    EXPECT_NE(text.find("n=40"), std::string::npos);
+}
+
+} // namespace cm5_peripheral_test
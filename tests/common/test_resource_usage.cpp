@@ -0,0 +1,88 @@
+/**
+ * @file test_resource_usage.cpp
+ * @brief Unit tests for process resource usage snapshots.
+ * @author Sandesh Ghimire | sandesh@soccentric
+ * @copyright (C) Soccentric LLC. All rights reserved.
+ */
+
+#include "resource_usage.h"
+#include <gtest/gtest.h>
+#include <chrono>
+#include <cstring>
+#include <sys/mman.h>
+#include <time.h>
+
+namespace cm5_peripheral_test {
+
+/**
+ * @test ResourceUsage_CpuTime
+ * @brief Tests that spinning shows up as user CPU time.
+ */
+TEST(ResourceUsageTest, CpuTime) {
+    ResourceUsage start = capture_resource_usage();
+    ASSERT_TRUE(start.valid);
+
+    // Spin on CPU time rather than wall time, so sharing the core with
+    // other tests only makes this take longer
+    auto process_cpu_ms = []() {
+        timespec now;
+        clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &now);
+        return now.tv_sec * 1000.0 + now.tv_nsec / 1e6;
+    };
+    double cpu_until = process_cpu_ms() + 50.0;
+    auto give_up = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    volatile uint64_t sink = 0;
+    while (process_cpu_ms() < cpu_until && std::chrono::steady_clock::now() < give_up) {
+        sink = sink + 1;
+    }
+
+    ResourceUsage delta = resource_usage_delta(start, capture_resource_usage());
+    ASSERT_TRUE(delta.valid);
+    EXPECT_GT(delta.user_ms + delta.system_ms, 10.0);
+    EXPECT_GE(delta.voluntary_switches, 0);
+    EXPECT_GE(delta.involuntary_switches, 0);
+}
+
+/**
+ * @test ResourceUsage_FaultsAndPeak
+ * @brief Tests that touching fresh memory counts minor faults and raises the peak RSS.
+ */
+TEST(ResourceUsageTest, FaultsAndPeak) {
+    // Larger than anything the process has touched so far
+    const size_t bytes = 256u << 20;
+    ResourceUsage start = capture_resource_usage();
+    void* region = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    ASSERT_NE(region, MAP_FAILED);
+    std::memset(region, 1, bytes);
+    ResourceUsage delta = resource_usage_delta(start, capture_resource_usage());
+    munmap(region, bytes);
+
+    ASSERT_TRUE(delta.valid);
+    EXPECT_GT(delta.minor_faults, 0);
+    EXPECT_GT(delta.peak_rss_kib, 128 * 1024);
+}
+
+/**
+ * @test ResourceUsage_Format
+ * @brief Tests the report line and the invalid cases.
+ */
+TEST(ResourceUsageTest, Format) {
+    ResourceUsage usage;
+    EXPECT_EQ(format_resource_usage(usage, std::chrono::milliseconds(100)), "n/a");
+    EXPECT_FALSE(resource_usage_delta(usage, capture_resource_usage()).valid);
+
+    usage.valid = true;
+    usage.user_ms = 150.0;
+    usage.system_ms = 50.0;
+    usage.voluntary_switches = 3;
+    usage.involuntary_switches = 7;
+    usage.minor_faults = 12;
+    usage.peak_rss_kib = 2048;
+    std::string text = format_resource_usage(usage, std::chrono::milliseconds(100));
+    EXPECT_NE(text.find("150 ms user + 50 ms sys (200% of one core)"), std::string::npos);
+    EXPECT_NE(text.find("3 voluntary / 7 involuntary"), std::string::npos);
+    EXPECT_NE(text.find("12 minor / 0 major"), std::string::npos);
+    EXPECT_NE(text.find("peak RSS +2048 KiB"), std::string::npos);
+}
+
+} // namespace cm5_peripheral_test
@@ -0,0 +1,269 @@
+/**
+ * @file test_series_file.cpp
+ * @brief Unit tests for the compressed series file and its background recorder.
+ * @author Sandesh Ghimire | sandesh@soccentric
+ * @copyright (C) Soccentric LLC. All rights reserved.
+ */
+
+#include "series_file.h"
+#include "series_recorder.h"
+#include <gtest/gtest.h>
+#include <cmath>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+#include <random>
+#include <thread>
+#include <unistd.h>
+
+namespace cm5_peripheral_test {
+
+namespace {
+
+bool same_bits(double a, double b) {
+    return std::memcmp(&a, &b, sizeof(a)) == 0;
+}
+
+} // namespace
+
+/**
+ * @brief Test fixture providing a per-process scratch directory.
+ */
+class SeriesFileTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        root_ = std::filesystem::temp_directory_path() / ("series_file_test_" + std::to_string(::getpid()));
+        std::filesystem::create_directories(root_);
+    }
+
+    void TearDown() override {
+        std::filesystem::remove_all(root_);
+    }
+
+    std::string scratch_file(const std::string& name) const {
+        return (root_ / name).string();
+    }
+
+    std::filesystem::path root_;
+};
+
+/**
+ * @test SeriesFile_RoundTrip
+ * @brief Tests bit-exact round trip of interleaved series, irregular times and special values.
+ */
+TEST_F(SeriesFileTest, RoundTrip) {
+    std::string path = scratch_file("series_round_trip.cm5ts");
+    std::mt19937_64 rng(3);
+    std::uniform_real_distribution<double> noise(-1.0, 1.0);
+    std::uniform_int_distribution<int64_t> jitter(-3000, 3000);
+
+    std::vector<SeriesSample> temperatures;
+    std::vector<SeriesSample> levels;
+    const double specials[] = {0.0, -0.0, std::numeric_limits<double>::infinity(),
+                               std::numeric_limits<double>::quiet_NaN(), 1e-310, -1e300};
+    {
+        SeriesFileWriter writer(path, 100);
+        ASSERT_TRUE(writer.is_open());
+        int temperature = writer.add_series("cpu/temperature_c");
+        int level = writer.add_series("gpio/gpio2_level");
+        int64_t time = 1700000000000;
+        for (int i = 0; i < 1000; ++i) {
+            // Mostly 1 s apart, with occasional large gaps and jitter
+            time += 1000 + (i % 97 == 0 ? 3600000 : 0) + (i % 5 == 0 ? jitter(rng) : 0);
+            double value = i < 6 ? specials[i] : 45.0 + 5.0 * std::sin(i / 50.0) + noise(rng);
+            ASSERT_TRUE(writer.append(temperature, time, value));
+            temperatures.push_back({time, value});
+            if (i % 3 == 0) {
+                double bit = (i / 7) % 2;
+                ASSERT_TRUE(writer.append(level, time + 7, bit));
+                levels.push_back({time + 7, bit});
+            }
+        }
+        EXPECT_FALSE(writer.append(5, 0, 0.0));
+        EXPECT_EQ(writer.samples(), temperatures.size() + levels.size());
+    }
+
+    SeriesFileReader reader(path);
+    ASSERT_TRUE(reader.is_valid());
+    EXPECT_EQ(reader.series_names(), (std::vector<std::string>{"cpu/temperature_c", "gpio/gpio2_level"}));
+
+    auto check = [&reader](const std::string& name, const std::vector<SeriesSample>& expected) {
+        auto decoded = reader.query(name, std::numeric_limits<int64_t>::min(), std::numeric_limits<int64_t>::max());
+        ASSERT_EQ(decoded.size(), expected.size()) << name;
+        for (size_t i = 0; i < expected.size(); ++i) {
+            EXPECT_EQ(decoded[i].time_ms, expected[i].time_ms) << name << " sample " << i;
+            EXPECT_TRUE(same_bits(decoded[i].value, expected[i].value)) << name << " sample " << i;
+        }
+    };
+    check("cpu/temperature_c", temperatures);
+    check("gpio/gpio2_level", levels);
+    EXPECT_TRUE(reader.query("missing", 0, std::numeric_limits<int64_t>::max()).empty());
+}
+
+/**
+ * @test SeriesFile_RangeQuery
+ * @brief Tests that a range query decodes only the overlapping chunks.
+ */
+TEST_F(SeriesFileTest, RangeQuery) {
+    std::string path = scratch_file("series_range.cm5ts");
+    {
+        SeriesFileWriter writer(path, 100);
+        int series = writer.add_series("x");
+        for (int i = 0; i < 1000; ++i) {
+            writer.append(series, i * 1000, i);
+        }
+    }
+
+    SeriesFileReader reader(path);
+    ASSERT_EQ(reader.chunks().size(), 10u);
+    auto samples = reader.query("x", 250000, 349000);
+    EXPECT_EQ(reader.chunks_decoded(), 2u);
+    ASSERT_EQ(samples.size(), 100u);
+    EXPECT_EQ(samples.front().time_ms, 250000);
+    EXPECT_DOUBLE_EQ(samples.back().value, 349.0);
+}
+
+/**
+ * @test SeriesFile_Compression
+ * @brief Tests that a steady 1 Hz sensor trace costs a few bytes per sample.
+ */
+TEST_F(SeriesFileTest, Compression) {
+    std::string path = scratch_file("series_compression.cm5ts");
+    SeriesFileWriter writer(path);
+    int series = writer.add_series("cpu/temperature_c");
+    const int samples = 86400;
+    for (int i = 0; i < samples; ++i) {
+        // Sensor quantised to 0.05°C, drifting slowly
+        double temperature = std::round((50.0 + 3.0 * std::sin(i / 600.0)) * 20.0) / 20.0;
+        writer.append(series, 1700000000000 + i * 1000LL, temperature);
+    }
+    writer.flush();
+    EXPECT_LT(static_cast<double>(writer.bytes_written()) / samples, 4.0);
+}
+
+/**
+ * @test SeriesFile_TruncatedAndAppend
+ * @brief Tests that a torn tail is ignored and reopening appends.
+ */
+TEST_F(SeriesFileTest, TruncatedAndAppend) {
+    std::string path = scratch_file("series_truncated.cm5ts");
+    {
+        SeriesFileWriter writer(path, 10);
+        int series = writer.add_series("x");
+        for (int i = 0; i < 30; ++i) {
+            writer.append(series, i, i);
+        }
+    }
+    std::filesystem::resize_file(path, std::filesystem::file_size(path) - 3);
+    SeriesFileReader torn(path);
+    EXPECT_EQ(torn.chunks().size(), 2u);
+    EXPECT_EQ(torn.query("x", 0, 100).size(), 20u);
+
+    std::string other = scratch_file("series_not_ours.txt");
+    std::ofstream(other) << "hello world";
+    EXPECT_FALSE(SeriesFileWriter(other).is_open());
+    EXPECT_FALSE(SeriesFileReader(other).is_valid());
+
+    std::filesystem::remove(path);
+    for (int run = 0; run < 2; ++run) {
+        SeriesFileWriter writer(path, 10);
+        int series = writer.add_series("x");
+        for (int i = 0; i < 5; ++i) {
+            writer.append(series, run * 100 + i, i);
+        }
+    }
+    EXPECT_EQ(SeriesFileReader(path).query("x", 0, 1000).size(), 10u);
+}
+
+/**
+ * @test SeriesFile_AppendAfterTornTail
+ * @brief Tests that reopening a crashed file drops the torn chunk before appending.
+ */
+TEST_F(SeriesFileTest, AppendAfterTornTail) {
+    std::string path = scratch_file("series_torn_append.cm5ts");
+    {
+        SeriesFileWriter writer(path, 64);
+        int series = writer.add_series("x");
+        for (int i = 0; i < 128; ++i) {
+            writer.append(series, i, i);
+        }
+    }
+    std::filesystem::resize_file(path, std::filesystem::file_size(path) - 20);
+    {
+        SeriesFileWriter writer(path, 64);
+        int series = writer.add_series("x");
+        for (int i = 0; i < 128; ++i) {
+            writer.append(series, 1000 + i, i);
+        }
+    }
+
+    SeriesFileReader reader(path);
+    EXPECT_EQ(reader.chunks().size(), 3u);
+    EXPECT_EQ(reader.query("x", 0, 999).size(), 64u);
+    std::vector<SeriesSample> resumed = reader.query("x", 1000, 2000);
+    ASSERT_EQ(resumed.size(), 128u);
+    EXPECT_EQ(resumed.front().time_ms, 1000);
+    EXPECT_EQ(resumed.back().time_ms, 1127);
+}
+
+/**
+ * @test SeriesFile_Recorder
+ * @brief Tests samples recorded through the background thread.
+ */
+TEST_F(SeriesFileTest, Recorder) {
+    std::string path = scratch_file("series_recorder.cm5ts");
+    uint64_t written = 0;
+    {
+        SeriesRecorder recorder(path, {"a", "b"}, 64, 16);
+        ASSERT_TRUE(recorder.is_open());
+        int accepted = 0;
+        for (int i = 0; i < 1000; ++i) {
+            accepted += recorder.record(i % 2, i, i * 0.5) ? 1 : 0;
+        }
+        recorder.stop();
+        EXPECT_FALSE(recorder.record(0, 0, 0.0));
+        EXPECT_EQ(recorder.written(), static_cast<uint64_t>(accepted));
+        EXPECT_EQ(recorder.written() + recorder.dropped(), 1000u);
+        EXPECT_NE(recorder.describe().find("dropped"), std::string::npos);
+        written = recorder.written();
+    }
+    SeriesFileReader reader(path);
+    auto a = reader.query("a", 0, 1000);
+    auto b = reader.query("b", 0, 1000);
+    EXPECT_EQ(a.size() + b.size(), written);
+    EXPECT_GT(a.size(), 0u);
+    for (const SeriesSample& sample : a) {
+        EXPECT_DOUBLE_EQ(sample.value, sample.time_ms * 0.5);
+    }
+}
+
+/**
+ * @test SeriesFile_RecorderFlushInterval
+ * @brief Tests that partial chunks reach the file while the recorder is
+ *        still running, so a crash would not lose them.
+ */
+TEST_F(SeriesFileTest, RecorderFlushInterval) {
+    std::string path = scratch_file("series_recorder_flush.cm5ts");
+    SeriesRecorder recorder(path, {"a", "b"}, 64, 512, std::chrono::milliseconds(50));
+    ASSERT_TRUE(recorder.is_open());
+    for (int i = 0; i < 10; ++i) {
+        ASSERT_TRUE(recorder.record(i % 2, i, i * 0.5));
+    }
+
+    // Far fewer samples than a chunk, and no stop(): only the interval writes them
+    size_t on_disk = 0;
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    while (on_disk < 10 && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        SeriesFileReader reader(path);
+        on_disk = reader.query("a", 0, 100).size() + reader.query("b", 0, 100).size();
+    }
+    EXPECT_EQ(on_disk, 10u);
+
+    recorder.stop();
+    SeriesFileReader reader(path);
+    EXPECT_EQ(reader.query("a", 0, 100).size(), 5u);
+}
+
+} // namespace cm5_peripheral_test
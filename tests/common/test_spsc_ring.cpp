@@ -0,0 +1,120 @@
+/**
+ * @file test_spsc_ring.cpp
+ * @brief Unit and stress tests for the lock-free single-producer/single-consumer ring.
+ * @author Sandesh Ghimire | sandesh@soccentric
+ * @copyright (C) Soccentric LLC. All rights reserved.
+ *
+ * The stress test is meant to be run under ThreadSanitizer as well.
+ */
+
+#include "spsc_ring.h"
+#include <gtest/gtest.h>
+#include <cstddef>
+#include <thread>
+
+namespace cm5_peripheral_test {
+
+/**
+ * @test SpscRing_Capacity
+ * @brief Tests power-of-two rounding and index padding.
+ */
+TEST(SpscRingTest, Capacity) {
+    EXPECT_EQ(SpscRing<int>(0).capacity(), 2u);
+    EXPECT_EQ(SpscRing<int>(5).capacity(), 8u);
+    EXPECT_EQ(SpscRing<int>(4096).capacity(), 4096u);
+    EXPECT_GE(alignof(SpscRing<int>), CACHE_LINE_SIZE);
+    EXPECT_GE(sizeof(SpscRing<int>), 3 * CACHE_LINE_SIZE);
+}
+
+/**
+ * @test SpscRing_SingleThreaded
+ * @brief Tests FIFO order, wrap-around, batches and overflow counting.
+ */
+TEST(SpscRingTest, SingleThreaded) {
+    SpscRing<int> ring(4);
+    int item = 0;
+    EXPECT_TRUE(ring.empty());
+    EXPECT_FALSE(ring.pop(item));
+
+    for (int i = 0; i < 4; ++i) {
+        EXPECT_TRUE(ring.push(i));
+    }
+    EXPECT_FALSE(ring.push(99));
+    EXPECT_EQ(ring.size(), 4u);
+    EXPECT_EQ(ring.overflowed(), 1u);
+
+    ASSERT_TRUE(ring.pop(item));
+    EXPECT_EQ(item, 0);
+
+    // Batch push wraps past the end of the slots and is cut short when full
+    const int batch[] = {4, 5, 6};
+    EXPECT_EQ(ring.push(batch, 3), 1u);
+    EXPECT_EQ(ring.overflowed(), 3u);
+    EXPECT_EQ(ring.pushed(), 5u);
+
+    int out[8] = {};
+    ASSERT_EQ(ring.pop(out, 8), 4u);
+    EXPECT_EQ(out[0], 1);
+    EXPECT_EQ(out[1], 2);
+    EXPECT_EQ(out[2], 3);
+    EXPECT_EQ(out[3], 4);
+    EXPECT_TRUE(ring.empty());
+    EXPECT_EQ(ring.pop(out, 8), 0u);
+}
+
+/**
+ * @test SpscRing_Stress
+ * @brief Tests that two threads mixing single and batched operations
+ *        on a small ring deliver every accepted item once, in order,
+ *        and account for every rejected one.
+ */
+TEST(SpscRingTest, Stress) {
+    constexpr uint64_t ITEMS = 200000;
+    SpscRing<uint64_t> ring(16);
+    uint64_t offered = 0;
+
+    std::thread producer([&]() {
+        uint64_t batch[7];
+        uint64_t next = 0;
+        while (next < ITEMS) {
+            size_t accepted;
+            if (next % 3 == 0) {
+                offered += 1;
+                accepted = ring.push(next) ? 1 : 0;
+            } else {
+                size_t count = static_cast<size_t>(std::min<uint64_t>(7, ITEMS - next));
+                for (size_t i = 0; i < count; ++i) {
+                    batch[i] = next + i;
+                }
+                offered += count;
+                accepted = ring.push(batch, count);
+            }
+            next += accepted;
+            if (accepted == 0) {
+                std::this_thread::yield();
+            }
+        }
+    });
+
+    uint64_t received = 0;
+    bool in_order = true;
+    uint64_t batch[5];
+    while (received < ITEMS) {
+        size_t taken = received % 2 == 0 ? ring.pop(batch, 5) : (ring.pop(batch[0]) ? 1 : 0);
+        for (size_t i = 0; i < taken; ++i) {
+            in_order = in_order && batch[i] == received + i;
+        }
+        received += taken;
+        if (taken == 0) {
+            std::this_thread::yield();
+        }
+    }
+    producer.join();
+
+    EXPECT_TRUE(in_order);
+    EXPECT_TRUE(ring.empty());
+    EXPECT_EQ(ring.pushed(), ITEMS);
+    EXPECT_EQ(ring.pushed() + ring.overflowed(), offered);
+}
+
+} // namespace cm5_peripheral_test
@@ -0,0 +1,119 @@
+/**
+ * @file test_streaming_stats.cpp
+ * @brief Unit tests for the constant-memory streaming estimators.
+ * @author Sandesh Ghimire | sandesh@soccentric
+ * @copyright (C) Soccentric LLC. All rights reserved.
+ */
+
+#include "streaming_stats.h"
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+namespace cm5_peripheral_test {
+
+/**
+ * @test StreamingStats_WelfordPrecision
+ * @brief Tests mean and variance with a large offset that defeats the naive sum of squares.
+ */
+TEST(StreamingStatsTest, WelfordPrecision) {
+    RunningMoments moments;
+    EXPECT_DOUBLE_EQ(moments.variance(), 0.0);
+    const double values[] = {4.0, 7.0, 13.0, 16.0};
+    for (double value : values) {
+        moments.add(1e9 + value);
+    }
+    EXPECT_EQ(moments.count(), 4u);
+    EXPECT_DOUBLE_EQ(moments.mean(), 1e9 + 10.0);
+    EXPECT_NEAR(moments.variance(), 30.0, 1e-6);
+    EXPECT_NEAR(moments.stddev(), std::sqrt(30.0), 1e-6);
+}
+
+/**
+ * @test StreamingStats_P2Quantiles
+ * @brief Tests P² estimates against exact quantiles of a skewed sample.
+ */
+TEST(StreamingStatsTest, P2Quantiles) {
+    std::mt19937_64 rng(7);
+    std::exponential_distribution<double> distribution(1.0);
+    P2Quantile median(0.5);
+    P2Quantile p99(0.99);
+    std::vector<double> samples;
+    for (int i = 0; i < 20000; ++i) {
+        double value = distribution(rng);
+        samples.push_back(value);
+        median.add(value);
+        p99.add(value);
+    }
+    std::sort(samples.begin(), samples.end());
+    double exact_median = samples[samples.size() / 2];
+    double exact_p99 = samples[static_cast<size_t>(samples.size() * 0.99)];
+    EXPECT_NEAR(median.value(), exact_median, 0.03 * exact_median);
+    EXPECT_NEAR(p99.value(), exact_p99, 0.05 * exact_p99);
+    EXPECT_EQ(median.count(), 20000u);
+}
+
+/**
+ * @test StreamingStats_P2FewSamples
+ * @brief Tests the exact nearest-rank answer below five samples.
+ */
+TEST(StreamingStatsTest, P2FewSamples) {
+    P2Quantile median(0.5);
+    EXPECT_DOUBLE_EQ(median.value(), 0.0);
+    median.add(9.0);
+    median.add(1.0);
+    median.add(5.0);
+    EXPECT_DOUBLE_EQ(median.value(), 5.0);
+
+    P2Quantile p99(0.99);
+    p99.add(3.0);
+    p99.add(8.0);
+    EXPECT_DOUBLE_EQ(p99.value(), 8.0);
+}
+
+/**
+ * @test StreamingStats_EwmaStep
+ * @brief Tests that a step reaches 63% after one time constant regardless of cadence.
+ */
+TEST(StreamingStatsTest, EwmaStep) {
+    Ewma fine(10.0);
+    Ewma coarse(10.0);
+    fine.add(0.0, 0.0);
+    coarse.add(0.0, 0.0);
+    for (int k = 1; k <= 100; ++k) {
+        fine.add(k * 0.1, 1.0);
+    }
+    coarse.add(5.0, 1.0);
+    coarse.add(10.0, 1.0);
+    double expected = 1.0 - std::exp(-1.0);
+    EXPECT_NEAR(fine.value(), expected, 1e-9);
+    EXPECT_NEAR(coarse.value(), expected, 1e-9);
+}
+
+/**
+ * @test StreamingStats_Summary
+ * @brief Tests extremes with timestamps and the one-line description.
+ */
+TEST(StreamingStatsTest, Summary) {
+    StreamingSummary summary("temperature_c", 60.0);
+    EXPECT_EQ(summary.describe(), "temperature_c: n 0");
+    const double temps[] = {50.0, 48.0, 55.0, 55.0, 52.0};
+    for (int k = 0; k < 5; ++k) {
+        summary.add(k, temps[k]);
+    }
+    EXPECT_DOUBLE_EQ(summary.extremes().min(), 48.0);
+    EXPECT_DOUBLE_EQ(summary.extremes().min_time(), 1.0);
+    EXPECT_DOUBLE_EQ(summary.extremes().max(), 55.0);
+    EXPECT_DOUBLE_EQ(summary.extremes().max_time(), 2.0);
+    EXPECT_DOUBLE_EQ(summary.extremes().range(), 7.0);
+    EXPECT_DOUBLE_EQ(summary.median().value(), 52.0);
+    EXPECT_DOUBLE_EQ(summary.moments().mean(), 52.0);
+
+    std::string text = summary.describe();
+    EXPECT_NE(text.find("n 5, mean 52.00"), std::string::npos);
+    EXPECT_NE(text.find("min 48.00 at 1.0 s, max 55.00 at 2.0 s"), std::string::npos);
+}
+
+} // namespace cm5_peripheral_test
@@ -0,0 +1,87 @@
+/**
+ * @file test_time_series.cpp
+ * @brief Unit tests for the fixed-capacity time-series ring buffer.
+ * @author Sandesh Ghimire | sandesh@soccentric
+ * @copyright (C) Soccentric LLC. All rights reserved.
+ */
+
+#include "time_series.h"
+#include <gtest/gtest.h>
+#include <sstream>
+
+namespace cm5_peripheral_test {
+
+/**
+ * @test TimeSeries_FillsInOrder
+ * @brief Tests appending below capacity.
+ */
+TEST(TimeSeriesTest, FillsInOrder) {
+    TimeSeries series("temperature_c", 4);
+    EXPECT_EQ(series.capacity(), 4u);
+    EXPECT_EQ(series.size(), 0u);
+
+    series.append(0.0, 40.0);
+    series.append(1.0, 41.0);
+    series.append(2.0, 42.0);
+    ASSERT_EQ(series.size(), 3u);
+    EXPECT_EQ(series.overwritten(), 0u);
+    for (size_t i = 0; i < series.size(); ++i) {
+        EXPECT_DOUBLE_EQ(series.time_at(i), static_cast<double>(i));
+        EXPECT_DOUBLE_EQ(series.value_at(i), 40.0 + i);
+    }
+}
+
+/**
+ * @test TimeSeries_WrapsAround
+ * @brief Tests that a full buffer keeps the most recent window, oldest first.
+ */
+TEST(TimeSeriesTest, WrapsAround) {
+    TimeSeries series("load_fraction", 3);
+    for (int k = 0; k < 10; ++k) {
+        series.append(k, k * 0.1);
+    }
+    ASSERT_EQ(series.size(), 3u);
+    EXPECT_EQ(series.capacity(), 3u);
+    EXPECT_EQ(series.appended(), 10u);
+    EXPECT_EQ(series.overwritten(), 7u);
+    EXPECT_DOUBLE_EQ(series.time_at(0), 7.0);
+    EXPECT_DOUBLE_EQ(series.time_at(2), 9.0);
+    EXPECT_DOUBLE_EQ(series.value_at(1), 0.8);
+
+    series.clear();
+    EXPECT_EQ(series.size(), 0u);
+    EXPECT_EQ(series.appended(), 0u);
+    series.append(20.0, 1.0);
+    EXPECT_DOUBLE_EQ(series.time_at(0), 20.0);
+}
+
+/**
+ * @test TimeSeries_ZeroCapacity
+ * @brief Tests that a zero capacity still retains the latest sample.
+ */
+TEST(TimeSeriesTest, ZeroCapacity) {
+    TimeSeries series("x", 0);
+    EXPECT_EQ(series.capacity(), 1u);
+    series.append(1.0, 5.0);
+    series.append(2.0, 6.0);
+    ASSERT_EQ(series.size(), 1u);
+    EXPECT_DOUBLE_EQ(series.value_at(0), 6.0);
+}
+
+/**
+ * @test TimeSeries_Output
+ * @brief Tests the one-line description and the CSV dump.
+ */
+TEST(TimeSeriesTest, Output) {
+    TimeSeries series("gpio2_level", 2);
+    series.append(0.5, 1.0);
+    series.append(1.5, 0.0);
+    series.append(2.5, 1.0);
+    EXPECT_EQ(series.describe(), "gpio2_level: 2 of 3 samples retained, 1.5 s to 2.5 s");
+
+    std::stringstream csv;
+    series.write_csv(csv);
+    EXPECT_EQ(csv.str(), "time_s,gpio2_level\n1.5,0\n2.5,1\n");
+}
+
+} // namespace cm5_peripheral_test
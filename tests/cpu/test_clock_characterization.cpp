@@ -0,0 +1,48 @@
+/**
+ * @file test_clock_characterization.cpp
+ * @brief Unit tests for clock characterization.
+ * @author Sandesh Ghimire | sandesh@soccentric
+ * @copyright (C) Soccentric LLC. All rights reserved.
+ */
+
+#include "clock_characterization.h"
+#include "cpu_affinity.h"
+#include <gtest/gtest.h>
+#include <vector>
+
+namespace cm5_peripheral_test {
+
+/**
+ * @test ClockCharacterization_SingleCore
+ * @brief Tests cost, resolution and monotonicity of the monotonic sources.
+ */
+TEST(ClockCharacterizationTest, SingleCore) {
+    std::vector<int> cpus = current_thread_cpus();
+    ASSERT_FALSE(cpus.empty());
+
+    const ClockSource monotonic[] = {ClockSource::FAST_COUNTER, ClockSource::STEADY_CLOCK,
+                                     ClockSource::MONOTONIC_RAW, ClockSource::MONOTONIC_COARSE};
+    for (ClockSource source : monotonic) {
+        ClockCharacteristics clock = characterize_clock(source, cpus.front(), 10000);
+        EXPECT_EQ(clock.source, source);
+        EXPECT_EQ(clock.cpu, cpus.front());
+        EXPECT_GT(clock.cost_ns, 0.0);
+        EXPECT_GT(clock.nominal_resolution_ns, 0.0);
+        EXPECT_EQ(clock.backward_steps, 0u) << clock_source_name(source);
+    }
+}
+
+/**
+ * @test ClockCharacterization_CrossCore
+ * @brief Tests that timestamps handed between cores stay ordered.
+ */
+TEST(ClockCharacterizationTest, CrossCore) {
+    std::vector<int> cpus = current_thread_cpus();
+    if (cpus.size() < 2) {
+        GTEST_SKIP() << "Needs at least two CPUs";
+    }
+    EXPECT_EQ(cross_core_clock_inversions(ClockSource::FAST_COUNTER, cpus[0], cpus[1], 1000), 0u);
+    EXPECT_EQ(cross_core_clock_inversions(ClockSource::STEADY_CLOCK, cpus[0], cpus[1], 1000), 0u);
+}
+
+} // namespace cm5_peripheral_test
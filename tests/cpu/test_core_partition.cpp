@@ -0,0 +1,80 @@
+/**
+ * @file test_core_partition.cpp
+ * @brief Unit tests for housekeeping / measurement core partitioning.
+ * @author Sandesh Ghimire | sandesh@soccentric
+ * @copyright (C) Soccentric LLC. All rights reserved.
+ */
+
+#include "core_partition.h"
+#include "fake_sysfs.h"
+#include <gtest/gtest.h>
+
+namespace cm5_peripheral_test {
+
+/**
+ * @test CorePartition_KernelIsolation
+ * @brief Tests that isolcpus and nohz_full CPUs become the measurement set.
+ */
+TEST(CorePartitionTest, KernelIsolation) {
+    CorePartition partition = plan_core_partition({0, 1, 2, 3}, {2, 3}, {1});
+    EXPECT_EQ(partition.mode, PartitionMode::KERNEL);
+    EXPECT_EQ(partition.housekeeping, (std::vector<int>{0}));
+    EXPECT_EQ(partition.measurement, (std::vector<int>{1, 2, 3}));
+}
+
+/**
+ * @test CorePartition_AffinityFallback
+ * @brief Tests the affinity split without kernel isolation.
+ */
+TEST(CorePartitionTest, AffinityFallback) {
+    CorePartition partition = plan_core_partition({0, 1, 2, 3}, {}, {});
+    EXPECT_EQ(partition.mode, PartitionMode::AFFINITY);
+    EXPECT_EQ(partition.housekeeping, (std::vector<int>{0}));
+    EXPECT_EQ(partition.measurement, (std::vector<int>{1, 2, 3}));
+
+    // Every online CPU isolated leaves nothing for housekeeping
+    partition = plan_core_partition({0, 1}, {0, 1}, {});
+    EXPECT_EQ(partition.mode, PartitionMode::AFFINITY);
+    EXPECT_EQ(partition.housekeeping, (std::vector<int>{0}));
+    EXPECT_EQ(partition.measurement, (std::vector<int>{1}));
+}
+
+/**
+ * @test CorePartition_SingleCpu
+ * @brief Tests that a single CPU is shared by both sets.
+ */
+TEST(CorePartitionTest, SingleCpu) {
+    CorePartition partition = plan_core_partition({0}, {}, {});
+    EXPECT_EQ(partition.mode, PartitionMode::SHARED);
+    EXPECT_EQ(partition.housekeeping, (std::vector<int>{0}));
+    EXPECT_EQ(partition.measurement, (std::vector<int>{0}));
+}
+
+/**
+ * @test CorePartition_Detect
+ * @brief Tests reading the kernel lists from a fake sysfs tree.
+ */
+TEST(CorePartitionTest, Detect) {
+    FakeSysfs sysfs("core_partition_test");
+    sysfs.write("online", "0-3\n");
+    sysfs.write("isolated", "3\n");
+    sysfs.write("nohz_full", "(null)\n");
+
+    CorePartition partition = detect_core_partition(sysfs.root().string());
+
+    EXPECT_EQ(partition.mode, PartitionMode::KERNEL);
+    EXPECT_EQ(partition.measurement, (std::vector<int>{3}));
+    EXPECT_TRUE(partition.nohz_full.empty());
+    EXPECT_EQ(partition.describe(), "kernel isolation: housekeeping 0-2, measurement 3, isolcpus 3");
+}
+
+/**
+ * @test CorePartition_FormatCpuList
+ * @brief Tests kernel-style range formatting.
+ */
+TEST(CorePartitionTest, FormatCpuList) {
+    EXPECT_EQ(format_cpu_list({}), "none");
+    EXPECT_EQ(format_cpu_list({0, 1, 2, 3, 6, 8, 9}), "0-3,6,8-9");
+}
+
+} // namespace cm5_peripheral_test
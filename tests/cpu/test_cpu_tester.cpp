@@ -0,0 +1,83 @@
+/**
+ * @file test_cpu_tester.cpp
+ * @brief Unit tests for CPU tester.
+ * @author Sandesh Ghimire | sandesh@soccentric
+ * @copyright (C) Soccentric LLC. All rights reserved.
+ */
+
+#include "cpu_tester.h"
+#include <gtest/gtest.h>
+
+namespace cm5_peripheral_test {
+
+/**
+ * @brief Test fixture for CPUTester.
+ */
+class CPUTesterTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        tester_ = std::make_unique<CPUTester>();
+    }
+
+    void TearDown() override {
+        tester_.reset();
+    }
+
+    std::unique_ptr<CPUTester> tester_;
+};
+
+/**
+ * @test CPUTester_Constructor
+ * @brief Tests CPUTester construction.
+ */
+TEST_F(CPUTesterTest, Constructor) {
+    ASSERT_NE(tester_, nullptr);
+    EXPECT_EQ(tester_->get_peripheral_name(), "CPU");
+}
+
+/**
+ * @test CPUTester_FrequencySweep
+ * @brief Tests cpufreq sweep execution.
+ */
+TEST_F(CPUTesterTest, FrequencySweep) {
+    if (!tester_->is_available()) {
+        GTEST_SKIP() << "CPU not available on this system";
+    }
+
+    TestReport report = tester_->frequency_sweep_test();
+    EXPECT_EQ(report.peripheral_name, "CPU");
+    EXPECT_GE(report.duration.count(), 0);
+    EXPECT_FALSE(report.details.empty());
+    EXPECT_TRUE(report.resources.valid);
+    EXPECT_GE(report.resources.user_ms + report.resources.system_ms, 0.0);
+}
+
+/**
+ * @test CPUTester_DvfsLatency
+ * @brief Tests DVFS latency measurement execution.
+ */
+TEST_F(CPUTesterTest, DvfsLatency) {
+    if (!tester_->is_available()) {
+        GTEST_SKIP() << "CPU not available on this system";
+    }
+
+    TestReport report = tester_->dvfs_latency_test();
+    EXPECT_EQ(report.peripheral_name, "CPU");
+    EXPECT_FALSE(report.details.empty());
+}
+
+/**
+ * @test CPUTester_IdleLatency
+ * @brief Tests idle-state wakeup latency measurement execution.
+ */
+TEST_F(CPUTesterTest, IdleLatency) {
+    if (!tester_->is_available()) {
+        GTEST_SKIP() << "CPU not available on this system";
+    }
+
+    TestReport report = tester_->idle_latency_test();
+    EXPECT_EQ(report.peripheral_name, "CPU");
+    EXPECT_FALSE(report.details.empty());
+}
+
+} // namespace cm5_peripheral_test
@@ -0,0 +1,117 @@
+/**
+ * @file test_cpu_topology.cpp
+ * @brief Unit tests for CPU topology and cache discovery.
+ * @author Sandesh Ghimire | sandesh@soccentric
+ * @copyright (C) Soccentric LLC. All rights reserved.
+ */
+
+#include "cpu_topology.h"
+#include "fake_sysfs.h"
+#include <gtest/gtest.h>
+
+namespace cm5_peripheral_test {
+
+/**
+ * @brief Test fixture providing a fake sysfs tree: one package, two
+ *        clusters, two SMT cores per cluster, CPU 3 offline.
+ */
+class CpuTopologyTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        sysfs_.write("possible", "0-3\n");
+        sysfs_.write("online", "0-2\n");
+
+        for (int cpu = 0; cpu < 4; ++cpu) {
+            int core = cpu / 2;
+            std::string siblings = std::to_string(core * 2) + "-" + std::to_string(core * 2 + 1);
+            write(cpu, "topology/physical_package_id", "0");
+            write(cpu, "topology/cluster_id", std::to_string(core));
+            write(cpu, "topology/core_id", std::to_string(core));
+            write(cpu, "topology/thread_siblings_list", siblings);
+
+            write(cpu, "cache/index0/level", "1");
+            write(cpu, "cache/index0/type", "Data");
+            write(cpu, "cache/index0/size", "64K");
+            write(cpu, "cache/index0/coherency_line_size", "64");
+            write(cpu, "cache/index0/ways_of_associativity", "4");
+            write(cpu, "cache/index0/number_of_sets", "256");
+            write(cpu, "cache/index0/shared_cpu_list", siblings);
+
+            write(cpu, "cache/index1/level", "2");
+            write(cpu, "cache/index1/type", "Unified");
+            write(cpu, "cache/index1/size", "2048K");
+            write(cpu, "cache/index1/coherency_line_size", "64");
+            write(cpu, "cache/index1/ways_of_associativity", "8");
+            write(cpu, "cache/index1/shared_cpu_list", "0-3");
+        }
+    }
+
+    void write(int cpu, const std::string& name, const std::string& value) {
+        sysfs_.write("cpu" + std::to_string(cpu) + "/" + name, value + "\n");
+    }
+
+    FakeSysfs sysfs_{"cpu_topology_test"};
+};
+
+/**
+ * @test CpuTopology_ParseCpuList
+ * @brief Tests kernel CPU list parsing.
+ */
+TEST(CpuTopologyParseTest, ParseCpuList) {
+    EXPECT_EQ(parse_cpu_list("0-3,6,8-9\n"), (std::vector<int>{0, 1, 2, 3, 6, 8, 9}));
+    EXPECT_EQ(parse_cpu_list("2"), (std::vector<int>{2}));
+    EXPECT_TRUE(parse_cpu_list("").empty());
+    EXPECT_TRUE(parse_cpu_list("x-y").empty());
+}
+
+/**
+ * @test CpuTopology_Cores
+ * @brief Tests package, cluster, core and SMT discovery.
+ */
+TEST_F(CpuTopologyTest, Cores) {
+    CpuTopology topology(sysfs_.root().string());
+
+    ASSERT_EQ(topology.cores().size(), 4u);
+    EXPECT_EQ(topology.online_count(), 3);
+    EXPECT_EQ(topology.package_count(), 1);
+    EXPECT_EQ(topology.cluster_count(), 2);
+    EXPECT_EQ(topology.physical_core_count(), 2);
+    EXPECT_EQ(topology.one_cpu_per_core(), (std::vector<int>{0, 2}));
+    EXPECT_FALSE(topology.cores()[3].online);
+    EXPECT_EQ(topology.cores()[1].smt_siblings, 0x3u);
+}
+
+/**
+ * @test CpuTopology_Caches
+ * @brief Tests cache descriptor deduplication and lookup.
+ */
+TEST_F(CpuTopologyTest, Caches) {
+    CpuTopology topology(sysfs_.root().string());
+
+    // Two private L1d instances and one shared L2
+    ASSERT_EQ(topology.caches().size(), 3u);
+    const CacheDescriptor* l1 = topology.data_cache(1, 2);
+    ASSERT_NE(l1, nullptr);
+    EXPECT_EQ(l1->size_bytes, 64u * 1024);
+    EXPECT_EQ(l1->shared_cpus, 0xCu);
+    EXPECT_EQ(l1->sets, 256u);
+
+    const CacheDescriptor* l2 = topology.data_cache(2);
+    ASSERT_NE(l2, nullptr);
+    EXPECT_EQ(l2->size_bytes, 2048u * 1024);
+    EXPECT_EQ(l2->type, CacheType::UNIFIED);
+    EXPECT_EQ(topology.line_size(), 64);
+    EXPECT_EQ(topology.data_cache(3), nullptr);
+}
+
+/**
+ * @test CpuTopology_System
+ * @brief Tests discovery on the running system does not fail.
+ */
+TEST(CpuTopologySystemTest, System) {
+    CpuTopology topology("/sys/devices/system/cpu");
+    EXPECT_GE(topology.online_count(), 0);
+    EXPECT_FALSE(topology.describe().empty());
+}
+
+} // namespace cm5_peripheral_test
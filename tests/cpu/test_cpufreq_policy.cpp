@@ -0,0 +1,123 @@
+/**
+ * @file test_cpufreq_policy.cpp
+ * @brief Unit tests for cpufreq policy access.
+ * @author Sandesh Ghimire | sandesh@soccentric
+ * @copyright (C) Soccentric LLC. All rights reserved.
+ */
+
+#include "cpufreq_policy.h"
+#include "fake_sysfs.h"
+#include <gtest/gtest.h>
+
+namespace cm5_peripheral_test {
+
+/**
+ * @brief Test fixture providing a fake cpufreq sysfs tree.
+ */
+class CpufreqPolicyTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        write("cpuinfo_min_freq", "1500000");
+        write("cpuinfo_max_freq", "2400000");
+        write("scaling_min_freq", "1500000");
+        write("scaling_max_freq", "2400000");
+        write("scaling_governor", "ondemand");
+        write("scaling_available_governors", "ondemand userspace performance powersave");
+    }
+
+    void write(const std::string& name, const std::string& value) {
+        sysfs_.write("cpu0/cpufreq/" + name, value + "\n");
+    }
+
+    std::string read(const std::string& name) {
+        return sysfs_.read("cpu0/cpufreq/" + name);
+    }
+
+    FakeSysfs sysfs_{"cpufreq_policy_test"};
+};
+
+/**
+ * @test CpufreqPolicy_AvailableFrequencies
+ * @brief Tests parsing of scaling_available_frequencies.
+ */
+TEST_F(CpufreqPolicyTest, AvailableFrequencies) {
+    write("scaling_available_frequencies", "2400000 1500000 1800000 ");
+    CpufreqPolicy policy(0, sysfs_.root().string());
+
+    ASSERT_TRUE(policy.is_available());
+    EXPECT_EQ(policy.available_frequencies_khz(), (std::vector<long>{1500000, 1800000, 2400000}));
+}
+
+/**
+ * @test CpufreqPolicy_FrequencyFallback
+ * @brief Tests fallback to cpuinfo limits when no step list is published.
+ */
+TEST_F(CpufreqPolicyTest, FrequencyFallback) {
+    CpufreqPolicy policy(0, sysfs_.root().string());
+    EXPECT_EQ(policy.available_frequencies_khz(), (std::vector<long>{1500000, 2400000}));
+}
+
+/**
+ * @test CpufreqPolicy_PinAndRestore
+ * @brief Tests pinning through the userspace governor and restoring settings.
+ */
+TEST_F(CpufreqPolicyTest, PinAndRestore) {
+    CpufreqPolicy policy(0, sysfs_.root().string());
+    CpufreqSettings original = policy.snapshot();
+    EXPECT_EQ(original.governor, "ondemand");
+
+    ASSERT_TRUE(policy.pin_frequency(1800000));
+    EXPECT_EQ(read("scaling_governor"), "userspace");
+    EXPECT_EQ(read("scaling_setspeed"), "1800000");
+
+    ASSERT_TRUE(policy.restore(original));
+    EXPECT_EQ(read("scaling_governor"), "ondemand");
+    EXPECT_EQ(read("scaling_min_freq"), "1500000");
+    EXPECT_EQ(read("scaling_max_freq"), "2400000");
+}
+
+/**
+ * @test CpufreqPolicy_RestoreUserspace
+ * @brief Tests that a policy already under userspace gets its fixed
+ *        frequency back after a pin.
+ */
+TEST_F(CpufreqPolicyTest, RestoreUserspace) {
+    write("scaling_governor", "userspace");
+    write("scaling_setspeed", "1500000");
+    CpufreqPolicy policy(0, sysfs_.root().string());
+    CpufreqSettings original = policy.snapshot();
+    EXPECT_EQ(original.setspeed_khz, 1500000);
+
+    ASSERT_TRUE(policy.pin_frequency(2400000));
+    EXPECT_EQ(read("scaling_setspeed"), "2400000");
+
+    ASSERT_TRUE(policy.restore(original));
+    EXPECT_EQ(read("scaling_governor"), "userspace");
+    EXPECT_EQ(read("scaling_setspeed"), "1500000");
+}
+
+/**
+ * @test CpufreqPolicy_PinByClamp
+ * @brief Tests pinning by min/max clamp when userspace is not offered.
+ */
+TEST_F(CpufreqPolicyTest, PinByClamp) {
+    write("scaling_available_governors", "schedutil performance");
+    CpufreqPolicy policy(0, sysfs_.root().string());
+
+    ASSERT_TRUE(policy.pin_frequency(1800000));
+    EXPECT_EQ(read("scaling_governor"), "ondemand");
+    EXPECT_EQ(read("scaling_min_freq"), "1800000");
+    EXPECT_EQ(read("scaling_max_freq"), "1800000");
+}
+
+/**
+ * @test CpufreqPolicy_Missing
+ * @brief Tests behaviour for a CPU without cpufreq.
+ */
+TEST_F(CpufreqPolicyTest, Missing) {
+    CpufreqPolicy policy(7, sysfs_.root().string());
+    EXPECT_FALSE(policy.is_available());
+    EXPECT_TRUE(policy.available_frequencies_khz().empty());
+}
+
+} // namespace cm5_peripheral_test
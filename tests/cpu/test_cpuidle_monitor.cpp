@@ -0,0 +1,129 @@
+/**
+ * @file test_cpuidle_monitor.cpp
+ * @brief Unit tests for cpuidle residency sampling.
+ * @author Sandesh Ghimire | sandesh@soccentric
+ * @copyright (C) Soccentric LLC. All rights reserved.
+ */
+
+#include "cpuidle_monitor.h"
+#include "fake_sysfs.h"
+#include <gtest/gtest.h>
+
+namespace cm5_peripheral_test {
+
+/**
+ * @brief Test fixture providing a fake two-core, two-state cpuidle tree.
+ */
+class CpuidleMonitorTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        for (int cpu = 0; cpu < 2; ++cpu) {
+            write(cpu, 0, "name", "WFI");
+            write(cpu, 0, "latency", "1");
+            write(cpu, 0, "residency", "1");
+            write(cpu, 1, "name", "cpu-sleep");
+            write(cpu, 1, "latency", "250");
+            write(cpu, 1, "residency", "1000");
+            for (int state = 0; state < 2; ++state) {
+                write(cpu, state, "usage", "0");
+                write(cpu, state, "time", "0");
+                write(cpu, state, "disable", "0");
+            }
+        }
+        sysfs_.create_directory("cpufreq");
+    }
+
+    void write(int cpu, int state, const std::string& name, const std::string& value) {
+        sysfs_.write("cpu" + std::to_string(cpu) + "/cpuidle/state" + std::to_string(state) + "/" + name, value + "\n");
+    }
+
+    FakeSysfs sysfs_{"cpuidle_monitor_test"};
+};
+
+/**
+ * @test CpuidleMonitor_Discovery
+ * @brief Tests discovery of cores and state descriptors.
+ */
+TEST_F(CpuidleMonitorTest, Discovery) {
+    CpuidleMonitor monitor(sysfs_.root().string());
+
+    ASSERT_TRUE(monitor.is_available());
+    EXPECT_EQ(monitor.cpus(), (std::vector<int>{0, 1}));
+    ASSERT_EQ(monitor.states().size(), 2u);
+    EXPECT_EQ(monitor.states()[1].name, "cpu-sleep");
+    EXPECT_EQ(monitor.states()[1].exit_latency_us, 250);
+}
+
+/**
+ * @test CpuidleMonitor_SampleDeltas
+ * @brief Tests usage/time deltas between samples.
+ */
+TEST_F(CpuidleMonitorTest, SampleDeltas) {
+    CpuidleMonitor monitor(sysfs_.root().string());
+    monitor.start();
+
+    write(1, 1, "usage", "12");
+    write(1, 1, "time", "4000");
+
+    auto deltas = monitor.sample();
+    ASSERT_EQ(deltas.size(), 2u);
+    EXPECT_EQ(deltas[0][1].entries, 0u);
+    EXPECT_EQ(deltas[1][1].entries, 12u);
+    EXPECT_EQ(deltas[1][1].time_us, 4000u);
+    EXPECT_GT(deltas[1][1].residency, 0.0);
+
+    auto second = monitor.sample();
+    EXPECT_EQ(second[1][1].entries, 0u);
+    EXPECT_TRUE(second[1][1].valid);
+}
+
+/**
+ * @test CpuidleMonitor_OfflineCore
+ * @brief Tests that unreadable or reset counters give no data instead
+ *        of a wrapped delta.
+ */
+TEST_F(CpuidleMonitorTest, OfflineCore) {
+    write(1, 1, "usage", "500");
+    write(1, 1, "time", "90000");
+    CpuidleMonitor monitor(sysfs_.root().string());
+    monitor.start();
+
+    // Core goes offline: the counters stop being readable
+    sysfs_.remove("cpu1/cpuidle/state1/usage");
+    auto offline = monitor.sample();
+    EXPECT_FALSE(offline[1][1].valid);
+    EXPECT_EQ(offline[1][1].time_us, 0u);
+    EXPECT_EQ(offline[1][1].residency, 0.0);
+    EXPECT_TRUE(offline[0][1].valid);
+    EXPECT_NE(monitor.format_residency(offline).find("cpu1: 0.0 -"), std::string::npos);
+
+    // Back online with counters restarted from zero
+    write(1, 1, "usage", "3");
+    write(1, 1, "time", "100");
+    EXPECT_FALSE(monitor.sample()[1][1].valid);
+    write(1, 1, "usage", "5");
+    write(1, 1, "time", "300");
+    auto online = monitor.sample();
+    EXPECT_TRUE(online[1][1].valid);
+    EXPECT_EQ(online[1][1].entries, 2u);
+    EXPECT_EQ(online[1][1].time_us, 200u);
+
+    // Counters that go backwards between two readable samples
+    write(1, 1, "usage", "1");
+    EXPECT_FALSE(monitor.sample()[1][1].valid);
+}
+
+/**
+ * @test CpuidleMonitor_DisableState
+ * @brief Tests toggling a state's disable flag.
+ */
+TEST_F(CpuidleMonitorTest, DisableState) {
+    CpuidleMonitor monitor(sysfs_.root().string());
+
+    EXPECT_FALSE(monitor.is_state_disabled(0, 1));
+    ASSERT_TRUE(monitor.set_state_disabled(0, 1, true));
+    EXPECT_TRUE(monitor.is_state_disabled(0, 1));
+    EXPECT_FALSE(monitor.is_state_disabled(1, 1));
+}
+
+} // namespace cm5_peripheral_test
@@ -0,0 +1,161 @@
+/**
+ * @file test_crypto_benchmark.cpp
+ * @brief Unit tests for crypto extension detection and implementations.
+ * @author Sandesh Ghimire | sandesh@soccentric
+ * @copyright (C) Soccentric LLC. All rights reserved.
+ */
+
+#include "crypto_benchmark.h"
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+namespace cm5_peripheral_test {
+
+namespace {
+
+const CryptoImpl BOTH_IMPLS[] = {CryptoImpl::PORTABLE, CryptoImpl::ACCELERATED};
+
+std::string to_hex(const uint8_t* data, size_t length) {
+    std::string hex;
+    char byte[3];
+    for (size_t i = 0; i < length; ++i) {
+        std::snprintf(byte, sizeof(byte), "%02x", data[i]);
+        hex += byte;
+    }
+    return hex;
+}
+
+} // namespace
+
+/**
+ * @test CryptoBenchmark_ParseFeatures
+ * @brief Tests parsing of ARM Features and x86 flags lines.
+ */
+TEST(CryptoBenchmarkTest, ParseFeatures) {
+    CryptoFeatures arm = parse_crypto_features("fp asimd evtstrm aes pmull sha1 sha2 crc32 atomics fphp");
+    EXPECT_TRUE(arm.aes);
+    EXPECT_TRUE(arm.pmull);
+    EXPECT_TRUE(arm.sha2);
+    EXPECT_TRUE(arm.crc32);
+
+    CryptoFeatures x86 = parse_crypto_features("fpu sse2 ssse3 sse4_2 aes avx");
+    EXPECT_TRUE(x86.aes);
+    EXPECT_FALSE(x86.pmull);
+    EXPECT_FALSE(x86.sha2);
+    EXPECT_TRUE(x86.crc32);
+
+    CryptoFeatures none = parse_crypto_features("fp asimd evtstrm");
+    EXPECT_FALSE(none.aes || none.pmull || none.sha2 || none.crc32);
+    EXPECT_FALSE(crypto_accelerated(CryptoAlgorithm::AES_GCM, none));
+}
+
+/**
+ * @test CryptoBenchmark_GcmVectors
+ * @brief Tests AES-128-GCM against the published zero-key test cases.
+ */
+TEST(CryptoBenchmarkTest, GcmVectors) {
+    const uint8_t key[16] = {0};
+    const uint8_t iv[12] = {0};
+    const uint8_t plaintext[16] = {0};
+
+    for (CryptoImpl impl : BOTH_IMPLS) {
+        uint8_t tag[16];
+        aes128_gcm_encrypt(impl, key, iv, nullptr, 0, nullptr, tag);
+        EXPECT_EQ(to_hex(tag, 16), "58e2fccefa7e3061367f1d57a4e7455a");
+
+        uint8_t ciphertext[16];
+        aes128_gcm_encrypt(impl, key, iv, plaintext, sizeof(plaintext), ciphertext, tag);
+        EXPECT_EQ(to_hex(ciphertext, 16), "0388dace60b6a392f328c2b971b2fe78");
+        EXPECT_EQ(to_hex(tag, 16), "ab6e47d42cec13bdf53a67b21257bddf");
+    }
+}
+
+/**
+ * @test CryptoBenchmark_Sha256Vectors
+ * @brief Tests SHA-256 on one-block and two-block messages.
+ */
+TEST(CryptoBenchmarkTest, Sha256Vectors) {
+    const std::string abc = "abc";
+    const std::string two_blocks = "abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq";
+
+    for (CryptoImpl impl : BOTH_IMPLS) {
+        uint8_t digest[32];
+        sha256_digest(impl, reinterpret_cast<const uint8_t*>(abc.data()), abc.size(), digest);
+        EXPECT_EQ(to_hex(digest, 32), "ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad");
+
+        sha256_digest(impl, reinterpret_cast<const uint8_t*>(two_blocks.data()), two_blocks.size(), digest);
+        EXPECT_EQ(to_hex(digest, 32), "248d6a61d20638b8e5c026930c3e6039a33ce45964ff2167f6ecedd419db06c1");
+    }
+}
+
+/**
+ * @test CryptoBenchmark_Crc32cVector
+ * @brief Tests CRC-32C against the standard check value.
+ */
+TEST(CryptoBenchmarkTest, Crc32cVector) {
+    const std::string check = "123456789";
+    for (CryptoImpl impl : BOTH_IMPLS) {
+        EXPECT_EQ(crc32c(impl, reinterpret_cast<const uint8_t*>(check.data()), check.size()), 0xE3069283u);
+    }
+}
+
+/**
+ * @test CryptoBenchmark_Primitives
+ * @brief Tests the single-block AES, carry-less multiply and piecewise
+ *        CRC entry points used by the SDC screen.
+ */
+TEST(CryptoBenchmarkTest, Primitives) {
+    // FIPS-197 Appendix B
+    const uint8_t key[16] = {0x2b, 0x7e, 0x15, 0x16, 0x28, 0xae, 0xd2, 0xa6,
+                             0xab, 0xf7, 0x15, 0x88, 0x09, 0xcf, 0x4f, 0x3c};
+    const uint8_t plain[16] = {0x32, 0x43, 0xf6, 0xa8, 0x88, 0x5a, 0x30, 0x8d,
+                               0x31, 0x31, 0x98, 0xa2, 0xe0, 0x37, 0x07, 0x34};
+    uint8_t round_keys[AES128_SCHEDULE_BYTES];
+    aes128_expand_key(key, round_keys);
+
+    const std::string check = "123456789";
+    const uint8_t* check_bytes = reinterpret_cast<const uint8_t*>(check.data());
+    for (CryptoImpl impl : BOTH_IMPLS) {
+        uint8_t cipher[16];
+        aes128_encrypt_block(impl, round_keys, plain, cipher);
+        EXPECT_EQ(to_hex(cipher, 16), "3925841d02dc09fbdc118597196a0b32");
+
+        uint64_t lo = 0;
+        uint64_t hi = 0;
+        clmul64(impl, 3, 3, lo, hi);
+        EXPECT_EQ(lo, 5u);
+        EXPECT_EQ(hi, 0u);
+        clmul64(impl, 1ULL << 63, 1ULL << 63, lo, hi);
+        EXPECT_EQ(lo, 0u);
+        EXPECT_EQ(hi, 1ULL << 62);
+
+        uint32_t crc = crc32c_update(impl, 0xFFFFFFFFu, check_bytes, 4);
+        crc = crc32c_update(impl, crc, check_bytes + 4, check.size() - 4);
+        EXPECT_EQ(crc ^ 0xFFFFFFFFu, 0xE3069283u);
+    }
+}
+
+/**
+ * @test CryptoBenchmark_ImplementationsAgree
+ * @brief Tests that accelerated and portable paths match on this host.
+ */
+TEST(CryptoBenchmarkTest, ImplementationsAgree) {
+    EXPECT_TRUE(crypto_implementations_agree(CryptoAlgorithm::AES_GCM));
+    EXPECT_TRUE(crypto_implementations_agree(CryptoAlgorithm::SHA256));
+    EXPECT_TRUE(crypto_implementations_agree(CryptoAlgorithm::CRC32C));
+}
+
+/**
+ * @test CryptoBenchmark_Throughput
+ * @brief Tests that the benchmark reports a positive rate.
+ */
+TEST(CryptoBenchmarkTest, Throughput) {
+    CryptoThroughput result = benchmark_crypto(CryptoAlgorithm::CRC32C, CryptoImpl::PORTABLE,
+                                               std::chrono::milliseconds(20));
+    EXPECT_GT(result.bytes_per_second, 0.0);
+    EXPECT_EQ(result.algorithm, CryptoAlgorithm::CRC32C);
+}
+
+} // namespace cm5_peripheral_test
@@ -0,0 +1,84 @@
+/**
+ * @file test_frontend_benchmark.cpp
+ * @brief Unit tests for the branch predictor and front-end microbenchmarks.
+ * @author Sandesh Ghimire | sandesh@soccentric
+ * @copyright (C) Soccentric LLC. All rights reserved.
+ */
+
+#include "frontend_benchmark.h"
+#include <gtest/gtest.h>
+#include <set>
+#include <string>
+
+namespace cm5_peripheral_test {
+
+/**
+ * @test FrontendBenchmark_KernelNames
+ * @brief Tests that every kernel has a distinct name.
+ */
+TEST(FrontendBenchmarkTest, KernelNames) {
+    std::set<std::string> names;
+    for (int index = 0; index < FRONTEND_KERNEL_COUNT; ++index) {
+        names.insert(frontend_kernel_name(static_cast<FrontendKernel>(index)));
+    }
+    EXPECT_EQ(names.size(), static_cast<size_t>(FRONTEND_KERNEL_COUNT));
+    EXPECT_EQ(names.count("unknown"), 0u);
+}
+
+/**
+ * @test FrontendBenchmark_RunsEveryKernel
+ * @brief Tests that each kernel runs, times and produces a checksum.
+ */
+TEST(FrontendBenchmarkTest, RunsEveryKernel) {
+    for (int index = 0; index < FRONTEND_KERNEL_COUNT; ++index) {
+        FrontendKernel kernel = static_cast<FrontendKernel>(index);
+        FrontendResult result = run_frontend_benchmark(kernel, 100000);
+        EXPECT_EQ(result.kernel, kernel) << frontend_kernel_name(kernel);
+        EXPECT_GT(result.iterations, 0u) << frontend_kernel_name(kernel);
+        EXPECT_GT(result.ns_per_iteration, 0.0) << frontend_kernel_name(kernel);
+        EXPECT_NE(result.checksum, 0u) << frontend_kernel_name(kernel);
+        if (result.branch_misses >= 0) {
+            EXPECT_LE(result.branch_misses, 2.0) << frontend_kernel_name(kernel);
+        }
+    }
+}
+
+/**
+ * @test FrontendBenchmark_DeterministicChecksum
+ * @brief Tests that a kernel's checksum depends only on its iteration count.
+ */
+TEST(FrontendBenchmarkTest, DeterministicChecksum) {
+    FrontendResult first = run_frontend_benchmark(FrontendKernel::VIRTUAL_CALL, 5000);
+    FrontendResult second = run_frontend_benchmark(FrontendKernel::VIRTUAL_CALL, 5000);
+    EXPECT_EQ(first.checksum, second.checksum);
+
+    // The three dispatch styles apply the same operations in the same order
+    EXPECT_EQ(run_frontend_benchmark(FrontendKernel::SWITCH_DISPATCH, 5000).checksum, first.checksum);
+    EXPECT_EQ(run_frontend_benchmark(FrontendKernel::FUNCTION_POINTER, 5000).checksum, first.checksum);
+
+    // Random order: same operations across styles, a different sequence
+    FrontendResult random = run_frontend_benchmark(FrontendKernel::RANDOM_VIRTUAL_CALL, 5000);
+    EXPECT_NE(random.checksum, first.checksum);
+    EXPECT_EQ(run_frontend_benchmark(FrontendKernel::RANDOM_SWITCH, 5000).checksum, random.checksum);
+    EXPECT_EQ(run_frontend_benchmark(FrontendKernel::RANDOM_FUNCTION_POINTER, 5000).checksum, random.checksum);
+}
+
+/**
+ * @test FrontendBenchmark_Footprint
+ * @brief Tests that the large footprint spans more code than the small
+ *        one and that iterations round to whole passes.
+ */
+TEST(FrontendBenchmarkTest, Footprint) {
+    FrontendResult small = run_frontend_benchmark(FrontendKernel::SMALL_FOOTPRINT, 10000);
+    FrontendResult large = run_frontend_benchmark(FrontendKernel::LARGE_FOOTPRINT, 10000);
+    EXPECT_GT(small.code_bytes, 0u);
+    EXPECT_GT(large.code_bytes, small.code_bytes * 8);
+    EXPECT_EQ(large.iterations % 2048, 0u);
+    EXPECT_GE(large.iterations, 2048u);
+
+    FrontendResult branch = run_frontend_benchmark(FrontendKernel::RANDOM_BRANCH, 10000);
+    EXPECT_EQ(branch.code_bytes, 0u);
+    EXPECT_EQ(branch.iterations, 10000u);
+}
+
+} // namespace cm5_peripheral_test
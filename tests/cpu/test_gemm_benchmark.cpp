@@ -0,0 +1,99 @@
+/**
+ * @file test_gemm_benchmark.cpp
+ * @brief Unit tests for the blocked GEMM benchmark.
+ * @author Sandesh Ghimire | sandesh@soccentric
+ * @copyright (C) Soccentric LLC. All rights reserved.
+ */
+
+#include "gemm_benchmark.h"
+#include "cpu_affinity.h"
+#include <gtest/gtest.h>
+#include <cmath>
+
+namespace cm5_peripheral_test {
+
+namespace {
+
+template <typename T>
+std::vector<T> naive_multiply(int m, int n, int k, const std::vector<T>& a, const std::vector<T>& b) {
+    std::vector<T> c(static_cast<size_t>(m) * n, T(0));
+    for (int i = 0; i < m; ++i) {
+        for (int j = 0; j < n; ++j) {
+            double sum = 0.0;
+            for (int p = 0; p < k; ++p) {
+                sum += static_cast<double>(a[i * k + p]) * b[p * n + j];
+            }
+            c[i * n + j] = static_cast<T>(sum);
+        }
+    }
+    return c;
+}
+
+template <typename T>
+std::vector<T> ramp(size_t count, int modulus) {
+    std::vector<T> values(count);
+    for (size_t i = 0; i < count; ++i) {
+        values[i] = static_cast<T>(static_cast<int>(i % modulus) - modulus / 2) / 8;
+    }
+    return values;
+}
+
+} // namespace
+
+/**
+ * @test GemmBenchmark_EdgeTiles
+ * @brief Tests odd shapes that leave partial register tiles and blocks.
+ */
+TEST(GemmBenchmarkTest, EdgeTiles) {
+    const int m = 37, n = 29, k = 45;
+    std::vector<double> a = ramp<double>(m * k, 7);
+    std::vector<double> b = ramp<double>(k * n, 5);
+    std::vector<double> c(m * n, 0.0);
+
+    // Small blocks force several MC/KC/NC iterations
+    BlockedGemm<double, 4, 4, 8, 16, 12> gemm;
+    gemm.multiply(0, m, n, k, a.data(), b.data(), c.data());
+
+    std::vector<double> expected = naive_multiply(m, n, k, a, b);
+    for (size_t i = 0; i < c.size(); ++i) {
+        ASSERT_DOUBLE_EQ(c[i], expected[i]) << "index " << i;
+    }
+}
+
+/**
+ * @test GemmBenchmark_DefaultTileFloat
+ * @brief Tests the target's default float tiling on a row band.
+ */
+TEST(GemmBenchmarkTest, DefaultTileFloat) {
+    const int size = 50;
+    std::vector<float> a = ramp<float>(size * size, 9);
+    std::vector<float> b = ramp<float>(size * size, 11);
+    std::vector<float> c(size * size, 0.0f);
+
+    BlockedGemm<float> gemm;
+    gemm.multiply(0, 20, size, size, a.data(), b.data(), c.data());
+    gemm.multiply(20, size, size, size, a.data(), b.data(), c.data());
+
+    std::vector<float> expected = naive_multiply(size, size, size, a, b);
+    for (size_t i = 0; i < c.size(); ++i) {
+        ASSERT_NEAR(c[i], expected[i], 1e-3f) << "index " << i;
+    }
+}
+
+/**
+ * @test GemmBenchmark_Run
+ * @brief Tests that a short run is verified and reports throughput.
+ */
+TEST(GemmBenchmarkTest, Run) {
+    std::vector<int> cpus = current_thread_cpus();
+    ASSERT_FALSE(cpus.empty());
+
+    GemmResult result = run_gemm_benchmark(GemmPrecision::DOUBLE, 64, {cpus.front()},
+                                           std::chrono::milliseconds(50));
+    EXPECT_TRUE(result.verified);
+    EXPECT_GT(result.gflops, 0.0);
+    EXPECT_EQ(result.threads, 1);
+    EXPECT_GT(gemm_peak_flops_per_cycle(GemmPrecision::SINGLE), gemm_peak_flops_per_cycle(GemmPrecision::DOUBLE));
+}
+
+} // namespace cm5_peripheral_test
@@ -0,0 +1,53 @@
+/**
+ * @file test_handoff_benchmark.cpp
+ * @brief Unit tests for the producer-to-consumer handoff benchmark.
+ * @author Sandesh Ghimire | sandesh@soccentric
+ * @copyright (C) Soccentric LLC. All rights reserved.
+ */
+
+#include "handoff_benchmark.h"
+#include "cpu_affinity.h"
+#include <gtest/gtest.h>
+#include <string>
+
+namespace cm5_peripheral_test {
+
+/**
+ * @test HandoffBenchmark_Names
+ * @brief Tests that every queue has a display name.
+ */
+TEST(HandoffBenchmarkTest, Names) {
+    EXPECT_EQ(std::string(handoff_queue_name(HandoffQueue::MUTEX_QUEUE)), "mutex queue");
+    EXPECT_EQ(std::string(handoff_queue_name(HandoffQueue::SPSC_BATCH)), "SPSC ring, batched");
+}
+
+/**
+ * @test HandoffBenchmark_AllQueues
+ * @brief Tests that each queue delivers every item in order through a
+ *        queue small enough to fill.
+ */
+TEST(HandoffBenchmarkTest, AllQueues) {
+    std::vector<int> cpus = current_thread_cpus();
+    ASSERT_FALSE(cpus.empty());
+
+    const HandoffQueue queues[] = {HandoffQueue::MUTEX_QUEUE, HandoffQueue::MUTEX_BATCH, HandoffQueue::SPSC_SINGLE,
+                                   HandoffQueue::SPSC_BATCH};
+    for (HandoffQueue queue : queues) {
+        HandoffResult result = run_handoff_benchmark(queue, cpus, 100000, 32);
+        EXPECT_TRUE(result.in_order) << handoff_queue_name(queue);
+        EXPECT_EQ(result.items, 100000u);
+        EXPECT_GT(result.items_per_second, 0.0) << handoff_queue_name(queue);
+    }
+}
+
+/**
+ * @test HandoffBenchmark_NoCpus
+ * @brief Tests that an empty CPU list streams nothing.
+ */
+TEST(HandoffBenchmarkTest, NoCpus) {
+    HandoffResult result = run_handoff_benchmark(HandoffQueue::SPSC_SINGLE, {}, 1000, 32);
+    EXPECT_FALSE(result.in_order);
+    EXPECT_EQ(result.items_per_second, 0.0);
+}
+
+} // namespace cm5_peripheral_test
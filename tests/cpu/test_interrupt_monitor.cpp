@@ -0,0 +1,145 @@
+/**
+ * @file test_interrupt_monitor.cpp
+ * @brief Unit tests for interrupt and softirq rate sampling.
+ * @author Sandesh Ghimire | sandesh@soccentric
+ * @copyright (C) Soccentric LLC. All rights reserved.
+ */
+
+#include "interrupt_monitor.h"
+#include "fake_sysfs.h"
+#include <gtest/gtest.h>
+#include <thread>
+
+namespace cm5_peripheral_test {
+
+/**
+ * @brief Test fixture providing fake two-CPU interrupts and softirqs files.
+ */
+class InterruptMonitorTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        write_interrupts(0, 0);
+        write_softirqs(0);
+    }
+
+    void write_interrupts(uint64_t timer, uint64_t mmc) {
+        sysfs_.write("interrupts",
+                     "           CPU0       CPU1       \n"
+                     " 11:    " + std::to_string(timer) + "    " + std::to_string(timer * 2) +
+                         "     GICv2  30 Level     arch_timer\n"
+                         " 42:    " + std::to_string(mmc) + "          0     GICv2 305 Level     mmc1\n"
+                         "IPI0:        5          7       Rescheduling interrupts\n"
+                         "Err:          0\n");
+    }
+
+    void write_softirqs(uint64_t net_rx) {
+        sysfs_.write("softirqs",
+                     "                    CPU0       CPU1       CPU2       CPU3\n"
+                     "          HI:          0          0          0          0\n"
+                     "      NET_RX:    " + std::to_string(net_rx) + "          1          9          9\n");
+    }
+
+    size_t find(const InterruptMonitor& monitor, const std::string& id) {
+        for (size_t i = 0; i < monitor.sources().size(); ++i) {
+            if (monitor.sources()[i].id == id) {
+                return i;
+            }
+        }
+        return monitor.sources().size();
+    }
+
+    FakeSysfs sysfs_{"interrupt_monitor_test"};
+};
+
+/**
+ * @test InterruptMonitor_Discovery
+ * @brief Tests discovery of CPU columns, sources and device names.
+ */
+TEST_F(InterruptMonitorTest, Discovery) {
+    InterruptMonitor monitor(sysfs_.root().string());
+
+    ASSERT_TRUE(monitor.is_available());
+    EXPECT_EQ(monitor.cpus(), (std::vector<int>{0, 1}));
+    ASSERT_EQ(monitor.sources().size(), 6u);
+    EXPECT_EQ(monitor.sources()[0].id, "11");
+    EXPECT_EQ(monitor.sources()[0].device, "GICv2 30 Level arch_timer");
+    EXPECT_EQ(monitor.sources()[2].device, "Rescheduling interrupts");
+    EXPECT_FALSE(monitor.sources()[3].softirq);
+    EXPECT_TRUE(monitor.sources()[5].softirq);
+    EXPECT_EQ(monitor.sources()[5].id, "NET_RX");
+}
+
+/**
+ * @test InterruptMonitor_SampleDeltas
+ * @brief Tests per-CPU totals and rates between samples.
+ */
+TEST_F(InterruptMonitorTest, SampleDeltas) {
+    InterruptMonitor monitor(sysfs_.root().string());
+    monitor.start();
+
+    write_interrupts(100, 40);
+    write_softirqs(25);
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    ASSERT_TRUE(monitor.sample());
+
+    size_t timer = find(monitor, "11");
+    size_t mmc = find(monitor, "42");
+    size_t net_rx = find(monitor, "NET_RX");
+    EXPECT_EQ(monitor.total(timer, 0), 100u);
+    EXPECT_EQ(monitor.total(timer, 1), 200u);
+    EXPECT_EQ(monitor.total(mmc, 0), 40u);
+    EXPECT_EQ(monitor.total(mmc, 1), 0u);
+    EXPECT_EQ(monitor.total(net_rx, 0), 25u);
+    EXPECT_GT(monitor.rate(timer, 1), monitor.rate(timer, 0));
+    EXPECT_EQ(monitor.peak_rate(timer, 0), monitor.rate(timer, 0));
+
+    // A quiet interval leaves the peak and adds nothing to the total
+    ASSERT_TRUE(monitor.sample());
+    EXPECT_EQ(monitor.total(timer, 0), 100u);
+    EXPECT_EQ(monitor.rate(timer, 0), 0.0);
+    EXPECT_GT(monitor.peak_rate(timer, 0), 0.0);
+    EXPECT_EQ(monitor.unknown_rows(), 0u);
+
+    std::string summary = monitor.format_summary(2, 1e12);
+    EXPECT_NE(summary.find("arch_timer"), std::string::npos);
+    EXPECT_EQ(summary.find("Rescheduling"), std::string::npos);
+    EXPECT_EQ(summary.find("[STORM]"), std::string::npos);
+}
+
+/**
+ * @test InterruptMonitor_UnknownRow
+ * @brief Tests that rows appearing after discovery are ignored and
+ *        each counted once however many samples see them.
+ */
+TEST_F(InterruptMonitorTest, UnknownRow) {
+    InterruptMonitor monitor(sysfs_.root().string());
+    monitor.start();
+
+    sysfs_.write("interrupts", " 99:      500        500     GICv2 400 Edge      new-device\n", true);
+    ASSERT_TRUE(monitor.sample());
+    EXPECT_EQ(monitor.unknown_rows(), 1u);
+    ASSERT_TRUE(monitor.sample());
+    EXPECT_EQ(monitor.unknown_rows(), 1u);
+
+    sysfs_.write("interrupts", "100:        1          1     GICv2 401 Edge      other-device\n", true);
+    ASSERT_TRUE(monitor.sample());
+    EXPECT_EQ(monitor.unknown_rows(), 2u);
+    EXPECT_NE(monitor.format_summary(1, 1e12).find("Rows not present at discovery: 2"), std::string::npos);
+}
+
+/**
+ * @test InterruptMonitor_Proc
+ * @brief Tests sampling the real procfs files.
+ */
+TEST(InterruptMonitorProcTest, Proc) {
+    InterruptMonitor monitor;
+    if (!monitor.is_available()) {
+        GTEST_SKIP() << "/proc/interrupts not readable";
+    }
+    monitor.start();
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    EXPECT_TRUE(monitor.sample());
+    EXPECT_GT(monitor.elapsed_seconds(), 0.0);
+}
+
+} // namespace cm5_peripheral_test
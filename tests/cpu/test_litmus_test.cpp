@@ -0,0 +1,70 @@
+/**
+ * @file test_litmus_test.cpp
+ * @brief Unit tests for the memory-ordering litmus test runner.
+ * @author Sandesh Ghimire | sandesh@soccentric
+ * @copyright (C) Soccentric LLC. All rights reserved.
+ */
+
+#include "litmus_test.h"
+#include "cpu_affinity.h"
+#include <gtest/gtest.h>
+#include <numeric>
+
+namespace cm5_peripheral_test {
+
+/**
+ * @test Litmus_ForbiddenOutcomes
+ * @brief Tests the forbidden-outcome table against the memory model.
+ */
+TEST(LitmusTest, ForbiddenOutcomes) {
+    // MP: flag seen without data
+    EXPECT_FALSE(litmus_forbidden(LitmusTest::MESSAGE_PASSING, LitmusOrdering::RELAXED, 0b01));
+    EXPECT_TRUE(litmus_forbidden(LitmusTest::MESSAGE_PASSING, LitmusOrdering::ACQUIRE_RELEASE, 0b01));
+    EXPECT_FALSE(litmus_forbidden(LitmusTest::MESSAGE_PASSING, LitmusOrdering::SEQ_CST, 0b11));
+
+    // SB: both stores missed; only seq_cst forbids it
+    EXPECT_FALSE(litmus_forbidden(LitmusTest::STORE_BUFFERING, LitmusOrdering::ACQUIRE_RELEASE, 0b00));
+    EXPECT_TRUE(litmus_forbidden(LitmusTest::STORE_BUFFERING, LitmusOrdering::SEQ_CST, 0b00));
+
+    // LB: causality cycle
+    EXPECT_FALSE(litmus_forbidden(LitmusTest::LOAD_BUFFERING, LitmusOrdering::RELAXED, 0b11));
+    EXPECT_TRUE(litmus_forbidden(LitmusTest::LOAD_BUFFERING, LitmusOrdering::ACQUIRE_RELEASE, 0b11));
+
+    // IRIW: readers disagree on write order
+    EXPECT_FALSE(litmus_forbidden(LitmusTest::IRIW, LitmusOrdering::ACQUIRE_RELEASE, 0b0101));
+    EXPECT_TRUE(litmus_forbidden(LitmusTest::IRIW, LitmusOrdering::SEQ_CST, 0b0101));
+}
+
+/**
+ * @test Litmus_FormatOutcome
+ * @brief Tests register formatting for two- and four-register shapes.
+ */
+TEST(LitmusTest, FormatOutcome) {
+    EXPECT_EQ(format_litmus_outcome(LitmusTest::MESSAGE_PASSING, 0b01), "r0=1 r1=0");
+    EXPECT_EQ(format_litmus_outcome(LitmusTest::IRIW, 0b0101), "r0=1 r1=0 r2=1 r3=0");
+    EXPECT_EQ(litmus_outcome_count(LitmusTest::IRIW), 16u);
+    EXPECT_EQ(litmus_thread_count(LitmusTest::IRIW), 4u);
+}
+
+/**
+ * @test Litmus_SeqCstRuns
+ * @brief Tests that seq_cst runs tally every instance and stay legal.
+ */
+TEST(LitmusTest, SeqCstRuns) {
+    std::vector<int> cpus = current_thread_cpus();
+    ASSERT_FALSE(cpus.empty());
+
+    const LitmusTest tests[] = {LitmusTest::MESSAGE_PASSING, LitmusTest::STORE_BUFFERING,
+                                LitmusTest::LOAD_BUFFERING, LitmusTest::IRIW};
+    for (LitmusTest test : tests) {
+        LitmusResult result = run_litmus_test(test, LitmusOrdering::SEQ_CST, cpus, 4096);
+        uint64_t tallied = std::accumulate(result.outcomes.begin(), result.outcomes.end(), uint64_t{0});
+
+        EXPECT_GE(result.iterations, 4096u) << litmus_test_name(test);
+        EXPECT_EQ(tallied, result.iterations) << litmus_test_name(test);
+        EXPECT_EQ(result.forbidden, 0u) << litmus_test_name(test);
+        EXPECT_EQ(result.cpus.size(), litmus_thread_count(test));
+    }
+}
+
+} // namespace cm5_peripheral_test
@@ -0,0 +1,78 @@
+/**
+ * @file test_lock_benchmark.cpp
+ * @brief Unit tests for synchronization primitive benchmarks.
+ * @author Sandesh Ghimire | sandesh@soccentric
+ * @copyright (C) Soccentric LLC. All rights reserved.
+ */
+
+#include "lock_benchmark.h"
+#include "cpu_affinity.h"
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <thread>
+
+namespace cm5_peripheral_test {
+
+/**
+ * @test LockBenchmark_JainFairness
+ * @brief Tests the fairness index on equal and skewed counts.
+ */
+TEST(LockBenchmarkTest, JainFairness) {
+    EXPECT_DOUBLE_EQ(jain_fairness({100, 100, 100, 100}), 1.0);
+    EXPECT_DOUBLE_EQ(jain_fairness({100, 0, 0, 0}), 0.25);
+    EXPECT_DOUBLE_EQ(jain_fairness({}), 1.0);
+}
+
+/**
+ * @test LockBenchmark_MutualExclusion
+ * @brief Tests that the ticket and MCS locks serialize a shared counter.
+ */
+TEST(LockBenchmarkTest, MutualExclusion) {
+    // Spinlocks convoy badly when oversubscribed, so stay within the CPU count
+    const size_t cpus = current_thread_cpus().size();
+    if (cpus < 2) {
+        GTEST_SKIP() << "Spinlock contention needs at least two CPUs";
+    }
+    const size_t THREADS = std::min<size_t>(4, cpus);
+    constexpr int ITERATIONS = 20000;
+
+    TicketSpinlock ticket;
+    McsLock mcs;
+    uint64_t ticket_counter = 0;
+    uint64_t mcs_counter = 0;
+
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < THREADS; ++t) {
+        threads.emplace_back([&]() {
+            McsLock::Node node;
+            for (int i = 0; i < ITERATIONS; ++i) {
+                ticket.lock();
+                ++ticket_counter;
+                ticket.unlock();
+
+                mcs.lock(node);
+                ++mcs_counter;
+                mcs.unlock(node);
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    EXPECT_EQ(ticket_counter, THREADS * ITERATIONS);
+    EXPECT_EQ(mcs_counter, THREADS * ITERATIONS);
+}
+
+/**
+ * @test LockBenchmark_Run
+ * @brief Tests a short benchmark run on CPU 0.
+ */
+TEST(LockBenchmarkTest, Run) {
+    ContentionResult result = run_contention_benchmark(SyncPrimitive::MCS_LOCK, {0}, std::chrono::milliseconds(20));
+    EXPECT_EQ(result.threads, 1);
+    EXPECT_GT(result.ops_per_second, 0.0);
+    EXPECT_TRUE(result.consistent);
+}
+
+} // namespace cm5_peripheral_test
@@ -0,0 +1,72 @@
+/**
+ * @file test_mapping_benchmark.cpp
+ * @brief Unit tests for the page-fault and memory-mapping benchmarks.
+ * @author Sandesh Ghimire | sandesh@soccentric
+ * @copyright (C) Soccentric LLC. All rights reserved.
+ */
+
+#include "mapping_benchmark.h"
+#include "cpu_affinity.h"
+#include <gtest/gtest.h>
+#include <filesystem>
+
+namespace cm5_peripheral_test {
+
+/**
+ * @test MappingBenchmark_MinorFault
+ * @brief Tests that touching fresh anonymous pages takes one fault each.
+ */
+TEST(MappingBenchmarkTest, MinorFault) {
+    MappingCostResult result = run_mapping_benchmark(MappingOperation::MINOR_FAULT, {}, 4u << 20);
+    ASSERT_TRUE(result.available) << result.note;
+    EXPECT_GT(result.operations, 0u);
+    EXPECT_GT(result.ns_per_op, 0.0);
+    EXPECT_GT(result.faults_per_op, 0.9);
+}
+
+/**
+ * @test MappingBenchmark_SystemCalls
+ * @brief Tests the chunked system call timings.
+ */
+TEST(MappingBenchmarkTest, SystemCalls) {
+    const MappingOperation operations[] = {MappingOperation::MMAP_MUNMAP, MappingOperation::MADVISE_DONTNEED,
+                                           MappingOperation::MPROTECT};
+    for (MappingOperation operation : operations) {
+        MappingCostResult result = run_mapping_benchmark(operation, {}, 1u << 20);
+        ASSERT_TRUE(result.available) << mapping_operation_name(operation) << ": " << result.note;
+        EXPECT_GT(result.chunk_bytes, 0u);
+        EXPECT_GT(result.ns_per_op, 0.0);
+        EXPECT_LT(result.faults_per_op, 0.0);
+    }
+}
+
+/**
+ * @test MappingBenchmark_MajorFault
+ * @brief Tests that the file-backed case reads its contents back.
+ */
+TEST(MappingBenchmarkTest, MajorFault) {
+    std::string dir = std::filesystem::temp_directory_path().string();
+    MappingCostResult result = run_mapping_benchmark(MappingOperation::MAJOR_FAULT, {}, 1u << 20, dir);
+    ASSERT_TRUE(result.available) << result.note;
+    EXPECT_GE(result.faults_per_op, 0.0);
+
+    MappingCostResult missing = run_mapping_benchmark(MappingOperation::MAJOR_FAULT, {}, 1u << 20, "/nonexistent");
+    EXPECT_FALSE(missing.available);
+    EXPECT_FALSE(missing.note.empty());
+}
+
+/**
+ * @test MappingBenchmark_FirstTouch
+ * @brief Tests concurrent first touch on the current CPUs.
+ */
+TEST(MappingBenchmarkTest, FirstTouch) {
+    std::vector<int> cpus = current_thread_cpus();
+    ASSERT_FALSE(cpus.empty());
+    MappingCostResult result = run_mapping_benchmark(MappingOperation::FIRST_TOUCH, cpus, 4u << 20);
+    ASSERT_TRUE(result.available) << result.note;
+    EXPECT_EQ(result.threads, static_cast<int>(cpus.size()));
+    EXPECT_GT(result.ops_per_second, 0.0);
+    EXPECT_GT(result.faults_per_op, 0.9);
+}
+
+} // namespace cm5_peripheral_test
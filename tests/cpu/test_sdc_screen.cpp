@@ -0,0 +1,74 @@
+/**
+ * @file test_sdc_screen.cpp
+ * @brief Unit tests for silent data corruption screening.
+ * @author Sandesh Ghimire | sandesh@soccentric
+ * @copyright (C) Soccentric LLC. All rights reserved.
+ */
+
+#include "sdc_screen.h"
+#include "cpu_affinity.h"
+#include "crypto_benchmark.h"
+#include <gtest/gtest.h>
+
+namespace cm5_peripheral_test {
+
+namespace {
+
+const SdcKernel ALL_KERNELS[] = {SdcKernel::INTEGER, SdcKernel::FLOAT, SdcKernel::SIMD, SdcKernel::CRC32C,
+                                SdcKernel::CRYPTO};
+
+} // namespace
+
+/**
+ * @test SdcScreen_GoldenDigests
+ * @brief Tests that this machine reproduces the golden table.
+ */
+TEST(SdcScreenTest, GoldenDigests) {
+    for (SdcKernel kernel : ALL_KERNELS) {
+        EXPECT_EQ(run_sdc_kernel(kernel, SDC_GOLDEN_SEED), sdc_golden_digest(kernel)) << sdc_kernel_name(kernel);
+    }
+}
+
+/**
+ * @test SdcScreen_SeedSensitivity
+ * @brief Tests that kernels are deterministic and depend on the seed.
+ */
+TEST(SdcScreenTest, SeedSensitivity) {
+    for (SdcKernel kernel : ALL_KERNELS) {
+        EXPECT_EQ(run_sdc_kernel(kernel, 42), run_sdc_kernel(kernel, 42)) << sdc_kernel_name(kernel);
+        EXPECT_NE(run_sdc_kernel(kernel, 42), run_sdc_kernel(kernel, 43)) << sdc_kernel_name(kernel);
+    }
+}
+
+/**
+ * @test SdcScreen_Accelerated
+ * @brief Tests that the CRC and crypto kernels follow the detected
+ *        extensions and the scalar kernels never claim acceleration.
+ */
+TEST(SdcScreenTest, Accelerated) {
+    CryptoFeatures features = detect_crypto_features();
+    EXPECT_EQ(sdc_kernel_accelerated(SdcKernel::CRC32C), crypto_accelerated(CryptoAlgorithm::CRC32C, features));
+    EXPECT_EQ(sdc_kernel_accelerated(SdcKernel::CRYPTO), crypto_accelerated(CryptoAlgorithm::AES_GCM, features));
+    EXPECT_FALSE(sdc_kernel_accelerated(SdcKernel::INTEGER));
+    EXPECT_FALSE(sdc_kernel_accelerated(SdcKernel::SIMD));
+}
+
+/**
+ * @test SdcScreen_CleanRun
+ * @brief Tests that a short screen on a healthy host finds no mismatches.
+ */
+TEST(SdcScreenTest, CleanRun) {
+    std::vector<int> cpus = current_thread_cpus();
+    ASSERT_FALSE(cpus.empty());
+
+    // Two workers on the same core still exercise the cross-core comparison
+    SdcScreenResult result = run_sdc_screen({cpus.front(), cpus.front()}, std::chrono::milliseconds(300));
+
+    ASSERT_EQ(result.rounds.size(), 2u);
+    EXPECT_GT(result.kernel_runs, 0u);
+    EXPECT_GT(result.runs_per_second, 0.0);
+    EXPECT_GT(result.rounds_compared, 0u);
+    EXPECT_TRUE(result.mismatches.empty());
+}
+
+} // namespace cm5_peripheral_test
@@ -0,0 +1,125 @@
+/**
+ * @file test_stress_generator.cpp
+ * @brief Unit tests for the CPU stress generator.
+ * @author Sandesh Ghimire | sandesh@soccentric
+ * @copyright (C) Soccentric LLC. All rights reserved.
+ */
+
+#include "stress_generator.h"
+#include "cpu_affinity.h"
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <thread>
+
+namespace cm5_peripheral_test {
+
+/**
+ * @test StressGenerator_ParseWorkload
+ * @brief Tests that workload names round-trip and unknown names fail.
+ */
+TEST(StressGeneratorTest, ParseWorkload) {
+    const StressWorkload workloads[] = {StressWorkload::INTEGER, StressWorkload::FLOAT_SIMD,
+                                        StressWorkload::CACHE_THRASH, StressWorkload::MEMORY_STREAM};
+    for (StressWorkload workload : workloads) {
+        StressWorkload parsed = StressWorkload::INTEGER;
+        EXPECT_TRUE(parse_stress_workload(stress_workload_name(workload), parsed));
+        EXPECT_EQ(parsed, workload);
+    }
+
+    StressWorkload parsed;
+    EXPECT_FALSE(parse_stress_workload("avx512", parsed));
+}
+
+/**
+ * @test StressGenerator_RunsEveryWorkload
+ * @brief Tests that each workload makes progress and stops on request.
+ */
+TEST(StressGeneratorTest, RunsEveryWorkload) {
+    std::vector<int> cpus = current_thread_cpus();
+    ASSERT_FALSE(cpus.empty());
+
+    StressConfig config;
+    config.mix = {StressWorkload::INTEGER, StressWorkload::FLOAT_SIMD, StressWorkload::CACHE_THRASH,
+                  StressWorkload::MEMORY_STREAM};
+    config.cpus.assign(4, cpus.front());
+    config.cache_bytes = 256 * 1024;
+
+    StressGenerator generator(config);
+    ASSERT_TRUE(generator.start());
+    EXPECT_TRUE(generator.is_running());
+    EXPECT_FALSE(generator.start());
+
+    // Wait for every worker rather than a fixed time: the streaming
+    // worker first faults in its buffers, and all four share one core
+    auto progressed = [&generator]() {
+        std::vector<uint64_t> work = generator.work_done();
+        return std::all_of(work.begin(), work.end(), [](uint64_t units) { return units > 0; });
+    };
+    auto give_up = std::chrono::steady_clock::now() + std::chrono::seconds(30);
+    while (!progressed() && std::chrono::steady_clock::now() < give_up) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    }
+    generator.stop();
+    EXPECT_FALSE(generator.is_running());
+
+    std::vector<uint64_t> work = generator.work_done();
+    ASSERT_EQ(work.size(), 4u);
+    for (uint64_t units : work) {
+        EXPECT_GT(units, 0u);
+    }
+}
+
+/**
+ * @test StressGenerator_DutyCycle
+ * @brief Tests that a lower duty cycle does proportionally less work.
+ *
+ * Both duty cycles run at once on the same core, so whatever else is
+ * competing for the CPU slows them alike. The period is long enough that
+ * the scheduler's preference for a freshly woken thread covers only a
+ * small part of each on-window.
+ */
+TEST(StressGeneratorTest, DutyCycle) {
+    std::vector<int> cpus = current_thread_cpus();
+    ASSERT_FALSE(cpus.empty());
+
+    StressConfig config;
+    config.cpus = {cpus.front(), cpus.front()};
+    config.duty_cycles = {1.0, 0.25};
+    config.period = std::chrono::milliseconds(100);
+    StressGenerator generator(config);
+    ASSERT_TRUE(generator.start());
+    std::this_thread::sleep_for(std::chrono::seconds(2));
+    generator.stop();
+    std::vector<uint64_t> work = generator.work_done();
+    ASSERT_EQ(work.size(), 2u);
+    ASSERT_GT(work[0], 0u);
+    EXPECT_LT(work[1], work[0] * 0.6);
+
+    StressConfig idle;
+    idle.cpus = {cpus.front()};
+    idle.duty_cycles = {0.0};
+    idle.period = std::chrono::milliseconds(20);
+    StressGenerator off(idle);
+    off.start();
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    off.stop();
+    EXPECT_EQ(off.work_done().front(), 0u);
+}
+
+/**
+ * @test StressGenerator_Describe
+ * @brief Tests that the description lists each core's workload and duty.
+ */
+TEST(StressGeneratorTest, Describe) {
+    StressConfig config;
+    config.mix = {StressWorkload::FLOAT_SIMD, StressWorkload::MEMORY_STREAM};
+    config.cpus = {0, 0};
+    config.duty_cycles = {1.0, 0.5};
+    StressGenerator generator(config);
+
+    std::string text = generator.describe();
+    EXPECT_NE(text.find("cpu0: fp @ 100%"), std::string::npos);
+    EXPECT_NE(text.find("cpu0: mem @ 50%"), std::string::npos);
+}
+
+} // namespace cm5_peripheral_test
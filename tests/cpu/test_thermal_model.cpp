@@ -0,0 +1,138 @@
+/**
+ * @file test_thermal_model.cpp
+ * @brief Unit tests for the online thermal model.
+ * @author Sandesh Ghimire | sandesh@soccentric
+ * @copyright (C) Soccentric LLC. All rights reserved.
+ */
+
+#include "thermal_model.h"
+#include "fake_sysfs.h"
+#include <gtest/gtest.h>
+#include <cmath>
+
+namespace cm5_peripheral_test {
+
+namespace {
+
+/**
+ * @brief Feeds @p model an exact first-order response.
+ * @param load_at Load for the interval starting at second k.
+ */
+template <typename Load>
+double simulate(ThermalModel& model, double tau, double ambient, double rise, int seconds, Load load_at) {
+    double a = std::exp(-1.0 / tau);
+    double temp = ambient;
+    model.add_sample(0.0, temp, 0.0);
+    for (int k = 0; k < seconds; ++k) {
+        double load = load_at(k);
+        temp = a * temp + (1.0 - a) * (ambient + rise * load);
+        model.add_sample(k + 1.0, temp, load);
+    }
+    return temp;
+}
+
+} // namespace
+
+/**
+ * @test ThermalModel_RecoversParameters
+ * @brief Tests that tau, ambient and rise are recovered from a varying load.
+ */
+TEST(ThermalModelTest, RecoversParameters) {
+    ThermalModel model;
+    double temp = simulate(model, 120.0, 30.0, 40.0, 300, [](int k) { return (k / 60) % 2 == 0 ? 0.2 : 1.0; });
+
+    ThermalFit fit = model.fit();
+    ASSERT_TRUE(fit.valid);
+    EXPECT_TRUE(fit.load_separable);
+    EXPECT_EQ(fit.samples, 300u);
+    EXPECT_NEAR(fit.interval_s, 1.0, 1e-9);
+    EXPECT_NEAR(fit.tau_s, 120.0, 0.5);
+    EXPECT_NEAR(fit.ambient_c, 30.0, 0.1);
+    EXPECT_NEAR(fit.rise_c, 40.0, 0.1);
+    EXPECT_LT(fit.rms_error_c, 0.01);
+
+    // Full-load steady state is 70°C: a 60°C limit is reached, 85°C never is
+    double expected = 120.0 * std::log((70.0 - temp) / (70.0 - 60.0));
+    EXPECT_NEAR(predict_time_to_limit(fit, temp, 1.0, 60.0), expected, 2.0);
+    EXPECT_TRUE(std::isinf(predict_time_to_limit(fit, temp, 1.0, 85.0)));
+    EXPECT_DOUBLE_EQ(predict_time_to_limit(fit, 61.0, 1.0, 60.0), 0.0);
+
+    std::string text = format_thermal_prediction(fit, temp, 1.0, 60.0);
+    EXPECT_NE(text.find("ambient 30.0"), std::string::npos);
+    EXPECT_NE(text.find("at full load"), std::string::npos);
+}
+
+/**
+ * @test ThermalModel_ConstantLoad
+ * @brief Tests that a constant load still yields tau and the steady state.
+ */
+TEST(ThermalModelTest, ConstantLoad) {
+    ThermalModel model;
+    simulate(model, 90.0, 25.0, 30.0, 200, [](int) { return 1.0; });
+
+    ThermalFit fit = model.fit();
+    ASSERT_TRUE(fit.valid);
+    EXPECT_FALSE(fit.load_separable);
+    EXPECT_NEAR(fit.tau_s, 90.0, 0.5);
+    EXPECT_NEAR(fit.steady_state_c, 55.0, 0.1);
+    EXPECT_NEAR(fit.mean_load, 1.0, 1e-9);
+}
+
+/**
+ * @test ThermalModel_NotFitted
+ * @brief Tests that too few samples or a flat trace do not produce a fit.
+ */
+TEST(ThermalModelTest, NotFitted) {
+    ThermalModel few;
+    simulate(few, 60.0, 30.0, 20.0, 5, [](int) { return 1.0; });
+    EXPECT_FALSE(few.fit().valid);
+
+    ThermalModel flat;
+    for (int k = 0; k < 50; ++k) {
+        flat.add_sample(k, 45.0, 0.5);
+    }
+    ThermalFit fit = flat.fit();
+    EXPECT_FALSE(fit.valid);
+    EXPECT_TRUE(std::isinf(predict_time_to_limit(fit, 45.0, 1.0, 85.0)));
+    EXPECT_NE(format_thermal_prediction(fit, 45.0, 0.5, 85.0).find("not fitted"), std::string::npos);
+}
+
+/**
+ * @test ThermalModel_TripPoint
+ * @brief Tests choosing the lowest passive trip from a fake thermal zone.
+ */
+TEST(ThermalModelTest, TripPoint) {
+    FakeSysfs sysfs("thermal_model_sysfs");
+    std::string zone = (sysfs.root() / "thermal_zone0").string();
+    EXPECT_DOUBLE_EQ(read_trip_point(zone), -1.0);
+
+    sysfs.write("thermal_zone0/trip_point_0_type", "critical\n");
+    sysfs.write("thermal_zone0/trip_point_0_temp", "110000\n");
+    sysfs.write("thermal_zone0/trip_point_1_type", "active\n");
+    sysfs.write("thermal_zone0/trip_point_1_temp", "50000\n");
+    EXPECT_DOUBLE_EQ(read_trip_point(zone), 50.0);
+
+    sysfs.write("thermal_zone0/trip_point_2_type", "passive\n");
+    sysfs.write("thermal_zone0/trip_point_2_temp", "85000\n");
+    EXPECT_DOUBLE_EQ(read_trip_point(zone), 85.0);
+}
+
+/**
+ * @test ThermalModel_LoadSampler
+ * @brief Tests the busy fraction between two fake /proc/stat snapshots.
+ */
+TEST(ThermalModelTest, LoadSampler) {
+    FakeSysfs proc("thermal_model_proc");
+    proc.write("stat", "cpu  100 0 100 700 100 0 0 0 0 0\ncpu0 100 0 100 700 100 0 0 0 0 0\n");
+    SystemLoadSampler sampler(proc.root().string());
+
+    // 300 busy and 100 idle jiffies since the baseline
+    proc.write("stat", "cpu  300 0 200 800 100 0 0 0 0 0\n");
+    EXPECT_DOUBLE_EQ(sampler.sample(), 0.75);
+    EXPECT_DOUBLE_EQ(sampler.sample(), 0.0);
+
+    proc.remove("stat");
+    EXPECT_DOUBLE_EQ(sampler.sample(), -1.0);
+}
+
+} // namespace cm5_peripheral_test
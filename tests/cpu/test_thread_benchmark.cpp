@@ -0,0 +1,61 @@
+/**
+ * @file test_thread_benchmark.cpp
+ * @brief Unit tests for the thread lifecycle and synchronization cost benchmarks.
+ * @author Sandesh Ghimire | sandesh@soccentric
+ * @copyright (C) Soccentric LLC. All rights reserved.
+ */
+
+#include "thread_benchmark.h"
+#include "cpu_affinity.h"
+#include <gtest/gtest.h>
+#include <string>
+
+namespace cm5_peripheral_test {
+
+/**
+ * @test ThreadBenchmark_Names
+ * @brief Tests that every operation has a display name.
+ */
+TEST(ThreadBenchmarkTest, Names) {
+    EXPECT_EQ(std::string(thread_operation_name(ThreadOperation::FUTEX)), "futex wake");
+    EXPECT_EQ(std::string(thread_operation_name(ThreadOperation::EVENTFD)), "eventfd signal");
+}
+
+/**
+ * @test ThreadBenchmark_AllOperations
+ * @brief Tests that each operation completes every round on the current CPUs.
+ */
+TEST(ThreadBenchmarkTest, AllOperations) {
+    std::vector<int> cpus = current_thread_cpus();
+    ASSERT_FALSE(cpus.empty());
+
+    const ThreadOperation operations[] = {
+        ThreadOperation::CREATE_JOIN, ThreadOperation::CONDVAR_HANDOFF, ThreadOperation::FUTEX,
+        ThreadOperation::BARRIER,     ThreadOperation::EVENTFD,
+    };
+    for (ThreadOperation operation : operations) {
+        ThreadCostResult result = run_thread_benchmark(operation, cpus, 3, 50);
+        EXPECT_TRUE(result.completed) << thread_operation_name(operation);
+        EXPECT_EQ(result.threads, 3);
+        EXPECT_EQ(result.rounds, 50u);
+        EXPECT_GT(result.median_ns, 0.0);
+        EXPECT_LE(result.median_ns, result.p99_ns);
+        EXPECT_LE(result.p99_ns, result.max_ns);
+    }
+}
+
+/**
+ * @test ThreadBenchmark_MinimumThreads
+ * @brief Tests that a single requested thread is raised to a pair.
+ */
+TEST(ThreadBenchmarkTest, MinimumThreads) {
+    ThreadCostResult result = run_thread_benchmark(ThreadOperation::FUTEX, {0}, 1, 20);
+    EXPECT_EQ(result.threads, 2);
+    EXPECT_TRUE(result.completed);
+
+    ThreadCostResult empty = run_thread_benchmark(ThreadOperation::BARRIER, {}, 2, 20);
+    EXPECT_FALSE(empty.completed);
+    EXPECT_EQ(empty.rounds, 0u);
+}
+
+} // namespace cm5_peripheral_test
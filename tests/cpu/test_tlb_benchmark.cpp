@@ -0,0 +1,72 @@
+/**
+ * @file test_tlb_benchmark.cpp
+ * @brief Unit tests for the TLB and huge-page benchmark.
+ * @author Sandesh Ghimire | sandesh@soccentric
+ * @copyright (C) Soccentric LLC. All rights reserved.
+ */
+
+#include "tlb_benchmark.h"
+#include "fake_sysfs.h"
+#include <gtest/gtest.h>
+
+namespace cm5_peripheral_test {
+
+/**
+ * @test TlbBenchmark_HugePageSize
+ * @brief Tests reading hpage_pmd_size and the 2 MiB fallback.
+ */
+TEST(TlbBenchmarkTest, HugePageSize) {
+    FakeSysfs sysfs("tlb_benchmark_sysfs");
+    EXPECT_EQ(huge_page_size(sysfs.root().string()), 2u * 1024 * 1024);
+
+    sysfs.write("kernel/mm/transparent_hugepage/hpage_pmd_size", "33554432\n");
+    EXPECT_EQ(huge_page_size(sysfs.root().string()), 32u * 1024 * 1024);
+}
+
+/**
+ * @test TlbBenchmark_AnonHugeBytes
+ * @brief Tests that AnonHugePages is taken from the mapping holding the address.
+ */
+TEST(TlbBenchmarkTest, AnonHugeBytes) {
+    FakeSysfs proc("tlb_benchmark_proc");
+    std::string path = (proc.root() / "smaps").string();
+    proc.write("smaps",
+               "00400000-00500000 r-xp 00000000 08:01 1234   /usr/bin/tool\n"
+               "Size:               1024 kB\n"
+               "AnonHugePages:         0 kB\n"
+               "7f0000000000-7f0000800000 rw-p 00000000 00:00 0\n"
+               "Size:               8192 kB\n"
+               "AnonHugePages:      6144 kB\n"
+               "VmFlags: rd wr mr mw me ac hg\n");
+
+    EXPECT_EQ(anon_huge_bytes(reinterpret_cast<const void*>(0x7f0000100000ULL), path), 6144u * 1024);
+    EXPECT_EQ(anon_huge_bytes(reinterpret_cast<const void*>(0x00410000ULL), path), 0u);
+    EXPECT_EQ(anon_huge_bytes(reinterpret_cast<const void*>(0x10ULL), path), 0u);
+}
+
+/**
+ * @test TlbBenchmark_BasePages
+ * @brief Tests a short chase over base pages.
+ */
+TEST(TlbBenchmarkTest, BasePages) {
+    TlbResult result = run_tlb_benchmark(PageBacking::BASE_PAGES, 1u << 20, 100000);
+    ASSERT_TRUE(result.available) << result.note;
+    EXPECT_EQ(result.working_set, 1u << 20);
+    EXPECT_EQ(result.pages, (1u << 20) / base_page_size());
+    EXPECT_GT(result.ns_per_access, 0.0);
+    EXPECT_DOUBLE_EQ(result.huge_fraction, 0.0);
+}
+
+/**
+ * @test TlbBenchmark_TransparentHuge
+ * @brief Tests that the THP backing maps and runs whether or not THP is enabled.
+ */
+TEST(TlbBenchmarkTest, TransparentHuge) {
+    TlbResult result = run_tlb_benchmark(PageBacking::TRANSPARENT_HUGE, 2 * huge_page_size(), 100000);
+    ASSERT_TRUE(result.available) << result.note;
+    EXPECT_GT(result.ns_per_access, 0.0);
+    EXPECT_GE(result.huge_fraction, 0.0);
+    EXPECT_LE(result.huge_fraction, 1.0);
+}
+
+} // namespace cm5_peripheral_test
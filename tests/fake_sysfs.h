@@ -0,0 +1,96 @@
+/**
+ * @file fake_sysfs.h
+ * @brief Scratch directory standing in for sysfs or procfs in unit tests.
+ * @author Sandesh Ghimire | sandesh@soccentric
+ * @copyright (C) Soccentric LLC. All rights reserved.
+ */
+
+#ifndef FAKE_SYSFS_H
+#define FAKE_SYSFS_H
+
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <unistd.h>
+
+namespace cm5_peripheral_test {
+
+/**
+ * @class FakeSysfs
+ * @brief Per-process directory tree, removed with its contents on destruction.
+ *
+ * The directory name carries the process id, so parallel test runs from
+ * different build trees never share files. Readers under test take
+ * root() in place of their /sys or /proc path.
+ */
+class FakeSysfs {
+public:
+    /**
+     * @brief Creates an empty tree.
+     * @param name Directory name prefix, unique per test file.
+     */
+    explicit FakeSysfs(const std::string& name)
+        : root_(std::filesystem::temp_directory_path() / (name + "_" + std::to_string(::getpid()))) {
+        std::filesystem::remove_all(root_);
+        std::filesystem::create_directories(root_);
+    }
+
+    ~FakeSysfs() {
+        std::error_code ec;
+        std::filesystem::remove_all(root_, ec);
+    }
+
+    FakeSysfs(const FakeSysfs&) = delete;
+    FakeSysfs& operator=(const FakeSysfs&) = delete;
+
+    /**
+     * @brief Returns the root of the tree.
+     */
+    const std::filesystem::path& root() const { return root_; }
+
+    /**
+     * @brief Writes a file, creating its parent directories.
+     * @param relative Path below root().
+     * @param content Exact file contents.
+     * @param append Append instead of replacing the file.
+     */
+    void write(const std::filesystem::path& relative, const std::string& content, bool append = false) const {
+        std::filesystem::path path = root_ / relative;
+        std::filesystem::create_directories(path.parent_path());
+        std::ofstream(path, append ? std::ios::app : std::ios::trunc) << content;
+    }
+
+    /**
+     * @brief Creates a directory and its parents.
+     * @param relative Path below root().
+     */
+    void create_directory(const std::filesystem::path& relative) const {
+        std::filesystem::create_directories(root_ / relative);
+    }
+
+    /**
+     * @brief Reads the first whitespace-separated token of a file.
+     * @param relative Path below root().
+     * @return Token, or "" if the file is missing or empty.
+     */
+    std::string read(const std::filesystem::path& relative) const {
+        std::string value;
+        std::ifstream(root_ / relative) >> value;
+        return value;
+    }
+
+    /**
+     * @brief Removes a file or directory, as when a device goes away.
+     * @param relative Path below root().
+     */
+    void remove(const std::filesystem::path& relative) const {
+        std::filesystem::remove_all(root_ / relative);
+    }
+
+private:
+    std::filesystem::path root_; /**< Tree root */
+};
+
+} // namespace cm5_peripheral_test
+
+#endif // FAKE_SYSFS_H